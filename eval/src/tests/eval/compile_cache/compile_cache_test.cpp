@@ -6,9 +6,12 @@
 #include <vespa/eval/eval/test/eval_spec.h>
 #include <vespa/vespalib/util/time.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
+#include <vespa/vespalib/component/vtag.h>
 #include <vespa/vespalib/util/blockingthreadstackexecutor.h>
 #include <vespa/vespalib/util/size_literals.h>
 #include <vespa/vespalib/util/stringfmt.h>
+#include <filesystem>
+#include <fstream>
 #include <set>
 
 using namespace vespalib;
@@ -241,6 +244,123 @@ TEST("require that the same executor can be bound multiple times") {
     EXPECT_EQUAL(exe1->tasks.size(), 1u);
 }
 
+//-----------------------------------------------------------------------------
+
+struct PersistentCacheDir {
+    vespalib::string dir;
+    PersistentCacheDir() : dir("persistent_compile_cache") { std::filesystem::remove_all(dir.c_str()); }
+    ~PersistentCacheDir() { std::filesystem::remove_all(dir.c_str()); }
+    // simulates a new process using the same cache directory
+    PersistentObjectCache::SP restart() {
+        auto cache = std::make_shared<PersistentObjectCache>(dir);
+        CompileCache::set_persistent_cache(cache);
+        return cache;
+    }
+};
+
+TEST_F("require that compiled code can be stored in and loaded from the persistent cache", PersistentCacheDir()) {
+    auto cache = f1.restart();
+    EXPECT_EQUAL(CompileCache::get_persistent_cache().get(), cache.get());
+    {
+        auto token = CompileCache::compile(*Function::parse("x+y*z"), PassParams::SEPARATE);
+        EXPECT_EQUAL(7.0, token->get().get_function<3>()(1.0, 2.0, 3.0));
+        EXPECT_EQUAL(cache->num_stored(), 1u);
+        EXPECT_EQUAL(cache->num_loaded(), 0u);
+    }
+    cache = f1.restart();
+    {
+        auto token = CompileCache::compile(*Function::parse("x+y*z"), PassParams::SEPARATE);
+        EXPECT_EQUAL(7.0, token->get().get_function<3>()(1.0, 2.0, 3.0));
+        auto other = CompileCache::compile(*Function::parse("x+y*z"), PassParams::ARRAY);
+        std::vector<double> params({1.0, 2.0, 3.0});
+        EXPECT_EQUAL(7.0, other->get().get_function()(&params[0]));
+        EXPECT_EQUAL(cache->num_stored(), 1u);
+        EXPECT_EQUAL(cache->num_loaded(), 1u);
+    }
+    CompileCache::set_persistent_cache({});
+    EXPECT_TRUE(CompileCache::get_persistent_cache().get() == nullptr);
+}
+
+std::vector<std::filesystem::path> list_object_files(const vespalib::string &dir) {
+    std::vector<std::filesystem::path> result;
+    for (const auto &entry: std::filesystem::directory_iterator(dir.c_str())) {
+        result.push_back(entry.path());
+    }
+    return result;
+}
+
+TEST_F("require that corrupt files in the persistent cache are removed and compiled again", PersistentCacheDir()) {
+    auto cache = f1.restart();
+    {
+        auto token = CompileCache::compile(*Function::parse("x+y*z"), PassParams::SEPARATE);
+        EXPECT_EQUAL(7.0, token->get().get_function<3>()(1.0, 2.0, 3.0));
+    }
+    auto files = list_object_files(f1.dir);
+    ASSERT_EQUAL(files.size(), 1u);
+    {
+        std::fstream file(files[0], std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(-1, std::ios::end);
+        file.put('\xff');
+    }
+    cache = f1.restart();
+    {
+        auto token = CompileCache::compile(*Function::parse("x+y*z"), PassParams::SEPARATE);
+        EXPECT_EQUAL(7.0, token->get().get_function<3>()(1.0, 2.0, 3.0));
+        EXPECT_EQUAL(cache->num_rejected(), 1u);
+        EXPECT_EQUAL(cache->num_loaded(), 0u);
+        EXPECT_EQUAL(cache->num_stored(), 1u);
+    }
+    CompileCache::set_persistent_cache({});
+}
+
+TEST_F("require that old and excess files are pruned from the persistent cache", PersistentCacheDir()) {
+    auto cache = f1.restart();
+    {
+        auto token1 = CompileCache::compile(*Function::parse("x+y"), PassParams::SEPARATE);
+        auto token2 = CompileCache::compile(*Function::parse("x*y"), PassParams::SEPARATE);
+        token1->get();
+        token2->get();
+    }
+    CompileCache::set_persistent_cache({});
+    auto files = list_object_files(f1.dir);
+    ASSERT_EQUAL(files.size(), 2u);
+    auto now = std::filesystem::file_time_type::clock::now();
+    std::filesystem::last_write_time(files[0], now - std::chrono::hours(2));
+    std::filesystem::last_write_time(files[1], now - std::chrono::minutes(1));
+    PersistentObjectCache within_limits(f1.dir, 1_Gi, std::chrono::hours(3));
+    EXPECT_EQUAL(list_object_files(f1.dir).size(), 2u);
+    PersistentObjectCache by_age(f1.dir, 1_Gi, std::chrono::hours(1));
+    auto left = list_object_files(f1.dir);
+    ASSERT_EQUAL(left.size(), 1u);
+    EXPECT_TRUE(left[0] == files[1]);
+    PersistentObjectCache by_size(f1.dir, std::filesystem::file_size(left[0]) - 1, std::chrono::hours(1));
+    EXPECT_EQUAL(list_object_files(f1.dir).size(), 0u);
+}
+
+TEST_F("require that code with process local state is not stored in the persistent cache", PersistentCacheDir()) {
+    auto cache = f1.restart();
+    auto token = CompileCache::compile(*Function::parse("x in [1,2,3,4,5,6,7,8,9,10]"), PassParams::SEPARATE);
+    EXPECT_EQUAL(1.0, token->get().get_function<1>()(10.0));
+    EXPECT_EQUAL(0.0, token->get().get_function<1>()(11.0));
+    EXPECT_EQUAL(cache->num_stored(), 0u);
+    EXPECT_EQUAL(cache->num_loaded(), 0u);
+    CompileCache::set_persistent_cache({});
+}
+
+TEST("require that persistent cache ids depend on the key") {
+    PersistentObjectCache cache("persistent_compile_cache_ids");
+    EXPECT_EQUAL(cache.make_id("foo"), cache.make_id("foo"));
+    EXPECT_NOT_EQUAL(cache.make_id("foo"), cache.make_id("bar"));
+    EXPECT_EQUAL(cache.make_id("foo").size(), 32u);
+    std::filesystem::remove_all("persistent_compile_cache_ids");
+}
+
+TEST("require that persistent cache host key covers the vespa commit and codegen version") {
+    vespalib::string key = PersistentObjectCache::host_key();
+    EXPECT_TRUE(key.find(VersionTagCommitSha) != vespalib::string::npos);
+    EXPECT_TRUE(key.find(make_string("codegen:%u;", PersistentObjectCache::codegen_version)) != vespalib::string::npos);
+}
+
 struct CompileCheck : test::EvalSpec::EvalTest {
     struct Entry {
         CompileCache::Token::UP fun;
@@ -11,6 +11,7 @@ std::mutex CompileCache::_lock{};
 CompileCache::Map CompileCache::_cached{};
 uint64_t CompileCache::_executor_tag{0};
 std::vector<std::pair<uint64_t,std::shared_ptr<Executor>>> CompileCache::_executor_stack{};
+PersistentObjectCache::SP CompileCache::_persistent_cache{};
 
 const CompiledFunction &
 CompileCache::Value::wait_for_result()
@@ -64,7 +65,7 @@ CompileCache::compile(const Function &function, PassParams pass_params)
             auto res = _cached.emplace(std::move(key), Value::ctor_tag());
             assert(res.second);
             token = std::make_unique<Token>(res.first, Token::ctor_tag());
-            task = std::make_unique<CompileTask>(function, pass_params, res.first->second.result);
+            task = std::make_unique<CompileTask>(function, pass_params, res.first->second.result, _persistent_cache);
             task = CpuUsage::wrap(std::move(task), CpuUsage::Category::SETUP);
             if (!_executor_stack.empty()) {
                 executor = _executor_stack.back().second;
@@ -101,6 +102,20 @@ CompileCache::wait_pending()
     }
 }
 
+void
+CompileCache::set_persistent_cache(PersistentObjectCache::SP cache)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    _persistent_cache = std::move(cache);
+}
+
+PersistentObjectCache::SP
+CompileCache::get_persistent_cache()
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _persistent_cache;
+}
+
 size_t
 CompileCache::num_cached()
 {
@@ -142,7 +157,9 @@ CompileCache::count_pending()
 void
 CompileCache::CompileTask::run()
 {
-    auto compiled = std::make_unique<CompiledFunction>(*function, pass_params);
+    auto compiled = persistent_cache
+                    ? std::make_unique<CompiledFunction>(*function, pass_params, persistent_cache)
+                    : std::make_unique<CompiledFunction>(*function, pass_params);
     std::lock_guard<std::mutex> guard(result->lock);
     result->compiled_function = std::move(compiled);
     result->cf.store(result->compiled_function.get(), std::memory_order_release);
@@ -17,6 +17,10 @@ namespace vespalib::eval {
  * to query the cache. The cache itself will not keep anything alive,
  * but will let you find compiled functions that are currently in use
  * by others.
+ *
+ * A persistent object cache may be set to also keep the generated
+ * machine code on disk, letting later processes skip compilation of
+ * expressions they have seen before.
  **/
 class CompileCache
 {
@@ -49,6 +53,7 @@ private:
     static Map _cached;
     static uint64_t _executor_tag;
     static std::vector<std::pair<uint64_t,std::shared_ptr<Executor>>> _executor_stack;
+    static PersistentObjectCache::SP _persistent_cache;
 
     static void release(Map::iterator entry);
     static uint64_t attach_executor(std::shared_ptr<Executor> executor);
@@ -93,6 +98,9 @@ public:
     static ExecutorBinding::UP bind(std::shared_ptr<Executor> executor) {
         return std::make_unique<ExecutorBinding>(std::move(executor), ExecutorBinding::ctor_tag());
     }
+    // set the persistent object cache used for later compilations (nullptr to disable)
+    static void set_persistent_cache(PersistentObjectCache::SP cache);
+    static PersistentObjectCache::SP get_persistent_cache();
     static size_t num_cached();
     static size_t num_bound();
     static size_t count_refs();
@@ -103,8 +111,11 @@ private:
         std::shared_ptr<Function const> function;
         PassParams pass_params;
         Result::SP result;
-        CompileTask(const Function &function_in, PassParams pass_params_in, Result::SP result_in)
-            : function(function_in.shared_from_this()), pass_params(pass_params_in), result(std::move(result_in)) {}
+        PersistentObjectCache::SP persistent_cache;
+        CompileTask(const Function &function_in, PassParams pass_params_in, Result::SP result_in,
+                    PersistentObjectCache::SP persistent_cache_in)
+            : function(function_in.shared_from_this()), pass_params(pass_params_in), result(std::move(result_in)),
+              persistent_cache(std::move(persistent_cache_in)) {}
         void run() override;
     };
 };
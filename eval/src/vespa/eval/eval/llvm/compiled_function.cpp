@@ -2,6 +2,7 @@
 
 #include "compiled_function.h"
 #include <vespa/eval/eval/param_usage.h>
+#include <vespa/eval/eval/key_gen.h>
 #include <vespa/eval/eval/gbdt.h>
 #include <vespa/eval/eval/node_traverser.h>
 #include <vespa/eval/eval/check_type.h>
@@ -33,7 +34,8 @@ double my_resolve(void *ctx, size_t idx) { return ((double *)ctx)[idx]; }
 } // namespace vespalib::eval::<unnamed>
 
 CompiledFunction::CompiledFunction(const nodes::Node &root_in, size_t num_params_in, PassParams pass_params_in,
-                                   const gbdt::Optimize::Chain &forest_optimizers)
+                                   const gbdt::Optimize::Chain &forest_optimizers,
+                                   PersistentObjectCache::SP object_cache, const vespalib::string &cache_key)
     : _llvm_wrapper(),
       _address(nullptr),
       _num_params(num_params_in),
@@ -43,10 +45,26 @@ CompiledFunction::CompiledFunction(const nodes::Node &root_in, size_t num_params
                                             _pass_params,
                                             root_in,
                                             forest_optimizers);
+    if (object_cache) {
+        _llvm_wrapper.use_object_cache(std::move(object_cache), cache_key);
+    }
     _llvm_wrapper.compile();
     _address = _llvm_wrapper.get_function_address(id);
 }
 
+CompiledFunction::CompiledFunction(const nodes::Node &root_in, size_t num_params_in, PassParams pass_params_in,
+                                   const gbdt::Optimize::Chain &forest_optimizers)
+    : CompiledFunction(root_in, num_params_in, pass_params_in, forest_optimizers, {}, {})
+{
+}
+
+CompiledFunction::CompiledFunction(const Function &function_in, PassParams pass_params_in,
+                                   PersistentObjectCache::SP object_cache)
+    : CompiledFunction(function_in.root(), function_in.num_params(), pass_params_in, gbdt::Optimize::best,
+                       object_cache, object_cache ? gen_key(function_in, pass_params_in) : vespalib::string())
+{
+}
+
 CompiledFunction::CompiledFunction(CompiledFunction &&rhs)
     : _llvm_wrapper(std::move(rhs._llvm_wrapper)),
       _address(rhs._address),
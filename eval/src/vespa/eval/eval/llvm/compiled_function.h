@@ -36,6 +36,9 @@ private:
     size_t      _num_params;
     PassParams  _pass_params;
 
+    CompiledFunction(const nodes::Node &root_in, size_t num_params_in, PassParams pass_params_in,
+                     const gbdt::Optimize::Chain &forest_optimizers,
+                     PersistentObjectCache::SP object_cache, const vespalib::string &cache_key);
 public:
     using UP = std::unique_ptr<CompiledFunction>;
     CompiledFunction(const nodes::Node &root_in, size_t num_params_in, PassParams pass_params_in,
@@ -46,6 +49,8 @@ public:
         : CompiledFunction(root_in, num_params_in, pass_params_in, gbdt::Optimize::best) {}
     CompiledFunction(const Function &function_in, PassParams pass_params_in)
         : CompiledFunction(function_in.root(), function_in.num_params(), pass_params_in, gbdt::Optimize::best) {}
+    // reuse machine code from (and store it in) the given persistent cache
+    CompiledFunction(const Function &function_in, PassParams pass_params_in, PersistentObjectCache::SP object_cache);
     CompiledFunction(CompiledFunction &&rhs);
     size_t num_params() const { return _num_params; }
     PassParams pass_params() const { return _pass_params; }
@@ -684,7 +684,8 @@ LLVMWrapper::LLVMWrapper()
       _engine(),
       _functions(),
       _forests(),
-      _plugin_state()
+      _plugin_state(),
+      _object_cache()
 {
     _context = std::make_unique<llvm::LLVMContext>();
     _module = std::make_unique<llvm::Module>("LLVMWrapper", *_context);
@@ -717,6 +718,13 @@ LLVMWrapper::make_forest_fragment(size_t num_params, const std::vector<const Nod
     return function_id;
 }
 
+void
+LLVMWrapper::use_object_cache(PersistentObjectCache::SP object_cache, const vespalib::string &key)
+{
+    _module->setModuleIdentifier(object_cache->make_id(key).c_str());
+    _object_cache = std::move(object_cache);
+}
+
 void
 LLVMWrapper::compile(llvm::raw_ostream * dumpStream)
 {
@@ -727,8 +735,17 @@ LLVMWrapper::compile(llvm::raw_ostream * dumpStream)
     _engine.reset(llvm::EngineBuilder(std::move(_module)).setOptLevel(CodeGenOptLevel::Aggressive).setRelocationModel(llvm::Reloc::Static).create());
     assert(_engine && "llvm jit not available for your platform");
 
+    // forests and plugin state are injected into the code as addresses
+    // only valid in this process, making the code unsuitable for reuse
+    bool cacheable = (_object_cache && _forests.empty() && _plugin_state.empty());
+    if (cacheable) {
+        _engine->setObjectCache(_object_cache.get());
+    }
     MallocMmapGuard largeAllocsAsMMap(1_Mi);
     _engine->finalizeObject();
+    if (cacheable) {
+        _engine->setObjectCache(nullptr);
+    }
 }
 
 void *
@@ -742,6 +759,7 @@ LLVMWrapper::~LLVMWrapper() {
     _forests.clear();
     _functions.clear();
     _engine.reset();
+    _object_cache.reset();
     _module.reset();
     _context.reset();
 }
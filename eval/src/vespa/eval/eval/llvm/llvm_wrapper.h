@@ -4,6 +4,7 @@
 
 #include <vespa/eval/eval/function.h>
 #include <vespa/eval/eval/gbdt.h>
+#include "persistent_object_cache.h"
 
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
@@ -50,6 +51,7 @@ private:
     std::vector<llvm::Function*>           _functions;
     std::vector<gbdt::Forest::UP>          _forests;
     std::vector<PluginState::UP>           _plugin_state;
+    PersistentObjectCache::SP              _object_cache;
 
     void compile(llvm::raw_ostream * dumpStream);
 public:
@@ -60,6 +62,9 @@ public:
                          const gbdt::Optimize::Chain &forest_optimizers);
     size_t make_forest_fragment(size_t num_params, const std::vector<const nodes::Node *> &fragment);
     const std::vector<gbdt::Forest::UP> &get_forests() const { return _forests; }
+    // look up and store the machine code in the given cache when
+    // compiling, 'key' must uniquely identify all functions made
+    void use_object_cache(PersistentObjectCache::SP object_cache, const vespalib::string &key);
     void compile(llvm::raw_ostream & dumpStream) { compile(&dumpStream); }
     void compile() { compile(nullptr); }
     void *get_function_address(size_t function_id);
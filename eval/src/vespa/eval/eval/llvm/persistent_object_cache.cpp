@@ -0,0 +1,241 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "persistent_object_cache.h"
+#include <vespa/vespalib/component/vtag.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <llvm/ADT/StringMap.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/MemoryBuffer.h>
+#if LLVM_VERSION_MAJOR < 16
+#include <llvm/Support/Host.h>
+#else
+#include <llvm/TargetParser/Host.h>
+#endif
+#include <xxhash.h>
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".eval.eval.llvm.persistent_object_cache");
+
+namespace vespalib::eval {
+
+namespace {
+
+constexpr const char *suffix = ".o";
+constexpr uint64_t file_magic = 0x564f424a43414348; // "VOBJCACH"
+
+struct FileHeader {
+    uint64_t magic;
+    uint64_t size;
+    uint64_t checksum;
+};
+static_assert(sizeof(FileHeader) == 24);
+
+uint64_t checksum_of(const char *data, size_t size) {
+    return XXH3_64bits(data, size);
+}
+
+void remove_file(const vespalib::string &name) {
+    std::error_code ec;
+    std::filesystem::remove(std::filesystem::path(name.c_str()), ec);
+}
+
+vespalib::string hash_of(const vespalib::string &a, const vespalib::string &b) {
+    XXH3_state_t *state = XXH3_createState();
+    XXH3_128bits_reset(state);
+    XXH3_128bits_update(state, a.data(), a.size());
+    XXH3_128bits_update(state, b.data(), b.size());
+    XXH128_hash_t hash = XXH3_128bits_digest(state);
+    XXH3_freeState(state);
+    return make_string("%016" PRIx64 "%016" PRIx64, uint64_t(hash.high64), uint64_t(hash.low64));
+}
+
+}
+
+PersistentObjectCache::PersistentObjectCache(const vespalib::string &dir, size_t max_bytes, vespalib::duration max_age)
+    : _dir(dir),
+      _host_key(host_key()),
+      _max_bytes(max_bytes),
+      _max_age(max_age),
+      _num_loaded(0),
+      _num_stored(0),
+      _num_rejected(0),
+      _bytes_since_prune(0),
+      _prune_lock()
+{
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(_dir.c_str()), ec);
+    if (ec) {
+        LOG(warning, "Could not create compile cache directory '%s': %s", _dir.c_str(), ec.message().c_str());
+        return;
+    }
+    size_t removed = prune();
+    if (removed > 0) {
+        LOG(info, "Removed %zu old compiled object files from '%s'", removed, _dir.c_str());
+    }
+}
+
+PersistentObjectCache::~PersistentObjectCache() = default;
+
+vespalib::string
+PersistentObjectCache::make_id(const vespalib::string &key) const
+{
+    return hash_of(_host_key, key);
+}
+
+vespalib::string
+PersistentObjectCache::file_name(const llvm::Module *module) const
+{
+    const auto &id = module->getModuleIdentifier();
+    return _dir + "/" + vespalib::string(id.data(), id.size()) + suffix;
+}
+
+void
+PersistentObjectCache::notifyObjectCompiled(const llvm::Module *module, llvm::MemoryBufferRef obj)
+{
+    vespalib::string name = file_name(module);
+    // write to a temporary file first, so that no other process sees a partial object file
+    vespalib::string tmp_name = make_string("%s.%d.%zu.tmp", name.c_str(), getpid(),
+                                            std::hash<std::thread::id>()(std::this_thread::get_id()));
+    FileHeader header{file_magic, obj.getBufferSize(), checksum_of(obj.getBufferStart(), obj.getBufferSize())};
+    {
+        std::ofstream file(tmp_name.c_str(), std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(obj.getBufferStart(), obj.getBufferSize());
+        if (!file.good()) {
+            LOG(warning, "Could not write compiled object file '%s'", tmp_name.c_str());
+            file.close();
+            remove_file(tmp_name);
+            return;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(std::filesystem::path(tmp_name.c_str()), std::filesystem::path(name.c_str()), ec);
+    if (ec) {
+        LOG(warning, "Could not rename '%s' to '%s': %s", tmp_name.c_str(), name.c_str(), ec.message().c_str());
+        remove_file(tmp_name);
+        return;
+    }
+    _num_stored.fetch_add(1, std::memory_order_relaxed);
+    size_t stored = _bytes_since_prune.fetch_add(sizeof(header) + header.size, std::memory_order_relaxed);
+    if (stored + sizeof(header) + header.size >= _max_bytes / 8) {
+        std::unique_lock guard(_prune_lock, std::try_to_lock);
+        if (guard.owns_lock()) {
+            prune();
+        }
+    }
+}
+
+std::unique_ptr<llvm::MemoryBuffer>
+PersistentObjectCache::getObject(const llvm::Module *module)
+{
+    vespalib::string name = file_name(module);
+    auto buffer = llvm::MemoryBuffer::getFile(name.c_str());
+    if (!buffer) {
+        return {};
+    }
+    const llvm::MemoryBuffer &file = *buffer.get();
+    FileHeader header{0, 0, 0};
+    if (file.getBufferSize() >= sizeof(header)) {
+        memcpy(&header, file.getBufferStart(), sizeof(header));
+    }
+    const char *obj = file.getBufferStart() + sizeof(header);
+    if (header.magic != file_magic || header.size != file.getBufferSize() - sizeof(header) ||
+        header.checksum != checksum_of(obj, header.size))
+    {
+        LOG(warning, "Removing corrupt compiled object file '%s'", name.c_str());
+        remove_file(name);
+        _num_rejected.fetch_add(1, std::memory_order_relaxed);
+        return {};
+    }
+    // keep recently used files when pruning
+    std::error_code ec;
+    std::filesystem::last_write_time(std::filesystem::path(name.c_str()),
+                                     std::filesystem::file_time_type::clock::now(), ec);
+    LOG(debug, "Loaded compiled object file '%s'", name.c_str());
+    _num_loaded.fetch_add(1, std::memory_order_relaxed);
+    return llvm::MemoryBuffer::getMemBufferCopy(llvm::StringRef(obj, header.size), file.getBufferIdentifier());
+}
+
+size_t
+PersistentObjectCache::prune()
+{
+    namespace fs = std::filesystem;
+    struct Entry {
+        fs::path path;
+        fs::file_time_type time;
+        uintmax_t size;
+    };
+    _bytes_since_prune.store(0, std::memory_order_relaxed);
+    auto now = fs::file_time_type::clock::now();
+    std::vector<Entry> entries;
+    size_t removed = 0;
+    std::error_code ec;
+    for (fs::directory_iterator itr(fs::path(_dir.c_str()), ec), end; !ec && itr != end; itr.increment(ec)) {
+        std::error_code entry_ec;
+        if (!itr->is_regular_file(entry_ec)) {
+            continue;
+        }
+        auto time = itr->last_write_time(entry_ec);
+        auto size = itr->file_size(entry_ec);
+        if (entry_ec) {
+            continue;
+        }
+        if (now - time > _max_age) {
+            removed += fs::remove(itr->path(), entry_ec) ? 1 : 0;
+        } else if (itr->path().extension() == suffix) {
+            // temporary files may still be written by someone, and are only removed when expired
+            entries.push_back({itr->path(), time, size});
+        }
+    }
+    if (ec) {
+        LOG(warning, "Could not list compile cache directory '%s': %s", _dir.c_str(), ec.message().c_str());
+    }
+    std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) { return a.time > b.time; });
+    uintmax_t kept_bytes = 0;
+    for (const auto &entry: entries) {
+        if (kept_bytes + entry.size <= _max_bytes) {
+            kept_bytes += entry.size;
+        } else {
+            std::error_code entry_ec;
+            removed += fs::remove(entry.path, entry_ec) ? 1 : 0;
+        }
+    }
+    return removed;
+}
+
+vespalib::string
+PersistentObjectCache::host_key()
+{
+#if LLVM_VERSION_MAJOR < 19
+    llvm::StringMap<bool> host_features;
+    llvm::sys::getHostCPUFeatures(host_features);
+#else
+    llvm::StringMap<bool> host_features = llvm::sys::getHostCPUFeatures();
+#endif
+    std::vector<std::string> features;
+    for (const auto &entry: host_features) {
+        if (entry.getValue()) {
+            features.push_back(entry.getKey().str());
+        }
+    }
+    std::sort(features.begin(), features.end());
+    vespalib::string key = make_string("llvm:%s;cpu:%s;vespa:%s/%s/%s;codegen:%u;features:",
+                                       LLVM_VERSION_STRING, llvm::sys::getHostCPUName().str().c_str(),
+                                       VersionTag, VersionTagDate, VersionTagCommitSha, codegen_version);
+    for (const auto &feature: features) {
+        key.append(feature);
+        key.append(",");
+    }
+    return key;
+}
+
+}
@@ -0,0 +1,77 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/util/time.h>
+#include <llvm/ExecutionEngine/ObjectCache.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace vespalib::eval {
+
+/**
+ * An LLVM object cache storing the machine code of compiled modules
+ * as files in a directory, so that later processes can load it
+ * instead of compiling the same module again. This is used to avoid
+ * recompiling large models on restart and reconfig.
+ *
+ * Modules are looked up by their module identifier, which must be set
+ * to the id returned by make_id for a key uniquely identifying the
+ * generated code. The id also covers the llvm version, the host cpu
+ * and the vespa build and commit, since machine code can only be
+ * reused by the same build on the same kind of host. Code with
+ * embedded addresses of process local objects must never be cached.
+ *
+ * Each file starts with a header holding the size and checksum of the
+ * object code, which is verified before the code is handed to llvm.
+ * Files that fail verification are removed. Loading a file refreshes
+ * its modification time. Files not used for max_age are removed, and
+ * the least recently used files are removed when the directory grows
+ * beyond max_bytes. This is done on construction and every time
+ * max_bytes / 8 has been stored since the last pruning.
+ **/
+class PersistentObjectCache : public llvm::ObjectCache
+{
+private:
+    vespalib::string    _dir;
+    vespalib::string    _host_key;
+    size_t              _max_bytes;
+    vespalib::duration  _max_age;
+    std::atomic<size_t> _num_loaded;
+    std::atomic<size_t> _num_stored;
+    std::atomic<size_t> _num_rejected;
+    std::atomic<size_t> _bytes_since_prune;
+    std::mutex          _prune_lock;
+
+    vespalib::string file_name(const llvm::Module *module) const;
+public:
+    using SP = std::shared_ptr<PersistentObjectCache>;
+    static constexpr size_t default_max_bytes = 1024ul * 1024ul * 1024ul;
+    static constexpr vespalib::duration default_max_age = std::chrono::hours(7 * 24);
+    explicit PersistentObjectCache(const vespalib::string &dir)
+        : PersistentObjectCache(dir, default_max_bytes, default_max_age) {}
+    PersistentObjectCache(const vespalib::string &dir, size_t max_bytes, vespalib::duration max_age);
+    ~PersistentObjectCache() override;
+    const vespalib::string &dir() const { return _dir; }
+    vespalib::string make_id(const vespalib::string &key) const;
+    void notifyObjectCompiled(const llvm::Module *module, llvm::MemoryBufferRef obj) override;
+    std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module *module) override;
+    size_t num_loaded() const { return _num_loaded.load(std::memory_order_relaxed); }
+    size_t num_stored() const { return _num_stored.load(std::memory_order_relaxed); }
+    // number of files that failed verification when loaded
+    size_t num_rejected() const { return _num_rejected.load(std::memory_order_relaxed); }
+    // remove expired files, then the least recently used ones until within max_bytes; returns files removed
+    size_t prune();
+
+    // Must be bumped whenever the code generated for a given key
+    // changes, since builds from a dirty tree share the same commit.
+    static constexpr uint32_t codegen_version = 1;
+
+    // llvm version, host cpu and features, vespa build and commit, and codegen version
+    static vespalib::string host_key();
+};
+
+}
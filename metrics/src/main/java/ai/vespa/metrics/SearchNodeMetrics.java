@@ -168,6 +168,7 @@ public enum SearchNodeMetrics implements VespaMetrics {
     CONTENT_PROTON_TRANSACTIONLOG_ENTRIES("content.proton.transactionlog.entries", Unit.RECORD, "The current number of entries in the transaction log"),
     CONTENT_PROTON_TRANSACTIONLOG_DISK_USAGE("content.proton.transactionlog.disk_usage", Unit.BYTE, "The disk usage (in bytes) of the transaction log"),
     CONTENT_PROTON_TRANSACTIONLOG_REPLAY_TIME("content.proton.transactionlog.replay_time", Unit.SECOND, "The replay time (in seconds) of the transaction log during start-up"),
+    CONTENT_PROTON_TRANSACTIONLOG_COMMIT_LATENCY("content.proton.transactionlog.commit_latency", Unit.SECOND, "The latency (in seconds) from a commit is started until it is synced and acked"),
 
     // document store
     CONTENT_PROTON_DOCUMENTDB_READY_DOCUMENT_STORE_DISK_USAGE("content.proton.documentdb.ready.document_store.disk_usage", Unit.BYTE, "Disk space usage in bytes"),
@@ -245,6 +246,9 @@ public enum SearchNodeMetrics implements VespaMetrics {
     CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_DOCS_RANKED("content.proton.documentdb.matching.rank_profile.docs_ranked", Unit.DOCUMENT, "Number of documents ranked (first phase)"),
     CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_DOCS_RERANKED("content.proton.documentdb.matching.rank_profile.docs_reranked", Unit.DOCUMENT, "Number of documents re-ranked (second phase)"),
     CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_LIMITED_QUERIES("content.proton.documentdb.matching.rank_profile.limited_queries", Unit.QUERY, "Number of queries limited in match phase"),
+    CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_PROFILED_QUERIES("content.proton.documentdb.matching.rank_profile.profiled_queries", Unit.QUERY, "Number of queries sampled for execution profiling"),
+    CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_PROFILED_ITERATOR_CALLS("content.proton.documentdb.matching.rank_profile.profiled_iterator_calls", Unit.OPERATION, "Number of search iterator calls (seek, unpack, ...) in profiled queries"),
+    CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_PROFILED_RANK_TIME("content.proton.documentdb.matching.rank_profile.profiled_rank_time", Unit.SECOND, "Average time (sec) spent in rank feature executors for profiled queries"),
     CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_DOCID_PARTITION_ACTIVE_TIME("content.proton.documentdb.matching.rank_profile.docid_partition.active_time", Unit.SECOND, "Time (sec) spent doing actual work"),
     CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_DOCID_PARTITION_DOCS_MATCHED("content.proton.documentdb.matching.rank_profile.docid_partition.docs_matched", Unit.DOCUMENT, "Number of documents matched"),
     CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_DOCID_PARTITION_DOCS_RANKED("content.proton.documentdb.matching.rank_profile.docid_partition.docs_ranked", Unit.DOCUMENT, "Number of documents ranked (first phase)"),
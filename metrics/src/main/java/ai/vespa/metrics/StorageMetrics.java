@@ -44,6 +44,9 @@ public enum StorageMetrics implements VespaMetrics {
     VDS_FILESTOR_ALLSTRIPES_THROTTLED_RPC_DIRECT_DISPATCHES("vds.filestor.allstripes.throttled_rpc_direct_dispatches", Unit.INSTANCE, "Number of times an RPC thread could not directly dispatch an async operation directly to Proton because it was disallowed by the throttle policy"),
     VDS_FILESTOR_ALLSTRIPES_THROTTLED_PERSISTENCE_THREAD_POLLS("vds.filestor.allstripes.throttled_persistence_thread_polls", Unit.INSTANCE, "Number of times a persistence thread could not immediately dispatch a queued async operation because it was disallowed by the throttle policy"),
     VDS_FILESTOR_ALLSTRIPES_TIMEOUTS_WAITING_FOR_THROTTLE_TOKEN("vds.filestor.allstripes.timeouts_waiting_for_throttle_token", Unit.INSTANCE, "Number of times a persistence thread timed out waiting for an available throttle policy token"),
+    VDS_FILESTOR_ALLSTRIPES_LOCK_CONTENTIONS("vds.filestor.allstripes.lock_contentions", Unit.INSTANCE, "Number of times a thread had to wait for the stripe lock held by another thread"),
+    VDS_FILESTOR_ALLSTRIPES_LOCK_WAIT_TIME("vds.filestor.allstripes.lock_wait_time", Unit.MILLISECOND, "Average time spent waiting for the stripe lock when it was held by another thread"),
+    VDS_FILESTOR_ALLSTRIPES_INHIBITED_OPERATIONS_SKIPPED("vds.filestor.allstripes.inhibited_operations_skipped", Unit.OPERATION, "Number of queued operations passed over when looking for the next operation to dispatch, because their bucket was locked or merges were throttled"),
     VDS_FILESTOR_ALLSTRIPES_AVERAGEQUEUEWAIT("vds.filestor.allstripes.averagequeuewait", Unit.MILLISECOND, "Average time an operation spends in input queue."),
 
     VDS_FILESTOR_ALLTHREADS_PUT_COUNT("vds.filestor.allthreads.put.count", Unit.OPERATION, "Number of requests processed."),
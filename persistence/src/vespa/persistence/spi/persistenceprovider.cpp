@@ -40,6 +40,13 @@ PersistenceProvider::put(const Bucket& bucket, Timestamp timestamp, DocumentSP d
     return *future.get();
 }
 
+void
+PersistenceProvider::putBatchAsync(const Bucket& bucket, std::vector<PutEntry> entries) {
+    for (auto& entry : entries) {
+        putAsync(bucket, entry.timestamp, std::move(entry.document), std::move(entry.on_complete));
+    }
+}
+
 RemoveResult
 PersistenceProvider::remove(const Bucket& bucket, Timestamp timestamp, const DocumentId & docId) {
     auto catcher = std::make_unique<CatchResult>();
@@ -9,6 +9,7 @@
 #include "selection.h"
 #include "clusterstate.h"
 #include "operationcomplete.h"
+#include "put_entry.h"
 #include <vespa/document/base/documentid.h>
 
 namespace document { class FieldSet; }
@@ -113,6 +114,15 @@ struct PersistenceProvider
      */
     virtual void putAsync(const Bucket &, Timestamp , DocumentSP, OperationComplete::UP ) = 0;
 
+    /**
+     * Store the given documents in the given bucket, in order. The
+     * completion callback of each entry is invoked when that particular
+     * put is done, as if it was given to putAsync. A provider can override
+     * this to amortize per operation overhead over the batch. The default
+     * implementation calls putAsync for each entry.
+     */
+    virtual void putBatchAsync(const Bucket &, std::vector<PutEntry> entries);
+
     /**
      * This remove function assumes that there exist something to be removed.
      * The data to be removed may not exist on this node though, so all remove
@@ -0,0 +1,19 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "put_entry.h"
+#include <vespa/document/fieldvalue/document.h>
+
+namespace storage::spi {
+
+PutEntry::PutEntry(Timestamp timestamp_, DocumentSP document_, OperationComplete::UP on_complete_) noexcept
+    : timestamp(timestamp_),
+      document(std::move(document_)),
+      on_complete(std::move(on_complete_))
+{
+}
+
+PutEntry::PutEntry(PutEntry&&) noexcept = default;
+PutEntry& PutEntry::operator=(PutEntry&&) noexcept = default;
+PutEntry::~PutEntry() = default;
+
+}
@@ -0,0 +1,24 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "operationcomplete.h"
+#include "types.h"
+
+namespace storage::spi {
+
+/**
+ * A single put in a batch of puts to the same bucket, with its own
+ * completion callback.
+ */
+struct PutEntry {
+    Timestamp              timestamp;
+    DocumentSP             document;
+    OperationComplete::UP  on_complete;
+
+    PutEntry(Timestamp timestamp_, DocumentSP document_, OperationComplete::UP on_complete_) noexcept;
+    PutEntry(PutEntry&&) noexcept;
+    PutEntry& operator=(PutEntry&&) noexcept;
+    ~PutEntry();
+};
+
+}
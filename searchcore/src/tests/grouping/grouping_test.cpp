@@ -11,7 +11,9 @@
 #include <vespa/searchcore/grouping/groupingsession.h>
 #include <vespa/searchcore/proton/matching/sessionmanager.h>
 #include <vespa/searchlib/common/allocatedbitvector.h>
+#include <vespa/searchlib/queryeval/blueprint.h>
 #include <vespa/searchlib/test/mock_attribute_context.h>
+#include <vespa/vespalib/util/simple_thread_bundle.h>
 #include <vespa/vespalib/util/testclock.h>
 #include <iostream>
 #include <vespa/vespalib/testkit/test_kit.h>
@@ -475,6 +477,62 @@ TEST_F("test grouping fork/join", DoomFixture()) {
     EXPECT_EQUAL(expect.asString(), list[0]->asString());
 }
 
+struct MyMetaStore : search::IDocumentMetaStore {
+    search::AllocatedBitVector dummy;
+    MyMetaStore() : dummy(1) {}
+    const search::BitVector & getValidLids() const override { return dummy; }
+    bool getGid(DocId, GlobalId &) const override { return false; }
+    bool getGidEvenIfMoved(DocId, GlobalId &) const override { return false; }
+    bool getLid(const GlobalId &, DocId &) const override { return false; }
+    DocumentMetaData getMetaData(const GlobalId &) const override { return {}; }
+    void getMetaData(const BucketId &, DocumentMetaData::Vector &) const override { }
+    DocId getCommittedDocIdLimit() const override { return 1; }
+    DocId getNumUsedLids() const override { return 0; }
+    DocId getNumActiveLids() const override { return 0; }
+    uint64_t getCurrentGeneration() const override { return 0; }
+    LidUsageStats getLidUsageStats() const override { return {}; }
+    std::unique_ptr<queryeval::Blueprint> createWhiteListBlueprint() const override { return {}; }
+    void foreach(const search::IGidToLidMapperVisitor &) const override { }
+};
+
+vespalib::string forkJoinMany(MyWorld &world, const DoomFixture &doom, vespalib::ThreadBundle &thread_bundle) {
+    GroupingContext context(world.bv, doom.clock.nowRef(), doom.timeOfDoom);
+    for (uint32_t i = 0; i < 5; ++i) {
+        Grouping request;
+        request.setId(i)
+               .setRoot(Group().addResult(SumAggregationResult().setExpression(MU<AttributeNode>("attr1"))))
+               .addLevel(createGL(i + 1, MU<AttributeNode>("attr0")))
+               .setFirstLevel(0)
+               .setLastLevel(1);
+        context.addGrouping(std::make_shared<Grouping>(request));
+    }
+    GroupingSession session(SessionId(), context, world.attributeContext);
+    session.prepareThreadContextCreation(2);
+    GroupingContext::UP ctx0 = session.createThreadContext(0, world.attributeContext);
+    GroupingContext::UP ctx1 = session.createThreadContext(1, world.attributeContext);
+    doGrouping(*ctx0, 12, 30.0, 11, 20.0, 10, 10.0);
+    doGrouping(*ctx1, 22, 150.0, 21, 40.0, 20, 25.0);
+    MyMetaStore metaStore;
+    {
+        GroupingManager man(*ctx0);
+        man.merge(*ctx1);
+        man.pruneAndConvertToGlobalId(true, metaStore, thread_bundle);
+    }
+    session.continueExecution(context);
+    vespalib::string result;
+    for (const auto &grouping : context.getGroupingList()) {
+        result += grouping->asString();
+    }
+    return result;
+}
+
+TEST_F("require that multiple groupings can be pruned in parallel", DoomFixture()) {
+    MyWorld world;
+    vespalib::SimpleThreadBundle thread_bundle(4);
+    vespalib::string expect = forkJoinMany(world, f1, vespalib::ThreadBundle::trivial());
+    EXPECT_EQUAL(expect, forkJoinMany(world, f1, thread_bundle));
+}
+
 TEST_F("test session timeout", DoomFixture()) {
     MyWorld world;
     SessionManager mgr(2);
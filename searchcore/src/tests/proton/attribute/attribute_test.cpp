@@ -981,6 +981,49 @@ TEST_F(TwoPhasePutTest, handles_assign_update_as_two_phase_put_when_specified_fo
     assertExecuteHistory({0, 0});
 }
 
+AVConfig
+get_string_config(bool multi_threaded_feed)
+{
+    AVConfig cfg(AVBasicType::STRING);
+    cfg.set_multi_threaded_feed(multi_threaded_feed);
+    return cfg;
+}
+
+TEST_F(AttributeWriterTest, string_attributes_using_multi_threaded_feed_are_put_in_two_phases)
+{
+    DocBuilder db([](auto& header) { header.addField("s1", DataType::T_STRING)
+                                           .addField("s2", DataType::T_STRING); });
+    auto s1 = addAttribute({"s1", get_string_config(true)});
+    auto s2 = addAttribute({"s2", get_string_config(false)});
+    allocAttributeWriter();
+    const auto& ctx = _aw->get_write_contexts();
+    EXPECT_EQ(2, ctx.size());
+    EXPECT_FALSE(ctx[0].use_two_phase_put());
+    EXPECT_EQ("s2", ctx[0].getFields()[0].getAttribute().getName());
+    EXPECT_TRUE(ctx[1].use_two_phase_put());
+    EXPECT_EQ("s1", ctx[1].getFields()[0].getAttribute().getName());
+
+    attribute::ConstCharContent sbuf;
+    auto doc = db.make_document("id:ns:searchdocument::1");
+    doc->setValue("s1", StringFieldValue("foo"));
+    doc->setValue("s2", StringFieldValue("foo"));
+    put(1, *doc, 1);
+    put(2, *doc, 2);
+    doc->setValue("s1", StringFieldValue("bar"));
+    put(3, *doc, 1);
+    EXPECT_EQ(3, _shared.getStats().acceptedTasks);
+    for (auto docid : {1, 2}) {
+        sbuf.fill(*s1, docid);
+        ASSERT_EQ(1u, sbuf.size());
+        EXPECT_EQ(vespalib::string(docid == 1 ? "bar" : "foo"), sbuf[0]);
+    }
+    sbuf.fill(*s2, 2);
+    EXPECT_EQ(vespalib::string("foo"), sbuf[0]);
+    EXPECT_EQ(3u, s1->getStatus().getLastSyncToken());
+    put(4, *db.make_document("id:ns:searchdocument::1"), 1);
+    sbuf.fill(*s1, 1);
+    EXPECT_EQ(vespalib::string(""), sbuf[0]);
+}
 
 ImportedAttributeVector::SP
 createImportedAttribute(const vespalib::string &name)
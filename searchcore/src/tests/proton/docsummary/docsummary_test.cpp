@@ -67,6 +67,7 @@
 #include <vespa/vespalib/geo/zcurve.h>
 #include <vespa/vespalib/util/destructor_callbacks.h>
 #include <vespa/vespalib/util/size_literals.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/config-summary.h>
 #include <filesystem>
 #include <regex>
@@ -492,6 +493,27 @@ TEST_F("requireThatAdapterHandlesMultipleDocuments", Fixture)
     bc._str.flush(flushToken);
 }
 
+TEST_F("requireThatAdapterHandlesPrefetchedDocuments", Fixture)
+{
+    BuildContext bc([](auto& header) { header.addField("a", DataType::T_INT); });
+    for (uint32_t lid = 0; lid < 3; ++lid) {
+        auto doc = bc.make_document(vespalib::make_string("id:ns:searchdocument::%u", lid));
+        doc->setValue("a", IntFieldValue(1000 * (lid + 1)));
+        bc.put_document(lid, std::move(doc));
+    }
+
+    DocumentStoreAdapter dsa(bc._str, bc.get_repo());
+    dsa.prefetch({2, 0, 5, 1});
+    EXPECT_EQUAL(3000, dsa.get_document(2)->get_field_value("a")->getAsInt());
+    EXPECT_EQUAL(1000, dsa.get_document(0)->get_field_value("a")->getAsInt());
+    EXPECT_TRUE(!dsa.get_document(5));
+    EXPECT_EQUAL(2000, dsa.get_document(1)->get_field_value("a")->getAsInt());
+    // Documents are handed out once from the prefetched set, then read again from the store
+    EXPECT_EQUAL(1000, dsa.get_document(0)->get_field_value("a")->getAsInt());
+    uint64_t flushToken = bc._str.initFlush(bc._serialNum - 1);
+    bc._str.flush(flushToken);
+}
+
 TEST_F("requireThatAdapterHandlesDocumentIdField", Fixture)
 {
     BuildContext bc([](auto&) noexcept {});
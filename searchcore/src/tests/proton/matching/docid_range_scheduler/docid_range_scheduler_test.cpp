@@ -287,4 +287,88 @@ TEST_MT_FF("require that the adaptive scheduler handles fewer documents than thr
 
 //-----------------------------------------------------------------------------
 
+TEST("require that the work stealing scheduler claims own work in chunks") {
+    WorkStealingDocidRangeScheduler scheduler(2, 2, 21);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 20u);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 3)));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange(11, 13)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(3, 5)));
+    EXPECT_EQUAL(scheduler.total_size(0), 4u);
+    EXPECT_EQUAL(scheduler.total_size(1), 2u);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 14u);
+    EXPECT_EQUAL(scheduler.stolen_size(0), 0u);
+}
+
+TEST("require that the work stealing scheduler claims larger chunks of large ranges") {
+    WorkStealingDocidRangeScheduler scheduler(1, 1, 1601);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 101)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(101, 195)));
+}
+
+TEST("require that the work stealing scheduler steals half the unclaimed work of the busiest thread") {
+    WorkStealingDocidRangeScheduler scheduler(3, 1, 31);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 2)));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange(11, 12)));
+    TEST_DO(verify_range(scheduler.first_range(2), DocidRange(21, 22)));
+    for (size_t i = 0; i < 9; ++i) {
+        EXPECT_TRUE(!scheduler.next_range(0).empty());
+    }
+    TEST_DO(verify_range(scheduler.next_range(2), DocidRange(22, 23)));
+    // thread 0 is out of work, thread 1 has 9 docs left to claim and thread 2 has 8
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(16, 17)));
+    EXPECT_EQUAL(scheduler.stolen_size(0), 5u);
+    EXPECT_EQUAL(scheduler.stolen_size(1), 0u);
+    // thread 1 only gets the first half of its own work
+    for (uint32_t docid = 12; docid < 16; ++docid) {
+        TEST_DO(verify_range(scheduler.next_range(1), DocidRange(docid, docid + 1)));
+    }
+    // thread 2 has 8 docs left to claim and thread 0 has 4
+    TEST_DO(verify_range(scheduler.next_range(1), DocidRange(27, 28)));
+    EXPECT_EQUAL(scheduler.stolen_size(1), 4u);
+}
+
+TEST("require that the work stealing scheduler steals all unclaimed work below twice the minimal task size") {
+    WorkStealingDocidRangeScheduler scheduler(2, 3, 11);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 4)));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange(6, 9)));
+    TEST_DO(verify_range(scheduler.next_range(1), DocidRange(9, 11)));
+    TEST_DO(verify_range(scheduler.next_range(1), DocidRange(4, 6)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange()));
+    EXPECT_EQUAL(scheduler.total_size(0), 3u);
+    EXPECT_EQUAL(scheduler.total_size(1), 7u);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 0u);
+}
+
+TEST("require that the work stealing scheduler protects against documents underflow") {
+    WorkStealingDocidRangeScheduler scheduler(2, 1, 0);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 0u);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange()));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange()));
+    EXPECT_EQUAL(scheduler.total_size(0), 0u);
+    EXPECT_EQUAL(scheduler.total_size(1), 0u);
+}
+
+TEST_MT_FF("require that the work stealing scheduler assigns each document exactly once",
+           4, WorkStealingDocidRangeScheduler(num_threads, 1, 10001), std::vector<std::atomic<uint32_t>>(10001))
+{
+    for (DocidRange docid_range = f1.first_range(thread_id);
+         !docid_range.empty();
+         docid_range = f1.next_range(thread_id))
+    {
+        for (uint32_t docid = docid_range.begin; docid < docid_range.end; ++docid) {
+            f2[docid].fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    TEST_BARRIER();
+    if (thread_id == 0) {
+        EXPECT_EQUAL(f1.unassigned_size(), 0u);
+        EXPECT_EQUAL(f1.total_size(0) + f1.total_size(1) + f1.total_size(2) + f1.total_size(3), 10000u);
+        for (uint32_t docid = 1; docid < 10001; ++docid) {
+            EXPECT_EQUAL(f2[docid].load(std::memory_order_relaxed), 1u);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 TEST_MAIN() { TEST_RUN_ALL(); }
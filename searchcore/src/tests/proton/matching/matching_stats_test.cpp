@@ -154,7 +154,7 @@ TEST("requireThatPartitionsAreAddedCorrectly") {
 
     MatchingStats::Partition subPart;
     subPart.docsCovered(7).docsMatched(3).docsRanked(2).docsReRanked(1)
-        .active_time(1.0).wait_time(0.5);
+        .docsStolen(4).active_time(1.0).wait_time(0.5);
     EXPECT_EQUAL(0u, subPart.softDoomed());
     EXPECT_EQUAL(0u, subPart.softDoomed(false).softDoomed());
     EXPECT_EQUAL(1u, subPart.softDoomed(true).softDoomed());
@@ -164,6 +164,7 @@ TEST("requireThatPartitionsAreAddedCorrectly") {
     EXPECT_EQUAL(3u, subPart.docsMatched());
     EXPECT_EQUAL(2u, subPart.docsRanked());
     EXPECT_EQUAL(1u, subPart.docsReRanked());
+    EXPECT_EQUAL(4u, subPart.docsStolen());
     EXPECT_EQUAL(1.0, subPart.active_time_avg());
     EXPECT_EQUAL(0.5, subPart.wait_time_avg());
     EXPECT_EQUAL(1u, subPart.active_time_count());
@@ -185,6 +186,7 @@ TEST("requireThatPartitionsAreAddedCorrectly") {
     EXPECT_EQUAL(3u, all1.getPartition(0).docsMatched());
     EXPECT_EQUAL(2u, all1.getPartition(0).docsRanked());
     EXPECT_EQUAL(1u, all1.getPartition(0).docsReRanked());
+    EXPECT_EQUAL(4u, all1.getPartition(0).docsStolen());
     EXPECT_EQUAL(1.0, all1.getPartition(0).active_time_avg());
     EXPECT_EQUAL(0.5, all1.getPartition(0).wait_time_avg());
     EXPECT_EQUAL(1u, all1.getPartition(0).active_time_count());
@@ -236,6 +238,7 @@ TEST("requireThatPartitionsAreAddedCorrectly") {
     EXPECT_EQUAL(6u, all1.getPartition(0).docsMatched());
     EXPECT_EQUAL(4u, all1.getPartition(0).docsRanked());
     EXPECT_EQUAL(2u, all1.getPartition(0).docsReRanked());
+    EXPECT_EQUAL(4u, all1.getPartition(0).docsStolen());
     EXPECT_EQUAL(0.75, all1.getPartition(0).active_time_avg());
     EXPECT_EQUAL(0.75, all1.getPartition(0).wait_time_avg());
     EXPECT_EQUAL(2u, all1.getPartition(0).active_time_count());
@@ -261,6 +264,32 @@ TEST("requireThatPartitionsAreAddedCorrectly") {
     EXPECT_EQUAL(1000ns, all1.getPartition(1).doomOvertime());
 }
 
+TEST("requireThatProfiledQueriesAreAddedCorrectly") {
+    MatchingStats stats;
+    EXPECT_EQUAL(0u, stats.profiledQueries());
+    EXPECT_EQUAL(0u, stats.profiledIteratorCalls());
+    EXPECT_EQUAL(0u, stats.profiledRankTimeCount());
+    MatchingStats::Partition part;
+    part.profiled_iterator_calls(100).profiled_rank_time(0.25);
+    stats.merge_partition(part, 0);
+    stats.merge_partition(part, 1);
+    stats.profiledQueries(1).profiledRankTime(0.5);
+    EXPECT_EQUAL(200u, stats.profiledIteratorCalls());
+    EXPECT_EQUAL(0.25, stats.getPartition(1).profiled_rank_time());
+
+    MatchingStats total;
+    total.add(stats);
+    total.add(MatchingStats().queries(1));
+    total.add(MatchingStats().profiledQueries(1).profiledRankTime(1.5));
+    EXPECT_EQUAL(2u, total.profiledQueries());
+    EXPECT_EQUAL(200u, total.profiledIteratorCalls());
+    EXPECT_EQUAL(2u, total.profiledRankTimeCount());
+    EXPECT_EQUAL(1.0, total.profiledRankTimeAvg());
+    EXPECT_EQUAL(0.5, total.profiledRankTimeMin());
+    EXPECT_EQUAL(1.5, total.profiledRankTimeMax());
+    EXPECT_EQUAL(100u, total.getPartition(0).profiled_iterator_calls());
+}
+
 TEST("requireThatSoftDoomIsSetAndAdded") {
     MatchingStats stats;
     MatchingStats stats2;
@@ -10,10 +10,13 @@
 #include <vespa/searchcore/proton/matching/sessionmanager.h>
 #include <vespa/searchcore/proton/matching/viewresolver.h>
 #include <vespa/searchcore/proton/test/bucketfactory.h>
+#include <vespa/searchcommon/attribute/config.h>
 #include <vespa/searchlib/aggregation/aggregation.h>
 #include <vespa/searchlib/aggregation/grouping.h>
 #include <vespa/searchlib/aggregation/perdocexpression.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
 #include <vespa/searchlib/attribute/extendableattributes.h>
+#include <vespa/searchlib/attribute/integerbase.h>
 #include <vespa/searchlib/engine/docsumreply.h>
 #include <vespa/searchlib/engine/docsumrequest.h>
 #include <vespa/searchlib/engine/searchreply.h>
@@ -303,6 +306,39 @@ struct MyWorld {
         searchContext.attr().addResult(attribute, term, result);
     }
 
+    void setup_batched_first_phase(uint32_t batch_size) {
+        // a real single value attribute is needed, since the attribute
+        // executors for extendable attributes do not support batches
+        schema.addAttributeField(Schema::AttributeField("a4", DataType::INT32));
+        auto attr = AttributeFactory::createAttribute("a4", search::attribute::Config(BasicType::INT32,
+                                                                                   CollectionType::SINGLE));
+        attr->addDocs(NUM_DOCS);
+        auto &int_attr = dynamic_cast<IntegerAttribute &>(*attr);
+        for (uint32_t i = 0; i < NUM_DOCS; ++i) {
+            int_attr.update(i, (i * 37) % NUM_DOCS); // distinct values
+        }
+        attr->commit();
+        attributeContext.add(attr);
+        set_property(indexproperties::rank::FirstPhase::NAME, "rankingExpression(first)");
+        set_property("rankingExpression(first).rankingScript", "attribute(a4)+attribute(a4).count");
+        set_property(FirstPhaseBatchSize::NAME, vespalib::make_string("%u", batch_size));
+    }
+
+    bool first_phase_supports_batch() {
+        Matcher::SP matcher = createMatcher();
+        SearchRequest::SP request = createSimpleRequest("f1", "spread");
+        search::fef::Properties overrides;
+        auto mtf = matcher->create_match_tools_factory(*request, searchContext, attributeContext, metaStore, overrides,
+                                                       ttb(), nullptr, searchContext.getDocIdLimit(), true);
+        MatchTools::UP match_tools = mtf->createMatchTools();
+        match_tools->setup_first_phase(nullptr);
+        return match_tools->rank_program().setup_batch(4);
+    }
+
+    void setup_profile_sampling(uint32_t interval) {
+        config.add(indexproperties::matching::ProfileSampleInterval::NAME, vespalib::make_string("%u", interval));
+    }
+
     void setupSecondPhaseRanking() {
         Properties cfg;
         cfg.add(indexproperties::rank::SecondPhase::NAME, "attribute(a2)");
@@ -393,7 +429,10 @@ struct MyWorld {
     }
 
     SearchReply::UP performSearch(const SearchRequest & req, size_t threads) {
-        Matcher::SP matcher = createMatcher();
+        return performSearch(createMatcher(), req, threads);
+    }
+
+    SearchReply::UP performSearch(Matcher::SP matcher, const SearchRequest & req, size_t threads) {
         SearchSession::OwnershipBundle owned_objects({std::make_unique<MockAttributeContext>(),
                                                       std::make_unique<FakeSearchContext>()},
                                                      std::make_shared<MySearchHandler>(matcher));
@@ -590,6 +629,45 @@ TEST("require that ranking is performed (multi-threaded)") {
     }
 }
 
+void verify_same_hits(const SearchReply &expect, const SearchReply &actual) {
+    ASSERT_EQUAL(expect.hits.size(), actual.hits.size());
+    for (size_t i = 0; i < expect.hits.size(); ++i) {
+        EXPECT_EQUAL(expect.hits[i].gid, actual.hits[i].gid);
+        EXPECT_EQUAL(expect.hits[i].metric, actual.hits[i].metric);
+    }
+}
+
+TEST("require that batched first phase ranking gives the same result as unbatched ranking") {
+    {
+        MyWorld world;
+        world.basicSetup();
+        world.setup_batched_first_phase(4);
+        EXPECT_TRUE(world.first_phase_supports_batch());
+    }
+    for (size_t threads: {1, 4}) {
+        for (const char *term: {"spread", "all"}) {
+            vespalib::string field = (vespalib::string(term) == "all") ? "a1" : "f1";
+            MyWorld unbatched;
+            unbatched.basicSetup();
+            unbatched.basicResults();
+            unbatched.verbose_a1_result("all");
+            unbatched.setup_batched_first_phase(0);
+            SearchReply::UP expect = unbatched.performSearch(*MyWorld::createSimpleRequest(field, term), threads);
+            ASSERT_TRUE(expect->hits.size() > 0u);
+            for (uint32_t batch_size: {1, 4, 128}) {
+                MyWorld batched;
+                batched.basicSetup();
+                batched.basicResults();
+                batched.verbose_a1_result("all");
+                batched.setup_batched_first_phase(batch_size);
+                SearchReply::UP actual = batched.performSearch(*MyWorld::createSimpleRequest(field, term), threads);
+                EXPECT_EQUAL(unbatched.matchingStats.docsRanked(), batched.matchingStats.docsRanked());
+                TEST_DO(verify_same_hits(*expect, *actual));
+            }
+        }
+    }
+}
+
 TEST("require that re-ranking is performed (multi-threaded)") {
     for (size_t threads = 1; threads <= 16; ++threads) {
         MyWorld world;
@@ -696,6 +774,47 @@ TEST("require that re-ranking is diverse with diversity = 1/10") {
     EXPECT_EQUAL(500.0, reply->hits[4].metric);
 }
 
+TEST("require that queries are not profiled by default") {
+    MyWorld world;
+    world.basicSetup();
+    world.basicResults();
+    SearchRequest::SP request = MyWorld::createSimpleRequest("f1", "spread");
+    SearchReply::UP reply = world.performSearch(*request, 1);
+    EXPECT_EQUAL(9u, reply->hits.size());
+    EXPECT_EQUAL(0u, request->trace().getLevel());
+    EXPECT_EQUAL(0u, world.matchingStats.profiledQueries());
+    EXPECT_EQUAL(0u, world.matchingStats.profiledIteratorCalls());
+}
+
+TEST("require that sampled queries are profiled (multi-threaded)") {
+    for (size_t threads = 1; threads <= 4; ++threads) {
+        MyWorld world;
+        world.basicSetup();
+        world.setupSecondPhaseRanking();
+        world.basicResults();
+        world.setup_profile_sampling(2);
+        Matcher::SP matcher = world.createMatcher();
+        std::vector<SearchRequest::SP> requests;
+        for (size_t i = 0; i < 3; ++i) {
+            requests.push_back(MyWorld::createSimpleRequest("f1", "spread"));
+            SearchReply::UP reply = world.performSearch(matcher, *requests.back(), threads);
+            EXPECT_EQUAL(9u, reply->hits.size());
+        }
+        EXPECT_EQUAL(3u, world.matchingStats.queries());
+        EXPECT_EQUAL(2u, world.matchingStats.profiledQueries());
+        EXPECT_EQUAL(2u, world.matchingStats.profiledRankTimeCount());
+        EXPECT_GREATER(world.matchingStats.profiledIteratorCalls(), 2 * 9u);
+        for (size_t i = 0; i < 3; ++i) {
+            auto trace = requests[i]->trace().toString();
+            bool sampled = ((i % 2) == 0);
+            EXPECT_EQUAL(sampled ? 1u : 0u, requests[i]->trace().getLevel());
+            EXPECT_EQUAL(sampled, trace.find("match_profiling") != vespalib::string::npos);
+            EXPECT_EQUAL(sampled, trace.find("first_phase_profiling") != vespalib::string::npos);
+            EXPECT_EQUAL(sampled, trace.find("second_phase_profiling") != vespalib::string::npos);
+        }
+    }
+}
+
 TEST("require that sortspec can be used (multi-threaded)") {
     for (size_t threads = 1; threads <= 16; ++threads) {
         MyWorld world;
@@ -9,6 +9,7 @@
 #include <vespa/document/fieldvalue/stringfieldvalue.h>
 #include <vespa/document/update/documentupdate.h>
 #include <vespa/document/update/assignvalueupdate.h>
+#include <vespa/persistence/spi/catchresult.h>
 #include <vespa/persistence/spi/documentselection.h>
 #include <vespa/persistence/spi/test.h>
 #include <vespa/searchcore/proton/persistenceengine/ipersistenceengineowner.h>
@@ -147,6 +148,7 @@ struct MyHandler : public IPersistenceHandler, IBucketFreezer {
     Bucket                       lastBucket;
     Timestamp                    lastTimestamp;
     DocumentId                   lastDocId;
+    uint32_t                     put_batches;
     Timestamp                    existingTimestamp;
     const ClusterState*          lastCalc;
     storage::spi::BucketInfo::ActiveState lastBucketState;
@@ -168,6 +170,7 @@ struct MyHandler : public IPersistenceHandler, IBucketFreezer {
           lastBucket(),
           lastTimestamp(),
           lastDocId(),
+          put_batches(0),
           existingTimestamp(),
           lastCalc(nullptr),
           lastBucketState(),
@@ -208,6 +211,14 @@ struct MyHandler : public IPersistenceHandler, IBucketFreezer {
         handle(token, bucket, timestamp, doc->getId());
     }
 
+    void handlePuts(const Bucket& bucket, std::vector<TimestampedPut> puts) override {
+        ++put_batches;
+        for (auto& put : puts) {
+            put.token->setResult(std::make_unique<Result>(), false);
+            handle(put.token, bucket, put.timestamp, put.doc->getId());
+        }
+    }
+
     void handleUpdate(FeedToken token, const Bucket& bucket,
                       Timestamp timestamp, DocumentUpdateSP upd) override {
         token->setResult(std::make_unique<UpdateResult>(existingTimestamp), existingTimestamp > 0);
@@ -486,6 +497,43 @@ TEST_F("require that put is rejected if resource limit is reached", SimpleFixtur
 }
 
 
+TEST_F("require that batched puts are routed to handlers in one batch per handler", SimpleFixture)
+{
+    std::vector<storage::spi::PutEntry> entries;
+    std::vector<std::future<std::unique_ptr<Result>>> results;
+    for (const auto& [ts, doc] : std::vector<std::pair<Timestamp, Document::SP>>{{tstamp1, doc1}, {tstamp2, doc2}, {tstamp3, doc3}}) {
+        auto catcher = std::make_unique<storage::spi::CatchResult>();
+        results.push_back(catcher->future_result());
+        entries.emplace_back(ts, doc, std::move(catcher));
+    }
+    f.engine.putBatchAsync(bucket1, std::move(entries));
+    EXPECT_EQUAL(Result(), *results[0].get());
+    EXPECT_EQUAL(Result(), *results[1].get());
+    EXPECT_EQUAL(Result(Result::ErrorType::PERMANENT_ERROR, "No handler for document type 'type3'"), *results[2].get());
+    EXPECT_EQUAL(1u, f.hset.handler1.put_batches);
+    EXPECT_EQUAL(1u, f.hset.handler2.put_batches);
+    TEST_DO(assertHandler(bucket1, tstamp1, docId1, f.hset.handler1));
+    TEST_DO(assertHandler(bucket1, tstamp2, docId2, f.hset.handler2));
+}
+
+
+TEST_F("require that batched puts are rejected if resource limit is reached", SimpleFixture)
+{
+    f._writeFilter._acceptWriteOperation = false;
+    f._writeFilter._message = "Disk is full";
+
+    std::vector<storage::spi::PutEntry> entries;
+    auto catcher = std::make_unique<storage::spi::CatchResult>();
+    auto result = catcher->future_result();
+    entries.emplace_back(tstamp1, doc1, std::move(catcher));
+    f.engine.putBatchAsync(bucket1, std::move(entries));
+    EXPECT_EQUAL(Result(Result::ErrorType::RESOURCE_EXHAUSTED,
+                        "Put operation rejected for document 'id:type1:type1::1': 'Disk is full'"),
+                 *result.get());
+    EXPECT_EQUAL(0u, f.hset.handler1.put_batches);
+}
+
+
 TEST_F("require that updates are routed to handler", SimpleFixture)
 {
     f.hset.handler1.setExistingTimestamp(tstamp2);
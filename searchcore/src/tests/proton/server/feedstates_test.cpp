@@ -4,11 +4,14 @@
 #include <vespa/document/base/documentid.h>
 #include <vespa/document/base/testdocrepo.h>
 #include <vespa/document/bucket/bucketid.h>
+#include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/repo/documenttyperepo.h>
 #include <vespa/searchcore/proton/test/bucketfactory.h>
 #include <vespa/searchcore/proton/server/feedstates.h>
 #include <vespa/searchcore/proton/server/ireplayconfig.h>
 #include <vespa/searchcore/proton/server/memoryconfigstore.h>
 #include <vespa/searchcore/proton/server/replay_throttling_policy.h>
+#include <vespa/searchcore/proton/feedoperation/putoperation.h>
 #include <vespa/searchcore/proton/feedoperation/removeoperation.h>
 #include <vespa/searchcore/proton/bucketdb/bucketdbhandler.h>
 #include <vespa/searchcore/proton/bucketdb/bucket_db_owner.h>
@@ -18,11 +21,16 @@
 #include <vespa/vespalib/util/foreground_thread_executor.h>
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/vespalib/util/buffer.h>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
 
 #include <vespa/log/log.h>
 LOG_SETUP("feedstates_test");
 
 using document::BucketId;
+using document::Document;
 using document::DocumentId;
 using document::DocumentTypeRepo;
 using document::TestDocRepo;
@@ -40,19 +48,44 @@ struct MyFeedView : public test::DummyFeedView {
     TestDocRepo repo;
     std::shared_ptr<const DocumentTypeRepo> repo_sp;
     int remove_handled;
+    int put_handled;
+    const DocumentTypeRepo *last_put_repo;
 
     MyFeedView();
     ~MyFeedView() override;
 
     const std::shared_ptr<const DocumentTypeRepo> &getDocumentTypeRepo() const override { return repo_sp; }
     void handleRemove(FeedToken , const RemoveOperation &) override { ++remove_handled; }
+    void handlePut(FeedToken , const PutOperation &op) override {
+        ++put_handled;
+        last_put_repo = op.getDocument()->getRepo();
+    }
 };
 
-MyFeedView::MyFeedView() : repo_sp(repo.getTypeRepoSp()), remove_handled(0) {}
+MyFeedView::MyFeedView() : repo_sp(repo.getTypeRepoSp()), remove_handled(0), put_handled(0), last_put_repo(nullptr) {}
 MyFeedView::~MyFeedView() = default;
 
+// Simulates a config change replacing the feed view, and thus the document type repo, when next_feed_view is set
 struct MyReplayConfig : IReplayConfig {
-    void replayConfig(SerialNum) override {}
+    IFeedView *&feed_view_ptr;
+    IFeedView *next_feed_view;
+    int config_replayed;
+    explicit MyReplayConfig(IFeedView *&feed_view_ptr_in)
+        : feed_view_ptr(feed_view_ptr_in),
+          next_feed_view(nullptr),
+          config_replayed(0)
+    {
+    }
+    void replayConfig(SerialNum) override {
+        ++config_replayed;
+        if (next_feed_view != nullptr) {
+            feed_view_ptr = next_feed_view;
+        }
+    }
+};
+
+struct MyConfigStore : MemoryConfigStore {
+    void deserializeConfig(SerialNum, nbostream &) override {}
 };
 
 struct MyIncSerialNum : IIncSerialNum {
@@ -70,32 +103,105 @@ struct Fixture
     MyFeedView feed_view2;
     IFeedView *feed_view_ptr;
     MyReplayConfig replay_config;
-    MemoryConfigStore config_store;
+    MyConfigStore config_store;
     bucketdb::BucketDBOwner _bucketDB;
     bucketdb::BucketDBHandler _bucketDBHandler;
     ReplayThrottlingPolicy _replay_throttling_policy;
     MyIncSerialNum _inc_serial_num;
     ReplayTransactionLogState state;
 
-    Fixture();
+    explicit Fixture(vespalib::Executor *decode_executor = nullptr);
     ~Fixture();
 };
 
-Fixture::Fixture()
+Fixture::Fixture(vespalib::Executor *decode_executor)
     : feed_view1(),
       feed_view2(),
       feed_view_ptr(&feed_view1),
-      replay_config(),
+      replay_config(feed_view_ptr),
       config_store(),
       _bucketDB(),
       _bucketDBHandler(_bucketDB),
-      _replay_throttling_policy({}),
+      _replay_throttling_policy({}, 4),
       _inc_serial_num(9u),
-      state("doctypename", feed_view_ptr, _bucketDBHandler, replay_config, config_store, _replay_throttling_policy, _inc_serial_num)
+      state("doctypename", feed_view_ptr, _bucketDBHandler, replay_config, config_store, _replay_throttling_policy, _inc_serial_num, decode_executor)
 {
 }
 Fixture::~Fixture() = default;
 
+// Runs decode tasks when they are posted
+struct DecodeExecutorHolder {
+    ForegroundThreadExecutor decode_executor;
+};
+
+struct DecodingFixture : public DecodeExecutorHolder, public Fixture {
+    DecodingFixture() : DecodeExecutorHolder(), Fixture(&decode_executor) {}
+};
+
+// Never runs decode tasks, leaving it to the master executor to decode packets
+struct DroppingExecutor : public vespalib::Executor {
+    Task::UP execute(Task::UP) override { return {}; }
+    void wakeup() override { }
+};
+
+struct DroppingDecodeExecutorHolder {
+    DroppingExecutor decode_executor;
+};
+
+struct DroppingDecodeFixture : public DroppingDecodeExecutorHolder, public Fixture {
+    DroppingDecodeFixture() : DroppingDecodeExecutorHolder(), Fixture(&decode_executor) {}
+};
+
+// Master executor where tasks are run on demand
+struct QueueingExecutor : public vespalib::Executor {
+    std::mutex lock;
+    std::deque<Task::UP> tasks;
+
+    Task::UP execute(Task::UP task) override {
+        std::lock_guard guard(lock);
+        tasks.push_back(std::move(task));
+        return {};
+    }
+    void wakeup() override { }
+    size_t size() {
+        std::lock_guard guard(lock);
+        return tasks.size();
+    }
+    bool run_one() {
+        Task::UP task;
+        {
+            std::lock_guard guard(lock);
+            if (tasks.empty()) {
+                return false;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task->run();
+        return true;
+    }
+    void run_all() {
+        while (run_one()) { }
+    }
+};
+
+void
+add_put(Packet &packet, SerialNum serial, const DocumentTypeRepo &repo)
+{
+    DocumentId doc_id("id:ns:testdoctype1::foo");
+    auto doc = std::make_shared<Document>(repo, *repo.getDocumentType("testdoctype1"), doc_id);
+    PutOperation op(BucketFactory::getBucketId(doc_id), Timestamp(10), std::move(doc));
+    nbostream str;
+    op.serialize(str);
+    packet.add(Packet::Entry(serial, FeedOperation::PUT, ConstBufferRef(str.data(), str.wp())));
+}
+
+void
+add_new_config(Packet &packet, SerialNum serial)
+{
+    packet.add(Packet::Entry(serial, FeedOperation::NEW_CONFIG, ConstBufferRef()));
+}
+
 
 struct RemoveOperationContext
 {
@@ -151,6 +257,114 @@ TEST_F("require that replay progress is tracked", Fixture)
     f.state.receive(wrap, executor);
     EXPECT_EQUAL(10u, progress.getCurrent());
     EXPECT_EQUAL(0.5, progress.getProgress());
+    EXPECT_EQUAL(1u, progress.get_entries());
+    EXPECT_EQUAL(opCtx.str.size(), progress.get_bytes());
+}
+
+void
+require_that_packets_deserialized_ahead_are_replayed(Fixture &f)
+{
+    ForegroundThreadExecutor executor;
+    TlsReplayProgress progress("test", 9, 11);
+    {
+        RemoveOperationContext opCtx(10);
+        auto wrap = std::make_shared<PacketWrapper>(*opCtx.packet, &progress);
+        f.state.receive(wrap, executor);
+        EXPECT_EQUAL(search::transactionlog::client::RPC::OK, wrap->result);
+        EXPECT_TRUE(wrap->gate.await(vespalib::duration::zero()));
+    }
+    EXPECT_EQUAL(1, f.feed_view1.remove_handled);
+    f.feed_view_ptr = &f.feed_view2;
+    {
+        RemoveOperationContext opCtx(11);
+        auto wrap = std::make_shared<PacketWrapper>(*opCtx.packet, &progress);
+        f.state.receive(wrap, executor);
+    }
+    EXPECT_EQUAL(1, f.feed_view1.remove_handled);
+    EXPECT_EQUAL(1, f.feed_view2.remove_handled);
+    EXPECT_EQUAL(11u, progress.getCurrent());
+    EXPECT_EQUAL(2u, progress.get_entries());
+}
+
+TEST_F("require that packets deserialized ahead by decode executor are replayed", DecodingFixture)
+{
+    require_that_packets_deserialized_ahead_are_replayed(f);
+}
+
+TEST_F("require that master executor deserializes packets not yet picked up by decode executor", DroppingDecodeFixture)
+{
+    require_that_packets_deserialized_ahead_are_replayed(f);
+}
+
+TEST_F("require that packets deserialized ahead are deserialized again if document type repo changed", DecodingFixture)
+{
+    QueueingExecutor executor;
+    Packet packet(0xf000);
+    add_put(packet, 10, *f.feed_view1.repo_sp);
+    f.state.receive(std::make_shared<PacketWrapper>(packet, nullptr), executor);
+    // Config change before the packet deserialized with the old repo is replayed
+    f.feed_view_ptr = &f.feed_view2;
+    executor.run_all();
+    EXPECT_EQUAL(0, f.feed_view1.put_handled);
+    EXPECT_EQUAL(1, f.feed_view2.put_handled);
+    EXPECT_EQUAL(f.feed_view2.repo_sp.get(), f.feed_view2.last_put_repo);
+}
+
+TEST_F("require that entries after config operation are deserialized with repo current at replay", DecodingFixture)
+{
+    ForegroundThreadExecutor executor;
+    f.replay_config.next_feed_view = &f.feed_view2;
+    {
+        Packet packet(0xf000);
+        add_put(packet, 10, *f.feed_view1.repo_sp);
+        add_new_config(packet, 11);
+        add_put(packet, 12, *f.feed_view1.repo_sp);
+        f.state.receive(std::make_shared<PacketWrapper>(packet, nullptr), executor);
+    }
+    EXPECT_EQUAL(1, f.replay_config.config_replayed);
+    EXPECT_EQUAL(1, f.feed_view1.put_handled);
+    EXPECT_EQUAL(f.feed_view1.repo_sp.get(), f.feed_view1.last_put_repo);
+    EXPECT_EQUAL(1, f.feed_view2.put_handled);
+    EXPECT_EQUAL(f.feed_view2.repo_sp.get(), f.feed_view2.last_put_repo);
+    {
+        // Later packets are deserialized ahead with the new repo
+        Packet packet(0xf000);
+        add_put(packet, 13, *f.feed_view1.repo_sp);
+        f.state.receive(std::make_shared<PacketWrapper>(packet, nullptr), executor);
+    }
+    EXPECT_EQUAL(1, f.feed_view1.put_handled);
+    EXPECT_EQUAL(2, f.feed_view2.put_handled);
+    EXPECT_EQUAL(f.feed_view2.repo_sp.get(), f.feed_view2.last_put_repo);
+}
+
+TEST_F("require that receive blocks while max pending packets are not replayed", DecodingFixture)
+{
+    QueueingExecutor executor;
+    std::vector<std::unique_ptr<RemoveOperationContext>> op_contexts;
+    for (SerialNum serial = 10; serial < 15; ++serial) {
+        op_contexts.push_back(std::make_unique<RemoveOperationContext>(serial));
+    }
+    // Max pending packets is 4
+    for (size_t i = 0; i < 4; ++i) {
+        auto wrap = std::make_shared<PacketWrapper>(*op_contexts[i]->packet, nullptr);
+        f.state.receive(wrap, executor);
+        EXPECT_TRUE(wrap->gate.await(vespalib::duration::zero()));
+    }
+    auto last_wrap = std::make_shared<PacketWrapper>(*op_contexts[4]->packet, nullptr);
+    std::atomic<bool> received(false);
+    std::thread thread([&]() {
+        f.state.receive(last_wrap, executor);
+        received = true;
+    });
+    std::this_thread::sleep_for(100ms);
+    EXPECT_FALSE(received);
+    EXPECT_EQUAL(4u, executor.size());
+    EXPECT_TRUE(executor.run_one());
+    thread.join();
+    EXPECT_TRUE(received);
+    EXPECT_TRUE(last_wrap->gate.await(vespalib::duration::zero()));
+    executor.run_all();
+    EXPECT_EQUAL(5, f.feed_view1.remove_handled);
 }
 
 }  // namespace
@@ -6,6 +6,9 @@
 #include <vespa/searchlib/expression/attributenode.h>
 #include <vespa/vespalib/util/issue.h>
 #include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/thread_bundle.h>
+#include <algorithm>
+#include <atomic>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".groupingmanager");
@@ -19,6 +22,42 @@ using vespalib::make_string_short::fmt;
 
 //-----------------------------------------------------------------------------
 
+namespace {
+
+void prune_grouping(Grouping &grouping) {
+    grouping.postMerge();
+    grouping.sortById();
+}
+
+void convert_grouping(Grouping &grouping, const search::IDocumentMetaStore &metaStore) {
+    grouping.convertToGlobalId(metaStore);
+    LOG(debug, "convertToGlobalId: %s", grouping.asString().c_str());
+}
+
+// Groupings may differ a lot in size, so each task picks the next
+// unhandled grouping instead of getting a fixed share up front.
+struct PruneAndConvertTask : vespalib::Runnable {
+    const GroupingContext::GroupingList &list;
+    std::atomic<size_t> &next;
+    bool merged;
+    const search::IDocumentMetaStore &metaStore;
+    PruneAndConvertTask(const GroupingContext::GroupingList &list_in, std::atomic<size_t> &next_in,
+                        bool merged_in, const search::IDocumentMetaStore &metaStore_in) noexcept
+        : list(list_in), next(next_in), merged(merged_in), metaStore(metaStore_in) {}
+    void run() override {
+        for (size_t i = next.fetch_add(1, std::memory_order_relaxed); i < list.size();
+             i = next.fetch_add(1, std::memory_order_relaxed))
+        {
+            if (merged) {
+                prune_grouping(*list[i]);
+            }
+            convert_grouping(*list[i], metaStore);
+        }
+    }
+};
+
+}
+
 using search::expression::ExpressionNode;
 using search::expression::AttributeNode;
 using search::expression::ConfigureStaticParams;
@@ -91,8 +130,7 @@ GroupingManager::prune()
 {
     GroupingContext::GroupingList &groupingList(_groupingContext.getGroupingList());
     for (const auto & g : groupingList) {
-        g->postMerge();
-        g->sortById();
+        prune_grouping(*g);
     }
 }
 
@@ -101,9 +139,30 @@ GroupingManager::convertToGlobalId(const search::IDocumentMetaStore &metaStore)
 {
     GroupingContext::GroupingList & groupingList = _groupingContext.getGroupingList();
     for (const auto & g : groupingList) {
-        g->convertToGlobalId(metaStore);
-        LOG(debug, "convertToGlobalId: %s", g->asString().c_str());
+        convert_grouping(*g, metaStore);
+    }
+}
+
+void
+GroupingManager::pruneAndConvertToGlobalId(bool merged, const search::IDocumentMetaStore &metaStore,
+                                           vespalib::ThreadBundle &thread_bundle)
+{
+    const GroupingContext::GroupingList &groupingList = _groupingContext.getGroupingList();
+    size_t num_tasks = std::min(groupingList.size(), thread_bundle.size());
+    if (num_tasks <= 1) {
+        if (merged) {
+            prune();
+        }
+        convertToGlobalId(metaStore);
+        return;
+    }
+    std::atomic<size_t> next(0);
+    std::vector<PruneAndConvertTask> tasks;
+    tasks.reserve(num_tasks);
+    for (size_t i = 0; i < num_tasks; ++i) {
+        tasks.emplace_back(groupingList, next, merged, metaStore);
     }
+    thread_bundle.run(tasks);
 }
 
 }
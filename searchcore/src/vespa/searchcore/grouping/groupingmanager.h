@@ -4,6 +4,8 @@
 #include <vespa/searchlib/common/idocumentmetastore.h>
 #include <vespa/searchcommon/attribute/iattributecontext.h>
 
+namespace vespalib { struct ThreadBundle; }
+
 namespace search {
     struct RankedHit;
     class BitVector;
@@ -89,6 +91,20 @@ public:
      * @param metaStore the attribute used to map from lid to gid.
      **/
     void convertToGlobalId(const IDocumentMetaStore &metaStore);
+
+    /**
+     * Prune (if the context was merged) and convert to global
+     * document ids, handling different groupings in parallel using
+     * the given thread bundle. Queries with many groupings (facets)
+     * will otherwise spend a lot of time doing this in a single
+     * thread after the match threads are done.
+     *
+     * @param merged whether to prune the grouping trees
+     * @param metaStore the attribute used to map from lid to gid.
+     * @param thread_bundle threads used to handle groupings in parallel
+     **/
+    void pruneAndConvertToGlobalId(bool merged, const IDocumentMetaStore &metaStore,
+                                   vespalib::ThreadBundle &thread_bundle);
 };
 
 }
@@ -12,6 +12,7 @@
 #include <vespa/searchlib/tensor/i_tensor_attribute.h>
 #include <vespa/searchlib/util/state_explorer_utils.h>
 #include <vespa/vespalib/data/slime/cursor.h>
+#include <vespa/vespalib/util/huge_page_allocator.h>
 
 using search::AddressSpaceUsage;
 using search::AttributeVector;
@@ -27,6 +28,7 @@ using search::attribute::MultiValueMappingBase;
 using search::attribute::Status;
 using vespalib::AddressSpace;
 using vespalib::MemoryUsage;
+using vespalib::alloc::HugePageAllocator;
 using namespace vespalib::slime;
 
 namespace proton {
@@ -121,6 +123,14 @@ type_to_string(const Config& cfg)
            "<" + vespalib::string(cfg.basicType().asString()) + ">";
 }
 
+void
+convertHugePageStatsToSlime(const HugePageAllocator::Stats &stats, Cursor &object)
+{
+    object.setLong("huge_page_bytes", stats.huge_page_bytes);
+    object.setLong("fallback_bytes", stats.fallback_bytes);
+    object.setLong("fallbacks", stats.fallbacks);
+}
+
 void
 convert_config_to_slime(const Config& cfg, bool full, Cursor& object)
 {
@@ -128,6 +138,7 @@ convert_config_to_slime(const Config& cfg, bool full, Cursor& object)
     object.setBool("fast_search", cfg.fastSearch());
     object.setBool("filter", cfg.getIsFilter());
     object.setBool("paged", cfg.paged());
+    object.setBool("huge_pages", cfg.huge_pages());
     if (full) {
         if (cfg.basicType().type() == BasicType::TENSOR) {
             object.setString("distance_metric", DistanceMetricUtils::to_string(cfg.distance_metric()));
@@ -185,6 +196,10 @@ AttributeVectorExplorer::get_state_helper(const AttributeVector& attr, const ves
             ObjectInserter tensor_inserter(object, "tensor");
             tensor_attr->get_state(tensor_inserter);
         }
+        const auto* huge_page_allocator = attr.get_huge_page_allocator();
+        if (huge_page_allocator) {
+            convertHugePageStatsToSlime(huge_page_allocator->get_stats(), object.setObject("huge_pages"));
+        }
         convertChangeVectorToSlime(attr, object.setObject("changeVector"));
         object.setLong("committedDocIdLimit", attr.getCommittedDocIdLimit());
         object.setLong("createSerialNum", attr.getCreateSerialNum());
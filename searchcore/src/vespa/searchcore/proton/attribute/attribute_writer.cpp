@@ -13,6 +13,7 @@
 #include <vespa/searchcommon/attribute/config.h>
 #include <vespa/searchcore/proton/common/attribute_updater.h>
 #include <vespa/searchlib/attribute/imported_attribute_vector.h>
+#include <vespa/searchlib/attribute/stringbase.h>
 #include <vespa/searchlib/tensor/prepare_result.h>
 #include <vespa/vespalib/stllike/hash_map.hpp>
 #include <vespa/vespalib/util/cpu_usage.h>
@@ -50,9 +51,25 @@ use_two_phase_put_for_attribute(const AttributeVector& attr)
     {
         return true;
     }
+    if (cfg.basicType() == search::attribute::BasicType::Type::STRING &&
+        cfg.collectionType() == search::attribute::CollectionType::Type::SINGLE &&
+        cfg.multi_threaded_feed())
+    {
+        return true;
+    }
     return false;
 }
 
+bool
+prefer_two_phase_put(const AttributeVector& attr, uint32_t docid)
+{
+    if (attr.isStringType()) {
+        // Only worth the extra executor hop while most puts find their value in the dictionary.
+        return static_cast<const search::StringAttribute&>(attr).prefer_prepared_update(docid);
+    }
+    return true;
+}
+
 }
 
 AttributeWriter::WriteField::WriteField(AttributeVector &attribute)
@@ -387,17 +404,20 @@ private:
     std::shared_ptr<const FieldPath> _field_path;
     const Document* const _doc;
     std::unique_ptr<FieldValue> _field_value;
+    const bool _prepare;
     std::promise<FieldValueAndPrepareResult> _result_promise;
 
 public:
     PreparePutTask(SerialNum serial_num,
                    uint32_t docid,
                    const AttributeWriter::WriteContext& wc,
-                   const Document& doc);
+                   const Document& doc,
+                   bool prepare);
     PreparePutTask(SerialNum serial_num,
                    uint32_t docid,
                    AttributeVector& attr,
-                   const FieldValue& field_value);
+                   const FieldValue& field_value,
+                   bool prepare);
     ~PreparePutTask() override;
     void run() override;
     SerialNum serial_num() const { return _serial_num; }
@@ -411,13 +431,15 @@ public:
 PreparePutTask::PreparePutTask(SerialNum serial_num,
                                uint32_t docid,
                                const AttributeWriter::WriteContext& wc,
-                               const Document& doc)
+                               const Document& doc,
+                               bool prepare)
     : _serial_num(serial_num),
       _docid(docid),
       _attr(wc.getFields()[0].getAttribute()),
       _field_path(wc.get_two_phase_put_field_path()),
       _doc(&doc),
       _field_value(),
+      _prepare(prepare),
       _result_promise()
 {
 }
@@ -425,13 +447,15 @@ PreparePutTask::PreparePutTask(SerialNum serial_num,
 PreparePutTask::PreparePutTask(SerialNum serial_num,
                                uint32_t docid,
                                AttributeVector& attr,
-                               const FieldValue& field_value)
+                               const FieldValue& field_value,
+                               bool prepare)
     : _serial_num(serial_num),
       _docid(docid),
       _attr(attr),
       _field_path(),
       _doc(nullptr),
       _field_value(field_value.clone()),
+      _prepare(prepare),
       _result_promise()
 {
 }
@@ -448,7 +472,8 @@ PreparePutTask::run()
         }
         if (_field_value.get()) {
             auto& fv = *_field_value;
-            _result_promise.set_value(FieldValueAndPrepareResult(std::move(_field_value), AttributeUpdater::prepare_set_value(_attr, _docid, fv)));
+            auto prepare_result = _prepare ? AttributeUpdater::prepare_set_value(_attr, _docid, fv) : std::unique_ptr<PrepareResult>();
+            _result_promise.set_value(FieldValueAndPrepareResult(std::move(_field_value), std::move(prepare_result)));
         } else {
             _result_promise.set_value(FieldValueAndPrepareResult());
         }
@@ -490,6 +515,20 @@ CompletePutTask::run()
     }
 }
 
+void
+schedule_two_phase_put(std::unique_ptr<PreparePutTask> prepare_task, std::unique_ptr<CompletePutTask> complete_task,
+                       bool prepare, vespalib::Executor& shared_executor,
+                       vespalib::ISequencedTaskExecutor& writer, ExecutorId executor_id)
+{
+    if (prepare) {
+        shared_executor.execute(CpuUsage::wrap(std::move(prepare_task), CpuUsage::Category::WRITE));
+    } else {
+        // Nothing to prepare, only extract the field value in the write thread right before completing.
+        writer.executeTask(executor_id, std::move(prepare_task));
+    }
+    writer.executeTask(executor_id, std::move(complete_task));
+}
+
 class RemoveTask : public vespalib::Executor::Task
 {
     const AttributeWriter::WriteContext  &_wc;
@@ -630,10 +669,11 @@ AttributeWriter::internalPut(SerialNum serialNum, const Document &doc, DocumentI
         if (allAttributes && wc.use_two_phase_put()) {
             assert(wc.getFields().size() == 1);
             wc.consider_build_field_paths(doc);
-            auto prepare_task = std::make_unique<PreparePutTask>(serialNum, lid, wc, doc);
+            bool prepare = prefer_two_phase_put(wc.getFields()[0].getAttribute(), lid);
+            auto prepare_task = std::make_unique<PreparePutTask>(serialNum, lid, wc, doc, prepare);
             auto complete_task = std::make_unique<CompletePutTask>(*prepare_task, onWriteDone);
-            _shared_executor.execute(CpuUsage::wrap(std::move(prepare_task), CpuUsage::Category::WRITE));
-            _attributeFieldWriter.executeTask(wc.getExecutorId(), std::move(complete_task));
+            schedule_two_phase_put(std::move(prepare_task), std::move(complete_task), prepare,
+                                   _shared_executor, _attributeFieldWriter, wc.getExecutorId());
         } else {
             if (allAttributes || wc.hasStructFieldAttribute()) {
                 auto putTask = std::make_unique<PutTask>(wc, serialNum, doc, lid, allAttributes, onWriteDone);
@@ -777,12 +817,13 @@ AttributeWriter::update(SerialNum serialNum, const DocumentUpdate &upd, Document
             continue;
         }
         if (found->second.use_two_phase_put_for_assign_updates && is_single_assign_update(fupd)) {
-            auto prepare_task = std::make_unique<PreparePutTask>(serialNum, lid, *attrp, get_single_assign_update_field_value(fupd));
+            bool prepare = prefer_two_phase_put(*attrp, lid);
+            auto prepare_task = std::make_unique<PreparePutTask>(serialNum, lid, *attrp, get_single_assign_update_field_value(fupd), prepare);
             auto complete_task = std::make_unique<CompletePutTask>(*prepare_task, onWriteDone);
             LOG(debug, "About to handle assign update as two phase put for docid %u in attribute vector '%s'",
                 lid, attrp->getName().c_str());
-            _shared_executor.execute(CpuUsage::wrap(std::move(prepare_task), CpuUsage::Category::WRITE));
-            _attributeFieldWriter.executeTask(found->second.executor_id, std::move(complete_task));
+            schedule_two_phase_put(std::move(prepare_task), std::move(complete_task), prepare,
+                                   _shared_executor, _attributeFieldWriter, found->second.executor_id);
         } else {
             args[found->second.executor_id.getId()]->_updates.emplace_back(attrp, &fupd);
             LOG(debug, "About to apply update for docId %u in attribute vector '%s'.", lid, attrp->getName().c_str());
@@ -577,11 +577,40 @@ complete_set_tensor(TensorAttribute& attr, uint32_t docid, const FieldValue& val
     }
 }
 
+bool
+is_single_string_attribute(const AttributeVector& attr)
+{
+    return attr.isStringType() && !attr.hasMultiValue();
+}
+
+std::unique_ptr<PrepareResult>
+prepare_set_string(const StringAttribute& attr, uint32_t docid, const FieldValue& val)
+{
+    if (!val.isLiteral()) {
+        // Reported when completing the update
+        return {};
+    }
+    return attr.prepare_update(docid, static_cast<const LiteralFieldValueB &>(val).getValue());
+}
+
+void
+complete_set_string(StringAttribute& attr, uint32_t docid, const FieldValue& val, std::unique_ptr<PrepareResult> prepare_result)
+{
+    const vespalib::string & v = getString(attr, docid, val);
+    if (!attr.complete_update(docid, v, std::move(prepare_result))) {
+        throw UpdateException(make_string("attribute update failed: %s[%u] = %s",
+                                          attr.getName().c_str(), docid, v.c_str()));
+    }
+}
+
 }
 
 std::unique_ptr<PrepareResult>
 AttributeUpdater::prepare_set_value(AttributeVector& attr, uint32_t docid, const FieldValue& val)
 {
+    if (is_single_string_attribute(attr)) {
+        return prepare_set_string(static_cast<const StringAttribute&>(attr), docid, val);
+    }
     validate_tensor_attribute_type(attr);
     return prepare_set_tensor(static_cast<TensorAttribute&>(attr), docid, val);
 }
@@ -590,6 +619,10 @@ void
 AttributeUpdater::complete_set_value(AttributeVector& attr, uint32_t docid, const FieldValue& val,
                                      std::unique_ptr<PrepareResult> prepare_result)
 {
+    if (is_single_string_attribute(attr)) {
+        complete_set_string(static_cast<StringAttribute&>(attr), docid, val, std::move(prepare_result));
+        return;
+    }
     validate_tensor_attribute_type(attr);
     complete_set_tensor(static_cast<TensorAttribute&>(attr), docid, val, std::move(prepare_result));
 }
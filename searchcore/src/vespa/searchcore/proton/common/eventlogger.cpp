@@ -71,6 +71,23 @@ EventLogger::transactionLogReplayProgress(const string &domainName, float progre
     EV_STATE("transactionlog.replay.progress", jstr.toString().data());
 }
 
+void
+EventLogger::transactionLogReplayThroughput(const string &domainName, uint64_t entries, uint64_t bytes,
+                                            vespalib::duration elapsedTime)
+{
+    double seconds = vespalib::to_s(elapsedTime);
+    JSONStringer jstr;
+    jstr.beginObject();
+    jstr.appendKey("domain").appendString(domainName);
+    jstr.appendKey("entries").appendInt64(entries);
+    jstr.appendKey("bytes").appendInt64(bytes);
+    jstr.appendKey("time.elapsed.ms").appendInt64(count_ms(elapsedTime));
+    jstr.appendKey("entries_per_second").appendDouble(seconds > 0.0 ? entries / seconds : 0.0);
+    jstr.appendKey("bytes_per_second").appendDouble(seconds > 0.0 ? bytes / seconds : 0.0);
+    jstr.endObject();
+    EV_STATE("transactionlog.replay.throughput", jstr.toString().data());
+}
+
 void
 EventLogger::transactionLogReplayComplete(const string &domainName, vespalib::duration elapsedTime)
 {
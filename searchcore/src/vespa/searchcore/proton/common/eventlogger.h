@@ -33,6 +33,10 @@ public:
                                              SerialNum first,
                                              SerialNum last,
                                              SerialNum current);
+    static void transactionLogReplayThroughput(const string &domainName,
+                                               uint64_t entries,
+                                               uint64_t bytes,
+                                               vespalib::duration elapsedTime);
     static void flushInit(const string &name);
     static void flushStart(const string &name,
                            int64_t beforeMemory,
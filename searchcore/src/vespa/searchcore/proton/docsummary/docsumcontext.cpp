@@ -73,6 +73,10 @@ DocsumContext::createSlimeReply()
     Cursor & array = root.setArray(DOCSUMS);
     const Symbol docsumSym = response->insert(DOCSUM);
     _docsumState._omit_summary_features = (rci.res_class == nullptr) || rci.res_class->omit_summary_features();
+    if ((rci.res_class != nullptr) && ! rci.all_fields_generated && ! _request.expired()) {
+        // Fetch all stored documents up front, so hits sharing a chunk only decompress it once.
+        _docsumStore.prefetch(_docsumState._docsumbuf);
+    }
     uint32_t num_ok(0);
     for (uint32_t docId : _docsumState._docsumbuf) {
         if (_request.expired() ) { break; }
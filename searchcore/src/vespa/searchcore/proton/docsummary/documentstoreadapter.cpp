@@ -6,6 +6,7 @@
 #include <vespa/document/fieldvalue/stringfieldvalue.h>
 #include <vespa/eval/eval/value_codec.h>
 #include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
 #include <vespa/document/fieldvalue/tensorfieldvalue.h>
 
 #include <vespa/log/log.h>
@@ -20,13 +21,24 @@ namespace {
 
 const vespalib::string DOCUMENT_ID_FIELD("documentid");
 
+class PrefetchVisitor : public search::IDocumentVisitor {
+public:
+    using DocumentMap = vespalib::hash_map<uint32_t, std::unique_ptr<Document>>;
+    explicit PrefetchVisitor(DocumentMap &documents) noexcept : _documents(documents) { }
+    void visit(uint32_t lid, DocumentUP doc) override { _documents[lid] = std::move(doc); }
+    bool allowVisitCaching() const override { return false; }
+private:
+    DocumentMap &_documents;
+};
+
 }
 
 DocumentStoreAdapter::
 DocumentStoreAdapter(const search::IDocumentStore & docStore,
                      const DocumentTypeRepo &repo)
     : _docStore(docStore),
-      _repo(repo)
+      _repo(repo),
+      _prefetched()
 {
 }
 
@@ -35,7 +47,14 @@ DocumentStoreAdapter::~DocumentStoreAdapter() = default;
 std::unique_ptr<const IDocsumStoreDocument>
 DocumentStoreAdapter::get_document(uint32_t docId)
 {
-    auto document = _docStore.read(docId, _repo);
+    std::unique_ptr<Document> document;
+    auto found = _prefetched.find(docId);
+    if (found != _prefetched.end()) {
+        document = std::move(found->second);
+        _prefetched.erase(found);
+    } else {
+        document = _docStore.read(docId, _repo);
+    }
     if ( ! document) {
         LOG(debug, "Did not find summary document for docId %u. Returning empty docsum", docId);
         return {};
@@ -44,4 +63,15 @@ DocumentStoreAdapter::get_document(uint32_t docId)
     return std::make_unique<DocsumStoreDocument>(std::move(document));
 }
 
+void
+DocumentStoreAdapter::prefetch(const std::vector<uint32_t> &docIds)
+{
+    _prefetched.clear();
+    if (docIds.size() < 2) {
+        return;
+    }
+    PrefetchVisitor visitor(_prefetched);
+    _docStore.read(docIds, _repo, visitor);
+}
+
 } // namespace proton
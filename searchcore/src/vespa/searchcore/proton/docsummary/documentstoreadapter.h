@@ -4,14 +4,18 @@
 
 #include <vespa/searchsummary/docsummary/docsumstore.h>
 #include <vespa/searchlib/docstore/idocumentstore.h>
+#include <vespa/vespalib/stllike/hash_map.h>
 
 namespace proton {
 
 class DocumentStoreAdapter : public search::docsummary::IDocsumStore
 {
 private:
+    using DocumentMap = vespalib::hash_map<uint32_t, std::unique_ptr<document::Document>>;
+
     const search::IDocumentStore           & _docStore;
     const document::DocumentTypeRepo       & _repo;
+    DocumentMap                              _prefetched;
 
 public:
     DocumentStoreAdapter(const search::IDocumentStore &docStore,
@@ -19,6 +23,7 @@ public:
     ~DocumentStoreAdapter();
 
     std::unique_ptr<const search::docsummary::IDocsumStoreDocument> get_document(uint32_t docId) override;
+    void prefetch(const std::vector<uint32_t> &docIds) override;
 };
 
 } // namespace proton
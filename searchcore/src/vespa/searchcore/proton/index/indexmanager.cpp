@@ -30,8 +30,14 @@ namespace proton::index {
 IndexManager::MaintainerOperations::MaintainerOperations(const FileHeaderContext &fileHeaderContext,
                                                          const TuneFileIndexManager &tuneFileIndexManager,
                                                          size_t cacheSize,
+                                                         uint32_t fusionPartitions,
+                                                         size_t fusionPartitionMemoryLimit,
+                                                         uint32_t fieldInverterShards,
                                                          IThreadingService &threadingService)
     : _cacheSize(cacheSize),
+      _fusionPartitions(fusionPartitions),
+      _fusionPartitionMemoryLimit(fusionPartitionMemoryLimit),
+      _fieldInverterShards(fieldInverterShards),
       _fileHeaderContext(fileHeaderContext),
       _tuneFileIndexing(tuneFileIndexManager._indexing),
       _tuneFileSearch(tuneFileIndexManager._search),
@@ -45,7 +51,7 @@ IndexManager::MaintainerOperations::createMemoryIndex(const Schema& schema,
                                                       SerialNum serialNum)
 {
     return std::make_shared<MemoryIndexWrapper>(schema, inspector, _fileHeaderContext, _tuneFileIndexing,
-                                                _threadingService, serialNum);
+                                                _threadingService, serialNum, _fieldInverterShards);
 }
 
 IDiskIndex::SP
@@ -72,6 +78,8 @@ IndexManager::MaintainerOperations::runFusion(const Schema &schema,
     SerialNumFileHeaderContext fileHeaderContext(_fileHeaderContext, serialNum);
     Fusion fusion(schema, outputDir, sources, selectorArray,
                   _tuneFileIndexing, fileHeaderContext);
+    fusion.set_max_word_range_partitions(_fusionPartitions);
+    fusion.set_word_range_partitions_memory_limit(_fusionPartitionMemoryLimit);
     return fusion.merge(_threadingService.shared(), std::move(flush_token));
 }
 
@@ -86,7 +94,9 @@ IndexManager::IndexManager(const vespalib::string &baseDir,
                            const search::TuneFileIndexManager &tuneFileIndexManager,
                            const search::TuneFileAttributes &tuneFileAttributes,
                            const FileHeaderContext &fileHeaderContext) :
-    _operations(fileHeaderContext, tuneFileIndexManager, indexConfig.cacheSize, threadingService),
+    _operations(fileHeaderContext, tuneFileIndexManager, indexConfig.cacheSize,
+                indexConfig.fusionPartitions, indexConfig.fusionPartitionMemoryLimit,
+                indexConfig.fieldInverterShards, threadingService),
     _maintainer(IndexMaintainerConfig(baseDir, indexConfig.warmup, indexConfig.maxFlushed, schema, serialNum, tuneFileAttributes),
                 IndexMaintainerContext(threadingService, reconfigurer, fileHeaderContext, warmupExecutor),
                 _operations)
@@ -13,14 +13,25 @@ struct IndexConfig {
     using WarmupConfig = searchcorespi::index::WarmupConfig;
     IndexConfig() : IndexConfig(WarmupConfig(), 2, 0) { }
     IndexConfig(WarmupConfig warmup_, size_t maxFlushed_, size_t cacheSize_)
+        : IndexConfig(warmup_, maxFlushed_, cacheSize_, 1, 0, 1)
+    { }
+    IndexConfig(WarmupConfig warmup_, size_t maxFlushed_, size_t cacheSize_,
+                uint32_t fusionPartitions_, size_t fusionPartitionMemoryLimit_,
+                uint32_t fieldInverterShards_)
         : warmup(warmup_),
           maxFlushed(maxFlushed_),
-          cacheSize(cacheSize_)
+          cacheSize(cacheSize_),
+          fusionPartitions(fusionPartitions_),
+          fusionPartitionMemoryLimit(fusionPartitionMemoryLimit_),
+          fieldInverterShards(fieldInverterShards_)
     { }
 
     const WarmupConfig warmup;
     const size_t       maxFlushed;
     const size_t       cacheSize;
+    const uint32_t     fusionPartitions;
+    const size_t       fusionPartitionMemoryLimit;
+    const uint32_t     fieldInverterShards;
 };
 
 /**
@@ -37,6 +48,9 @@ public:
         using IDiskIndex = searchcorespi::index::IDiskIndex;
         using IMemoryIndex = searchcorespi::index::IMemoryIndex;
         const size_t _cacheSize;
+        const uint32_t _fusionPartitions;
+        const size_t _fusionPartitionMemoryLimit;
+        const uint32_t _fieldInverterShards;
         const search::common::FileHeaderContext &_fileHeaderContext;
         const search::TuneFileIndexing _tuneFileIndexing;
         const search::TuneFileSearch _tuneFileSearch;
@@ -46,6 +60,9 @@ public:
         MaintainerOperations(const search::common::FileHeaderContext &fileHeaderContext,
                              const search::TuneFileIndexManager &tuneFileIndexManager,
                              size_t cacheSize,
+                             uint32_t fusionPartitions,
+                             size_t fusionPartitionMemoryLimit,
+                             uint32_t fieldInverterShards,
                              searchcorespi::index::IThreadingService &threadingService);
 
         IMemoryIndex::SP createMemoryIndex(const Schema& schema,
@@ -22,9 +22,10 @@ MemoryIndexWrapper::MemoryIndexWrapper(const search::index::Schema& schema,
                                        const search::common::FileHeaderContext& fileHeaderContext,
                                        const TuneFileIndexing& tuneFileIndexing,
                                        searchcorespi::index::IThreadingService& threadingService,
-                                       search::SerialNum serialNum)
+                                       search::SerialNum serialNum,
+                                       uint32_t fieldInverterShards)
     : _index(schema, inspector, threadingService.field_writer(),
-             threadingService.field_writer()),
+             threadingService.field_writer(), fieldInverterShards),
       _serialNum(serialNum),
       _fileHeaderContext(fileHeaderContext),
       _tuneFileIndexing(tuneFileIndexing)
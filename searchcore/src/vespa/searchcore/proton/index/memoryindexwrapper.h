@@ -30,7 +30,8 @@ public:
                        const search::common::FileHeaderContext& fileHeaderContext,
                        const search::TuneFileIndexing& tuneFileIndexing,
                        searchcorespi::index::IThreadingService& threadingService,
-                       SerialNum serialNum);
+                       SerialNum serialNum,
+                       uint32_t fieldInverterShards);
 
     /**
      * Implements searchcorespi::IndexSearchable
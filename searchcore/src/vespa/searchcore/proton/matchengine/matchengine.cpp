@@ -7,6 +7,7 @@
 #include <vespa/vespalib/data/slime/binary_format.h>
 #include <vespa/vespalib/util/size_literals.h>
 #include <vespa/vespalib/util/cpu_usage.h>
+#include <vespa/vespalib/util/numa.h>
 
 #include <vespa/log/log.h>
 
@@ -47,8 +48,10 @@ namespace proton {
 
 using namespace vespalib::slime;
 using vespalib::CpuUsage;
+using vespalib::SimpleThreadBundle;
 
-MatchEngine::MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey, bool async)
+MatchEngine::MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey, bool async,
+                         std::shared_ptr<const vespalib::NumaNodes> numaNodes)
     : _lock(),
       _distributionKey(distributionKey),
       _async(async),
@@ -56,12 +59,17 @@ MatchEngine::MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t di
       _forward_issues(true),
       _handlers(),
       _executor(std::max(size_t(1), numThreads / threadsPerSearch),
-                CpuUsage::wrap(match_engine_executor, CpuUsage::Category::READ)),
-      _threadBundlePool(std::max(size_t(1), threadsPerSearch),
-                        CpuUsage::wrap(match_engine_thread_bundle, CpuUsage::Category::READ)),
+                vespalib::bind_to_numa_nodes(CpuUsage::wrap(match_engine_executor, CpuUsage::Category::READ), numaNodes)),
+      _threadBundlePools(),
       _nodeUp(false),
       _nodeMaintenance(false)
 {
+    auto init_fun = CpuUsage::wrap(match_engine_thread_bundle, CpuUsage::Category::READ);
+    size_t numPools = (numaNodes && (numaNodes->size() > 1)) ? numaNodes->size() : 1;
+    for (size_t node = 0; node < numPools; ++node) {
+        _threadBundlePools.push_back(std::make_unique<SimpleThreadBundle::Pool>(std::max(size_t(1), threadsPerSearch),
+                                                                                 vespalib::bind_to_numa_node(init_fun, numaNodes, node)));
+    }
 }
 
 MatchEngine::~MatchEngine()
@@ -123,6 +131,16 @@ MatchEngine::search(SearchRequest::Source request, SearchClient &client)
     return performSearch(std::move(request));
 }
 
+SimpleThreadBundle::Pool &
+MatchEngine::threadBundlePool()
+{
+    int node = vespalib::current_numa_node();
+    if ((node >= 0) && (size_t(node) < _threadBundlePools.size())) {
+        return *_threadBundlePools[node];
+    }
+    return *_threadBundlePools[0];
+}
+
 std::unique_ptr<SearchReply>
 MatchEngine::doSearch(const SearchRequest & searchRequest) {
     if (searchRequest.expired()) {
@@ -133,7 +151,7 @@ MatchEngine::doSearch(const SearchRequest & searchRequest) {
     searchRequest.setTraceLevel(trace::Level::lookup(searchRequest.propertiesMap.modelOverrides(),
                                                       searchRequest.trace().getLevel()), 3);
     ISearchHandler::SP searchHandler;
-    auto threadBundle = _threadBundlePool.getBundle();
+    auto threadBundle = threadBundlePool().getBundle();
     { // try to find the match handler corresponding to the specified search doc type
         DocTypeName docTypeName(searchRequest);
         std::lock_guard<std::mutex> guard(_lock);
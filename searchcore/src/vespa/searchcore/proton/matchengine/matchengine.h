@@ -11,6 +11,8 @@
 #include <vespa/vespalib/util/simple_thread_bundle.h>
 #include <mutex>
 
+namespace vespalib { class NumaNodes; }
+
 namespace proton {
 
 class MatchEngine : public search::engine::SearchServer,
@@ -24,10 +26,11 @@ private:
     std::atomic<bool>                  _forward_issues;
     HandlerMap<ISearchHandler>         _handlers;
     vespalib::ThreadStackExecutor      _executor;
-    vespalib::SimpleThreadBundle::Pool _threadBundlePool;
+    std::vector<std::unique_ptr<vespalib::SimpleThreadBundle::Pool>> _threadBundlePools;
     std::atomic<bool>                  _nodeUp;
     std::atomic<bool>                  _nodeMaintenance;
 
+    vespalib::SimpleThreadBundle::Pool &threadBundlePool();
     std::unique_ptr<search::engine::SearchReply> doSearch(const search::engine::SearchRequest & searchRequest);
 public:
     /**
@@ -48,8 +51,15 @@ public:
      * @param threadsPerSearch number of threads used for each search
      * @param distributionKey distributionkey of this node.
      * @param async if query is dispatched to threadpool
+     * @param numaNodes if given (and more than one), search threads are bound to the
+     *                  nodes round robin, and each query gets a thread bundle with
+     *                  threads bound to the same node as the thread handling it.
      */
-    MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey, bool async);
+    MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey, bool async,
+                std::shared_ptr<const vespalib::NumaNodes> numaNodes);
+    MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey, bool async)
+        : MatchEngine(numThreads, threadsPerSearch, distributionKey, async, {})
+    {}
     MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey)
         : MatchEngine(numThreads, threadsPerSearch, distributionKey, true)
     {}
@@ -9,6 +9,9 @@ namespace {
 
 size_t clamped_sub(size_t a, size_t b) { return (b > a) ? 0 : (a - b); }
 
+// claim 1/16 of the remaining unclaimed work of a thread at a time
+constexpr size_t chunk_divisor = 16;
+
 } // namespace proton::matching::<unnamed>
 
 const std::atomic<size_t> IdleObserver::_always_zero(0);
@@ -164,4 +167,87 @@ AdaptiveDocidRangeScheduler::share_range(size_t thread_id, DocidRange todo)
 
 //-----------------------------------------------------------------------------
 
+DocidRange
+WorkStealingDocidRangeScheduler::claim(size_t thread_id)
+{
+    Worker &worker = _workers[thread_id];
+    uint64_t value = worker.unclaimed.load(std::memory_order_relaxed);
+    for (;;) {
+        DocidRange todo = unpack(value);
+        if (todo.empty()) {
+            return DocidRange();
+        }
+        size_t chunk = std::max(size_t(_min_task), (todo.size() + chunk_divisor - 1) / chunk_divisor);
+        DocidRange work(todo.begin, todo.begin + std::min(chunk, todo.size()));
+        if (worker.unclaimed.compare_exchange_weak(value, pack(DocidRange(work.end, todo.end)),
+                                                   std::memory_order_relaxed))
+        {
+            worker.assigned += work.size();
+            _unassigned.fetch_sub(work.size(), std::memory_order_relaxed);
+            return work;
+        }
+    }
+}
+
+bool
+WorkStealingDocidRangeScheduler::steal(size_t thread_id)
+{
+    for (;;) {
+        size_t victim = thread_id;
+        uint64_t victim_value = 0;
+        size_t victim_todo = 0;
+        for (size_t i = 0; i < _workers.size(); ++i) {
+            uint64_t value = _workers[i].unclaimed.load(std::memory_order_relaxed);
+            size_t todo = unpack(value).size();
+            if (todo > victim_todo) {
+                victim = i;
+                victim_value = value;
+                victim_todo = todo;
+            }
+        }
+        if (victim_todo == 0) {
+            return false;
+        }
+        // our own unclaimed range is empty, so we cannot be the victim
+        assert(victim != thread_id);
+        DocidRange todo = unpack(victim_value);
+        uint32_t split = (todo.size() >= (2 * size_t(_min_task))) ? (todo.begin + todo.size() / 2) : todo.begin;
+        if (_workers[victim].unclaimed.compare_exchange_strong(victim_value, pack(DocidRange(todo.begin, split)),
+                                                               std::memory_order_relaxed))
+        {
+            DocidRange stolen(split, todo.end);
+            _workers[thread_id].unclaimed.store(pack(stolen), std::memory_order_relaxed);
+            _workers[thread_id].stolen += stolen.size();
+            return true;
+        }
+    }
+}
+
+WorkStealingDocidRangeScheduler::WorkStealingDocidRangeScheduler(size_t num_threads, uint32_t min_task, uint32_t docid_limit)
+    : _min_task(std::max(1u, min_task)),
+      _workers(num_threads),
+      _unassigned(0)
+{
+    DocidRangeSplitter splitter(DocidRange(1, docid_limit), num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        _workers[i].unclaimed.store(pack(splitter.get(i)), std::memory_order_relaxed);
+    }
+    _unassigned.store(splitter.full_range().size(), std::memory_order_relaxed);
+}
+
+WorkStealingDocidRangeScheduler::~WorkStealingDocidRangeScheduler() = default;
+
+DocidRange
+WorkStealingDocidRangeScheduler::next_range(size_t thread_id)
+{
+    for (;;) {
+        DocidRange work = claim(thread_id);
+        if (!work.empty() || !steal(thread_id)) {
+            return work;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 }
@@ -103,6 +103,10 @@ public:
  * will return the remaining work to be done by the thread calling
  * it. The returned range is guaranteed to be a prefix of the range
  * passed as input to the 'share_range' function.
+ *
+ * The 'stolen_size' function returns the accumulated size of all
+ * ranges the given worker has taken over from other workers without
+ * their cooperation (work-stealing).
  **/
 struct DocidRangeScheduler {
     using UP = std::unique_ptr<DocidRangeScheduler>;
@@ -112,6 +116,7 @@ struct DocidRangeScheduler {
     virtual size_t unassigned_size() const = 0;
     virtual IdleObserver make_idle_observer() const = 0;
     virtual DocidRange share_range(size_t thread_id, DocidRange todo) = 0;
+    virtual size_t stolen_size(size_t thread_id) const = 0;
     virtual ~DocidRangeScheduler() {}
 };
 
@@ -133,6 +138,7 @@ public:
     size_t unassigned_size() const override { return 0; }
     IdleObserver make_idle_observer() const override { return IdleObserver(); }
     DocidRange share_range(size_t, DocidRange todo) override { return todo; }
+    size_t stolen_size(size_t) const override { return 0; }
 };
 
 /**
@@ -160,6 +166,7 @@ public:
     size_t unassigned_size() const override { return _unassigned.load(std::memory_order_relaxed); }
     IdleObserver make_idle_observer() const override { return IdleObserver(); }
     DocidRange share_range(size_t, DocidRange todo) override { return todo; }
+    size_t stolen_size(size_t) const override { return 0; }
 };
 
 /**
@@ -199,6 +206,46 @@ public:
     size_t unassigned_size() const override { return 0; }
     IdleObserver make_idle_observer() const override { return IdleObserver(_num_idle); }
     DocidRange share_range(size_t, DocidRange todo) override;
+    size_t stolen_size(size_t) const override { return 0; }
+};
+
+/**
+ * A work-stealing scheduler that begins by giving each thread an
+ * equal part of the docid space. Each thread claims its part in
+ * chunks of decreasing size. A thread running out of work steals the
+ * upper half of the unclaimed work of the thread with the most
+ * unclaimed work left, without waiting for that thread to notice.
+ * Threads never block, and the range being worked on by a thread is
+ * never split, so chunks are kept small compared to the part given
+ * to each thread.
+ **/
+class WorkStealingDocidRangeScheduler : public DocidRangeScheduler
+{
+private:
+    struct alignas(64) Worker {
+        std::atomic<uint64_t> unclaimed; // packed docid range
+        size_t                assigned;
+        size_t                stolen;
+        Worker() noexcept : unclaimed(0), assigned(0), stolen(0) {}
+    };
+    static uint64_t pack(DocidRange range) noexcept { return (uint64_t(range.begin) << 32) | range.end; }
+    static DocidRange unpack(uint64_t value) noexcept { return DocidRange(value >> 32, value & 0xffffffffu); }
+    uint32_t            _min_task;
+    std::vector<Worker> _workers;
+    std::atomic<size_t> _unassigned;
+
+    VESPA_DLL_LOCAL DocidRange claim(size_t thread_id);
+    VESPA_DLL_LOCAL bool steal(size_t thread_id);
+public:
+    WorkStealingDocidRangeScheduler(size_t num_threads, uint32_t min_task, uint32_t docid_limit);
+    ~WorkStealingDocidRangeScheduler() override;
+    DocidRange first_range(size_t thread_id) override { return next_range(thread_id); }
+    DocidRange next_range(size_t thread_id) override;
+    size_t total_size(size_t thread_id) const override { return _workers[thread_id].assigned; }
+    size_t unassigned_size() const override { return _unassigned.load(std::memory_order_relaxed); }
+    IdleObserver make_idle_observer() const override { return IdleObserver(); }
+    DocidRange share_range(size_t, DocidRange todo) override { return todo; }
+    size_t stolen_size(size_t thread_id) const override { return _workers[thread_id].stolen; }
 };
 
 }
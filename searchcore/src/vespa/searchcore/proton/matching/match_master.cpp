@@ -26,6 +26,9 @@ namespace {
 
 using namespace vespalib::literals;
 
+// Smallest docid range claimed or stolen by a match thread
+constexpr uint32_t min_stealing_task = 256;
+
 struct TimedMatchLoopCommunicator final : IMatchLoopCommunicator {
     IMatchLoopCommunicator &communicator;
     vespalib::Timer timer;
@@ -50,7 +53,7 @@ DocidRangeScheduler::UP
 createScheduler(uint32_t numThreads, uint32_t numSearchPartitions, uint32_t numDocs)
 {
     if (numSearchPartitions == 0) {
-        return std::make_unique<AdaptiveDocidRangeScheduler>(numThreads, 1, numDocs);
+        return std::make_unique<WorkStealingDocidRangeScheduler>(numThreads, min_stealing_task, numDocs);
     }
     if (numSearchPartitions <= numThreads) {
         return std::make_unique<PartitionDocidRangeScheduler>(numThreads, numDocs);
@@ -62,13 +65,13 @@ template <class FullResult>
 auto make_reply(const MatchToolsFactory &mtf, ResultProcessor &processor, ThreadBundle &bundle, FullResult full_result) {
     if (mtf.has_match_features()) {
         auto docs = processor.extract_docid_ordering(*full_result);
-        auto reply = processor.makeReply(std::move(std::move(full_result)));
+        auto reply = processor.makeReply(std::move(std::move(full_result)), bundle);
         if ((docs.size() > 0) && reply->_reply) {
             reply->_reply->match_features = ExtractFeatures::get_match_features(mtf, docs, bundle);
         }
         return reply;
     } else {
-        return processor.makeReply(std::move(full_result));
+        return processor.makeReply(std::move(full_result), bundle);
     }
 }
 
@@ -103,11 +106,13 @@ MatchMaster::match(search::engine::Trace & trace,
     double query_time_s = vespalib::to_s(query_latency_time.elapsed());
     double rerank_time_s = vespalib::to_s(timedCommunicator.elapsed);
     double match_time_s = 0.0;
+    double profiled_rank_time_s = 0.0;
     auto inserter = trace.make_inserter("query_execution"_ssv);
     for (size_t i = 0; i < threadState.size(); ++i) {
         const MatchThread & matchThread = *threadState[i];
         match_time_s = std::max(match_time_s, matchThread.get_match_time());
         _stats.merge_partition(matchThread.get_thread_stats(), i);
+        profiled_rank_time_s += matchThread.get_thread_stats().profiled_rank_time();
         inserter.handle_thread(matchThread.getTrace());
         matchThread.get_issues().for_each_message([](const auto &msg){ Issue::report(Issue(msg)); });
     }
@@ -119,6 +124,9 @@ MatchMaster::match(search::engine::Trace & trace,
     if (mtf.match_limiter().was_limited()) {
         _stats.limited_queries(1);        
     }
+    if (threadState[0]->is_profiled()) {
+        _stats.profiledQueries(1).profiledRankTime(profiled_rank_time_s);
+    }
     return reply;
 }
 
@@ -99,21 +99,46 @@ fillPartialResult(ResultProcessor::Context & context, size_t totalHits, size_t n
 
 //-----------------------------------------------------------------------------
 
-MatchThread::Context::Context(double rankDropLimit, MatchTools &tools, HitCollector &hits, uint32_t num_threads)
+MatchThread::Context::Context(double rankDropLimit, MatchTools &tools, HitCollector &hits, uint32_t num_threads,
+                              uint32_t batch_size)
     : matches(0),
       _matches_limit(tools.match_limiter().sample_hits_per_thread(num_threads)),
       _score_feature(get_score_feature(tools.rank_program())),
+      _rank_program(tools.rank_program()),
+      _batch_size(((batch_size > 0) && tools.rank_program().setup_batch(batch_size)) ? batch_size : 0),
+      _batch(),
       _rankDropLimit(rankDropLimit),
       _hits(hits),
       _doom(tools.getDoom()),
       dropped()
 {
+    _batch.reserve(_batch_size);
 }
 
+MatchThread::Context::~Context() = default;
+
 template <MatchThread::RankDropLimitE use_rank_drop_limit>
 void
 MatchThread::Context::rankHit(uint32_t docId) {
-    double score = _score_feature.as_number(docId);
+    addScoredHit<use_rank_drop_limit>(docId, _score_feature.as_number(docId));
+}
+
+template <MatchThread::RankDropLimitE use_rank_drop_limit>
+void
+MatchThread::Context::rankBatch() {
+    if (_batch.empty()) {
+        return;
+    }
+    auto scores = _rank_program.execute_batch(_batch);
+    for (size_t i = 0; i < _batch.size(); ++i) {
+        addScoredHit<use_rank_drop_limit>(_batch[i], scores[i]);
+    }
+    _batch.clear();
+}
+
+template <MatchThread::RankDropLimitE use_rank_drop_limit>
+void
+MatchThread::Context::addScoredHit(uint32_t docId, double score) {
     // convert NaN and Inf scores to -Inf
     if (__builtin_expect(std::isnan(score) || std::isinf(score), false)) {
         score = -HUGE_VAL;
@@ -190,8 +215,13 @@ MatchThread::inner_match_loop(Context &context, MatchTools &tools, DocidRange &d
     uint32_t docId = search->seekFirst(docid_range.begin);
     while ((docId < docid_range.end) && !context.atSoftDoom()) {
         if (do_rank) {
-            search->unpack(docId);
-            context.rankHit<use_rank_drop_limit>(docId);
+            if (context.batched()) {
+                // No unpack needed, batch ranking does not use match data
+                context.batchHit<use_rank_drop_limit>(docId);
+            } else {
+                search->unpack(docId);
+                context.rankHit<use_rank_drop_limit>(docId);
+            }
         } else {
             context.addHit(docId);
         }
@@ -206,6 +236,9 @@ MatchThread::inner_match_loop(Context &context, MatchTools &tools, DocidRange &d
             docId = Strategy::seek_next(*search, docId + 1);
         }
     }
+    if (do_rank) {
+        context.rankBatch<use_rank_drop_limit>();
+    }
     return docId;
 }
 
@@ -217,7 +250,7 @@ MatchThread::match_loop(MatchTools &tools, HitCollector &hits)
     bool softDoomed = false;
     uint32_t docsCovered = 0;
     vespalib::duration overtime(vespalib::duration::zero());
-    Context context(matchParams.rankDropLimit, tools, hits, num_threads);
+    Context context(matchParams.rankDropLimit, tools, hits, num_threads, do_rank ? tools.first_phase_batch_size() : 0);
     for (DocidRange docid_range = scheduler.first_range(thread_id);
          !docid_range.empty();
          docid_range = scheduler.next_range(thread_id))
@@ -244,6 +277,7 @@ MatchThread::match_loop(MatchTools &tools, HitCollector &hits)
     thread_stats.docsCovered(docsCovered);
     thread_stats.docsMatched(matches);
     thread_stats.softDoomed(softDoomed);
+    thread_stats.docsStolen(scheduler.stolen_size(thread_id));
     if (softDoomed) {
         thread_stats.doomOvertime(overtime);
     }
@@ -504,17 +538,22 @@ MatchThread::run()
     trace->addEvent(4, "Start thread merge");
     mergeDirector.dualMerge(thread_id, *resultContext->result, resultContext->groupingSource);
     trace->addEvent(4, "MatchThread::run Done");
+    double profiled_rank_time_s = 0.0;
     if (match_profiler) {
         match_profiler->report(trace->createCursor("match_profiling"));
+        thread_stats.profiled_iterator_calls(match_profiler->total_count());
     }
     if (first_phase_profiler) {
         first_phase_profiler->report(trace->createCursor("first_phase_profiling"),
                                      [](const vespalib::string &name){ return BlueprintResolver::describe_feature(name); });
+        profiled_rank_time_s += vespalib::to_s(first_phase_profiler->total_time());
     }
     if (second_phase_profiler) {
         second_phase_profiler->report(trace->createCursor("second_phase_profiling"),
                                       [](const vespalib::string &name){ return BlueprintResolver::describe_feature(name); });
+        profiled_rank_time_s += vespalib::to_s(second_phase_profiler->total_time());
     }
+    thread_stats.profiled_rank_time(profiled_rank_time_s);
 }
 
 std::unique_ptr<PartialResult>
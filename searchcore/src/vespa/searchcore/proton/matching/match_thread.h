@@ -74,9 +74,21 @@ private:
     class Context {
     public:
         Context(double rankDropLimit, MatchTools &tools, HitCollector &hits,
-                uint32_t num_threads) __attribute__((noinline));
+                uint32_t num_threads, uint32_t batch_size) __attribute__((noinline));
+        ~Context();
         template <RankDropLimitE use_rank_drop_limit>
         void rankHit(uint32_t docId);
+        // Ranking in batches is used when the first phase rank program supports it.
+        bool batched() const { return _batch_size > 0; }
+        template <RankDropLimitE use_rank_drop_limit>
+        void batchHit(uint32_t docId) {
+            _batch.push_back(docId);
+            if (_batch.size() == _batch_size) {
+                rankBatch<use_rank_drop_limit>();
+            }
+        }
+        template <RankDropLimitE use_rank_drop_limit>
+        void rankBatch() __attribute__((noinline));
         void addHit(uint32_t docId) { _hits.addHit(docId, search::zero_rank_value); }
         bool isBelowLimit() const { return matches < _matches_limit; }
         bool    isAtLimit() const { return matches == _matches_limit; }
@@ -84,8 +96,14 @@ private:
         vespalib::duration timeLeft() const { return _doom.soft_left(); }
         uint32_t        matches;
     private:
+        template <RankDropLimitE use_rank_drop_limit>
+        void addScoredHit(uint32_t docId, double score);
+
         uint32_t        _matches_limit;
         LazyValue       _score_feature;
+        RankProgram    &_rank_program;
+        uint32_t        _batch_size;
+        std::vector<uint32_t> _batch;
         double          _rankDropLimit;
         HitCollector   &_hits;
         const Doom      _doom;
@@ -135,6 +153,7 @@ public:
     void run() override;
     const MatchingStats::Partition &get_thread_stats() const { return thread_stats; }
     double get_match_time() const { return match_time_s; }
+    bool is_profiled() const { return (match_profiler || first_phase_profiler || second_phase_profiler); }
     std::unique_ptr<PartialResult> extract_result();
     const Trace & getTrace() const { return *trace; }
     const UniqueIssues &get_issues() const { return my_issues; }
@@ -128,6 +128,11 @@ MatchTools::has_second_phase_rank() const {
     return !_rankSetup.getSecondPhaseRank().empty();
 }
 
+uint32_t
+MatchTools::first_phase_batch_size() const {
+    return FirstPhaseBatchSize::lookup(_queryEnv.getProperties(), _rankSetup.get_first_phase_batch_size());
+}
+
 void
 MatchTools::setup_first_phase(ExecutionProfiler *profiler)
 {
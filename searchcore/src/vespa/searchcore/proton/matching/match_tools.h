@@ -70,6 +70,7 @@ public:
     QueryLimiter & getQueryLimiter() { return _queryLimiter; }
     MaybeMatchPhaseLimiter &match_limiter() { return _match_limiter; }
     bool has_second_phase_rank() const;
+    uint32_t first_phase_batch_size() const;
     const MatchData &match_data() const { return *_match_data; }
     RankProgram &rank_program() { return *_rank_program; }
     SearchIterator &search() { return *_search; }
@@ -51,6 +51,9 @@ namespace {
 
 constexpr vespalib::duration TIME_BEFORE_ALLOWING_SOFT_TIMEOUT_FACTOR_ADJUSTMENT = 60s;
 
+// flat profiling (top n tasks by self time) is used for sampled queries
+constexpr int32_t SAMPLED_PROFILE_DEPTH = -32;
+
 // used to give out empty whitelist blueprints
 struct StupidMetaStore : search::IDocumentMetaStore {
     static const search::AllocatedBitVector _dummy;
@@ -127,7 +130,8 @@ Matcher::Matcher(const search::index::Schema &schema, Properties props, const st
     _startTime(my_clock::now()),
     _now_ref(now_ref),
     _queryLimiter(queryLimiter),
-    _distributionKey(distributionKey)
+    _distributionKey(distributionKey),
+    _profileSampleCount(0)
 {
     search::features::setup_search_features(_blueprintFactory);
     search::fef::test::setup_fef_test_plugin(_blueprintFactory);
@@ -141,6 +145,16 @@ Matcher::Matcher(const search::index::Schema &schema, Properties props, const st
 
 Matcher::~Matcher() = default;
 
+bool
+Matcher::sampleProfile()
+{
+    uint32_t interval = _rankSetup->get_profile_sample_interval();
+    if (interval == 0) {
+        return false;
+    }
+    return ((_profileSampleCount.fetch_add(1, std::memory_order_relaxed) % interval) == 0);
+}
+
 MatchingStats
 Matcher::getStats()
 {
@@ -305,6 +319,20 @@ Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundl
         if (limitedThreadBundle.size() > 1) {
             attrContext.enableMultiThreadSafe();
         }
+        if (sampleProfile()) {
+            // Profiles are only collected and returned when tracing. Explicitly requested profiling wins.
+            Trace &trace = request.trace();
+            trace.setLevel(std::max(trace.getLevel(), 1u));
+            if (trace.match_profile_depth() == 0) {
+                trace.match_profile_depth(SAMPLED_PROFILE_DEPTH);
+            }
+            if (trace.first_phase_profile_depth() == 0) {
+                trace.first_phase_profile_depth(SAMPLED_PROFILE_DEPTH);
+            }
+            if (trace.second_phase_profile_depth() == 0) {
+                trace.second_phase_profile_depth(SAMPLED_PROFILE_DEPTH);
+            }
+        }
         ResultProcessor::Result::UP result = master.match(request.trace(), params, limitedThreadBundle, *mtf, rp,
                                                           _distributionKey, numParts);
         my_stats = MatchMaster::getStats(std::move(master));
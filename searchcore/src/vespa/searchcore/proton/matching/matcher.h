@@ -18,6 +18,7 @@
 #include <vespa/searchlib/query/base.h>
 #include <vespa/vespalib/util/featureset.h>
 #include <vespa/vespalib/util/thread_bundle.h>
+#include <atomic>
 #include <mutex>
 
 namespace search::grouping {
@@ -69,7 +70,9 @@ private:
     const std::atomic<steady_time> &_now_ref;
     QueryLimiter                   &_queryLimiter;
     uint32_t                        _distributionKey;
+    std::atomic<uint64_t>           _profileSampleCount;
 
+    bool sampleProfile();
     size_t computeNumThreadsPerSearch(search::queryeval::Blueprint::HitEstimate hits,
                                       const Properties & rankProperties) const;
     void updateStats(const MatchingStats & stats, const search::engine::Request & request,
@@ -27,6 +27,9 @@ MatchingStats::MatchingStats(double prev_soft_doom_factor) noexcept
       _docsRanked(0),
       _docsReRanked(0),
       _softDoomed(0),
+      _profiledQueries(0),
+      _profiledIteratorCalls(0),
+      _profiledRankTime(),
       _doomOvertime(),
       _softDoomFactor(prev_soft_doom_factor),
       _querySetupTime(),
@@ -48,6 +51,7 @@ MatchingStats::merge_partition(const Partition &partition, size_t id)
     _docsMatched += partition.docsMatched();
     _docsRanked += partition.docsRanked();
     _docsReRanked += partition.docsReRanked();
+    _profiledIteratorCalls += partition.profiled_iterator_calls();
     _doomOvertime.add(partition._doomOvertime);
     if (partition.softDoomed()) {
         _softDoomed = 1;
@@ -67,6 +71,9 @@ MatchingStats::add(const MatchingStats &rhs) noexcept
     _docsRanked += rhs._docsRanked;
     _docsReRanked += rhs._docsReRanked;
     _softDoomed += rhs.softDoomed();
+    _profiledQueries += rhs._profiledQueries;
+    _profiledIteratorCalls += rhs._profiledIteratorCalls;
+    _profiledRankTime.add(rhs._profiledRankTime);
     _doomOvertime.add(rhs._doomOvertime);
 
     _querySetupTime.add(rhs._querySetupTime);
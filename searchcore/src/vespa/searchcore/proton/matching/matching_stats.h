@@ -63,6 +63,9 @@ public:
         size_t _docsRanked;
         size_t _docsReRanked;
         size_t _softDoomed;
+        size_t _docsStolen;
+        size_t _profiledIteratorCalls;
+        double _profiledRankTime;
         Avg    _doomOvertime;
         Avg    _active_time;
         Avg    _wait_time;
@@ -74,6 +77,9 @@ public:
               _docsRanked(0),
               _docsReRanked(0),
               _softDoomed(0),
+              _docsStolen(0),
+              _profiledIteratorCalls(0),
+              _profiledRankTime(0.0),
               _doomOvertime(),
               _active_time(),
               _wait_time() { }
@@ -88,6 +94,12 @@ public:
         size_t docsReRanked() const noexcept { return _docsReRanked; }
         Partition &softDoomed(bool v) noexcept { _softDoomed += v ? 1 : 0; return *this; }
         size_t softDoomed() const noexcept { return _softDoomed; }
+        Partition &docsStolen(size_t value) noexcept { _docsStolen = value; return *this; }
+        size_t docsStolen() const noexcept { return _docsStolen; }
+        Partition &profiled_iterator_calls(size_t value) noexcept { _profiledIteratorCalls = value; return *this; }
+        size_t profiled_iterator_calls() const noexcept { return _profiledIteratorCalls; }
+        Partition &profiled_rank_time(double time_s) noexcept { _profiledRankTime = time_s; return *this; }
+        double profiled_rank_time() const noexcept { return _profiledRankTime; }
         Partition & doomOvertime(vespalib::duration overtime) noexcept { _doomOvertime.set(vespalib::to_s(overtime)); return *this; }
         vespalib::duration doomOvertime() const noexcept { return vespalib::from_s(_doomOvertime.max()); }
 
@@ -108,6 +120,9 @@ public:
             _docsRanked += rhs._docsRanked;
             _docsReRanked += rhs._docsReRanked;
             _softDoomed += rhs._softDoomed;
+            _docsStolen += rhs._docsStolen;
+            _profiledIteratorCalls += rhs._profiledIteratorCalls;
+            _profiledRankTime += rhs._profiledRankTime;
             _doomOvertime.add(rhs._doomOvertime);
 
             _active_time.add(rhs._active_time);
@@ -124,6 +139,9 @@ private:
     size_t                 _docsRanked;
     size_t                 _docsReRanked;
     size_t                 _softDoomed;
+    size_t                 _profiledQueries;
+    size_t                 _profiledIteratorCalls;
+    Avg                    _profiledRankTime;
     Avg                    _doomOvertime;
     using SoftDoomFactor = vespalib::datastore::AtomicValueWrapper<double>;
     SoftDoomFactor         _softDoomFactor;
@@ -167,6 +185,17 @@ public:
 
     vespalib::duration doomOvertime() const { return vespalib::from_s(_doomOvertime.max()); }
 
+    // only tracked for queries sampled for (or explicitly asking for) execution profiling
+    MatchingStats &profiledQueries(size_t value) { _profiledQueries = value; return *this; }
+    size_t profiledQueries() const { return _profiledQueries; }
+    MatchingStats &profiledIteratorCalls(size_t value) { _profiledIteratorCalls = value; return *this; }
+    size_t profiledIteratorCalls() const { return _profiledIteratorCalls; }
+    MatchingStats &profiledRankTime(double time_s) { _profiledRankTime.set(time_s); return *this; }
+    double profiledRankTimeAvg() const { return _profiledRankTime.avg(); }
+    size_t profiledRankTimeCount() const { return _profiledRankTime.count(); }
+    double profiledRankTimeMin() const { return _profiledRankTime.min(); }
+    double profiledRankTimeMax() const { return _profiledRankTime.max(); }
+
     MatchingStats &softDoomFactor(double value) { _softDoomFactor.store_relaxed(value); return *this; }
     double softDoomFactor() const { return _softDoomFactor.load_relaxed(); }
     MatchingStats &updatesoftDoomFactor(vespalib::duration hardLimit, vespalib::duration softLimit, vespalib::duration duration);
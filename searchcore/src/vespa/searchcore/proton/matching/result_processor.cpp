@@ -117,17 +117,14 @@ ResultProcessor::extract_docid_ordering(const PartialResult &result) const
 }
 
 ResultProcessor::Result::UP
-ResultProcessor::makeReply(PartialResultUP full_result)
+ResultProcessor::makeReply(PartialResultUP full_result, vespalib::ThreadBundle &thread_bundle)
 {
     auto reply = std::make_unique<search::engine::SearchReply>();
     search::engine::SearchReply &r = *reply;
     PartialResult &result = *full_result;
     size_t numFs4Hits(0);
     if (_groupingSession) {
-        if (_wasMerged) {
-            _groupingSession->getGroupingManager().prune();
-        }
-        _groupingSession->getGroupingManager().convertToGlobalId(_metaStore);
+        _groupingSession->getGroupingManager().pruneAndConvertToGlobalId(_wasMerged, _metaStore, thread_bundle);
         _groupingSession->continueExecution(_groupingContext);
         numFs4Hits = _groupingContext.countFS4Hits();
         _groupingContext.getResult().swap(r.groupResult);
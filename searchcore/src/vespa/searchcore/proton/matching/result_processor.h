@@ -5,6 +5,8 @@
 #include <vespa/searchlib/common/sortresults.h>
 #include <vespa/vespalib/util/dual_merge_director.h>
 
+namespace vespalib { struct ThreadBundle; }
+
 namespace search {
     namespace engine {
         class SearchReply;
@@ -104,7 +106,7 @@ public:
     void prepareThreadContextCreation(size_t num_threads);
     std::unique_ptr<Context> createThreadContext(const vespalib::Doom & hardDoom, size_t thread_id, uint32_t distributionKey);
     std::vector<std::pair<uint32_t,uint32_t>> extract_docid_ordering(const PartialResult &result) const;
-    std::unique_ptr<Result> makeReply(PartialResultUP full_result);
+    std::unique_ptr<Result> makeReply(PartialResultUP full_result, vespalib::ThreadBundle &thread_bundle);
 };
 
 }
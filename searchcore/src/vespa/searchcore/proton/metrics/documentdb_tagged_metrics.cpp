@@ -152,7 +152,10 @@ DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::RankProfileMetrics
       groupingTime("grouping_time", {}, "Average time (sec) spent on grouping", this),
       rerankTime("rerank_time", {}, "Average time (sec) spent on 2nd phase ranking", this),
       querySetupTime("query_setup_time", {}, "Average time (sec) spent setting up and tearing down queries", this),
-      queryLatency("query_latency", {}, "Total average latency (sec) when matching and ranking a query", this)
+      queryLatency("query_latency", {}, "Total average latency (sec) when matching and ranking a query", this),
+      profiledQueries("profiled_queries", {}, "Number of queries sampled for execution profiling", this),
+      profiledIteratorCalls("profiled_iterator_calls", {}, "Number of search iterator calls (seek, unpack, ...) in profiled queries", this),
+      profiledRankTime("profiled_rank_time", {}, "Average time (sec) spent in rank feature executors for profiled queries", this)
 {
     softDoomFactor.set(MatchingStats::INITIAL_SOFT_DOOM_FACTOR);
     for (size_t i = 0; i < numDocIdPartitions; ++i) {
@@ -168,6 +171,7 @@ DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::DocIdPartition::Do
       docsMatched("docs_matched", {}, "Number of documents matched", this),
       docsRanked("docs_ranked", {}, "Number of documents ranked (first phase)", this),
       docsReRanked("docs_reranked", {}, "Number of documents re-ranked (second phase)", this),
+      docsStolen("docs_stolen", {}, "Size of docid ranges taken over from other match threads", this),
       activeTime("active_time", {}, "Time (sec) spent doing actual work", this),
       waitTime("wait_time", {}, "Time (sec) spent waiting for other external threads and resources", this)
 { }
@@ -180,6 +184,7 @@ DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::DocIdPartition::up
     docsMatched.inc(stats.docsMatched());
     docsRanked.inc(stats.docsRanked());
     docsReRanked.inc(stats.docsReRanked());
+    docsStolen.inc(stats.docsStolen());
     activeTime.addValueBatch(stats.active_time_avg(), stats.active_time_count(),
                              stats.active_time_min(), stats.active_time_max());
     waitTime.addValueBatch(stats.wait_time_avg(), stats.wait_time_count(),
@@ -207,6 +212,10 @@ DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::update(const metri
                                       stats.querySetupTimeMin(), stats.querySetupTimeMax());
     queryLatency.addValueBatch(stats.queryLatencyAvg(), stats.queryLatencyCount(),
                                stats.queryLatencyMin(), stats.queryLatencyMax());
+    profiledQueries.inc(stats.profiledQueries());
+    profiledIteratorCalls.inc(stats.profiledIteratorCalls());
+    profiledRankTime.addValueBatch(stats.profiledRankTimeAvg(), stats.profiledRankTimeCount(),
+                                   stats.profiledRankTimeMin(), stats.profiledRankTimeMax());
     if (stats.getNumPartitions() > 0) {
         for (size_t i = partitions.size(); i < stats.getNumPartitions(); ++i) {
             // This loop is to handle live reconfigs that changes how many partitions(number of threads) might be used per query.
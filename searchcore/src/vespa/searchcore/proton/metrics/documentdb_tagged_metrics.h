@@ -124,6 +124,7 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
                 metrics::LongCountMetric docsMatched;
                 metrics::LongCountMetric docsRanked;
                 metrics::LongCountMetric docsReRanked;
+                metrics::LongCountMetric docsStolen;
                 metrics::DoubleAverageMetric activeTime;
                 metrics::DoubleAverageMetric waitTime;
 
@@ -147,6 +148,9 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
             metrics::DoubleAverageMetric rerankTime;
             metrics::DoubleAverageMetric querySetupTime;
             metrics::DoubleAverageMetric queryLatency;
+            metrics::LongCountMetric     profiledQueries;
+            metrics::LongCountMetric     profiledIteratorCalls;
+            metrics::DoubleAverageMetric profiledRankTime;
             DocIdPartitions              partitions;
 
             RankProfileMetrics(const vespalib::string &name,
@@ -13,7 +13,10 @@ TransLogServerMetrics::DomainMetrics::DomainMetrics(metrics::MetricSet *parent,
             "Transaction log metrics for a document type", parent),
       entries("entries", {}, "The current number of entries in the transaction log", this),
       diskUsage("disk_usage", {}, "The disk usage (in bytes) of the transaction log", this),
-      replayTime("replay_time", {}, "The replay time (in seconds) of the transaction log during start-up", this)
+      replayTime("replay_time", {}, "The replay time (in seconds) of the transaction log during start-up", this),
+      commitLatency("commit_latency", {}, "The latency (in seconds) from a commit is started until it is synced and acked", this),
+      lastCommitCount(0),
+      lastCommitLatencySum(0.0)
 {
 }
 
@@ -25,6 +28,12 @@ TransLogServerMetrics::DomainMetrics::update(const DomainInfo &stats)
     entries.set(stats.numEntries);
     diskUsage.set(stats.byteSize);
     replayTime.set(stats.maxSessionRunTime.count());
+    const auto &latency = stats.commitLatency;
+    if (latency.count > lastCommitCount) {
+        commitLatency.addTotalValueWithCount(latency.sumSeconds - lastCommitLatencySum, latency.count - lastCommitCount);
+    }
+    lastCommitCount = latency.count;
+    lastCommitLatencySum = latency.sumSeconds;
 }
 
 void
@@ -19,6 +19,9 @@ public:
         metrics::LongValueMetric entries;
         metrics::LongValueMetric diskUsage;
         metrics::DoubleValueMetric replayTime;
+        metrics::DoubleValueMetric commitLatency;
+        uint64_t                   lastCommitCount;
+        double                     lastCommitLatencySum;
 
         using UP = std::unique_ptr<DomainMetrics>;
         DomainMetrics(metrics::MetricSet *parent, const vespalib::string &documentType);
@@ -44,6 +44,18 @@ public:
     virtual void handlePut(FeedToken token, const storage::spi::Bucket &bucket,
                            storage::spi::Timestamp timestamp, DocumentSP doc) = 0;
 
+    struct TimestampedPut {
+        FeedToken               token;
+        storage::spi::Timestamp timestamp;
+        DocumentSP              doc;
+    };
+
+    /**
+     * Handle an ordered batch of puts to the same bucket. Each put is
+     * completed through its own feed token.
+     */
+    virtual void handlePuts(const storage::spi::Bucket &bucket, std::vector<TimestampedPut> puts) = 0;
+
     virtual void handleUpdate(FeedToken token, const storage::spi::Bucket &bucket,
                               storage::spi::Timestamp timestamp, DocumentUpdateSP upd) = 0;
 
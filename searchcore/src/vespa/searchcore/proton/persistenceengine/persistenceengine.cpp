@@ -11,6 +11,7 @@
 #include <vespa/document/update/documentupdate.h>
 #include <vespa/document/util/feed_reject_helper.h>
 #include <vespa/document/base/exceptions.h>
+#include <algorithm>
 #include <thread>
 
 #include <vespa/log/log.h>
@@ -374,6 +375,49 @@ PersistenceEngine::putAsync(const Bucket &bucket, Timestamp ts, storage::spi::Do
     handler->handlePut(feedtoken::make(std::move(transportContext)), bucket, ts, std::move(doc));
 }
 
+void
+PersistenceEngine::putBatchAsync(const Bucket &bucket, std::vector<storage::spi::PutEntry> entries)
+{
+    if (!_writeFilter.acceptWriteOperation()) {
+        IResourceWriteFilter::State state = _writeFilter.getAcceptState();
+        if (!state.acceptWriteOperation()) {
+            for (auto& entry : entries) {
+                entry.on_complete->onComplete(std::make_unique<Result>(Result::ErrorType::RESOURCE_EXHAUSTED,
+                        fmt("Put operation rejected for document '%s': '%s'", entry.document->getId().toString().c_str(), state.message().c_str())));
+            }
+            return;
+        }
+    }
+    ReadGuard rguard(_rwMutex);
+    LOG(spam, "putBatchAsync(%s, %zu puts)", bucket.toString().c_str(), entries.size());
+    // Group the puts per handler, keeping their relative order.
+    std::vector<std::pair<IPersistenceHandler *, std::vector<IPersistenceHandler::TimestampedPut>>> batches;
+    for (auto& entry : entries) {
+        if (!entry.document->getId().hasDocType()) {
+            entry.on_complete->onComplete(std::make_unique<Result>(Result::ErrorType::PERMANENT_ERROR,
+                    fmt("Old id scheme not supported in elastic mode (%s)", entry.document->getId().toString().c_str())));
+            continue;
+        }
+        DocTypeName docType(entry.document->getType());
+        IPersistenceHandler * handler = getHandler(rguard, bucket.getBucketSpace(), docType);
+        if (!handler) {
+            entry.on_complete->onComplete(std::make_unique<Result>(Result::ErrorType::PERMANENT_ERROR,
+                    fmt("No handler for document type '%s'", docType.toString().c_str())));
+            continue;
+        }
+        auto itr = std::find_if(batches.begin(), batches.end(), [handler](const auto & batch) { return batch.first == handler; });
+        if (itr == batches.end()) {
+            itr = batches.emplace(batches.end(), handler, std::vector<IPersistenceHandler::TimestampedPut>());
+            itr->second.reserve(entries.size());
+        }
+        auto transportContext = std::make_shared<AsyncTransportContext>(1, std::move(entry.on_complete));
+        itr->second.push_back({feedtoken::make(std::move(transportContext)), entry.timestamp, std::move(entry.document)});
+    }
+    for (auto& [handler, puts] : batches) {
+        handler->handlePuts(bucket, std::move(puts));
+    }
+}
+
 void
 PersistenceEngine::removeAsync(const Bucket& b, std::vector<storage::spi::IdAndTimestamp> ids, OperationComplete::UP onComplete)
 {
@@ -74,19 +74,22 @@ namespace {
 
 index::IndexConfig
 makeIndexConfig(const ProtonConfig::Index & cfg) {
-    return {WarmupConfig(vespalib::from_s(cfg.warmup.time), cfg.warmup.unpack), size_t(cfg.maxflushed), size_t(cfg.cache.size)};
+    return {WarmupConfig(vespalib::from_s(cfg.warmup.time), cfg.warmup.unpack), size_t(cfg.maxflushed), size_t(cfg.cache.size),
+            uint32_t(std::max(1, cfg.fusion.partitions)), size_t(cfg.fusion.partitionmemorylimit),
+            uint32_t(std::max(1, cfg.invert.fieldshards))};
 }
 
 ReplayThrottlingPolicy
 make_replay_throttling_policy(const ProtonConfig::ReplayThrottlingPolicy& cfg) {
+    uint32_t max_pending_packets = std::max(0, cfg.maxPendingPackets);
     if (cfg.type == ProtonConfig::ReplayThrottlingPolicy::Type::UNLIMITED) {
-        return ReplayThrottlingPolicy({});
+        return ReplayThrottlingPolicy({}, max_pending_packets);
     }
     vespalib::SharedOperationThrottler::DynamicThrottleParams params;
     params.min_window_size = cfg.minWindowSize;
     params.max_window_size = cfg.maxWindowSize;
     params.window_size_increment = cfg.windowSizeIncrement;
-    return ReplayThrottlingPolicy(params);
+    return ReplayThrottlingPolicy(params, max_pending_packets);
 }
 
 class MetricsUpdateHook : public metrics::UpdateHook {
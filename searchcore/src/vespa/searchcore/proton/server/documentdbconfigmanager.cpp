@@ -186,6 +186,7 @@ deriveConfig(const ProtonConfig::Summary & summary, const vespalib::HwInfo & hwI
             .setMaxNumLids(log.maxnumlids)
             .setMaxBucketSpread(log.maxbucketspread).setMinFileSizeFactor(log.minfilesizefactor)
             .compactCompression(deriveCompression(log.compact.compression))
+            .setCompactDictionaryMaxBytes(log.compact.dictionary.maxbytes)
             .setFileConfig(fileConfig);
     return {config, logConfig};
 }
@@ -314,6 +314,10 @@ FeedHandler::performEof()
             _replay_end_serial_num, load_relaxed(_serialNum));
         assert(_replay_end_serial_num == load_relaxed(_serialNum));
     }
+    if (_tlsReplayProgress && LOG_WOULD_LOG(event)) {
+        EventLogger::transactionLogReplayThroughput(_tlsMgr.getDomainName(), _tlsReplayProgress->get_entries(),
+                                                    _tlsReplayProgress->get_bytes(), _tlsReplayProgress->get_elapsed());
+    }
     _owner.onTransactionLogReplayDone();
     _tlsMgr.replayDone();
     changeToNormalFeedState();
@@ -475,7 +479,8 @@ FeedHandler::replayTransactionLog(SerialNum flushedIndexMgrSerial, SerialNum flu
     assert(_activeFeedView);
     assert(_bucketDBHandler);
     auto state = make_shared<ReplayTransactionLogState>
-                          (getDocTypeName(), _activeFeedView, *_bucketDBHandler, _replayConfig, config_store, replay_throttling_policy, *this);
+                          (getDocTypeName(), _activeFeedView, *_bucketDBHandler, _replayConfig, config_store, replay_throttling_policy, *this,
+                           &_writeService.shared());
     changeFeedState(state);
     // Resurrected attribute vector might cause oldestFlushedSerial to
     // be lower than _prunedSerialNum, so don't warn for now.
@@ -756,6 +761,18 @@ FeedHandler::handleOperation(FeedToken token, FeedOperation::UP op)
     }));
 }
 
+void
+FeedHandler::handleOperations(std::vector<std::pair<FeedToken, FeedOperation::UP>> ops)
+{
+    // Same blocking semantics as handleOperation(), but the whole batch only costs a single
+    // hop to the master thread.
+    _writeService.blocking_master_execute(makeLambdaTask([this, ops = std::move(ops)]() mutable {
+        for (auto& [token, op] : ops) {
+            doHandleOperation(std::move(token), std::move(op));
+        }
+    }));
+}
+
 IDocumentMoveHandler::MoveResult
 FeedHandler::handleMove(MoveOperation &op, vespalib::IDestructorCallback::SP moveDoneCtx)
 {
@@ -238,6 +238,8 @@ public:
 
     void performOperation(FeedToken token, FeedOperationUP op);
     void handleOperation(FeedToken token, FeedOperationUP op);
+    // Handle an ordered batch of operations as a single task in the master write thread
+    void handleOperations(std::vector<std::pair<FeedToken, FeedOperationUP>> ops);
 
     MoveResult handleMove(MoveOperation &op, std::shared_ptr<vespalib::IDestructorCallback> moveDoneCtx) override;
     void heartBeat() override;
@@ -14,6 +14,8 @@
 #include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/shared_operation_throttler.h>
 #include <cassert>
+#include <condition_variable>
+#include <mutex>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.server.feedstates");
@@ -35,9 +37,10 @@ namespace {
 const search::SerialNum REPLAY_PROGRESS_INTERVAL = 50000;
 
 void
-handleProgress(TlsReplayProgress &progress, SerialNum currentSerial)
+handleProgress(TlsReplayProgress &progress, const Packet::Entry &entry)
 {
-    progress.updateCurrent(currentSerial);
+    progress.updateCurrent(entry.serial());
+    progress.add_replayed(entry.data().size());
     if (LOG_WOULD_LOG(event) && (LOG_WOULD_LOG(debug) ||
             (progress.getCurrent() % REPLAY_PROGRESS_INTERVAL == 0)))
     {
@@ -147,6 +150,84 @@ public:
     }
 };
 
+/*
+ * Copy of a transaction log packet where the entries are deserialized into
+ * feed operations ahead of replay, using the document type repo that was
+ * current when the packet was received. Deserialization stops at the first
+ * config operation, since it might change the document type repo, or at the
+ * first entry that fails to deserialize. Remaining entries are deserialized
+ * when replayed.
+ */
+class DecodedPacket {
+    std::vector<char> _buf;
+    std::shared_ptr<const document::DocumentTypeRepo> _repo;
+    TlsReplayProgress *_progress;
+    std::vector<Packet::Entry> _entries;
+    std::vector<std::unique_ptr<FeedOperation>> _ops;
+    bool _entries_valid;
+    std::atomic<bool> _claimed;
+    vespalib::Gate _decoded;
+
+    void decode() {
+        try {
+            vespalib::nbostream_longlivedbuf handle(_buf.data(), _buf.size());
+            while ( !handle.empty() ) {
+                _entries.emplace_back();
+                _entries.back().deserialize(handle);
+            }
+            _entries_valid = true;
+            _ops.reserve(_entries.size());
+            for (const auto &entry : _entries) {
+                auto op = ReplayPacketDispatcher::deserializeEntry(entry, *_repo);
+                if (!op) {
+                    break;
+                }
+                _ops.push_back(std::move(op));
+            }
+        } catch (const std::exception &) {
+            // Rethrown when the failing entry is deserialized again during replay.
+        }
+    }
+
+public:
+    DecodedPacket(const Packet &packet, std::shared_ptr<const document::DocumentTypeRepo> repo,
+                  TlsReplayProgress *progress)
+        : _buf(packet.getHandle().data(), packet.getHandle().data() + packet.getHandle().size()),
+          _repo(std::move(repo)),
+          _progress(progress),
+          _entries(),
+          _ops(),
+          _entries_valid(false),
+          _claimed(false),
+          _decoded()
+    {}
+    ~DecodedPacket();
+
+    // Called in decode executor thread.
+    void run_decode() {
+        if (!_claimed.exchange(true)) {
+            decode();
+            _decoded.countDown();
+        }
+    }
+    // Called in master executor thread. Decodes the packet if the decode executor has not started on it yet.
+    void ensure_decoded() {
+        if (!_claimed.exchange(true)) {
+            decode();
+        } else {
+            _decoded.await();
+        }
+    }
+    const std::vector<char> &buf() const noexcept { return _buf; }
+    const document::DocumentTypeRepo *repo() const noexcept { return _repo.get(); }
+    TlsReplayProgress *progress() const noexcept { return _progress; }
+    bool entries_valid() const noexcept { return _entries_valid; }
+    const std::vector<Packet::Entry> &entries() const noexcept { return _entries; }
+    const FeedOperation *op(size_t i) const noexcept { return (i < _ops.size()) ? _ops[i].get() : nullptr; }
+};
+
+DecodedPacket::~DecodedPacket() = default;
+
 class PacketDispatcher {
 public:
     PacketDispatcher(IReplayPacketHandler *packet_handler)
@@ -154,41 +235,107 @@ public:
     {}
 
     void handlePacket(PacketWrapper & wrap);
+    void handleDecodedPacket(DecodedPacket &packet);
 private:
-    void handleEntry(const Packet::Entry &entry);
+    void handleEntries(const char *buf, size_t sz, TlsReplayProgress *progress);
+    void handleEntry(const Packet::Entry &entry, const FeedOperation *op);
     IReplayPacketHandler *_packet_handler;
 };
 
 void
 PacketDispatcher::handlePacket(PacketWrapper & wrap)
 {
-    vespalib::nbostream_longlivedbuf handle(wrap.packet.getHandle().data(), wrap.packet.getHandle().size());
+    handleEntries(wrap.packet.getHandle().data(), wrap.packet.getHandle().size(), wrap.progress);
+    wrap.result = RPC::OK;
+    wrap.gate.countDown();
+}
+
+void
+PacketDispatcher::handleDecodedPacket(DecodedPacket &packet)
+{
+    packet.ensure_decoded();
+    if (!packet.entries_valid()) {
+        handleEntries(packet.buf().data(), packet.buf().size(), packet.progress());
+        return;
+    }
+    // Feed operations deserialized with another document type repo are deserialized again
+    bool use_decoded = (packet.repo() == &_packet_handler->getDeserializeRepo());
+    const auto &entries = packet.entries();
+    for (size_t i = 0; i < entries.size(); ++i) {
+        handleEntry(entries[i], use_decoded ? packet.op(i) : nullptr);
+        if (packet.progress() != nullptr) {
+            handleProgress(*packet.progress(), entries[i]);
+        }
+    }
+}
+
+void
+PacketDispatcher::handleEntries(const char *buf, size_t sz, TlsReplayProgress *progress)
+{
+    vespalib::nbostream_longlivedbuf handle(buf, sz);
     while ( !handle.empty() ) {
         Packet::Entry entry;
         entry.deserialize(handle);
-        handleEntry(entry);
-        if (wrap.progress != nullptr) {
-            handleProgress(*wrap.progress, entry.serial());
+        handleEntry(entry, nullptr);
+        if (progress != nullptr) {
+            handleProgress(*progress, entry);
         }
     }
-    wrap.result = RPC::OK;
-    wrap.gate.countDown();
 }
 
 void
-PacketDispatcher::handleEntry(const Packet::Entry &entry) {
+PacketDispatcher::handleEntry(const Packet::Entry &entry, const FeedOperation *op) {
     // Called by handlePacket() in executor thread.
     LOG(spam, "replay packet entry: entrySerial(%" PRIu64 "), entryType(%u)", entry.serial(), entry.type());
 
     auto entry_serial_num = entry.serial();
     _packet_handler->check_serial_num(entry_serial_num);
     ReplayPacketDispatcher dispatcher(*_packet_handler);
-    dispatcher.replayEntry(entry);
+    if (op != nullptr) {
+        dispatcher.replayOperation(*op);
+    } else {
+        dispatcher.replayEntry(entry);
+    }
     _packet_handler->optionalCommit(entry_serial_num);
 }
 
 }  // namespace
 
+/*
+ * Limits the number of packets received but not yet replayed, and tracks the
+ * document type repo to use when deserializing the next received packet.
+ */
+class ReplayTransactionLogState::PendingPackets {
+    std::mutex _lock;
+    std::condition_variable _cond;
+    uint32_t _pending;
+    const uint32_t _max_pending;
+    std::shared_ptr<const document::DocumentTypeRepo> _repo;
+
+public:
+    PendingPackets(uint32_t max_pending, std::shared_ptr<const document::DocumentTypeRepo> repo)
+        : _lock(),
+          _cond(),
+          _pending(0),
+          _max_pending(max_pending),
+          _repo(std::move(repo))
+    {}
+    // Called by receive() in the transaction log visitor thread.
+    std::shared_ptr<const document::DocumentTypeRepo> acquire() {
+        std::unique_lock guard(_lock);
+        _cond.wait(guard, [this]() { return _pending < _max_pending; });
+        ++_pending;
+        return _repo;
+    }
+    // Called in master executor thread after a packet has been replayed.
+    void release(std::shared_ptr<const document::DocumentTypeRepo> repo) {
+        std::lock_guard guard(_lock);
+        --_pending;
+        _repo = std::move(repo);
+        _cond.notify_all();
+    }
+};
+
 ReplayTransactionLogState::ReplayTransactionLogState(
         const vespalib::string &name,
         IFeedView *& feed_view_ptr,
@@ -196,20 +343,47 @@ ReplayTransactionLogState::ReplayTransactionLogState(
         IReplayConfig &replay_config,
         FeedConfigStore &config_store,
         const ReplayThrottlingPolicy &replay_throttling_policy,
-        IIncSerialNum& inc_serial_num)
+        IIncSerialNum& inc_serial_num,
+        Executor *decode_executor)
     : FeedState(REPLAY_TRANSACTION_LOG),
       _doc_type_name(name),
-      _packet_handler(std::make_unique<TransactionLogReplayPacketHandler>(feed_view_ptr, bucketDBHandler, replay_config, config_store, replay_throttling_policy, inc_serial_num))
-{ }
+      _feed_view_ptr(feed_view_ptr),
+      _packet_handler(std::make_unique<TransactionLogReplayPacketHandler>(feed_view_ptr, bucketDBHandler, replay_config, config_store, replay_throttling_policy, inc_serial_num)),
+      _decode_executor(decode_executor),
+      _pending_packets()
+{
+    uint32_t max_pending_packets = replay_throttling_policy.get_max_pending_packets();
+    if (_decode_executor != nullptr && max_pending_packets > 0) {
+        _pending_packets = std::make_unique<PendingPackets>(max_pending_packets, feed_view_ptr->getDocumentTypeRepo());
+    }
+}
 
 ReplayTransactionLogState::~ReplayTransactionLogState() = default;
 
 void
 ReplayTransactionLogState::receive(const PacketWrapper::SP &wrap, Executor &executor) {
-    executor.execute(makeLambdaTask([this, wrap = wrap] () {
+    if (!_pending_packets) {
+        executor.execute(makeLambdaTask([this, wrap = wrap] () {
+            PacketDispatcher dispatcher(_packet_handler.get());
+            dispatcher.handlePacket(*wrap);
+        }));
+        return;
+    }
+    /*
+     * Deserialize the packet in the decode executor while the previous packets
+     * are replayed. The feed operations are still replayed in serial order by
+     * the master executor, which deserializes the packet itself if the decode
+     * executor has not started on it yet.
+     */
+    auto packet = std::make_shared<DecodedPacket>(wrap->packet, _pending_packets->acquire(), wrap->progress);
+    _decode_executor->execute(makeLambdaTask([packet] () { packet->run_decode(); }));
+    executor.execute(makeLambdaTask([this, packet = std::move(packet)] () {
         PacketDispatcher dispatcher(_packet_handler.get());
-        dispatcher.handlePacket(*wrap);
+        dispatcher.handleDecodedPacket(*packet);
+        _pending_packets->release(_feed_view_ptr->getDocumentTypeRepo());
     }));
+    wrap->result = RPC::OK;
+    wrap->gate.countDown();
 }
 
 }  // namespace proton
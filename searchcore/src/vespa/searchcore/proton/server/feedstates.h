@@ -46,17 +46,26 @@ public:
  * Replayed messages from the transaction log are sent to the active feed view.
  */
 class ReplayTransactionLogState : public FeedState {
+    class PendingPackets;
     vespalib::string _doc_type_name;
+    IFeedView *& _feed_view_ptr;  // Pointer can be changed in executor thread.
     std::unique_ptr<IReplayPacketHandler> _packet_handler;
+    vespalib::Executor *_decode_executor;
+    std::unique_ptr<PendingPackets> _pending_packets;
 
 public:
+    /*
+     * If decode_executor is set (and the policy allows pending packets), packets are
+     * deserialized by the decode executor ahead of being replayed by the master executor.
+     */
     ReplayTransactionLogState(const vespalib::string &name,
             IFeedView *& feed_view_ptr,
             bucketdb::IBucketDBHandler &bucketDBHandler,
             IReplayConfig &replay_config,
             FeedConfigStore &config_store,
             const ReplayThrottlingPolicy &replay_throttling_policy,
-            IIncSerialNum &inc_serial_num);
+            IIncSerialNum &inc_serial_num,
+            vespalib::Executor *decode_executor);
 
     ~ReplayTransactionLogState() override;
     void handleOperation(FeedToken, FeedOperationUP op) override {
@@ -40,6 +40,18 @@ PersistenceHandlerProxy::handlePut(FeedToken token, const Bucket &bucket, Timest
     _feedHandler.handleOperation(std::move(token), std::move(op));
 }
 
+void
+PersistenceHandlerProxy::handlePuts(const Bucket &bucket, std::vector<TimestampedPut> puts)
+{
+    document::BucketId bucketId = bucket.getBucketId().stripUnused();
+    std::vector<std::pair<FeedToken, FeedOperation::UP>> ops;
+    ops.reserve(puts.size());
+    for (auto& put : puts) {
+        ops.emplace_back(std::move(put.token), std::make_unique<PutOperation>(bucketId, put.timestamp, std::move(put.doc)));
+    }
+    _feedHandler.handleOperations(std::move(ops));
+}
+
 void
 PersistenceHandlerProxy::handleUpdate(FeedToken token, const Bucket &bucket, Timestamp timestamp, DocumentUpdateSP upd)
 {
@@ -29,6 +29,8 @@ public:
     void handlePut(FeedToken token, const storage::spi::Bucket &bucket,
                    storage::spi::Timestamp timestamp, DocumentSP doc) override;
 
+    void handlePuts(const storage::spi::Bucket &bucket, std::vector<TimestampedPut> puts) override;
+
     void handleUpdate(FeedToken token, const storage::spi::Bucket &bucket,
                       storage::spi::Timestamp timestamp, DocumentUpdateSP upd) override;
 
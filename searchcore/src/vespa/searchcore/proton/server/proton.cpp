@@ -47,6 +47,7 @@
 #include <vespa/vespalib/util/host_name.h>
 #include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/mmap_file_allocator_factory.h>
+#include <vespa/vespalib/util/numa.h>
 #include <vespa/vespalib/util/random.h>
 #include <vespa/vespalib/util/sequencedtaskexecutor.h>
 #include <vespa/vespalib/util/size_literals.h>
@@ -122,6 +123,21 @@ diskMemUsageSamplerConfig(const ProtonConfig &proton, const vespalib::HwInfo &hw
              hwInfo };
 }
 
+std::shared_ptr<const vespalib::NumaNodes>
+detectNumaNodes(const ProtonConfig &proton)
+{
+    if (!proton.numa.enabled) {
+        return {};
+    }
+    auto nodes = std::make_shared<const vespalib::NumaNodes>(vespalib::NumaNodes::detect());
+    if (nodes->size() < 2) {
+        LOG(info, "NUMA placement enabled, but %zu NUMA nodes detected. Threads will not be bound.", nodes->size());
+        return {};
+    }
+    LOG(info, "Binding search, summary and feed threads to %zu NUMA nodes", nodes->size());
+    return nodes;
+}
+
 uint32_t
 computeRpcTransportThreads(const ProtonConfig & cfg, const vespalib::HwInfo::Cpu &cpuInfo) {
     bool areSearchAndDocsumAsync = cfg.docsum.async && cfg.search.async;
@@ -302,13 +318,15 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
     _tls = std::make_unique<TLS>(_configUri.createWithNewId(protonConfig.tlsconfigid), _fileHeaderContext);
     _metricsEngine->addMetricsHook(*_metricsHook);
     _fileHeaderContext.setClusterName(protonConfig.clustername, protonConfig.basedir);
+    auto numaNodes = detectNumaNodes(protonConfig);
     _matchEngine = std::make_unique<MatchEngine>(protonConfig.numsearcherthreads,
                                                  getNumThreadsPerSearch(),
                                                  protonConfig.distributionkey,
-                                                 protonConfig.search.async);
+                                                 protonConfig.search.async,
+                                                 numaNodes);
     _matchEngine->set_issue_forwarding(protonConfig.forwardIssues);
     _distributionKey = protonConfig.distributionkey;
-    _summaryEngine = std::make_unique<SummaryEngine>(protonConfig.numsummarythreads, protonConfig.docsum.async);
+    _summaryEngine = std::make_unique<SummaryEngine>(protonConfig.numsummarythreads, protonConfig.docsum.async, numaNodes);
     _summaryEngine->set_issue_forwarding(protonConfig.forwardIssues);
     _sessionManager = std::make_unique<matching::SessionManager>(protonConfig.grouping.sessionmanager.maxentries);
 
@@ -343,13 +361,21 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
                                                              _diskMemUsageSampler->notifier(),
                                                              protonConfig.visit.defaultserializedsize,
                                                              protonConfig.visit.ignoremaxbytes);
-    _shared_service = std::make_unique<SharedThreadingService>(
-            SharedThreadingServiceConfig::make(protonConfig, hwInfo.cpu()), _transport, *_persistenceEngine);
+    auto sharedThreadingServiceConfig = SharedThreadingServiceConfig::make(protonConfig, hwInfo.cpu());
+    sharedThreadingServiceConfig.set_numa_nodes(numaNodes);
+    _shared_service = std::make_unique<SharedThreadingService>(sharedThreadingServiceConfig, _transport, *_persistenceEngine);
     _scheduler = std::make_unique<ScheduledForwardExecutor>(_transport, _shared_service->shared());
     _diskMemUsageSampler->setConfig(diskMemUsageSamplerConfig(protonConfig, hwInfo), *_scheduler);
 
     vespalib::string fileConfigId;
     _compile_cache_executor_binding = vespalib::eval::CompileCache::bind(_shared_service->shared_raw());
+    if (protonConfig.compilecache.persistent) {
+        auto dir = protonConfig.basedir + "/compile-cache";
+        LOG(info, "Using persistent compile cache in %s", dir.c_str());
+        vespalib::eval::CompileCache::set_persistent_cache(
+                std::make_shared<vespalib::eval::PersistentObjectCache>(dir, protonConfig.compilecache.maxsize,
+                                                                        vespalib::from_s(protonConfig.compilecache.maxage)));
+    }
 
     InitializeThreadsCalculator calc(hwInfo.cpu(), protonConfig.basedir, protonConfig.initialize.threads);
     LOG(info, "Start initializing components: threads=%u, configured=%u",
@@ -504,6 +530,7 @@ Proton::~Proton()
     _persistenceEngine.reset();
     _tls.reset();
     _compile_cache_executor_binding.reset();
+    vespalib::eval::CompileCache::set_persistent_cache({});
     _shared_service.reset();
     LOG(debug, "Explicit destructor done");
 }
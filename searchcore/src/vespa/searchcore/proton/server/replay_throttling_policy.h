@@ -10,18 +10,24 @@ namespace proton {
 /*
  * Policy for transaction log replay throttling. If params are set then a dynamic throttler
  * is used, otherwise an unlimited throttler is used.
+ *
+ * max_pending_packets limits the number of packets deserialized ahead of replay.
+ * If 0 then each packet is deserialized when replayed.
  */
 class ReplayThrottlingPolicy
 {
     using DynamicThrottleParams = vespalib::SharedOperationThrottler::DynamicThrottleParams;
     std::optional<DynamicThrottleParams> _params;
+    uint32_t _max_pending_packets;
 
 public:
-    explicit ReplayThrottlingPolicy(std::optional<DynamicThrottleParams> params)
-        : _params(std::move(params))
+    explicit ReplayThrottlingPolicy(std::optional<DynamicThrottleParams> params, uint32_t max_pending_packets = 0)
+        : _params(std::move(params)),
+          _max_pending_packets(max_pending_packets)
     {
     }
     const std::optional<DynamicThrottleParams>& get_params() const noexcept {  return _params; }
+    uint32_t get_max_pending_packets() const noexcept { return _max_pending_packets; }
 };
 
 }
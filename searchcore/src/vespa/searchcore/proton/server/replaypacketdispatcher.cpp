@@ -9,12 +9,58 @@ using vespalib::IllegalStateException;
 
 namespace proton {
 
+namespace {
+
+std::unique_ptr<FeedOperation>
+make_operation(const search::transactionlog::Packet::Entry &entry)
+{
+    switch (entry.type()) {
+    case FeedOperation::PUT:
+        return std::make_unique<PutOperation>();
+    case FeedOperation::REMOVE:
+        return std::make_unique<RemoveOperationWithDocId>();
+    case FeedOperation::REMOVE_GID:
+        return std::make_unique<RemoveOperationWithGid>();
+    case FeedOperation::UPDATE:
+        return std::make_unique<UpdateOperation>(static_cast<FeedOperation::Type>(entry.type()));
+    case FeedOperation::NOOP:
+        return std::make_unique<NoopOperation>();
+    case FeedOperation::DELETE_BUCKET:
+        return std::make_unique<DeleteBucketOperation>();
+    case FeedOperation::SPLIT_BUCKET:
+        return std::make_unique<SplitBucketOperation>();
+    case FeedOperation::JOIN_BUCKETS:
+        return std::make_unique<JoinBucketsOperation>();
+    case FeedOperation::PRUNE_REMOVED_DOCUMENTS:
+        return std::make_unique<PruneRemovedDocumentsOperation>();
+    case FeedOperation::MOVE:
+        return std::make_unique<MoveOperation>();
+    case FeedOperation::CREATE_BUCKET:
+        return std::make_unique<CreateBucketOperation>();
+    case FeedOperation::COMPACT_LID_SPACE:
+        return std::make_unique<CompactLidSpaceOperation>();
+    default:
+        throw IllegalStateException
+            (make_string("Got packet entry with unknown type id '%u' from TLS", entry.type()));
+    }
+}
+
+void
+check_fully_consumed(const vespalib::nbostream &is, const search::transactionlog::Packet::Entry &entry)
+{
+    if ( ! is.empty()) {
+        throw document::DeserializeException
+            (make_string("Too much data in packet entry (type id '%u', %ld bytes)",
+                         entry.type(), is.size()));
+    }
+}
+
+}
+
 template <typename OperationType>
 void
-ReplayPacketDispatcher::replay(OperationType &op, vespalib::nbostream &is, const Packet::Entry &entry)
+ReplayPacketDispatcher::replay(const OperationType &op)
 {
-    op.deserialize(is, _handler.getDeserializeRepo());
-    op.setSerialNum(entry.serial());
     store(op);
     _handler.replay(op);
 }
@@ -29,70 +75,76 @@ ReplayPacketDispatcher::ReplayPacketDispatcher(IReplayPacketHandler &handler)
 void
 ReplayPacketDispatcher::replayEntry(const Packet::Entry &entry)
 {
-    vespalib::nbostream is(entry.data().c_str(), entry.data().size());
-    switch (entry.type()) {
-    case FeedOperation::PUT: {
-        PutOperation op;
-        replay(op, is, entry);
-        break;
-    } case FeedOperation::REMOVE: {
-        RemoveOperationWithDocId op;
-        replay(op, is, entry);
-        break;
-    } case FeedOperation::REMOVE_GID: {
-        RemoveOperationWithGid op;
-        replay(op, is, entry);
-        break;
-    } case FeedOperation::UPDATE: {
-        UpdateOperation op(static_cast<FeedOperation::Type>(entry.type()));
-        replay(op, is, entry);
-        break;
-    } case FeedOperation::NOOP: {
-        NoopOperation op;
-        replay(op, is, entry);
-        break;
-    } case FeedOperation::NEW_CONFIG: {
+    if (entry.type() == FeedOperation::NEW_CONFIG) {
+        vespalib::nbostream is(entry.data().c_str(), entry.data().size());
         NewConfigOperation op(entry.serial(), _handler.getNewConfigStreamHandler());
         op.deserialize(is, _handler.getDeserializeRepo());
+        check_fully_consumed(is, entry);
         _handler.replay(op);
+        return;
+    }
+    auto op = deserializeEntry(entry, _handler.getDeserializeRepo());
+    replayOperation(*op);
+}
+
+
+void
+ReplayPacketDispatcher::replayOperation(const FeedOperation &op)
+{
+    switch (op.getType()) {
+    case FeedOperation::PUT:
+        replay(static_cast<const PutOperation &>(op));
+        break;
+    case FeedOperation::REMOVE:
+    case FeedOperation::REMOVE_GID:
+        replay(static_cast<const RemoveOperation &>(op));
+        break;
+    case FeedOperation::UPDATE:
+        replay(static_cast<const UpdateOperation &>(op));
         break;
-    } case FeedOperation::DELETE_BUCKET: {
-        DeleteBucketOperation op;
-        replay(op, is, entry);
+    case FeedOperation::NOOP:
+        replay(static_cast<const NoopOperation &>(op));
         break;
-    } case FeedOperation::SPLIT_BUCKET: {
-        SplitBucketOperation op;
-        replay(op, is, entry);
+    case FeedOperation::DELETE_BUCKET:
+        replay(static_cast<const DeleteBucketOperation &>(op));
         break;
-    } case FeedOperation::JOIN_BUCKETS: {
-        JoinBucketsOperation op;
-        replay(op, is, entry);
+    case FeedOperation::SPLIT_BUCKET:
+        replay(static_cast<const SplitBucketOperation &>(op));
         break;
-    } case FeedOperation::PRUNE_REMOVED_DOCUMENTS: {
-        PruneRemovedDocumentsOperation op;
-        replay(op, is, entry);
+    case FeedOperation::JOIN_BUCKETS:
+        replay(static_cast<const JoinBucketsOperation &>(op));
         break;
-    } case FeedOperation::MOVE: {
-        MoveOperation op;
-        replay(op, is, entry);
+    case FeedOperation::PRUNE_REMOVED_DOCUMENTS:
+        replay(static_cast<const PruneRemovedDocumentsOperation &>(op));
         break;
-    } case FeedOperation::CREATE_BUCKET: {
-        CreateBucketOperation op;
-        replay(op, is, entry);
+    case FeedOperation::MOVE:
+        replay(static_cast<const MoveOperation &>(op));
         break;
-    } case FeedOperation::COMPACT_LID_SPACE: {
-        CompactLidSpaceOperation op;
-        replay(op, is, entry);
+    case FeedOperation::CREATE_BUCKET:
+        replay(static_cast<const CreateBucketOperation &>(op));
         break;
-    } default:
+    case FeedOperation::COMPACT_LID_SPACE:
+        replay(static_cast<const CompactLidSpaceOperation &>(op));
+        break;
+    default:
         throw IllegalStateException
-            (make_string("Got packet entry with unknown type id '%u' from TLS", entry.type()));
+            (make_string("Cannot replay feed operation with type id '%u'", op.getType()));
     }
-    if ( ! is.empty()) {
-        throw document::DeserializeException
-            (make_string("Too much data in packet entry (type id '%u', %ld bytes)",
-                         entry.type(), is.size()));
+}
+
+
+std::unique_ptr<FeedOperation>
+ReplayPacketDispatcher::deserializeEntry(const Packet::Entry &entry, const document::DocumentTypeRepo &repo)
+{
+    if (entry.type() == FeedOperation::NEW_CONFIG) {
+        return {};
     }
+    vespalib::nbostream is(entry.data().c_str(), entry.data().size());
+    auto op = make_operation(entry);
+    op->deserialize(is, repo);
+    op->setSerialNum(entry.serial());
+    check_fully_consumed(is, entry);
+    return op;
 }
 
 
@@ -4,6 +4,7 @@
 
 #include "ireplaypackethandler.h"
 #include <vespa/searchlib/transactionlog/common.h>
+#include <memory>
 
 namespace proton {
 
@@ -20,7 +21,7 @@ private:
     IReplayPacketHandler &_handler;
 
     template <typename OperationType>
-    void replay(OperationType &op, vespalib::nbostream &is, const Packet::Entry &entry);
+    void replay(const OperationType &op);
 
 protected:
     virtual void store(const FeedOperation &op);
@@ -30,6 +31,20 @@ public:
     virtual ~ReplayPacketDispatcher();
 
     void replayEntry(const Packet::Entry &entry);
+
+    /**
+     * Dispatches a feed operation previously deserialized by deserializeEntry().
+     */
+    void replayOperation(const FeedOperation &op);
+
+    /**
+     * Deserializes a packet entry into a feed operation without dispatching it,
+     * allowing entries to be deserialized ahead of replay in other threads.
+     * Returns nullptr for config operations, which have side effects when
+     * deserialized and must be handled by replayEntry() in serial order.
+     */
+    static std::unique_ptr<FeedOperation>
+    deserializeEntry(const Packet::Entry &entry, const document::DocumentTypeRepo &repo);
 };
 
 } // namespace proton
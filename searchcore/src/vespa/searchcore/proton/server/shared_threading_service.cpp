@@ -6,6 +6,7 @@
 #include <vespa/vespalib/util/sequencedtaskexecutor.h>
 #include <vespa/vespalib/util/invokeserviceimpl.h>
 #include <vespa/vespalib/util/nice.h>
+#include <vespa/vespalib/util/numa.h>
 
 using vespalib::CpuUsage;
 using vespalib::steady_time;
@@ -21,7 +22,9 @@ SharedThreadingService::SharedThreadingService(const SharedThreadingServiceConfi
                                                storage::spi::BucketExecutor& bucket_executor)
     : _transport(transport),
       _shared(std::make_shared<vespalib::BlockingThreadStackExecutor>(cfg.shared_threads(),
-                                                                      cfg.shared_task_limit(), vespalib::be_nice(proton_shared_executor, cfg.feeding_niceness()))),
+                                                                      cfg.shared_task_limit(),
+                                                                      vespalib::bind_to_numa_nodes(vespalib::be_nice(proton_shared_executor, cfg.feeding_niceness()),
+                                                                                                   cfg.numa_nodes()))),
       _field_writer(),
       _invokeService(std::make_unique<vespalib::InvokeServiceImpl>(std::max(vespalib::adjustTimeoutByDetectedHz(1ms),
                                                                             cfg.field_writer_config().reactionTime()))),
@@ -29,7 +32,8 @@ SharedThreadingService::SharedThreadingService(const SharedThreadingServiceConfi
       _bucket_executor(bucket_executor)
 {
     const auto& fw_cfg = cfg.field_writer_config();
-    _field_writer = vespalib::SequencedTaskExecutor::create(vespalib::be_nice(CpuUsage::wrap(proton_field_writer_executor, CpuUsage::Category::WRITE), cfg.feeding_niceness()),
+    _field_writer = vespalib::SequencedTaskExecutor::create(vespalib::bind_to_numa_nodes(vespalib::be_nice(CpuUsage::wrap(proton_field_writer_executor, CpuUsage::Category::WRITE), cfg.feeding_niceness()),
+                                                                                         cfg.numa_nodes()),
                                                             cfg.field_writer_threads(),
                                                             fw_cfg.defaultTaskLimit(),
                                                             fw_cfg.is_task_limit_hard(),
@@ -17,7 +17,8 @@ SharedThreadingServiceConfig::SharedThreadingServiceConfig(uint32_t shared_threa
       _shared_task_limit(shared_task_limit_in),
       _field_writer_threads(field_writer_threads_in),
       _feeding_niceness(feeding_niceness_in),
-      _field_writer_config(field_writer_config_in)
+      _field_writer_config(field_writer_config_in),
+      _numa_nodes()
 {
 }
 
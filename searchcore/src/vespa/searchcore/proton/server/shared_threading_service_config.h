@@ -3,8 +3,10 @@
 
 #include "threading_service_config.h"
 #include <vespa/vespalib/util/hw_info.h>
+#include <memory>
 
 namespace vespa::config::search::core::internal { class InternalProtonType; }
+namespace vespalib { class NumaNodes; }
 
 namespace proton {
 
@@ -21,6 +23,7 @@ private:
     uint32_t _field_writer_threads;
     double   _feeding_niceness;
     ThreadingServiceConfig _field_writer_config;
+    std::shared_ptr<const vespalib::NumaNodes> _numa_nodes;
 
 public:
     SharedThreadingServiceConfig(uint32_t shared_threads_in,
@@ -36,6 +39,8 @@ public:
     uint32_t field_writer_threads() const { return _field_writer_threads; }
     double feeding_niceness() const { return _feeding_niceness; }
     const ThreadingServiceConfig& field_writer_config() const { return _field_writer_config; }
+    const std::shared_ptr<const vespalib::NumaNodes>& numa_nodes() const { return _numa_nodes; }
+    void set_numa_nodes(std::shared_ptr<const vespalib::NumaNodes> numa_nodes) { _numa_nodes = std::move(numa_nodes); }
 };
 
 }
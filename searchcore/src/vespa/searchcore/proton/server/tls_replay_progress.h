@@ -4,6 +4,7 @@
 
 #include <vespa/searchlib/common/serialnum.h>
 #include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/util/time.h>
 #include <atomic>
 #include <memory>
 
@@ -16,6 +17,9 @@ private:
     const search::SerialNum _first;
     const search::SerialNum _last;
     std::atomic<search::SerialNum> _current;
+    std::atomic<uint64_t>   _entries;
+    std::atomic<uint64_t>   _bytes;
+    const vespalib::Timer   _timer;
 
 public:
     using UP = std::unique_ptr<TlsReplayProgress>;
@@ -26,7 +30,10 @@ public:
         : _domainName(domainName),
           _first(first),
           _last(last),
-          _current(first)
+          _current(first),
+          _entries(0),
+          _bytes(0),
+          _timer()
     {
     }
     const vespalib::string &getDomainName() const noexcept { return _domainName; }
@@ -41,6 +48,13 @@ public:
         }
     }
     void updateCurrent(search::SerialNum current) noexcept { _current.store(current, std::memory_order_relaxed); }
+    void add_replayed(size_t bytes) noexcept {
+        _entries.store(get_entries() + 1, std::memory_order_relaxed);
+        _bytes.store(get_bytes() + bytes, std::memory_order_relaxed);
+    }
+    uint64_t get_entries() const noexcept { return _entries.load(std::memory_order_relaxed); }
+    uint64_t get_bytes() const noexcept { return _bytes.load(std::memory_order_relaxed); }
+    vespalib::duration get_elapsed() const noexcept { return _timer.elapsed(); }
 };
 
 } // namespace proton
@@ -3,6 +3,7 @@
 #include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/vespalib/util/size_literals.h>
 #include <vespa/vespalib/util/cpu_usage.h>
+#include <vespa/vespalib/util/numa.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.summaryengine.summaryengine");
@@ -57,13 +58,14 @@ SummaryEngine::DocsumMetrics::DocsumMetrics()
 
 SummaryEngine::DocsumMetrics::~DocsumMetrics() = default;
 
-SummaryEngine::SummaryEngine(size_t numThreads, bool async)
+SummaryEngine::SummaryEngine(size_t numThreads, bool async, std::shared_ptr<const vespalib::NumaNodes> numaNodes)
     : _lock(),
       _async(async),
       _closed(false),
       _forward_issues(true),
       _handlers(),
-      _executor(numThreads, CpuUsage::wrap(summary_engine_executor, CpuUsage::Category::READ)),
+      _executor(numThreads, vespalib::bind_to_numa_nodes(CpuUsage::wrap(summary_engine_executor, CpuUsage::Category::READ),
+                                                         std::move(numaNodes))),
       _metrics(std::make_unique<DocsumMetrics>())
 { }
 
@@ -11,6 +11,7 @@
 #include <vespa/metrics/metricset.h>
 #include <mutex>
 
+namespace vespalib { class NumaNodes; }
 
 namespace proton {
 
@@ -50,8 +51,12 @@ public:
      * using the putSearchHandler() method.
      *
      * @param numThreads Number of threads allocated for handling summary requests.
+     * @param numaNodes if given, the threads are bound to the NUMA nodes round robin.
      */
-    SummaryEngine(size_t numThreads, bool async);
+    SummaryEngine(size_t numThreads, bool async, std::shared_ptr<const vespalib::NumaNodes> numaNodes);
+    SummaryEngine(size_t numThreads, bool async)
+        : SummaryEngine(numThreads, async, {})
+    { }
     SummaryEngine(size_t numThreads)
         : SummaryEngine(numThreads, true)
     { }
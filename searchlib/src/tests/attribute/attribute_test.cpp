@@ -18,6 +18,7 @@
 #include <vespa/document/update/assignvalueupdate.h>
 #include <vespa/document/update/mapvalueupdate.h>
 #include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/util/huge_page_allocator.h>
 #include <vespa/vespalib/util/mmap_file_allocator.h>
 #include <vespa/vespalib/util/mmap_file_allocator_factory.h>
 #include <vespa/vespalib/util/round_up_to_page_size.h>
@@ -290,6 +291,7 @@ protected:
 
     int test_paged_attribute(const vespalib::string& name, const vespalib::string& swapfile, const search::attribute::Config& cfg);
     void test_paged_attributes();
+    void test_huge_page_attribute();
 
 public:
     AttributeTest();
@@ -2407,6 +2409,24 @@ AttributeTest::test_paged_attributes()
     fs::remove_all(fs::path(basedir));
 }
 
+void
+AttributeTest::test_huge_page_attribute()
+{
+    using vespalib::alloc::MemoryAllocator;
+    search::attribute::Config cfg(BasicType::INT32, CollectionType::SINGLE);
+    cfg.set_huge_pages(true);
+    auto av = createAttribute("int-sv-huge-pages", cfg);
+    auto allocator = av->get_huge_page_allocator();
+    ASSERT_TRUE(allocator != nullptr);
+    auto stats = allocator->get_stats();
+    EXPECT_EQ(0u, stats.huge_page_bytes + stats.fallback_bytes);
+    // Grow mapping from lid to value beyond a huge page
+    addClearedDocs(av, MemoryAllocator::HUGEPAGE_SIZE / sizeof(int32_t));
+    stats = allocator->get_stats();
+    EXPECT_LE(MemoryAllocator::HUGEPAGE_SIZE, stats.huge_page_bytes + stats.fallback_bytes);
+    EXPECT_TRUE(createAttribute("int-sv", Config(BasicType::INT32, CollectionType::SINGLE))->get_huge_page_allocator() == nullptr);
+}
+
 void testNamePrefix() {
     Config cfg(BasicType::INT32, CollectionType::SINGLE);
     AttributeVector::SP vFlat = createAttribute("sfsint32_pc", cfg);
@@ -2559,6 +2579,11 @@ TEST_F(AttributeTest, paged_attributes)
     test_paged_attributes();
 }
 
+TEST_F(AttributeTest, huge_page_attribute)
+{
+    test_huge_page_attribute();
+}
+
 }
 
 void
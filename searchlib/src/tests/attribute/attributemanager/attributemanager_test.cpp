@@ -251,6 +251,12 @@ TEST("require that config can be converted")
         a.paged = true;
         EXPECT_TRUE(CC::convert(a).paged());
     }
+    {
+        CACA a;
+        EXPECT_TRUE(!CC::convert(a).huge_pages());
+        a.hugepages = true;
+        EXPECT_TRUE(CC::convert(a).huge_pages());
+    }
     { // tensor
         CACA a;
         a.datatype = CACAD::TENSOR;
@@ -6,6 +6,7 @@
 #include <vespa/searchlib/attribute/singlestringpostattribute.h>
 #include <vespa/searchlib/attribute/multistringattribute.h>
 #include <vespa/searchlib/attribute/multistringpostattribute.h>
+#include <vespa/vespalib/util/stringfmt.h>
 
 #include <vespa/searchlib/attribute/enumstore.hpp>
 #include <vespa/searchlib/attribute/single_string_enum_search_context.h>
@@ -410,6 +411,96 @@ TEST("testSingleValue")
     }
 }
 
+template <typename Attribute>
+void
+testPreparedUpdate(Attribute & attr)
+{
+    attr.addReservedDoc();
+    AttributeVector::DocId docId;
+    EXPECT_TRUE(attr.addDoc(docId));
+    EXPECT_TRUE(attr.addDoc(docId));
+    attr.update(1, "foo");
+    attr.commit();
+
+    // Value not in dictionary
+    auto missed = attr.prepare_update(2, "bar");
+    ASSERT_TRUE(missed.get() != nullptr);
+    EXPECT_FALSE(static_cast<const SingleValueStringPrepareResult &>(*missed).idx().valid());
+    EXPECT_TRUE(attr.complete_update(2, "bar", std::move(missed)));
+    attr.commit();
+    EXPECT_EQUAL(vespalib::string("bar"), vespalib::string(attr.get(2)));
+
+    // Value in dictionary
+    auto prepared = attr.prepare_update(2, "foo");
+    ASSERT_TRUE(prepared.get() != nullptr);
+    auto idx = static_cast<const SingleValueStringPrepareResult &>(*prepared).idx();
+    EXPECT_TRUE(attr.getEnumStore().is_live_index(idx, "foo"));
+    EXPECT_FALSE(attr.getEnumStore().is_live_index(idx, "bar"));
+    EXPECT_TRUE(attr.complete_update(2, "foo", std::move(prepared)));
+    attr.commit();
+    EXPECT_EQUAL(vespalib::string("foo"), vespalib::string(attr.get(2)));
+    EXPECT_EQUAL(attr.getEnum(1), attr.getEnum(2));
+
+    // Value removed from dictionary after prepare
+    prepared = attr.prepare_update(1, "foo");
+    ASSERT_TRUE(prepared.get() != nullptr);
+    idx = static_cast<const SingleValueStringPrepareResult &>(*prepared).idx();
+    attr.update(1, "baz");
+    attr.update(2, "baz");
+    attr.commit();
+    EXPECT_FALSE(attr.getEnumStore().is_live_index(idx, "foo"));
+    EXPECT_TRUE(attr.complete_update(1, "foo", std::move(prepared)));
+    attr.commit();
+    EXPECT_EQUAL(vespalib::string("foo"), vespalib::string(attr.get(1)));
+    EXPECT_EQUAL(vespalib::string("baz"), vespalib::string(attr.get(2)));
+}
+
+TEST("testPreparedUpdate")
+{
+    {
+        Config cfg(BasicType::STRING, CollectionType::SINGLE);
+        SingleValueStringAttribute svsa("svsa", cfg);
+        testPreparedUpdate(svsa);
+    }
+    {
+        Config cfg(BasicType::STRING, CollectionType::SINGLE);
+        cfg.setFastSearch(true);
+        SingleValueStringPostingAttribute svsa("svspa", cfg);
+        testPreparedUpdate(svsa);
+    }
+}
+
+TEST("require that prepared updates are only preferred while most values are found in the dictionary")
+{
+    Config cfg(BasicType::STRING, CollectionType::SINGLE);
+    SingleValueStringAttribute attr("svsa", cfg);
+    attr.addReservedDoc();
+    AttributeVector::DocId docId;
+    for (uint32_t i = 0; i < 16; ++i) {
+        EXPECT_TRUE(attr.addDoc(docId));
+    }
+    attr.update(1, "common");
+    attr.commit();
+    EXPECT_TRUE(attr.prefer_prepared_update(1));
+    auto put = [&attr](uint32_t doc, const vespalib::string & value) {
+        EXPECT_TRUE(attr.complete_update(doc, value, attr.prepare_update(doc, value)));
+        attr.commit();
+    };
+    // High cardinality, every value is new
+    for (uint32_t i = 0; i < 256; ++i) {
+        put(1 + (i % 16), vespalib::make_string("unique%u", i));
+    }
+    EXPECT_FALSE(attr.prefer_prepared_update(1));
+    EXPECT_FALSE(attr.prefer_prepared_update(15));
+    // Still probing every 16th document
+    EXPECT_TRUE(attr.prefer_prepared_update(16));
+    // Low cardinality, values already present
+    for (uint32_t i = 0; i < 256; ++i) {
+        put(1 + (i % 16), "unique255");
+    }
+    EXPECT_TRUE(attr.prefer_prepared_update(1));
+}
+
 TEST("test uncased match") {
     QueryTermUCS4 xyz("xyz", QueryTermSimple::Type::WORD);
     StringSearchHelper helper(xyz, false);
@@ -3,6 +3,9 @@
 LOG_SETUP("bitvector_benchmark");
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/common/compressed_bitvector.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+#include <random>
 
 using namespace search;
 
@@ -19,6 +22,19 @@ size_t scan(BitVector & bv)
     return count;
 }
 
+template <typename Vector>
+size_t lookup(const Vector & vector, const std::vector<uint32_t> & docids) __attribute__((noinline));
+
+template <typename Vector>
+size_t lookup(const Vector & vector, const std::vector<uint32_t> & docids)
+{
+    size_t count(0);
+    for (uint32_t docid : docids) {
+        count += vector.testBit(docid) ? 1 : 0;
+    }
+    return count;
+}
+
 }
 
 // This test is 10% faster with table lookup than with runtime shifting.
@@ -33,4 +49,36 @@ TEST("speed of getNextTrueBit")
     EXPECT_EQUAL(bv->size(), bv->countTrueBits());
 }
 
+// Random lookups like those done by global filters during nearest neighbor search.
+TEST("speed of testBit in compressed bitvector")
+{
+    constexpr uint32_t size = 50000000;
+    std::mt19937 rnd(42);
+    std::vector<uint32_t> docids(10000000);
+    for (uint32_t & docid : docids) {
+        docid = rnd() % size;
+    }
+    for (uint32_t ratio : {64, 256, 1024, 4096}) {
+        BitVector::UP bv(BitVector::create(size));
+        std::vector<uint32_t> hits;
+        for (uint32_t docid(0); docid < size; docid++) {
+            if (rnd() % ratio == 0) {
+                bv->setBit(docid);
+                hits.push_back(docid);
+            }
+        }
+        bv->invalidateCachedCount();
+        auto cbv = CompressedBitVector::create(hits, size);
+        size_t expected = lookup(*bv, docids);
+        EXPECT_EQUAL(expected, lookup(cbv, docids));
+        size_t sink(0);
+        double bv_time = vespalib::BenchmarkTimer::benchmark([&]() { sink += lookup(*bv, docids); }, 1.0);
+        double cbv_time = vespalib::BenchmarkTimer::benchmark([&]() { sink += lookup(cbv, docids); }, 1.0);
+        EXPECT_TRUE(sink > 0);
+        fprintf(stderr, "1/%u hits: bitvector %.1f ns, compressed %.1f ns per lookup, memory %zu vs %zu bytes\n",
+                ratio, bv_time * 1e9 / docids.size(), cbv_time * 1e9 / docids.size(),
+                bv->getFileBytes(), cbv.memory_usage());
+    }
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
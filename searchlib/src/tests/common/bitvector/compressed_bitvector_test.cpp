@@ -0,0 +1,101 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/common/compressed_bitvector.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/util/size_literals.h>
+#include <algorithm>
+#include <iterator>
+
+using search::BitVector;
+using search::CompressedBitVector;
+using Ids = std::vector<uint32_t>;
+
+namespace {
+
+constexpr uint32_t chunk_size = CompressedBitVector::chunk_size;
+
+Ids
+ids_of(const CompressedBitVector &cbv)
+{
+    Ids result;
+    cbv.foreach_truebit([&result](uint32_t id) { result.push_back(id); });
+    return result;
+}
+
+// every nth id in [begin, end)
+Ids
+every(uint32_t nth, uint32_t begin, uint32_t end)
+{
+    Ids result;
+    for (uint32_t id = begin; id < end; id += nth) {
+        result.push_back(id);
+    }
+    return result;
+}
+
+Ids
+merge(const Ids &a, const Ids &b)
+{
+    Ids result;
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(result));
+    return result;
+}
+
+void
+expect_ids(const Ids &exp, const CompressedBitVector &cbv)
+{
+    EXPECT_EQ(exp, ids_of(cbv));
+    EXPECT_EQ(exp.size(), cbv.countTrueBits());
+    for (uint32_t id = 0; id < cbv.size() + 10; ++id) {
+        EXPECT_EQ(std::binary_search(exp.begin(), exp.end(), id), cbv.testBit(id)) << "id " << id;
+    }
+}
+
+// sparse chunk, dense chunk, empty chunk and a partial last chunk
+const uint32_t test_size = 3 * chunk_size + 1000;
+const Ids sparse_ids = merge(every(97, 5, chunk_size), every(13, 3 * chunk_size + 1, test_size));
+const Ids dense_ids = merge(every(3, chunk_size, 2 * chunk_size), every(7, 3 * chunk_size, test_size));
+
+}
+
+TEST(CompressedBitVectorTest, empty_vector)
+{
+    auto cbv = CompressedBitVector::create(Ids(), 0);
+    EXPECT_EQ(0u, cbv.size());
+    expect_ids({}, cbv);
+}
+
+TEST(CompressedBitVectorTest, ids_are_preserved_in_sparse_and_dense_chunks)
+{
+    expect_ids(sparse_ids, CompressedBitVector::create(sparse_ids, test_size));
+    expect_ids(dense_ids, CompressedBitVector::create(dense_ids, test_size));
+    auto all = merge(sparse_ids, dense_ids);
+    expect_ids(all, CompressedBitVector::create(all, test_size));
+}
+
+TEST(CompressedBitVectorTest, sparse_vector_uses_less_memory_than_bitvector)
+{
+    auto cbv = CompressedBitVector::create(sparse_ids, test_size);
+    EXPECT_LT(cbv.memory_usage(), test_size / 8);
+    auto dense = CompressedBitVector::create(every(2, 0, test_size), test_size);
+    EXPECT_LT(dense.memory_usage(), test_size / 8 + 4_Ki);
+}
+
+TEST(CompressedBitVectorTest, can_be_created_from_bitvector)
+{
+    auto bv = BitVector::create(1, test_size);
+    for (uint32_t id : sparse_ids) {
+        bv->setBit(id);
+    }
+    bv->invalidateCachedCount();
+    expect_ids(sparse_ids, CompressedBitVector::create(*bv));
+}
+
+TEST(CompressedBitVectorTest, lookup_handles_ids_at_bucket_boundaries)
+{
+    Ids ids = {0, 255, 256, 511, 4096, chunk_size - 256, chunk_size - 1, chunk_size, chunk_size + 255};
+    expect_ids(ids, CompressedBitVector::create(ids, 2 * chunk_size));
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
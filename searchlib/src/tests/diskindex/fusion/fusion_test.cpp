@@ -74,6 +74,7 @@ class FusionTest : public ::testing::Test
 protected:
     Schema _schema;
     bool   _force_small_merge_chunk;
+    uint32_t _max_word_range_partitions;
     const Schema & getSchema() const { return _schema; }
 
     void requireThatFusionIsWorking(const vespalib::string &prefix, bool directio, bool readmmap, bool force_short_merge_chunk);
@@ -397,6 +398,7 @@ FusionTest::requireThatFusionIsWorking(const vespalib::string &prefix, bool dire
         Fusion fusion(schema, prefix + "dump3", sources, selector,
                       tuneFileIndexing,fileHeaderContext);
         fusion.set_force_small_merge_chunk(force_small_merge_chunk);
+        fusion.set_max_word_range_partitions(_max_word_range_partitions);
         ASSERT_TRUE(fusion.merge(executor, std::make_shared<FlushToken>()));
     } while (0);
     do {
@@ -411,6 +413,7 @@ FusionTest::requireThatFusionIsWorking(const vespalib::string &prefix, bool dire
         Fusion fusion(schema2, prefix + "dump4", sources, selector,
                       tuneFileIndexing, fileHeaderContext);
         fusion.set_force_small_merge_chunk(force_small_merge_chunk);
+        fusion.set_max_word_range_partitions(_max_word_range_partitions);
         ASSERT_TRUE(fusion.merge(executor, std::make_shared<FlushToken>()));
     } while (0);
     do {
@@ -425,6 +428,7 @@ FusionTest::requireThatFusionIsWorking(const vespalib::string &prefix, bool dire
         Fusion fusion(schema3, prefix + "dump5", sources, selector,
                       tuneFileIndexing, fileHeaderContext);
         fusion.set_force_small_merge_chunk(force_small_merge_chunk);
+        fusion.set_max_word_range_partitions(_max_word_range_partitions);
         ASSERT_TRUE(fusion.merge(executor, std::make_shared<FlushToken>()));
     } while (0);
     do {
@@ -440,6 +444,7 @@ FusionTest::requireThatFusionIsWorking(const vespalib::string &prefix, bool dire
                       tuneFileIndexing, fileHeaderContext);
         fusion.set_dynamic_k_pos_index_format(true);
         fusion.set_force_small_merge_chunk(force_small_merge_chunk);
+        fusion.set_max_word_range_partitions(_max_word_range_partitions);
         ASSERT_TRUE(fusion.merge(executor, std::make_shared<FlushToken>()));
     } while (0);
     do {
@@ -454,6 +459,7 @@ FusionTest::requireThatFusionIsWorking(const vespalib::string &prefix, bool dire
         Fusion fusion(schema, prefix + "dump3", sources, selector,
                       tuneFileIndexing, fileHeaderContext);
         fusion.set_force_small_merge_chunk(force_small_merge_chunk);
+        fusion.set_max_word_range_partitions(_max_word_range_partitions);
         ASSERT_TRUE(fusion.merge(executor, std::make_shared<FlushToken>()));
     } while (0);
     do {
@@ -506,7 +512,8 @@ FusionTest::merge_simple_indexes(const vespalib::string &dump_dir, const std::ve
 FusionTest::FusionTest()
     : ::testing::Test(),
       _schema(make_schema(false)),
-      _force_small_merge_chunk(false)
+      _force_small_merge_chunk(false),
+      _max_word_range_partitions(1)
 {
 }
 
@@ -535,6 +542,18 @@ TEST_F(FusionTest, require_that_small_merge_chunk_fusion_is_working)
     requireThatFusionIsWorking("s", false, false, true);
 }
 
+TEST_F(FusionTest, require_that_word_range_partitioned_fusion_is_working)
+{
+    _max_word_range_partitions = 3;
+    requireThatFusionIsWorking("p", false, false, true);
+}
+
+TEST_F(FusionTest, require_that_directio_word_range_partitioned_fusion_is_working)
+{
+    _max_word_range_partitions = 3;
+    requireThatFusionIsWorking("pd", true, false, true);
+}
+
 namespace {
 
 void clean_field_length_testdirs()
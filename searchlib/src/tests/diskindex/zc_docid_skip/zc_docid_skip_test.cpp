@@ -0,0 +1,139 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/diskindex/zcpostingiterators.h>
+#include <vespa/vespalib/gtest/gtest.h>
+
+using search::diskindex::zc_skip_single_byte_docid_deltas;
+
+namespace {
+
+/*
+ * Docid deltas encoded the same way as in zc posting lists, i.e. each
+ * delta is stored as (delta - 1) with 7 bits per byte.
+ */
+struct DocIdDeltas {
+    std::vector<uint32_t> docids;
+    std::vector<uint8_t>  bytes;
+    std::vector<size_t>   offsets; // start of encoded delta for each docid
+
+    explicit DocIdDeltas(const std::vector<uint32_t> &docids_in)
+        : docids(docids_in),
+          bytes(),
+          offsets()
+    {
+        uint32_t prev = 0;
+        for (uint32_t docid : docids) {
+            offsets.push_back(bytes.size());
+            uint32_t num = docid - prev - 1;
+            while (num >= (1 << 7)) {
+                bytes.push_back((num & ((1 << 7) - 1)) | (1 << 7));
+                num >>= 7;
+            }
+            bytes.push_back(num);
+            prev = docid;
+        }
+        offsets.push_back(bytes.size());
+    }
+    const uint8_t *begin() const { return bytes.data(); }
+    const uint8_t *end() const { return bytes.data() + bytes.size(); }
+};
+
+std::vector<uint32_t> make_docids(const std::vector<uint32_t> &gaps) {
+    std::vector<uint32_t> docids;
+    uint32_t docid = 0;
+    for (uint32_t gap : gaps) {
+        docid += gap;
+        docids.push_back(docid);
+    }
+    return docids;
+}
+
+std::vector<uint32_t> repeat_gap(uint32_t gap, size_t count) {
+    return std::vector<uint32_t>(count, gap);
+}
+
+std::vector<uint32_t> concat(std::vector<uint32_t> a, const std::vector<uint32_t> &b) {
+    a.insert(a.end(), b.begin(), b.end());
+    return a;
+}
+
+struct SkipResult {
+    uint32_t skipped;
+    size_t   pos;
+    uint32_t docid;
+};
+
+SkipResult skip(const DocIdDeltas &deltas, size_t idx, uint32_t target) {
+    const uint8_t *valI = deltas.begin() + deltas.offsets[idx];
+    uint32_t docid = (idx > 0) ? deltas.docids[idx - 1] : 0;
+    uint32_t skipped = zc_skip_single_byte_docid_deltas(valI, deltas.end(), docid, target);
+    return {skipped, size_t(valI - deltas.begin()), docid};
+}
+
+void expect_skipped_to(const DocIdDeltas &deltas, const SkipResult &result, size_t idx) {
+    EXPECT_EQ(deltas.offsets[idx], result.pos);
+    EXPECT_EQ(deltas.docids[idx - 1], result.docid);
+}
+
+}
+
+TEST(ZcDocIdSkipTest, single_byte_deltas_are_skipped_in_groups_of_8_until_end_of_buffer)
+{
+    std::vector<uint32_t> gaps;
+    for (uint32_t i = 0; i < 100; ++i) {
+        gaps.push_back(1 + (i * 13) % 128);
+    }
+    DocIdDeltas deltas(make_docids(gaps));
+    auto result = skip(deltas, 0, deltas.docids.back() + 1);
+    // The last 4 deltas do not fill a group and are left for regular decoding
+    EXPECT_EQ(96u, result.skipped);
+    expect_skipped_to(deltas, result, 96);
+}
+
+TEST(ZcDocIdSkipTest, group_containing_target_is_not_skipped)
+{
+    DocIdDeltas deltas(make_docids(repeat_gap(3, 40)));
+    EXPECT_EQ(16u, skip(deltas, 0, deltas.docids[20]).skipped);
+    EXPECT_EQ(16u, skip(deltas, 0, deltas.docids[15] + 1).skipped);
+    EXPECT_EQ(8u, skip(deltas, 0, deltas.docids[15]).skipped);
+    EXPECT_EQ(0u, skip(deltas, 0, deltas.docids[7]).skipped);
+    auto result = skip(deltas, 0, deltas.docids[15] + 1);
+    expect_skipped_to(deltas, result, 16);
+}
+
+TEST(ZcDocIdSkipTest, skipping_stops_at_group_with_multi_byte_delta)
+{
+    auto gaps = concat(concat(repeat_gap(1, 11), {129}), repeat_gap(2, 20));
+    DocIdDeltas deltas(make_docids(gaps));
+    ASSERT_EQ(deltas.offsets[11] + 2, deltas.offsets[12]);
+    auto result = skip(deltas, 0, deltas.docids.back() + 1);
+    EXPECT_EQ(8u, result.skipped);
+    expect_skipped_to(deltas, result, 8);
+    // any group containing the multi-byte delta is rejected
+    EXPECT_EQ(0u, skip(deltas, 9, deltas.docids.back() + 1).skipped);
+    // skipping resumes after the multi-byte delta
+    result = skip(deltas, 12, deltas.docids.back() + 1);
+    EXPECT_EQ(16u, result.skipped);
+    expect_skipped_to(deltas, result, 28);
+}
+
+TEST(ZcDocIdSkipTest, largest_single_byte_deltas_are_summed_correctly)
+{
+    DocIdDeltas deltas(make_docids(repeat_gap(128, 24)));
+    auto result = skip(deltas, 0, deltas.docids.back());
+    EXPECT_EQ(16u, result.skipped);
+    EXPECT_EQ(16u * 128, result.docid);
+    expect_skipped_to(deltas, result, 16);
+}
+
+TEST(ZcDocIdSkipTest, nothing_is_skipped_when_less_than_8_deltas_remain)
+{
+    DocIdDeltas deltas(make_docids(repeat_gap(1, 15)));
+    auto result = skip(deltas, 8, deltas.docids.back() + 1);
+    EXPECT_EQ(0u, result.skipped);
+    EXPECT_EQ(deltas.offsets[8], result.pos);
+    EXPECT_EQ(deltas.docids[7], result.docid);
+    EXPECT_EQ(0u, skip(deltas, 15, deltas.docids.back() + 1).skipped);
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -8,6 +8,9 @@
 #include <vespa/searchlib/docstore/chunkformats.h>
 #include <vespa/vespalib/objects/hexdump.h>
 #include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/util/size_literals.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 #include <zstd.h>
 
 LOG_SETUP("chunk_test");
@@ -100,4 +103,41 @@ TEST("require that V2 can create and handle lz4, zstd, and none") {
     verifyChunkCompression(CompressionConfig::ZSTD, MY_LONG_STRING, strlen(MY_LONG_STRING), zstd_compressed_length);
 }
 
+std::vector<char> trainDictionary(std::vector<vespalib::string> & docs) {
+    std::vector<vespalib::ConstBufferRef> samples;
+    for (size_t i(0); i < 1000; i++) {
+        docs.push_back(vespalib::make_string("{\"id\":\"id:ns:music::%zu\",\"artist\":\"Some artist\","
+                                             "\"title\":\"Some title %zu\",\"year\":%zu}", i, i * 3, 1900 + i % 100));
+    }
+    for (const auto & doc : docs) {
+        samples.emplace_back(doc.data(), doc.size());
+    }
+    return vespalib::compression::ZStdDictionaryCompressor::train(samples, 4_Ki);
+}
+
+TEST("require that Chunk can be packed and read back using a zstd dictionary") {
+    std::vector<vespalib::string> docs;
+    std::vector<char> dict = trainDictionary(docs);
+    ASSERT_FALSE(dict.empty());
+    Chunk::Dictionary dictionary(vespalib::ConstBufferRef(dict.data(), dict.size()));
+    Chunk c(0, Chunk::Config(64_Ki));
+    for (uint32_t lid(0); lid < 10; lid++) {
+        c.append(lid, {docs[lid].data(), docs[lid].size()});
+    }
+    vespalib::DataBuffer packed;
+    c.pack(7, packed, CompressionConfig(CompressionConfig::ZSTD), &dictionary);
+    vespalib::DataBuffer plain;
+    c.pack(7, plain, CompressionConfig(CompressionConfig::ZSTD));
+    EXPECT_LESS(packed.getDataLen(), plain.getDataLen());
+
+    Chunk r(0, packed.getData(), packed.getDataLen(), &dictionary);
+    EXPECT_EQUAL(10u, r.count());
+    for (uint32_t lid(0); lid < 10; lid++) {
+        vespalib::DataBuffer buffer;
+        EXPECT_EQUAL(ssize_t(docs[lid].size()), r.read(lid, buffer));
+        EXPECT_EQUAL(docs[lid], vespalib::string(buffer.getData(), buffer.getDataLen()));
+    }
+    EXPECT_EXCEPTION(Chunk(0, packed.getData(), packed.getDataLen()), ChunkException, "dictionary");
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
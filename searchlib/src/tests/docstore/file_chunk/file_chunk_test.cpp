@@ -9,6 +9,7 @@
 #include <vespa/vespalib/util/cpu_usage.h>
 #include <vespa/vespalib/util/compressionconfig.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 
@@ -31,10 +32,18 @@ struct MyFileHeaderContext : public FileHeaderContext {
 
 struct SetLidObserver : public ISetLid {
     std::vector<uint32_t> lids;
+    LidInfoWithLidV infos;
     void setLid(const unique_lock &guard, uint32_t lid, const LidInfo &lidInfo) override {
         (void) guard;
-        (void) lidInfo;
         lids.push_back(lid);
+        infos.emplace_back(lidInfo, lid);
+    }
+};
+
+struct CollectingVisitor : public IBufferVisitor {
+    std::vector<std::pair<uint32_t, vespalib::string>> visited;
+    void visit(uint32_t lid, vespalib::ConstBufferRef buffer) override {
+        visited.emplace_back(lid, vespalib::string(buffer.c_str(), buffer.size()));
     }
 };
 
@@ -72,11 +81,11 @@ struct FixtureBase {
         return serialNum++;
     };
 
-    explicit FixtureBase(const vespalib::string &baseName, bool dirCleanup = true)
+    explicit FixtureBase(const vespalib::string &baseName, bool dirCleanup = true, const TuneFileSummary &tune = {})
         : dir(baseName),
           executor(1),
           serialNum(1),
-          tuneFile(),
+          tuneFile(tune),
           fileHeaderCtx(),
           updateLock(),
           lidObserver(),
@@ -98,8 +107,8 @@ FixtureBase::~FixtureBase() = default;
 struct ReadFixture : public FixtureBase {
     FileChunk chunk;
 
-    explicit ReadFixture(const vespalib::string &baseName, bool dirCleanup = true)
-        : FixtureBase(baseName, dirCleanup),
+    explicit ReadFixture(const vespalib::string &baseName, bool dirCleanup = true, const TuneFileSummary &tune = {})
+        : FixtureBase(baseName, dirCleanup, tune),
           chunk(FileChunk::FileId(0), FileChunk::NameId(1234), baseName, tuneFile, &bucketizer)
     {
         dir.cleanup(dirCleanup);
@@ -225,6 +234,42 @@ TEST("require that entries with lid >= docIdLimit are skipped in updateLidMap()"
     }
 }
 
+TuneFileSummary
+asyncio_tune()
+{
+    TuneFileSummary tune;
+    tune._randRead.setWantAsyncIO();
+    return tune;
+}
+
+TEST("require that lids spread over many chunks are read both streamed and batched")
+{
+    {
+        WriteFixture f("tmp", 0, false);
+        for (uint32_t lid = 1; lid <= 10; ++lid) {
+            f.append(lid).append(lid + 100);
+            f.flush();
+        }
+    }
+    for (const TuneFileSummary &tune : {TuneFileSummary(), asyncio_tune()}) {
+        ReadFixture f("tmp", false, tune);
+        f.updateLidMap(1000);
+        EXPECT_GREATER(f.chunk.getNumChunks(), 1u);
+        LidInfoWithLidV infos = f.lidObserver.infos;
+        std::sort(infos.begin(), infos.end(), [](const auto &a, const auto &b) {
+            return (a.getChunkId() != b.getChunkId()) ? (a.getChunkId() < b.getChunkId()) : (a.getLid() < b.getLid());
+        });
+        CollectingVisitor visitor;
+        f.chunk.read(infos.begin(), infos.size(), visitor);
+        ASSERT_EQUAL(20u, visitor.visited.size());
+        for (size_t i = 0; i < infos.size(); ++i) {
+            EXPECT_EQUAL(infos[i].getLid(), visitor.visited[i].first);
+            EXPECT_EQUAL(getData(infos[i].getLid()), visitor.visited[i].second);
+        }
+    }
+    WriteFixture cleanup("tmp", 0);
+}
+
 using vespalib::compression::CompressionConfig;
 
 TEST("require that operator == detects inequality") {
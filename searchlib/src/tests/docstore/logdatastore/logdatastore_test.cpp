@@ -482,6 +482,10 @@ public:
         VerifyVisitor vv(*this, expected, allowCaching);
         _datastore->visit(lids, _repo, vv);
     }
+    void verifyBatchRead(const std::vector<uint32_t> & lids) {
+        VerifyVisitor vv(*this, lids, false);
+        _datastore->read(lids, _repo, vv);
+    }
     void recreate();
 
 private:
@@ -565,8 +569,8 @@ TEST("Control static memory usage") {
     IDocumentStore &ds = vcs.getStore();
     vespalib::MemoryUsage usage = ds.getMemoryUsage();
     constexpr size_t mutex_size = sizeof(std::mutex) * 2 * (113 + 1); // sizeof(std::mutex) is platform dependent
-    EXPECT_EQUAL(74668 + mutex_size, usage.allocatedBytes());
-    EXPECT_EQUAL(944u + mutex_size, usage.usedBytes());
+    EXPECT_EQUAL(74684 + mutex_size, usage.allocatedBytes());
+    EXPECT_EQUAL(960u + mutex_size, usage.usedBytes());
 }
 
 TEST("test the update cache strategy") {
@@ -625,6 +629,28 @@ TEST("test the invalidate cache strategy") {
     TEST_DO(verifyCacheStats(ds.getCacheStats(), 0, 3, 1, 241));
 }
 
+TEST("test that batched reads use and populate the cache") {
+    VisitCacheStore vcs(DocumentStore::Config::UpdateStrategy::INVALIDATE);
+    IDocumentStore & ds = vcs.getStore();
+    for (size_t i(1); i <= 10; i++) {
+        vcs.write(i);
+    }
+    vcs.verifyBatchRead({3, 5, 7});
+    EXPECT_EQUAL(0u, ds.getCacheStats().hits);
+    EXPECT_EQUAL(3u, ds.getCacheStats().misses);
+    EXPECT_EQUAL(3u, ds.getCacheStats().elements);
+    vcs.verifyRead(5);
+    EXPECT_EQUAL(1u, ds.getCacheStats().hits);
+    vcs.verifyBatchRead({3, 4});
+    EXPECT_EQUAL(2u, ds.getCacheStats().hits);
+    EXPECT_EQUAL(4u, ds.getCacheStats().misses);
+    EXPECT_EQUAL(4u, ds.getCacheStats().elements);
+    vcs.write(4);
+    EXPECT_EQUAL(3u, ds.getCacheStats().elements);
+    vcs.verifyBatchRead({4});
+    EXPECT_EQUAL(4u, ds.getCacheStats().elements);
+}
+
 TEST("test that the integrated visit cache works.") {
     VisitCacheStore vcs(DocumentStore::Config::UpdateStrategy::INVALIDATE);
     IDocumentStore & ds = vcs.getStore();
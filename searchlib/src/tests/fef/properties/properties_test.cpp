@@ -285,6 +285,22 @@ TEST("test stuff") {
             p.add("vespa.matching.termwise_limit", "0.05");
             EXPECT_EQUAL(matching::TermwiseLimit::lookup(p), 0.05);
         }
+        { // vespa.matching.first_phase.batch_size
+            EXPECT_EQUAL(matching::FirstPhaseBatchSize::NAME, vespalib::string("vespa.matching.first_phase.batch_size"));
+            EXPECT_EQUAL(matching::FirstPhaseBatchSize::DEFAULT_VALUE, 128u);
+            Properties p;
+            EXPECT_EQUAL(matching::FirstPhaseBatchSize::lookup(p), 128u);
+            p.add("vespa.matching.first_phase.batch_size", "0");
+            EXPECT_EQUAL(matching::FirstPhaseBatchSize::lookup(p), 0u);
+        }
+        { // vespa.matching.profile_sample_interval
+            EXPECT_EQUAL(matching::ProfileSampleInterval::NAME, vespalib::string("vespa.matching.profile_sample_interval"));
+            EXPECT_EQUAL(matching::ProfileSampleInterval::DEFAULT_VALUE, 0u);
+            Properties p;
+            EXPECT_EQUAL(matching::ProfileSampleInterval::lookup(p), 0u);
+            p.add("vespa.matching.profile_sample_interval", "1000");
+            EXPECT_EQUAL(matching::ProfileSampleInterval::lookup(p), 1000u);
+        }
         { // vespa.matching.numthreads
             EXPECT_EQUAL(matching::NumThreadsPerSearch::NAME, vespalib::string("vespa.matching.numthreadspersearch"));
             EXPECT_EQUAL(matching::NumThreadsPerSearch::DEFAULT_VALUE, std::numeric_limits<uint32_t>::max());
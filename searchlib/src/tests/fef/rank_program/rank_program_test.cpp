@@ -2,12 +2,17 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/vespalib/stllike/string.h>
 #include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/searchcommon/attribute/config.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/integerbase.h>
+#include <vespa/searchlib/features/attributefeature.h>
 #include <vespa/searchlib/features/valuefeature.h>
 #include <vespa/searchlib/features/rankingexpressionfeature.h>
 #include <vespa/searchlib/fef/blueprintfactory.h>
 #include <vespa/searchlib/fef/indexproperties.h>
 #include <vespa/searchlib/fef/matchdatalayout.h>
 #include <vespa/searchlib/fef/test/indexenvironment.h>
+#include <vespa/searchlib/fef/test/indexenvironmentbuilder.h>
 #include <vespa/searchlib/fef/test/queryenvironment.h>
 #include <vespa/searchlib/fef/test/plugin/sum.h>
 #include <vespa/searchlib/fef/test/plugin/double.h>
@@ -21,6 +26,11 @@ using namespace search::fef::test;
 using namespace search::features;
 using vespalib::ExecutionProfiler;
 using vespalib::Slime;
+using search::AttributeFactory;
+using search::IntegerAttribute;
+using AVC = search::attribute::Config;
+using AVBT = search::attribute::BasicType;
+using AVCT = search::attribute::CollectionType;
 
 uint32_t default_docid = 1;
 
@@ -80,6 +90,7 @@ struct Fixture {
     Fixture() : factory(), indexEnv(), resolver(new BlueprintResolver(factory, indexEnv)),
                 overrides(), match_data(), program(resolver), track_cnt(0)
     {
+        factory.addPrototype(Blueprint::SP(new AttributeBlueprint()));
         factory.addPrototype(Blueprint::SP(new BoxingBlueprint()));
         factory.addPrototype(Blueprint::SP(new DocidBlueprint()));
         factory.addPrototype(Blueprint::SP(new DoubleBlueprint()));
@@ -98,6 +109,20 @@ struct Fixture {
         indexEnv.getProperties().add(indexproperties::eval::UseFastForest::NAME, "true");
         return *this;
     }
+    Fixture &add_int_attribute(const vespalib::string &name, const std::vector<int64_t> &values) {
+        auto attr = AttributeFactory::createAttribute(name, AVC(AVBT::INT64, AVCT::SINGLE));
+        attr->addReservedDoc();
+        attr->addDocs(values.size());
+        auto &int_attr = dynamic_cast<IntegerAttribute &>(*attr);
+        for (size_t i = 0; i < values.size(); ++i) {
+            int_attr.update(i + 1, values[i]);
+        }
+        attr->commit();
+        indexEnv.getAttributeMap().add(attr);
+        IndexEnvironmentBuilder(indexEnv).addField(FieldType::ATTRIBUTE, FieldInfo::CollectionType::SINGLE,
+                                                   FieldInfo::DataType::INT64, name);
+        return *this;
+    }
     Fixture &add_expr(const vespalib::string &name, const vespalib::string &expr) {
         vespalib::string feature_name = expr_feature(name);
         vespalib::string expr_name = feature_name + ".rankingScript";
@@ -140,6 +165,10 @@ struct Fixture {
         }
         return 31212.0;
     }
+    std::vector<double> get_batch(const std::vector<uint32_t> &docids) {
+        auto scores = program.execute_batch(docids);
+        return {scores.begin(), scores.end()};
+    }
     std::map<vespalib::string, double> all(uint32_t docid = default_docid) {
         auto result = program.get_seeds();
         std::map<vespalib::string, double> result_map;
@@ -422,4 +451,73 @@ TEST_F("require that rank program can be profiled", Fixture()) {
     EXPECT_EQUAL((*b)["count"].asLong(), 1);
 }
 
+TEST_F("require that compiled ranking expressions can be calculated in batches", Fixture()) {
+    f1.lazy_expressions(false).add_expr("score", "2*docid+value(1)").compile();
+    EXPECT_EQUAL(f1.final_executor_name(), "search::features::CompiledRankingExpressionExecutor");
+    ASSERT_TRUE(f1.program.setup_batch(4));
+    EXPECT_EQUAL(4u, f1.program.get_batch_size());
+    EXPECT_EQUAL(f1.get_batch({3, 5, 8}), std::vector<double>({7.0, 11.0, 17.0}));
+    EXPECT_EQUAL(f1.get_batch({9, 10, 11, 12}), std::vector<double>({19.0, 21.0, 23.0, 25.0}));
+    EXPECT_EQUAL(f1.get(5), 11.0);
+}
+
+TEST_F("require that lazy compiled ranking expressions can be calculated in batches", Fixture()) {
+    f1.lazy_expressions(true).add_expr("score", "if(docid<5,docid,value(100))").compile();
+    EXPECT_EQUAL(f1.final_executor_name(), "search::features::LazyCompiledRankingExpressionExecutor");
+    ASSERT_TRUE(f1.program.setup_batch(8));
+    EXPECT_EQUAL(f1.get_batch({2, 4, 6}), std::vector<double>({2.0, 4.0, 100.0}));
+}
+
+TEST_F("require that const seed can be calculated in batches", Fixture()) {
+    f1.lazy_expressions(false).add_expr("score", "value(1)+value(2)").compile();
+    ASSERT_TRUE(f1.program.setup_batch(4));
+    EXPECT_EQUAL(f1.get_batch({1, 2}), std::vector<double>({3.0, 3.0}));
+}
+
+TEST_F("require that single value attributes can be calculated in batches", Fixture()) {
+    int64_t undefined = search::attribute::getUndefined<int64_t>();
+    f1.add_int_attribute("foo", {5, undefined, 7, 9, 11});
+    f1.lazy_expressions(false).add_expr("score", "if(isNan(attribute(foo)),-1,attribute(foo))"
+                                        "+10*attribute(foo).count+100*attribute(foo).weight"
+                                        "+1000*attribute(foo).contains").compile();
+    ASSERT_TRUE(f1.program.setup_batch(4));
+    EXPECT_EQUAL(f1.get_batch({1, 2, 3, 4}), std::vector<double>({15.0, 9.0, 17.0, 19.0}));
+    EXPECT_EQUAL(f1.get_batch({5}), std::vector<double>({21.0}));
+    for (uint32_t docid: {1, 2, 3, 4, 5}) {
+        EXPECT_EQUAL(f1.get_batch({docid}), std::vector<double>({f1.get(docid)}));
+    }
+}
+
+TEST_F("require that fast-forest gbdt evaluation can be calculated in batches", Fixture()) {
+    f1.use_fast_forest().lazy_expressions(false).add_expr("score", "if(docid<5,1,2)+if(docid<8,10,20)").compile();
+    EXPECT_EQUAL(f1.final_executor_name(), "search::features::FastForestExecutor");
+    ASSERT_TRUE(f1.program.setup_batch(4));
+    EXPECT_EQUAL(f1.get_batch({3, 6, 9}), std::vector<double>({11.0, 12.0, 22.0}));
+    for (uint32_t docid: {3, 4, 5, 7, 8, 12}) {
+        EXPECT_EQUAL(f1.get_batch({docid}), std::vector<double>({f1.get(docid)}));
+    }
+}
+
+TEST_F("require that batch calculation is not used when an executor does not support it", Fixture()) {
+    f1.lazy_expressions(false).add_expr("score", "docid+mysum(docid,value(1))").compile();
+    EXPECT_FALSE(f1.program.setup_batch(4));
+    EXPECT_EQUAL(0u, f1.program.get_batch_size());
+}
+
+TEST_F("require that batch calculation is not used with multiple seeds", Fixture()) {
+    f1.add("docid").add("value(1)").compile();
+    EXPECT_FALSE(f1.program.setup_batch(4));
+}
+
+TEST_F("require that batch calculation is not used with overridden features", Fixture()) {
+    f1.lazy_expressions(false).add_expr("score", "2*docid").override("docid", 5.0).compile();
+    EXPECT_FALSE(f1.program.setup_batch(4));
+}
+
+TEST_F("require that batch calculation is not used when profiling", Fixture()) {
+    ExecutionProfiler profiler(64);
+    f1.lazy_expressions(false).add_expr("score", "2*docid").compile(&profiler);
+    EXPECT_FALSE(f1.program.setup_batch(4));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -104,7 +104,11 @@ makeDoc15(DocBuilder &b)
 VESPA_THREAD_STACK_TAG(invert_executor)
 VESPA_THREAD_STACK_TAG(push_executor)
 
-struct DocumentInverterTest : public ::testing::Test {
+/*
+ * Test parameter is the number of field inverter shards, also used as
+ * the number of invert threads.
+ */
+struct DocumentInverterTest : public ::testing::TestWithParam<uint32_t> {
     DocBuilder _b;
     Schema _schema;
     std::unique_ptr<ISequencedTaskExecutor> _invertThreads;
@@ -120,14 +124,14 @@ struct DocumentInverterTest : public ::testing::Test {
     DocumentInverterTest()
         : _b(make_add_fields()),
           _schema(SchemaBuilder(_b).add_all_indexes().build()),
-          _invertThreads(SequencedTaskExecutor::create(invert_executor, 1)),
+          _invertThreads(SequencedTaskExecutor::create(invert_executor, GetParam())),
           _pushThreads(SequencedTaskExecutor::create(push_executor, 1)),
           _word_store(),
           _remover(_word_store),
           _inserter_backend(),
           _calculator(),
           _fic(_remover, _inserter_backend, _calculator),
-          _inv_context(_schema, *_invertThreads, *_pushThreads, _fic),
+          _inv_context(_schema, *_invertThreads, *_pushThreads, _fic, GetParam()),
           _inv(_inv_context)
     {
     }
@@ -139,7 +143,7 @@ struct DocumentInverterTest : public ::testing::Test {
     }
 };
 
-TEST_F(DocumentInverterTest, require_that_fresh_insert_works)
+TEST_P(DocumentInverterTest, require_that_fresh_insert_works)
 {
     auto doc10 = makeDoc10(_b);
     _inv.invertDocument(10, *doc10, {});
@@ -151,7 +155,7 @@ TEST_F(DocumentInverterTest, require_that_fresh_insert_works)
               _inserter_backend.toStr());
 }
 
-TEST_F(DocumentInverterTest, require_that_multiple_docs_work)
+TEST_P(DocumentInverterTest, require_that_multiple_docs_work)
 {
     auto doc10 = makeDoc10(_b);
     auto doc11 = makeDoc11(_b);
@@ -168,7 +172,7 @@ TEST_F(DocumentInverterTest, require_that_multiple_docs_work)
               _inserter_backend.toStr());
 }
 
-TEST_F(DocumentInverterTest, require_that_remove_works)
+TEST_P(DocumentInverterTest, require_that_remove_works)
 {
     _inv.getInverter(0)->remove("b", 10);
     _inv.getInverter(0)->remove("a", 10);
@@ -183,7 +187,7 @@ TEST_F(DocumentInverterTest, require_that_remove_works)
               _inserter_backend.toStr());
 }
 
-TEST_F(DocumentInverterTest, require_that_reput_works)
+TEST_P(DocumentInverterTest, require_that_reput_works)
 {
     auto doc10 = makeDoc10(_b);
     auto doc11 = makeDoc11(_b);
@@ -199,7 +203,7 @@ TEST_F(DocumentInverterTest, require_that_reput_works)
               _inserter_backend.toStr());
 }
 
-TEST_F(DocumentInverterTest, require_that_abort_pending_doc_works)
+TEST_P(DocumentInverterTest, require_that_abort_pending_doc_works)
 {
     auto doc10 = makeDoc10(_b);
     auto doc11 = makeDoc11(_b);
@@ -256,7 +260,7 @@ TEST_F(DocumentInverterTest, require_that_abort_pending_doc_works)
               _inserter_backend.toStr());
 }
 
-TEST_F(DocumentInverterTest, require_that_mix_of_add_and_remove_works)
+TEST_P(DocumentInverterTest, require_that_mix_of_add_and_remove_works)
 {
     _inv.getInverter(0)->remove("a", 11);
     _inv.getInverter(0)->remove("c", 9);
@@ -273,7 +277,7 @@ TEST_F(DocumentInverterTest, require_that_mix_of_add_and_remove_works)
               _inserter_backend.toStr());
 }
 
-TEST_F(DocumentInverterTest, require_that_empty_document_can_be_inverted)
+TEST_P(DocumentInverterTest, require_that_empty_document_can_be_inverted)
 {
     auto doc15 = makeDoc15(_b);
     _inv.invertDocument(15, *doc15, {});
@@ -282,6 +286,73 @@ TEST_F(DocumentInverterTest, require_that_empty_document_can_be_inverted)
               _inserter_backend.toStr());
 }
 
+TEST_P(DocumentInverterTest, require_that_removes_and_adds_from_shards_are_merged_in_posting_order)
+{
+    // With 2 or 3 shards, documents 10, 11 and 12 are not all inverted by the same shard,
+    // while removes are applied by the owning field inverter.
+    _inv.getInverter(0)->remove("a", 10);
+    _inv.getInverter(0)->remove("a", 11);
+    _inv.getInverter(0)->remove("b", 12);
+    _inv.getInverter(0)->remove("e", 10);
+    _inv.getInverter(0)->remove("h", 11);
+    auto doc10 = makeDoc10(_b);
+    auto doc11 = makeDoc11(_b);
+    auto doc12 = makeDoc12(_b);
+    _inv.invertDocument(12, *doc12, {});
+    _inv.invertDocument(11, *doc11, {});
+    _inv.invertDocument(10, *doc10, {});
+    pushDocuments();
+    EXPECT_EQ("f=0,w=a,r=10,a=10,r=11,a=11,"
+              "w=b,a=10,a=11,r=12,"
+              "w=c,a=10,"
+              "w=d,a=10,"
+              "w=doc12,a=12,"
+              "w=e,r=10,a=11,"
+              "w=f,a=11,"
+              "w=h,r=11,a=12,"
+              "f=1,w=a,a=11,"
+              "w=g,a=11",
+              _inserter_backend.toStr());
+
+    // Re-add the same documents, now in reverse order, with removes of the old versions
+    _inv.getInverter(0)->remove("a", 10);
+    _inv.getInverter(0)->remove("a", 11);
+    _inv.getInverter(0)->remove("doc12", 12);
+    _inv.invertDocument(10, *doc11, {});
+    _inv.invertDocument(11, *doc12, {});
+    _inv.invertDocument(12, *doc10, {});
+    _inserter_backend.reset();
+    pushDocuments();
+    EXPECT_EQ("f=0,w=a,r=10,a=10,r=11,a=12,"
+              "w=b,a=10,a=12,"
+              "w=c,a=12,"
+              "w=d,a=12,"
+              "w=doc12,a=11,r=12,"
+              "w=e,a=10,"
+              "w=f,a=10,"
+              "w=h,a=11,"
+              "f=1,w=a,a=10,"
+              "w=g,a=10",
+              _inserter_backend.toStr());
+}
+
+TEST_P(DocumentInverterTest, require_that_field_inverter_shards_are_used_for_text_fields)
+{
+    uint32_t num_shards = GetParam();
+    EXPECT_EQ(num_shards, _inv_context.get_field_shards());
+    auto& inverter = *_inv.getInverter(0);
+    if (num_shards > 1) {
+        EXPECT_EQ(num_shards, inverter.get_num_shards());
+        EXPECT_EQ(&inverter.get_shard(10 % num_shards), inverter.get_shard_inverter(10, 10 % num_shards));
+        EXPECT_EQ(nullptr, inverter.get_shard_inverter(10, 11 % num_shards));
+    } else {
+        EXPECT_EQ(0u, inverter.get_num_shards());
+        EXPECT_EQ(&inverter, inverter.get_shard_inverter(10, 0));
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(DocumentInverterMultiTest, DocumentInverterTest, ::testing::Values(1, 2, 3));
+
 }
 
 GTEST_MAIN_RUN_ALL_TESTS()
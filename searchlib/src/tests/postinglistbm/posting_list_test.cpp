@@ -7,6 +7,7 @@
 #include <vespa/searchlib/test/fakedata/fpfactory.h>
 #include <vespa/vespalib/util/rand48.h>
 #include <vespa/vespalib/gtest/gtest.h>
+#include <algorithm>
 #include <cinttypes>
 
 using search::fef::TermFieldMatchData;
@@ -139,4 +140,86 @@ TEST_F(PostingListTest, verify_posting_list_iterators_over_weighted_set_field)
     run();
 }
 
+/*
+ * Docids with long runs of docid deltas that are encoded in a single
+ * byte, which are skipped 8 at a time when seeking in zc posting lists.
+ * A multi-byte delta is placed in the middle of a run and the list ends
+ * with a run that is too short to fill a group.
+ */
+std::vector<uint32_t>
+make_dense_docids()
+{
+    std::vector<uint32_t> docids;
+    uint32_t docid = 0;
+    auto add = [&](uint32_t gap) { docid += gap; docids.push_back(docid); };
+    for (uint32_t i = 0; i < 3000; ++i) {
+        add(1 + (i * 7) % 16);
+    }
+    for (uint32_t i = 0; i < 1000; ++i) {
+        add(1 + (i * 37) % 128);
+    }
+    add(129);
+    for (uint32_t i = 0; i < 1000; ++i) {
+        add(1 + i % 4);
+    }
+    add(5000);
+    for (uint32_t i = 0; i < 5; ++i) {
+        add(1);
+    }
+    return docids;
+}
+
+void
+validate_seek_to_missing_docids(const FakePosting& posting, const std::vector<uint32_t>& docids, uint32_t stride)
+{
+    TermFieldMatchData md;
+    TermFieldMatchDataArray tfmda;
+    tfmda.add(&md);
+    std::unique_ptr<SearchIterator> iterator(posting.createIterator(tfmda));
+    iterator->initFullRange();
+    for (uint32_t target = 1; target <= docids.back() + 1; target += stride) {
+        bool hit = iterator->seek(target);
+        auto expect = std::lower_bound(docids.begin(), docids.end(), target);
+        if (expect == docids.end()) {
+            EXPECT_FALSE(hit);
+            EXPECT_TRUE(iterator->isAtEnd());
+            return;
+        }
+        ASSERT_EQ(*expect, iterator->getDocId()) << posting.getName() << " target=" << target;
+        EXPECT_EQ(*expect == target, hit);
+    }
+}
+
+TEST(PostingListSkipTest, seek_in_dense_posting_list_gives_same_docids_and_features)
+{
+    FakeWordSet word_set;
+    word_set.setupParams(false, false);
+    auto docids = make_dense_docids();
+    FakeWord word(docids.back() + 1, docids, "dense", word_set.getFieldsParams(), word_set.getPackedIndex());
+    for (const auto& type : getPostingTypes()) {
+        if (type.compare(0, 2, "Zc") != 0) {
+            continue; // docid delta skipping is specific to the zc posting lists
+        }
+        std::unique_ptr<FPFactory> factory(getFPFactory(type, word_set.getSchema()));
+        std::vector<const FakeWord *> words;
+        words.push_back(&word);
+        factory->setup(words);
+        auto posting = factory->make(word);
+        for (uint32_t stride : {1, 7, 9, 64, 1000}) {
+            if (posting->hasWordPositions()) {
+                TermFieldMatchData md;
+                TermFieldMatchDataArray tfmda;
+                tfmda.add(&md);
+                md.setNeedNormalFeatures(posting->enable_unpack_normal_features());
+                md.setNeedInterleavedFeatures(posting->enable_unpack_interleaved_features());
+                std::unique_ptr<SearchIterator> iterator(posting->createIterator(tfmda));
+                EXPECT_TRUE(word.validate(iterator.get(), tfmda, stride, posting->enable_unpack_normal_features(),
+                                          posting->has_interleaved_features() &&
+                                          posting->enable_unpack_interleaved_features(), false));
+            }
+            validate_seek_to_missing_docids(*posting, docids, stride * 3 + 2);
+        }
+    }
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -4,19 +4,26 @@
 #include <vespa/vespalib/util/signalhandler.h>
 #include <vespa/searchlib/common/bitvector.h>
 #include <vespa/searchlib/common/resultset.h>
+#include <vespa/searchlib/diskindex/zcbuf.h>
+#include <vespa/searchlib/diskindex/zcpostingiterators.h>
 #include <vespa/searchlib/index/docidandfeatures.h>
 #include <vespa/searchlib/test/fakedata/fake_match_loop.h>
 #include <vespa/searchlib/test/fakedata/fakeposting.h>
 #include <vespa/searchlib/test/fakedata/fakeword.h>
 #include <vespa/searchlib/test/fakedata/fakewordset.h>
 #include <vespa/searchlib/test/fakedata/fpfactory.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
 #include <vespa/vespalib/util/rand48.h>
 #include <vespa/vespalib/util/size_literals.h>
+#include <cassert>
 #include <unistd.h>
 
 #include <vespa/log/log.h>
 
 using search::ResultSet;
+using search::diskindex::ZcBuf;
+using search::diskindex::zc_skip_min_docid_distance;
+using search::diskindex::zc_skip_single_byte_docid_deltas;
 using search::fef::TermFieldMatchData;
 using search::fef::TermFieldMatchDataArray;
 using search::index::schema::CollectionType;
@@ -42,6 +49,7 @@ private:
     FakeWordSet _wordSet;
     uint32_t _stride;
     bool _unpack;
+    bool _zcDocIdSkip;
 
 public:
     vespalib::Rand48 _rnd;
@@ -67,7 +75,8 @@ usage()
            "[-t <postingType>] "
            "[-o {direct, and, or}] "
            "[-u] "
-           "[-w <numWordsPerClass>]\n");
+           "[-w <numWordsPerClass>] "
+           "[-z]\n");
 }
 
 void
@@ -101,12 +110,68 @@ PostingListBM::PostingListBM()
       _wordSet(),
       _stride(0),
       _unpack(false),
+      _zcDocIdSkip(false),
       _rnd()
 {
 }
 
 PostingListBM::~PostingListBM() = default;
 
+/*
+ * Seek through zc encoded docid deltas with the given docid stride, the
+ * same way as the zc posting iterators do, returning the number of seeks.
+ */
+template <bool useSkip>
+size_t
+seekAll(const ZcBuf &deltas, uint32_t lastDocId, uint32_t stride)
+{
+    const uint8_t *valI = deltas._mallocStart;
+    const uint8_t *valIEnd = deltas._mallocStart + deltas.size();
+    uint32_t docId = 0;
+    size_t seeks = 0;
+    for (uint32_t target = 1; target <= lastDocId; target = docId + stride) {
+        ++seeks;
+        if constexpr (useSkip) {
+            if (docId + zc_skip_min_docid_distance < target) {
+                zc_skip_single_byte_docid_deltas(valI, valIEnd, docId, target);
+            }
+        }
+        while (docId < target) {
+            ZCDECODE(valI, docId += 1 +);
+        }
+    }
+    return seeks;
+}
+
+/*
+ * Compare plain decoding of dense docid deltas with skipping of single
+ * byte docid deltas in groups of 8, for a range of seek strides.
+ */
+void
+benchmarkZcDocIdSkip(vespalib::Rand48 &rnd, uint32_t numDocs, uint32_t loops)
+{
+    ZcBuf deltas;
+    deltas.clearReserve(numDocs);
+    uint32_t docId = 0;
+    for (uint32_t i = 0; i < numDocs; ++i) {
+        uint32_t gap = ((i % 1000) == 999) ? 300 : (1 + rnd.lrand48() % 8);
+        docId += gap;
+        deltas.encode(gap - 1);
+    }
+    double budget = 1.0 * loops;
+    size_t seeks = 0;
+    for (uint32_t stride : {1, 8, 32, 128, 1024}) {
+        assert(seekAll<false>(deltas, docId, stride) == seekAll<true>(deltas, docId, stride));
+        double plainMs = vespalib::BenchmarkTimer::benchmark([&]() { seeks += seekAll<false>(deltas, docId, stride); },
+                                                             budget) * 1000.0;
+        double skipMs = vespalib::BenchmarkTimer::benchmark([&]() { seeks += seekAll<true>(deltas, docId, stride); },
+                                                            budget) * 1000.0;
+        printf("stride %5u: plain decode %8.3f ms, skip single byte deltas %8.3f ms (%.2fx)\n",
+               stride, plainMs, skipMs, plainMs / skipMs);
+    }
+    printf("%zu seeks\n", seeks);
+}
+
 int
 PostingListBM::main(int argc, char **argv)
 {
@@ -115,7 +180,7 @@ PostingListBM::main(int argc, char **argv)
     bool hasElements = false;
     bool hasElementWeights = false;
 
-    while ((c = getopt(argc, argv, "C:c:m:r:d:l:s:t:o:uw:T:q")) != -1) {
+    while ((c = getopt(argc, argv, "C:c:m:r:d:l:s:t:o:uw:T:qz")) != -1) {
         switch(c) {
         case 'C':
             _skipCommonPairsRate = atoi(optarg);
@@ -191,6 +256,9 @@ PostingListBM::main(int argc, char **argv)
         case 'w':
             _numWordsPerClass = atoi(optarg);
             break;
+        case 'z':
+            _zcDocIdSkip = true;
+            break;
         default:
             usage();
             return 1;
@@ -202,6 +270,11 @@ PostingListBM::main(int argc, char **argv)
         return 1;
     }
 
+    if (_zcDocIdSkip) {
+        benchmarkZcDocIdSkip(_rnd, _numDocs, _loops);
+        return 0;
+    }
+
     _wordSet.setupParams(hasElements, hasElementWeights);
 
     uint32_t numTasks = 40000;
@@ -52,6 +52,16 @@ TEST(GlobalFilterTest, create_can_make_test_filter) {
     verify(*filter);
 }
 
+TEST(GlobalFilterTest, create_makes_compressed_test_filter_when_sparse) {
+    std::vector<uint32_t> docs;
+    for (uint32_t docid = 2000; docid < 100000; docid += 2000) {
+        docs.push_back(docid);
+    }
+    auto filter = GlobalFilter::create(docs, 100000);
+    EXPECT_THAT(vespalib::getClassName(*filter), HasSubstr("CompressedBitVectorFilter"));
+    verify(*filter, 2000, 100000);
+}
+
 TEST(GlobalFilterTest, test_filter_requires_docs_in_order) {
     auto docs = std::vector<uint32_t>({11,33,22});
     EXPECT_THAT([&](){ GlobalFilter::create(docs, 100); }, Throws<RequireFailedException>());
@@ -187,6 +197,46 @@ TEST(GlobalFilterTest, global_filter_can_be_created_with_blueprint_using_multipl
     verify(*filter);
 }
 
+TEST(GlobalFilterTest, sparse_global_filter_created_with_blueprint_is_compressed) {
+    auto blueprint = create_blueprint(2000, 100000);
+    auto filter = GlobalFilter::create(*blueprint, 100000, ThreadBundle::trivial());
+    EXPECT_THAT(vespalib::getClassName(*filter), HasSubstr("CompressedBitVectorFilter"));
+    verify(*filter, 2000, 100000);
+}
+
+TEST(GlobalFilterTest, sparse_global_filter_created_with_blueprint_using_multiple_threads_is_compressed) {
+    SimpleThreadBundle thread_bundle(7);
+    auto blueprint = create_blueprint(2000, 100000);
+    auto filter = GlobalFilter::create(*blueprint, 100000, thread_bundle);
+    EXPECT_THAT(vespalib::getClassName(*filter), HasSubstr("CompressedBitVectorFilter"));
+    verify(*filter, 2000, 100000);
+}
+
+TEST(GlobalFilterTest, global_filter_with_dense_and_sparse_parts_is_not_compressed) {
+    SimpleThreadBundle thread_bundle(7);
+    SimpleResult result;
+    for (uint32_t docid = 1; docid < 100000; ++docid) {
+        if ((docid < 1000) ? ((docid % 2) == 0) : ((docid % 2000) == 0)) {
+            result.addHit(docid);
+        }
+    }
+    auto blueprint = std::make_unique<SimpleBlueprint>(result);
+    blueprint->setDocIdLimit(100000);
+    auto filter = GlobalFilter::create(*blueprint, 100000, thread_bundle);
+    EXPECT_THAT(vespalib::getClassName(*filter), Not(HasSubstr("CompressedBitVectorFilter")));
+    EXPECT_EQ(filter->size(), 100000u);
+    EXPECT_EQ(filter->count(), 499u + 49u);
+    for (uint32_t docid = 1; docid < 100000; ++docid) {
+        EXPECT_EQ(filter->check(docid), (docid < 1000) ? ((docid % 2) == 0) : ((docid % 2000) == 0)) << "docid " << docid;
+    }
+}
+
+TEST(GlobalFilterTest, dense_global_filter_created_with_blueprint_is_not_compressed) {
+    auto blueprint = create_blueprint();
+    auto filter = GlobalFilter::create(*blueprint, 100, ThreadBundle::trivial());
+    EXPECT_THAT(vespalib::getClassName(*filter), Not(HasSubstr("CompressedBitVectorFilter")));
+}
+
 TEST(GlobalFilterTest, multi_threaded_global_filter_works_with_few_documents) {
     SimpleThreadBundle thread_bundle(7);
     for (uint32_t limit = 1; limit < 20; ++limit) {
@@ -706,6 +706,44 @@ SearchIterator::UP create_wand(bool use_dww,
     return SearchIterator::UP(ParallelWeakAndSearch::create(terms, matchParams, RankParams(tfmd, std::move(childrenMatchData)), strict));
 }
 
+TEST(ParallelWeakAndTest, require_that_block_max_weights_do_not_change_search_result)
+{
+    // Long posting lists where only a few documents have high weight, so
+    // most posting list blocks can be skipped based on their max weight.
+    uint32_t docid_limit = 2000;
+    DocumentWeightAttributeHelper helper;
+    helper.add_docs(docid_limit);
+    SimpleResult expect;
+    for (uint32_t docid = 1; docid < docid_limit; ++docid) {
+        bool high = (docid % 97) == 0;
+        helper.set_doc(docid, docid % 2, high ? 100 : 1);
+        if (high) {
+            expect.addHit(docid);
+        }
+    }
+    std::vector<int32_t> weights = {1, 2};
+    std::vector<IDirectPostingStore::LookupResult> dict_entries;
+    for (const char *term : {"0", "1"}) {
+        dict_entries.push_back(helper.dww().lookup(term, helper.dww().get_dictionary_snapshot()));
+    }
+    for (bool use_dww : {false, true}) {
+        for (bool strict : {false, true}) {
+            SCOPED_TRACE(vespalib::make_string("use_dww=%s, strict=%s", use_dww ? "true" : "false", strict ? "true" : "false"));
+            DummyHeap heap;
+            TermFieldMatchData tfmd;
+            MatchParams match_params(heap, 50, 1.0, 1);
+            auto search = create_wand(use_dww, tfmd, match_params, weights, dict_entries, helper.dww(), strict);
+            SimpleResult actual;
+            if (strict) {
+                actual.searchStrict(*search, docid_limit);
+            } else {
+                actual.search(*search, docid_limit);
+            }
+            EXPECT_EQ(expect, actual);
+        }
+    }
+}
+
 class Verifier : public search::test::DwwIteratorChildrenVerifier {
 public:
     Verifier(bool use_dww) : _use_dww(use_dww) { }
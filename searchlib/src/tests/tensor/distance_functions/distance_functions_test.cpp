@@ -692,6 +692,26 @@ TEST(DistanceFunctionsTest, transformed_mips_growing_norm)
     EXPECT_GT(-29900.0, f->calc(t(p9d)));
 }
 
+TEST(DistanceFunctionsTest, bfloat16_cells_give_same_distance_as_float_cells)
+{
+    // values exactly representable as bfloat16, longer than one simd chunk
+    std::vector<float> lhs;
+    std::vector<float> rhs_f;
+    std::vector<vespalib::BFloat16> rhs_bf;
+    for (size_t i = 0; i < 77; ++i) {
+        lhs.push_back(float(int(i % 13) - 6) * 0.25f);
+        rhs_f.push_back(float(int(i % 7) - 3) * 0.5f);
+        rhs_bf.emplace_back(rhs_f.back());
+    }
+    EuclideanDistanceFunctionFactory<vespalib::BFloat16> euclid;
+    AngularDistanceFunctionFactory<float> angular;
+    PrenormalizedAngularDistanceFunctionFactory<float> prenorm;
+    MipsDistanceFunctionFactory<float> mips;
+    for (DistanceFunctionFactory *dff : std::vector<DistanceFunctionFactory *>{&euclid, &angular, &prenorm, &mips}) {
+        auto f = dff->for_insertion_vector(t(lhs));
+        EXPECT_FLOAT_EQ(f->calc(t(rhs_f)), f->calc(t(rhs_bf)));
+    }
+}
 
 GTEST_MAIN_RUN_ALL_TESTS()
 
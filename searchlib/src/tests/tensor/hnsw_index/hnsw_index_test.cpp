@@ -37,6 +37,8 @@ using vespalib::eval::get_cell_type;
 using vespalib::eval::ValueType;
 using vespalib::datastore::CompactionSpec;
 using vespalib::datastore::CompactionStrategy;
+using search::attribute::VectorQuantizationParams;
+using search::attribute::VectorQuantizationType;
 using search::queryeval::GlobalFilter;
 using search::test::VectorBufferReader;
 using search::test::VectorBufferWriter;
@@ -115,11 +117,16 @@ public:
     }
 
     void init(bool heuristic_select_neighbors) {
+        init(heuristic_select_neighbors, VectorQuantizationParams());
+    }
+    void init(bool heuristic_select_neighbors, const VectorQuantizationParams& quantization) {
         auto generator = std::make_unique<LevelGenerator>();
         level_generator = generator.get();
+        HnswIndexConfig cfg(5, 2, 10, 0, heuristic_select_neighbors);
+        cfg.set_quantization(quantization);
         index = std::make_unique<IndexType>(vectors, dff(),
                                             std::move(generator),
-                                            HnswIndexConfig(5, 2, 10, 0, heuristic_select_neighbors));
+                                            cfg);
     }
     void add_document(uint32_t docid, uint32_t max_level = 0) {
         level_generator->level = max_level;
@@ -716,7 +723,7 @@ make_graph_helper(HnswIndex<type>& index)
                 if constexpr (std::is_same_v<std::remove_reference_t<decltype(node)>, std::vector<uint32_t>>) {
                     node.emplace_back(level_array[level].load_relaxed().ref());
                 } else {
-                    LinkArrayRef link_array(graph.get_link_array(level_array, level));
+                    LinkArrayRef link_array(graph.get_link_array(doc_id, level_array, level));
                     node.emplace_back(std::vector<uint32_t>(link_array.begin(), link_array.end()));
                 }
             }
@@ -824,6 +831,78 @@ TYPED_TEST(HnswIndexTest, hnsw_graph_can_be_saved_and_loaded)
     this->check_savetest_index("after load");
 }
 
+TYPED_TEST(HnswIndexTest, quantizer_is_trained_and_results_are_rescored)
+{
+    this->init(true, VectorQuantizationParams(VectorQuantizationType::Int8, 0, 5, 2.0));
+    for (uint32_t docid = 1; docid < 5; ++docid) {
+        this->add_document(docid);
+    }
+    EXPECT_FALSE(this->index->get_quantized_vectors().ready());
+    for (uint32_t docid = 5; docid < 10; ++docid) {
+        this->add_document(docid);
+    }
+    this->index->wait_for_quantizer_training();
+    this->commit();
+    const auto& quantized = this->index->get_quantized_vectors();
+    EXPECT_TRUE(quantized.ready());
+    EXPECT_EQ(2u, quantized.code_size());
+    EXPECT_EQ(10u, quantized.acquire_nodeid_limit());
+    this->expect_top_3_by_docid("{3,4.6}", {3, 4.6}, {3, 7, 9});
+    this->expect_top_3_by_docid("{8,3}", {8, 3}, {5, 6, 9});
+    this->expect_top_3_by_docid("{0,3}", {0, 3}, {3, 4, 8});
+    auto qv = this->vectors.get_vector(7, 0);
+    auto df = this->index->distance_function_factory().for_query_vector(qv);
+    auto hits = this->index->find_top_k(1, *df, 1, this->_doom->get_doom(), 10000.0);
+    ASSERT_EQ(1, hits.size());
+    EXPECT_EQ(7, hits[0].docid);
+    EXPECT_DOUBLE_EQ(0.0, hits[0].distance); // rescored with original vector cells
+}
+
+TYPED_TEST(HnswIndexTest, quantizer_is_trained_in_background_and_installed_at_commit)
+{
+    this->init(true, VectorQuantizationParams(VectorQuantizationType::Product, 1, 5, 2.0));
+    for (uint32_t docid = 1; docid < 5; ++docid) {
+        this->add_document(docid);
+    }
+    this->level_generator->level = 0;
+    this->index->add_document(5); // starts training
+    this->index->wait_for_quantizer_training();
+    const auto& quantized = this->index->get_quantized_vectors();
+    EXPECT_FALSE(quantized.ready());
+    EXPECT_EQ(nullptr, quantized.quantizer());
+    this->index->add_document(6); // added before the trained quantizer is installed
+    this->commit();
+    EXPECT_TRUE(quantized.ready());
+    EXPECT_EQ(7u, quantized.acquire_nodeid_limit());
+    this->add_document(7); // encoded when added
+    EXPECT_EQ(8u, quantized.acquire_nodeid_limit());
+    this->expect_top_3_by_docid("{2.1,3}", {2.1, 3}, {1, 2, 3});
+}
+
+TYPED_TEST(HnswIndexTest, quantizer_codebook_is_saved_after_graph)
+{
+    this->init(false, VectorQuantizationParams(VectorQuantizationType::Product, 1, 2, 2.0));
+    this->make_savetest_index();
+    this->index->wait_for_quantizer_training();
+    this->commit();
+    const auto& quantized = this->index->get_quantized_vectors();
+    ASSERT_TRUE(quantized.ready());
+    auto codebook = quantized.quantizer()->get_codebook();
+    EXPECT_EQ(2 * 256u, codebook.size());
+    HnswIndexSaver saver(this->index->get_graph(), codebook);
+    VectorBufferWriter vector_writer;
+    saver.save(vector_writer);
+    this->init(false);
+    auto& graph = this->index->get_graph();
+    auto& id_mapping = this->index->get_id_mapping();
+    HnswIndexLoader<VectorBufferReader, TypeParam::index_type> loader(graph, id_mapping,
+                                                                      std::make_unique<VectorBufferReader>(vector_writer.output),
+                                                                      codebook.size());
+    while (loader.load_next()) {}
+    this->check_savetest_index("after load");
+    EXPECT_EQ(codebook, loader.quantizer_codebook());
+}
+
 using HnswMultiIndexTest = HnswIndexTest<HnswIndex<HnswIndexType::MULTI>>;
 
 namespace {
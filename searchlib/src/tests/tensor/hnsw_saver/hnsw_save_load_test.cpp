@@ -1,15 +1,18 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
+#include <vespa/fastos/file.h>
 #include <vespa/searchlib/tensor/hnsw_graph.h>
 #include <vespa/searchlib/tensor/hnsw_identity_mapping.h>
 #include <vespa/searchlib/tensor/hnsw_index_saver.h>
 #include <vespa/searchlib/tensor/hnsw_index_loader.hpp>
 #include <vespa/searchlib/tensor/hnsw_index_traits.h>
+#include <vespa/searchlib/tensor/hnsw_mapped_index_loader.h>
 #include <vespa/searchlib/tensor/hnsw_nodeid_mapping.h>
 #include <vespa/searchlib/test/vector_buffer_reader.h>
 #include <vespa/searchlib/test/vector_buffer_writer.h>
 #include <vespa/searchlib/util/fileutil.h>
 #include <vespa/vespalib/gtest/gtest.h>
+#include <cstring>
 #include <vector>
 
 #include <vespa/log/log.h>
@@ -122,6 +125,7 @@ class CopyGraphTest : public ::testing::Test {
 public:
     GraphType original;
     GraphType copy;
+    std::vector<uint64_t> mapped_data;
 
     void expect_empty_d(uint32_t nodeid) const {
         EXPECT_FALSE(copy.acquire_levels_ref(nodeid).valid());
@@ -147,12 +151,38 @@ public:
         }
     }
 
-    std::vector<char> save_original() const {
-        HnswIndexSaver saver(original);
+    static std::vector<char> save(const GraphType& graph, bool save_link_offsets) {
+        HnswIndexSaver saver(graph, std::vector<float>(), save_link_offsets);
         VectorBufferWriter vector_writer;
         saver.save(vector_writer);
         return vector_writer.output;
     }
+    std::vector<char> save_original(bool save_link_offsets = false) const {
+        return save(original, save_link_offsets);
+    }
+    void map_copy(const std::vector<char>& data) {
+        // The mapped loader requires 8 byte aligned data, like a memory mapped file after the file header
+        mapped_data.resize((data.size() + 7) / 8);
+        memcpy(mapped_data.data(), data.data(), data.size());
+        typename HnswIndexTraits<GraphType::index_type>::IdMapping id_mapping;
+        HnswMappedIndexLoader<GraphType::index_type> loader(copy, id_mapping, {}, mapped_data.data(), data.size());
+        while (loader.load_next()) {}
+    }
+    static HnswMappedLinks::Footer get_footer(const std::vector<char>& data) {
+        HnswMappedLinks::Footer footer;
+        memcpy(&footer, data.data() + data.size() - sizeof(footer), sizeof(footer));
+        return footer;
+    }
+    template <typename T>
+    static T peek(const std::vector<char>& data, size_t pos) {
+        T value;
+        memcpy(&value, data.data() + pos, sizeof(T));
+        return value;
+    }
+    template <typename T>
+    static void poke(std::vector<char>& data, size_t pos, T value) {
+        memcpy(data.data() + pos, &value, sizeof(T));
+    }
     void load_copy(std::vector<char> data) {
         typename HnswIndexTraits<GraphType::index_type>::IdMapping id_mapping;
         HnswIndexLoader<VectorBufferReader, GraphType::index_type> loader(copy, id_mapping, std::make_unique<VectorBufferReader>(data));
@@ -214,4 +244,123 @@ TYPED_TEST(CopyGraphTest, later_changes_ignored)
     this->expect_copy_as_populated();
 }
 
+TYPED_TEST(CopyGraphTest, graph_with_link_offsets_can_be_loaded_by_regular_loader)
+{
+    populate(this->original);
+    auto data = this->save_original(true);
+    EXPECT_LT(this->save_original().size(), data.size());
+    this->load_copy(data);
+    this->expect_copy_as_populated();
+    EXPECT_FALSE(this->copy.mapped_links);
+}
+
+TYPED_TEST(CopyGraphTest, reconstructs_mapped_graph)
+{
+    populate(this->original);
+    auto data = this->save_original(true);
+    this->map_copy(data);
+    this->expect_copy_as_populated();
+    ASSERT_TRUE(this->copy.mapped_links);
+    EXPECT_EQ(6, this->copy.mapped_links->num_link_arrays());
+}
+
+TYPED_TEST(CopyGraphTest, updated_links_in_mapped_graph_are_stored_in_memory)
+{
+    populate(this->original);
+    this->map_copy(this->save_original(true));
+    this->copy.set_link_array(1, 0, V{2, 4});
+    this->copy.set_link_array(2, 0, V{1, 4});
+    this->copy.remove_node(6);
+    this->expect_level_0(1, {2, 4});
+    this->expect_level_0(2, {1, 4});
+    this->expect_level_1(2, {4}); // not updated, but moved to the store with the rest of the node
+    this->expect_level_0(4, {1, 2, 6});
+    this->expect_empty_d(6);
+    EXPECT_FALSE(this->copy.is_mapped(1));
+    EXPECT_FALSE(this->copy.is_mapped(2));
+    EXPECT_TRUE(this->copy.is_mapped(4));
+    EXPECT_FALSE(this->copy.is_mapped(6));
+    EXPECT_TRUE(this->copy.acquire_level_array(2)[1].load_relaxed().valid());
+    EXPECT_FALSE(this->copy.acquire_level_array(4)[1].load_relaxed().valid());
+}
+
+TYPED_TEST(CopyGraphTest, mapped_graph_with_updates_is_saved_like_in_memory_graph)
+{
+    populate(this->original);
+    this->map_copy(this->save_original(true));
+    modify(this->original);
+    modify(this->copy);
+    EXPECT_EQ(this->save_original(true), this->save(this->copy, true));
+}
+
+TYPED_TEST(CopyGraphTest, mapped_graph_can_be_saved_again)
+{
+    populate(this->original);
+    auto data = this->save_original(true);
+    this->map_copy(data);
+    EXPECT_EQ(data, this->save(this->copy, true));
+}
+
+TYPED_TEST(CopyGraphTest, mapped_loader_rejects_link_offsets_out_of_order)
+{
+    populate(this->original);
+    auto data = this->save_original(true);
+    auto footer = this->get_footer(data);
+    size_t link_offsets_pos = footer.trailer_offset * sizeof(uint32_t);
+    auto first_offset = this->template peek<uint64_t>(data, link_offsets_pos);
+    this->poke(data, link_offsets_pos + sizeof(uint64_t), first_offset);
+    EXPECT_THROW(this->map_copy(data), std::runtime_error);
+    EXPECT_FALSE(this->copy.mapped_links);
+}
+
+TYPED_TEST(CopyGraphTest, mapped_loader_rejects_link_offset_beyond_trailer)
+{
+    populate(this->original);
+    auto data = this->save_original(true);
+    auto footer = this->get_footer(data);
+    size_t last_offset_pos = footer.trailer_offset * sizeof(uint32_t) + (footer.num_link_arrays - 1) * sizeof(uint64_t);
+    this->poke(data, last_offset_pos, footer.trailer_offset);
+    EXPECT_THROW(this->map_copy(data), std::runtime_error);
+    EXPECT_FALSE(this->copy.mapped_links);
+}
+
+TYPED_TEST(CopyGraphTest, mapped_loader_rejects_first_link_arrays_out_of_order)
+{
+    populate(this->original);
+    auto data = this->save_original(true);
+    auto footer = this->get_footer(data);
+    size_t first_link_array_pos = footer.trailer_offset * sizeof(uint32_t) + footer.num_link_arrays * sizeof(uint64_t);
+    EXPECT_EQ(3u, this->template peek<uint32_t>(data, first_link_array_pos + 4 * sizeof(uint32_t)));
+    this->poke(data, first_link_array_pos + 4 * sizeof(uint32_t), uint32_t(0));
+    EXPECT_THROW(this->map_copy(data), std::runtime_error);
+    EXPECT_FALSE(this->copy.mapped_links);
+}
+
+TYPED_TEST(CopyGraphTest, mapped_loader_rejects_entry_node_beyond_nodes)
+{
+    populate(this->original);
+    auto data = this->save_original(true);
+    // Entry nodeid, entry level and number of nodes are the first words
+    auto num_nodes = this->template peek<uint32_t>(data, 2 * sizeof(uint32_t));
+    this->poke(data, 0, num_nodes);
+    EXPECT_THROW(this->map_copy(data), std::runtime_error);
+    EXPECT_FALSE(this->copy.mapped_links);
+}
+
+TYPED_TEST(CopyGraphTest, mapped_loader_rejects_entry_level_beyond_levels_of_entry_node)
+{
+    populate(this->original);
+    auto data = this->save_original(true);
+    this->poke(data, sizeof(uint32_t), int32_t(2));
+    EXPECT_THROW(this->map_copy(data), std::runtime_error);
+    EXPECT_FALSE(this->copy.mapped_links);
+}
+
+TYPED_TEST(CopyGraphTest, mapped_loader_rejects_graph_without_link_offsets)
+{
+    populate(this->original);
+    EXPECT_THROW(this->map_copy(this->save_original()), std::runtime_error);
+    EXPECT_FALSE(this->copy.mapped_links);
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,244 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/tensor/distance_function_factory.h>
+#include <vespa/searchlib/tensor/int8_scalar_quantizer.h>
+#include <vespa/searchlib/tensor/product_quantizer.h>
+#include <vespa/searchlib/tensor/quantized_vector_store.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <cmath>
+#include <random>
+
+using namespace search::tensor;
+using search::attribute::DistanceMetric;
+using search::attribute::VectorQuantizationParams;
+using search::attribute::VectorQuantizationType;
+using vespalib::eval::CellType;
+using vespalib::eval::TypedCells;
+
+namespace {
+
+constexpr uint32_t dims = 16;
+
+std::vector<float>
+make_samples(uint32_t num_samples)
+{
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> dist(-3.0f, 5.0f);
+    std::vector<float> samples(size_t(num_samples) * dims);
+    for (auto& value : samples) {
+        value = dist(gen);
+    }
+    return samples;
+}
+
+double
+max_abs_error(const VectorQuantizer& quantizer, vespalib::ConstArrayRef<float> vector)
+{
+    std::vector<uint8_t> code(quantizer.code_size());
+    std::vector<float> decoded(quantizer.dims());
+    quantizer.encode(vector, code);
+    quantizer.decode(code, decoded);
+    double result = 0.0;
+    for (uint32_t i = 0; i < vector.size(); ++i) {
+        result = std::max(result, std::abs(double(vector[i]) - decoded[i]));
+    }
+    return result;
+}
+
+void
+expect_products_match_decoded(const VectorQuantizer& quantizer, vespalib::ConstArrayRef<float> query,
+                              vespalib::ConstArrayRef<float> vector)
+{
+    std::vector<uint8_t> code(quantizer.code_size());
+    std::vector<float> decoded(quantizer.dims());
+    quantizer.encode(vector, code);
+    quantizer.decode(code, decoded);
+    double dot_product = 0.0;
+    double norm_sq = 0.0;
+    for (uint32_t i = 0; i < decoded.size(); ++i) {
+        dot_product += double(query[i]) * decoded[i];
+        norm_sq += double(decoded[i]) * decoded[i];
+    }
+    auto products = quantizer.prepare_query(query)->calc(code);
+    EXPECT_NEAR(dot_product, products.dot_product, 1e-3);
+    EXPECT_NEAR(norm_sq, products.norm_sq, 1e-3);
+}
+
+}
+
+TEST(VectorQuantizerTest, factory_creates_quantizer_with_expected_code_size)
+{
+    EXPECT_FALSE(make_vector_quantizer(VectorQuantizationParams(), dims));
+    auto int8 = make_vector_quantizer(VectorQuantizationParams(VectorQuantizationType::Int8, 0, 100, 2.0), dims);
+    ASSERT_TRUE(int8);
+    EXPECT_EQ(VectorQuantizationType::Int8, int8->type());
+    EXPECT_EQ(dims, int8->code_size());
+    auto pq = make_vector_quantizer(VectorQuantizationParams(VectorQuantizationType::Product, 0, 100, 2.0), dims);
+    ASSERT_TRUE(pq);
+    EXPECT_EQ(VectorQuantizationType::Product, pq->type());
+    EXPECT_EQ(dims / 4, pq->code_size());
+    auto pq8 = make_vector_quantizer(VectorQuantizationParams(VectorQuantizationType::Product, 8, 100, 2.0), dims);
+    EXPECT_EQ(8u, pq8->code_size());
+}
+
+TEST(VectorQuantizerTest, type_names_can_be_converted)
+{
+    for (auto type : {VectorQuantizationType::None, VectorQuantizationType::Int8, VectorQuantizationType::Product}) {
+        EXPECT_EQ(type, VectorQuantizer::type_from_string(VectorQuantizer::type_to_string(type)));
+    }
+}
+
+TEST(VectorQuantizerTest, int8_scalar_quantizer_error_is_bounded_by_half_step)
+{
+    uint32_t num_samples = 200;
+    auto samples = make_samples(num_samples);
+    Int8ScalarQuantizer quantizer(dims);
+    quantizer.train(samples, num_samples);
+    double step = 8.0 / 255;
+    for (uint32_t i = 0; i < num_samples; ++i) {
+        vespalib::ConstArrayRef<float> vector(samples.data() + i * dims, dims);
+        EXPECT_LE(max_abs_error(quantizer, vector), 0.5 * step + 1e-6);
+    }
+}
+
+TEST(VectorQuantizerTest, int8_scalar_quantizer_clamps_values_outside_trained_range)
+{
+    std::vector<float> samples(dims, 0.0f);
+    samples.resize(2 * dims, 1.0f);
+    Int8ScalarQuantizer quantizer(dims);
+    quantizer.train(samples, 2);
+    std::vector<float> vector(dims, 10.0f);
+    std::vector<uint8_t> code(dims);
+    std::vector<float> decoded(dims);
+    quantizer.encode(vector, code);
+    quantizer.decode(code, decoded);
+    EXPECT_EQ(127, static_cast<int8_t>(code[0]));
+    EXPECT_NEAR(1.0f, decoded[0], 1e-6);
+    std::fill(vector.begin(), vector.end(), -10.0f);
+    quantizer.encode(vector, code);
+    quantizer.decode(code, decoded);
+    EXPECT_EQ(-128, static_cast<int8_t>(code[0]));
+    EXPECT_NEAR(0.0f, decoded[0], 1e-6);
+}
+
+TEST(VectorQuantizerTest, product_quantizer_reconstructs_clustered_vectors)
+{
+    // Vectors drawn from a small number of distinct points are reconstructed exactly.
+    uint32_t num_points = 10;
+    auto points = make_samples(num_points);
+    uint32_t num_samples = 300;
+    std::vector<float> samples;
+    for (uint32_t i = 0; i < num_samples; ++i) {
+        auto point = points.begin() + (i % num_points) * dims;
+        samples.insert(samples.end(), point, point + dims);
+    }
+    ProductQuantizer quantizer(dims, 4);
+    quantizer.train(samples, num_samples);
+    for (uint32_t i = 0; i < num_points; ++i) {
+        vespalib::ConstArrayRef<float> vector(points.data() + i * dims, dims);
+        EXPECT_LE(max_abs_error(quantizer, vector), 1e-5);
+    }
+}
+
+TEST(VectorQuantizerTest, product_quantizer_supports_uneven_sub_vectors)
+{
+    uint32_t num_samples = 500;
+    auto samples = make_samples(num_samples);
+    ProductQuantizer quantizer(dims, 5);
+    quantizer.train(samples, num_samples);
+    EXPECT_EQ(5u, quantizer.code_size());
+    vespalib::ConstArrayRef<float> vector(samples.data(), dims);
+    EXPECT_LT(max_abs_error(quantizer, vector), 8.0);
+}
+
+TEST(VectorQuantizerTest, query_products_are_calculated_on_codes)
+{
+    uint32_t num_samples = 300;
+    auto samples = make_samples(num_samples);
+    Int8ScalarQuantizer int8(dims);
+    int8.train(samples, num_samples);
+    ProductQuantizer pq(dims, 5);
+    pq.train(samples, num_samples);
+    vespalib::ConstArrayRef<float> query(samples.data(), dims);
+    for (uint32_t i = 1; i < 10; ++i) {
+        vespalib::ConstArrayRef<float> vector(samples.data() + i * dims, dims);
+        expect_products_match_decoded(int8, query, vector);
+        expect_products_match_decoded(pq, query, vector);
+    }
+}
+
+TEST(VectorQuantizerTest, codebook_can_be_restored)
+{
+    uint32_t num_samples = 300;
+    auto samples = make_samples(num_samples);
+    ProductQuantizer trained(dims, 4);
+    trained.train(samples, num_samples);
+    ProductQuantizer restored(dims, 4);
+    EXPECT_FALSE(restored.set_codebook(std::vector<float>(3)));
+    EXPECT_TRUE(restored.set_codebook(trained.get_codebook()));
+    std::vector<uint8_t> code_1(4);
+    std::vector<uint8_t> code_2(4);
+    vespalib::ConstArrayRef<float> vector(samples.data() + dims, dims);
+    trained.encode(vector, code_1);
+    restored.encode(vector, code_2);
+    EXPECT_EQ(code_1, code_2);
+}
+
+TEST(QuantizedVectorStoreTest, codes_are_decoded_by_reader)
+{
+    uint32_t num_samples = 20;
+    auto samples = make_samples(num_samples);
+    auto quantizer = std::make_unique<Int8ScalarQuantizer>(dims);
+    quantizer->train(samples, num_samples);
+    QuantizedVectorStore store;
+    EXPECT_FALSE(store.ready());
+    store.set_quantizer(std::move(quantizer));
+    std::vector<double> vector(samples.begin() + dims, samples.begin() + 2 * dims);
+    store.encode(3, TypedCells(vespalib::ConstArrayRef<double>(vector)));
+    store.publish();
+    EXPECT_TRUE(store.ready());
+    EXPECT_EQ(4u, store.acquire_nodeid_limit());
+    EXPECT_LE(4 * dims, store.memory_usage().usedBytes());
+    std::vector<float> query(dims, 1.0f);
+    auto df = make_distance_function_factory(DistanceMetric::Euclidean, CellType::FLOAT)->for_query_vector(TypedCells(query));
+    QuantizedVectorReader reader(store, *df);
+    EXPECT_TRUE(reader.has_code(3));
+    EXPECT_FALSE(reader.has_code(4));
+    auto decoded = reader.decode(3);
+    ASSERT_EQ(dims, decoded.size);
+    auto values = decoded.typify<float>();
+    for (uint32_t i = 0; i < dims; ++i) {
+        EXPECT_NEAR(vector[i], values[i], 0.02);
+    }
+    EXPECT_EQ(0u, reader.decode(4).size);
+}
+
+TEST(QuantizedVectorStoreTest, reader_distances_match_distances_to_decoded_vectors)
+{
+    uint32_t num_samples = 300;
+    auto samples = make_samples(num_samples);
+    for (auto type : {VectorQuantizationType::Int8, VectorQuantizationType::Product}) {
+        auto quantizer = make_vector_quantizer(VectorQuantizationParams(type, 4, num_samples, 2.0), dims);
+        quantizer->train(samples, num_samples);
+        QuantizedVectorStore store;
+        store.set_quantizer(std::move(quantizer));
+        for (uint32_t nodeid = 1; nodeid < 10; ++nodeid) {
+            store.encode(nodeid, TypedCells(vespalib::ConstArrayRef<float>(samples.data() + nodeid * dims, dims)));
+        }
+        store.publish();
+        for (auto metric : {DistanceMetric::Euclidean, DistanceMetric::Angular,
+                            DistanceMetric::PrenormalizedAngular, DistanceMetric::Dotproduct})
+        {
+            SCOPED_TRACE(VectorQuantizer::type_to_string(type));
+            auto factory = make_distance_function_factory(metric, CellType::FLOAT);
+            auto df = factory->for_query_vector(TypedCells(vespalib::ConstArrayRef<float>(samples.data(), dims)));
+            QuantizedVectorReader reader(store, *df);
+            for (uint32_t nodeid = 1; nodeid < 10; ++nodeid) {
+                double expected = df->calc(reader.decode(nodeid));
+                EXPECT_NEAR(expected, reader.calc_distance(nodeid), 1e-3 * std::max(1.0, std::abs(expected)));
+            }
+        }
+    }
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
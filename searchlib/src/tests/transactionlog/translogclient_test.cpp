@@ -1,4 +1,5 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/searchlib/transactionlog/commit_scheduler.h>
 #include <vespa/searchlib/transactionlog/translogclient.h>
 #include <vespa/searchlib/transactionlog/translogserver.h>
 #include <vespa/searchlib/test/directory_handler.h>
@@ -908,6 +909,60 @@ TEST("testSync") {
     EXPECT_EQUAL(syncedTo, TOTAL_NUM_ENTRIES);
 }
 
+TEST("require that fsync of commits to several domains is coalesced by group commit") {
+    const unsigned int NUM_PACKETS = 20;
+    const unsigned int NUM_ENTRIES = 4;
+
+    DummyFileHeaderContext fileHeaderContext;
+    test::DirectoryHandler testDir("test_group_commit");
+    TLS tlss(testDir.getDir(), 18377, ".", fileHeaderContext,
+             createDomainConfig(0x1000000).setFSyncOnCommit(true).setGroupCommitMaxLatency(20ms));
+    TransLogClient tls(tlss.transport, "tcp/localhost:18377");
+    createDomainTest(tls, "gc1", 0);
+    createDomainTest(tls, "gc2", 1);
+    {
+        vespalib::Gate gate;
+        auto onDone = std::make_shared<vespalib::GateCallback>(gate);
+        fillDomainTest(onDone, tlss.tls, "gc1", NUM_PACKETS, NUM_ENTRIES);
+        fillDomainTest(onDone, tlss.tls, "gc2", NUM_PACKETS, NUM_ENTRIES);
+        onDone.reset();
+        gate.await();
+    }
+    DomainStats stats = tlss.tls.getDomainStats();
+    for (const auto & name : {"gc1", "gc2"}) {
+        const CommitLatencyStats & latency = stats[name].commitLatency;
+        EXPECT_EQUAL(NUM_PACKETS, latency.count);
+        uint64_t bucketSum(0);
+        for (uint64_t bucket : latency.buckets) {
+            bucketSum += bucket;
+        }
+        EXPECT_EQUAL(latency.count, bucketSum);
+        EXPECT_GREATER(latency.maxSeconds, 0.0);
+        EXPECT_LESS_EQUAL(latency.maxSeconds, latency.sumSeconds);
+        EXPECT_EQUAL(NUM_PACKETS * NUM_ENTRIES, stats[name].numEntries);
+    }
+    // Every packet is committed on its own, syncs of commits arriving within the window are coalesced
+    uint64_t numSyncs = tlss.tls.getCommitScheduler().getNumSyncs();
+    EXPECT_GREATER(numSyncs, 0u);
+    EXPECT_LESS(numSyncs, 2 * NUM_PACKETS);
+}
+
+TEST("require that fsync of commits is done by each domain when group commit is disabled") {
+    const unsigned int NUM_PACKETS = 5;
+    const unsigned int NUM_ENTRIES = 4;
+
+    DummyFileHeaderContext fileHeaderContext;
+    test::DirectoryHandler testDir("test_no_group_commit");
+    TLS tlss(testDir.getDir(), 18377, ".", fileHeaderContext, createDomainConfig(0x1000000).setFSyncOnCommit(true));
+    TransLogClient tls(tlss.transport, "tcp/localhost:18377");
+    createDomainTest(tls, "ngc", 0);
+    fillDomainTest(tlss.tls, "ngc", NUM_PACKETS, NUM_ENTRIES);
+    DomainStats stats = tlss.tls.getDomainStats();
+    EXPECT_EQUAL(NUM_PACKETS, stats["ngc"].commitLatency.count);
+    EXPECT_EQUAL(NUM_PACKETS * NUM_ENTRIES, stats["ngc"].numEntries);
+    EXPECT_EQUAL(0u, tlss.tls.getCommitScheduler().getNumSyncs());
+}
+
 TEST("test truncate on version mismatch") {
     const unsigned int NUM_PACKETS = 3;
     const unsigned int NUM_ENTRIES = 4;
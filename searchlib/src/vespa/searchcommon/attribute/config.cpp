@@ -23,6 +23,8 @@ Config::Config(BasicType bt, CollectionType ct, bool fastSearch_) noexcept
       _fastAccess(false),
       _mutable(false),
       _paged(false),
+      _huge_pages(false),
+      _multi_threaded_feed(false),
       _distance_metric(DistanceMetric::Euclidean),
       _match(Match::UNCASED),
       _dictionary(),
@@ -51,6 +53,8 @@ Config::operator==(const Config &b) const noexcept
            _fastAccess == b._fastAccess &&
            _mutable == b._mutable &&
            _paged == b._paged &&
+           _huge_pages == b._huge_pages &&
+           _multi_threaded_feed == b._multi_threaded_feed &&
            _maxUnCommittedMemory == b._maxUnCommittedMemory &&
            _match == b._match &&
            _dictionary == b._dictionary &&
@@ -37,6 +37,7 @@ public:
     CollectionType collectionType()       const noexcept { return _type; }
     bool fastSearch()                     const noexcept { return _fastSearch; }
     bool paged()                          const noexcept { return _paged; }
+    bool huge_pages()                     const noexcept { return _huge_pages; }
     const PredicateParams &predicateParams() const noexcept { return _predicateParams; }
     const vespalib::eval::ValueType & tensorType() const noexcept { return _tensorType; }
     DistanceMetric distance_metric() const noexcept { return _distance_metric; }
@@ -55,6 +56,16 @@ public:
      */
     bool fastAccess() const noexcept { return _fastAccess; }
 
+    /**
+     * Check if puts to this attribute should be prepared by the shared
+     * executor before being completed in the attribute write thread.
+     * Only used for single value string attributes, where the prepare
+     * step looks up the value in the enum store dictionary. New values are
+     * still inserted by the attribute write thread, so this only pays off
+     * for low cardinality attributes.
+     */
+    bool multi_threaded_feed() const noexcept { return _multi_threaded_feed; }
+
     const GrowStrategy & getGrowStrategy() const { return _growStrategy; }
     const CompactionStrategy &getCompactionStrategy() const { return _compactionStrategy; }
     const DictionaryConfig & get_dictionary_config() const { return _dictionary; }
@@ -84,7 +95,9 @@ public:
     Config & setIsFilter(bool isFilter) { _isFilter = isFilter; return *this; }
     Config & setMutable(bool isMutable) { _mutable = isMutable; return *this; }
     Config & setPaged(bool paged_in) { _paged = paged_in; return *this; }
+    Config & set_huge_pages(bool v) { _huge_pages = v; return *this; }
     Config & setFastAccess(bool v) { _fastAccess = v; return *this; }
+    Config & set_multi_threaded_feed(bool v) { _multi_threaded_feed = v; return *this; }
     Config & setGrowStrategy(const GrowStrategy &gs) { _growStrategy = gs; return *this; }
     Config & setCompactionStrategy(const CompactionStrategy &compactionStrategy) {
         _compactionStrategy = compactionStrategy;
@@ -106,6 +119,8 @@ private:
     bool           _fastAccess : 1;
     bool           _mutable : 1;
     bool           _paged : 1;
+    bool           _huge_pages : 1;
+    bool           _multi_threaded_feed : 1;
     DistanceMetric                 _distance_metric;
     Match                          _match;
     DictionaryConfig               _dictionary;
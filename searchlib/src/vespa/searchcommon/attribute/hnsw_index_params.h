@@ -3,6 +3,7 @@
 #pragma once
 
 #include "distance_metric.h"
+#include "vector_quantization_params.h"
 
 namespace search::attribute {
 
@@ -17,6 +18,8 @@ private:
     // This is always the same as in the attribute config, and is duplicated here to simplify usage.
     DistanceMetric _distance_metric;
     bool _multi_threaded_indexing;
+    VectorQuantizationParams _quantization;
+    bool _mapped_graph;
 
 public:
     HnswIndexParams(uint32_t max_links_per_node_in,
@@ -26,19 +29,33 @@ public:
             : _max_links_per_node(max_links_per_node_in),
               _neighbors_to_explore_at_insert(neighbors_to_explore_at_insert_in),
               _distance_metric(distance_metric_in),
-              _multi_threaded_indexing(multi_threaded_indexing_in)
+              _multi_threaded_indexing(multi_threaded_indexing_in),
+              _quantization(),
+              _mapped_graph(false)
     {}
 
     uint32_t max_links_per_node() const { return _max_links_per_node; }
     uint32_t neighbors_to_explore_at_insert() const { return _neighbors_to_explore_at_insert; }
     DistanceMetric distance_metric() const { return _distance_metric; }
     bool multi_threaded_indexing() const { return _multi_threaded_indexing; }
+    const VectorQuantizationParams& quantization() const { return _quantization; }
+    HnswIndexParams& set_quantization(const VectorQuantizationParams& quantization_in) {
+        _quantization = quantization_in;
+        return *this;
+    }
+    bool mapped_graph() const { return _mapped_graph; }
+    HnswIndexParams& set_mapped_graph(bool mapped_graph_in) {
+        _mapped_graph = mapped_graph_in;
+        return *this;
+    }
 
     bool operator==(const HnswIndexParams& rhs) const {
         return (_max_links_per_node == rhs._max_links_per_node &&
                 _neighbors_to_explore_at_insert == rhs._neighbors_to_explore_at_insert &&
                 _distance_metric == rhs._distance_metric &&
-                _multi_threaded_indexing == rhs._multi_threaded_indexing);
+                _multi_threaded_indexing == rhs._multi_threaded_indexing &&
+                _quantization == rhs._quantization &&
+                _mapped_graph == rhs._mapped_graph);
     }
 };
 
@@ -0,0 +1,55 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+
+namespace search::attribute {
+
+enum class VectorQuantizationType : uint8_t { None, Int8, Product };
+
+/**
+ * Configuration parameters for an optional quantized representation of the
+ * vectors in a hnsw index. The quantized vectors are used when traversing the
+ * graph at query time, and the best candidates are rescored using the original
+ * vector cells.
+ */
+class VectorQuantizationParams {
+private:
+    VectorQuantizationType _type;
+    // Number of sub-vectors (code bytes per vector) used by product quantization. 0 means dimensions / 4.
+    uint32_t _subvectors;
+    // Number of indexed vectors sampled when training the quantizer.
+    uint32_t _training_samples;
+    // Multiplier applied to explore_k when selecting candidates for full precision rescoring.
+    double _rescore_factor;
+
+public:
+    VectorQuantizationParams() noexcept
+        : VectorQuantizationParams(VectorQuantizationType::None, 0, 10000, 2.0)
+    {}
+    VectorQuantizationParams(VectorQuantizationType type_in,
+                             uint32_t subvectors_in,
+                             uint32_t training_samples_in,
+                             double rescore_factor_in) noexcept
+        : _type(type_in),
+          _subvectors(subvectors_in),
+          _training_samples(training_samples_in),
+          _rescore_factor(rescore_factor_in < 1.0 ? 1.0 : rescore_factor_in)
+    {}
+
+    VectorQuantizationType type() const noexcept { return _type; }
+    bool enabled() const noexcept { return _type != VectorQuantizationType::None; }
+    uint32_t subvectors() const noexcept { return _subvectors; }
+    uint32_t training_samples() const noexcept { return _training_samples; }
+    double rescore_factor() const noexcept { return _rescore_factor; }
+
+    bool operator==(const VectorQuantizationParams& rhs) const noexcept {
+        return (_type == rhs._type &&
+                _subvectors == rhs._subvectors &&
+                _training_samples == rhs._training_samples &&
+                _rescore_factor == rhs._rescore_factor);
+    }
+};
+
+}
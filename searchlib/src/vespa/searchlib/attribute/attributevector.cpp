@@ -22,6 +22,7 @@
 #include <vespa/searchlib/util/file_settings.h>
 #include <vespa/vespalib/util/jsonwriter.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/huge_page_allocator.h>
 #include <vespa/vespalib/util/mmap_file_allocator_factory.h>
 #include <vespa/vespalib/util/size_literals.h>
 #include <thread>
@@ -73,6 +74,9 @@ make_memory_allocator(const vespalib::string& name, const search::attribute::Con
     if (allow_paged(config)) {
         return vespalib::alloc::MmapFileAllocatorFactory::instance().make_memory_allocator(name);
     }
+    if (config.huge_pages()) {
+        return std::make_unique<vespalib::alloc::HugePageAllocator>();
+    }
     return {};
 }
 
@@ -726,6 +730,12 @@ AttributeVector::update_config(const Config& cfg)
     drain_hold(1_Mi); // Wait until 1MiB or less on hold
 }
 
+const vespalib::alloc::HugePageAllocator*
+AttributeVector::get_huge_page_allocator() const noexcept
+{
+    return dynamic_cast<const vespalib::alloc::HugePageAllocator*>(_memory_allocator.get());
+}
+
 vespalib::alloc::Alloc
 AttributeVector::get_initial_alloc()
 {
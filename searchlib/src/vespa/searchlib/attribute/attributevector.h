@@ -34,6 +34,7 @@ namespace vespalib {
 }
 
 namespace vespalib::alloc {
+    class HugePageAllocator;
     class MemoryAllocator;
     class Alloc;
 }
@@ -272,6 +273,9 @@ public:
     bool isLoaded() const { return _loaded; }
     void logEnumStoreEvent(const char *reason, const char *stage);
 
+    /** Return the allocator backing the data stores with huge pages, nullptr if huge pages are not used. */
+    const vespalib::alloc::HugePageAllocator* get_huge_page_allocator() const noexcept;
+
     /** Return the fixed length of the attribute. If 0 then you must inquire each document. */
     size_t getFixedWidth() const override;
     BasicType getInternalBasicType() const;
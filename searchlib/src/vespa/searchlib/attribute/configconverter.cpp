@@ -92,6 +92,25 @@ convertMatch(AttributesConfig::Attribute::Match match_cfg) {
     assert(false);
 }
 
+VectorQuantizationType
+convert(AttributesConfig::Attribute::Index::Hnsw::Quantization::Type type_cfg) {
+    switch (type_cfg) {
+        case AttributesConfig::Attribute::Index::Hnsw::Quantization::Type::NONE:
+            return VectorQuantizationType::None;
+        case AttributesConfig::Attribute::Index::Hnsw::Quantization::Type::INT8:
+            return VectorQuantizationType::Int8;
+        case AttributesConfig::Attribute::Index::Hnsw::Quantization::Type::PRODUCT:
+            return VectorQuantizationType::Product;
+    }
+    assert(false);
+}
+
+VectorQuantizationParams
+convert_quantization(const AttributesConfig::Attribute::Index::Hnsw::Quantization& quantization) {
+    return {convert(quantization.type), static_cast<uint32_t>(quantization.subvectors),
+            static_cast<uint32_t>(quantization.trainingsamples), quantization.rescorefactor};
+}
+
 }
 
 Config
@@ -106,8 +125,10 @@ ConfigConverter::convert(const AttributesConfig::Attribute & cfg)
     retval.setFastSearch(cfg.fastsearch);
     retval.setIsFilter(cfg.enableonlybitvector);
     retval.setFastAccess(cfg.fastaccess);
+    retval.set_multi_threaded_feed(cfg.multithreadedfeed);
     retval.setMutable(cfg.ismutable);
     retval.setPaged(cfg.paged);
+    retval.set_huge_pages(cfg.hugepages);
     retval.setMaxUnCommittedMemory(cfg.maxuncommittedmemory);
     predicateParams.setArity(cfg.arity);
     predicateParams.setBounds(cfg.lowerbound, cfg.upperbound);
@@ -142,9 +163,12 @@ ConfigConverter::convert(const AttributesConfig::Attribute & cfg)
     }
     retval.set_distance_metric(dm);
     if (cfg.index.hnsw.enabled) {
-        retval.set_hnsw_index_params(HnswIndexParams(cfg.index.hnsw.maxlinkspernode,
-                                                     cfg.index.hnsw.neighborstoexploreatinsert,
-                                                     dm, cfg.index.hnsw.multithreadedindexing));
+        HnswIndexParams hnsw_params(cfg.index.hnsw.maxlinkspernode,
+                                    cfg.index.hnsw.neighborstoexploreatinsert,
+                                    dm, cfg.index.hnsw.multithreadedindexing);
+        hnsw_params.set_quantization(convert_quantization(cfg.index.hnsw.quantization));
+        hnsw_params.set_mapped_graph(cfg.index.hnsw.mappedgraph);
+        retval.set_hnsw_index_params(hnsw_params);
     }
     if (retval.basicType().type() == BasicType::Type::TENSOR) {
         if (!cfg.tensortype.empty()) {
@@ -199,6 +199,13 @@ public:
     bool find_enum(EntryType value, IEnumStore::EnumHandle& e) const;
     Index insert(EntryType value);
     bool find_index(EntryType value, Index& idx) const;
+    /**
+     * Returns true if the given index, found by a reader using find_enum(),
+     * still refers to a unique value in use that is equal to the given value.
+     * Must be called by the writer, and the generation guard held by the
+     * reader during the lookup must still be held.
+     */
+    bool is_live_index(Index idx, EntryType value) const;
     void free_unused_values() override;
     void free_unused_values(IndexList to_remove);
     void clear_default_value_ref() override;
@@ -202,6 +202,26 @@ EnumStoreT<EntryT>::find_index(EntryType value, Index& idx) const
     return _dict->find_index(cmp, idx);
 }
 
+template <typename EntryT>
+bool
+EnumStoreT<EntryT>::is_live_index(Index idx, EntryType value) const
+{
+    if (!idx.valid()) {
+        return false;
+    }
+    // Values in buffers being compacted (or on hold after compaction) have been moved.
+    const auto* state = _store.get_allocator().get_data_store().getBufferMeta(InternalIndex(idx).bufferId()).get_state_acquire();
+    if ((state == nullptr) || !state->isActive() || state->getCompacting()) {
+        return false;
+    }
+    // Unused values might already have been removed from the dictionary.
+    if (get_ref_count(idx) == 0) {
+        return false;
+    }
+    auto cmp = make_comparator(value);
+    return !cmp.less(idx, Index()) && !cmp.less(Index(), idx);
+}
+
 template <typename EntryT>
 void
 EnumStoreT<EntryT>::free_unused_values()
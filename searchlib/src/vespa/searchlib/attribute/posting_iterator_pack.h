@@ -4,6 +4,7 @@
 
 #include "i_direct_posting_store.h"
 #include <vespa/searchlib/queryeval/begin_and_end_id.h>
+#include <limits>
 
 namespace search {
 
@@ -42,6 +43,16 @@ public:
         return _children[ref].getData();
     }
 
+    // End (exclusive) of the posting list block (btree leaf) containing the current position.
+    uint32_t get_block_end(ref_t ref) const {
+        return _children[ref].valid() ? (_children[ref].getLeafLastKey() + 1) : endDocId;
+    }
+
+    // Max weight in the posting list block (btree leaf) containing the current position.
+    int32_t get_block_max_weight(ref_t ref) const {
+        return _children[ref].valid() ? _children[ref].getLeafAggregated().getMax() : std::numeric_limits<int32_t>::max();
+    }
+
     std::unique_ptr<BitVector> get_hits(uint32_t begin_id, uint32_t end_id);
     void or_hits_into(BitVector &result, uint32_t begin_id);
 
@@ -59,6 +70,20 @@ private:
     }
 };
 
+template <>
+inline uint32_t
+PostingIteratorPack<DocidIterator>::get_block_end(ref_t) const
+{
+    return endDocId;
+}
+
+template <>
+inline int32_t
+PostingIteratorPack<DocidIterator>::get_block_max_weight(ref_t) const
+{
+    return 1;
+}
+
 using DocidIteratorPack = PostingIteratorPack<DocidIterator>;
 using DocidWithWeightIteratorPack = PostingIteratorPack<DocidWithWeightIterator>;
 
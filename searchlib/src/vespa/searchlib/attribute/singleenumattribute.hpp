@@ -140,11 +140,14 @@ template <typename B>
 void
 SingleValueEnumAttribute<B>::considerUpdateAttributeChange(const Change & c, EnumStoreBatchUpdater & inserter)
 {
-    EnumIndex idx;
-    if (!this->_enumStore.find_index(c._data.raw(), idx)) {
-        c.set_entry_ref(inserter.insert(c._data.raw()).ref());
-    } else {
-        c.set_entry_ref(idx.ref());
+    // The entry ref might already be set by SingleValueStringAttributeT::complete_update()
+    if (!c.has_entry_ref()) {
+        EnumIndex idx;
+        if (!this->_enumStore.find_index(c._data.raw(), idx)) {
+            c.set_entry_ref(inserter.insert(c._data.raw()).ref());
+        } else {
+            c.set_entry_ref(idx.ref());
+        }
     }
     considerUpdateAttributeChange(c._doc, c); // for numeric
 }
@@ -4,6 +4,8 @@
 
 namespace search {
 
+SingleValueStringPrepareResult::~SingleValueStringPrepareResult() = default;
+
 template class SingleValueStringAttributeT<EnumAttribute<StringAttribute>>; 
 
 } // namespace search
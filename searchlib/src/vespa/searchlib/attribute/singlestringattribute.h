@@ -5,9 +5,29 @@
 #include "enumattribute.h"
 #include "singleenumattribute.h"
 #include "stringbase.h"
+#include <vespa/searchlib/tensor/prepare_result.h>
+#include <vespa/vespalib/util/generationhandler.h>
+#include <atomic>
 
 namespace search {
 
+/**
+ * Result of preparing an update of a single value string attribute.
+ * Keeps the enum index found in the frozen dictionary, and the
+ * generation guard held while looking it up.
+ */
+class SingleValueStringPrepareResult : public tensor::PrepareResult {
+    vespalib::GenerationHandler::Guard _guard;
+    IEnumStore::Index                  _idx;
+public:
+    SingleValueStringPrepareResult(vespalib::GenerationHandler::Guard guard, IEnumStore::Index idx) noexcept
+        : _guard(std::move(guard)),
+          _idx(idx)
+    { }
+    ~SingleValueStringPrepareResult() override;
+    IEnumStore::Index idx() const noexcept { return _idx; }
+};
+
 /**
  * Implementation of single value string attribute that uses an underlying enum store
  * to store unique string values.
@@ -16,6 +36,22 @@ namespace search {
  */
 template <typename B>
 class SingleValueStringAttributeT : public SingleValueEnumAttribute<B> {
+private:
+    /*
+     * Prepared updates only move dictionary lookups of values already present off the
+     * write thread. Inserting new values is still done by the write thread, so for high
+     * cardinality attributes the prepare step is mostly wasted. The hit rate is measured
+     * over windows of completed prepared updates, and prepared updates are only preferred
+     * while at least half of them find their value. Otherwise only every
+     * prepared_update_probe_interval document is prepared, to keep measuring.
+     */
+    static constexpr uint32_t prepared_update_window = 256;
+    static constexpr uint32_t prepared_update_probe_interval = 16;
+    uint32_t          _prepared_updates;
+    uint32_t          _prepared_update_hits;
+    std::atomic<bool> _prefer_prepared_update;
+
+    void note_prepared_update(bool hit);
 protected:
     using Change = StringAttribute::Change;
     using ChangeVector = StringAttribute::ChangeVector;
@@ -38,6 +74,12 @@ public:
 
     void freezeEnumDictionary() override;
 
+    std::unique_ptr<tensor::PrepareResult> prepare_update(DocId doc, const vespalib::string & v) const override;
+    bool complete_update(DocId doc, const vespalib::string & v, std::unique_ptr<tensor::PrepareResult> prepare_result) override;
+    bool prefer_prepared_update(DocId doc) const override {
+        return _prefer_prepared_update.load(std::memory_order_relaxed) || ((doc % prepared_update_probe_interval) == 0);
+    }
+
     //-------------------------------------------------------------------------
     // Attribute read API
     //-------------------------------------------------------------------------
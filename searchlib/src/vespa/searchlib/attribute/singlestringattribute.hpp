@@ -22,7 +22,10 @@ template <typename B>
 SingleValueStringAttributeT<B>::
 SingleValueStringAttributeT(const vespalib::string &name,
                             const AttributeVector::Config & c)
-    : SingleValueEnumAttribute<B>(name, c)
+    : SingleValueEnumAttribute<B>(name, c),
+      _prepared_updates(0),
+      _prepared_update_hits(0),
+      _prefer_prepared_update(true)
 { }
 
 template <typename B>
@@ -40,6 +43,57 @@ SingleValueStringAttributeT<B>::freezeEnumDictionary()
     this->getEnumStore().freeze_dictionary();
 }
 
+template <typename B>
+std::unique_ptr<tensor::PrepareResult>
+SingleValueStringAttributeT<B>::prepare_update(DocId, const vespalib::string & v) const
+{
+    auto guard = this->getGenerationHandler().takeGuard();
+    EnumHandle e;
+    if (!this->_enumStore.find_enum(v.c_str(), e)) {
+        // An invalid index tells complete_update() that the lookup missed.
+        return std::make_unique<SingleValueStringPrepareResult>(std::move(guard), EnumIndex());
+    }
+    return std::make_unique<SingleValueStringPrepareResult>(std::move(guard), EnumIndex(vespalib::datastore::EntryRef(e)));
+}
+
+template <typename B>
+bool
+SingleValueStringAttributeT<B>::complete_update(DocId doc, const vespalib::string & v,
+                                                std::unique_ptr<tensor::PrepareResult> prepare_result)
+{
+    auto* prepared = dynamic_cast<const SingleValueStringPrepareResult*>(prepare_result.get());
+    if (prepared == nullptr) {
+        return this->update(doc, v);
+    }
+    bool hit = (doc < this->getNumDocs()) && this->_enumStore.is_live_index(prepared->idx(), v.c_str());
+    note_prepared_update(hit);
+    if (!hit) {
+        return this->update(doc, v);
+    }
+    // The cached entry ref lets commit skip the dictionary lookup for this change.
+    Change change(ChangeBase::UPDATE, doc, StringChangeData(v));
+    change.set_entry_ref(prepared->idx().ref());
+    this->_changes.push_back(change);
+    this->getStatus().incUpdates();
+    this->updateUncommittedDocIdLimit(doc);
+    return true;
+}
+
+template <typename B>
+void
+SingleValueStringAttributeT<B>::note_prepared_update(bool hit)
+{
+    ++_prepared_updates;
+    if (hit) {
+        ++_prepared_update_hits;
+    }
+    if (_prepared_updates >= prepared_update_window) {
+        _prefer_prepared_update.store(_prepared_update_hits * 2 >= _prepared_updates, std::memory_order_relaxed);
+        _prepared_updates = 0;
+        _prepared_update_hits = 0;
+    }
+}
+
 template <typename B>
 std::unique_ptr<attribute::SearchContext>
 SingleValueStringAttributeT<B>::getSearch(QueryTermSimpleUP qTerm,
@@ -5,6 +5,7 @@
 #include "load_utils.h"
 #include "readerbase.h"
 #include "enum_store_loaders.h"
+#include <vespa/searchlib/tensor/prepare_result.h>
 #include <vespa/searchlib/common/sort.h>
 #include <vespa/searchlib/query/query_term_ucs4.h>
 #include <vespa/searchcommon/attribute/config.h>
@@ -173,6 +174,24 @@ StringAttribute::apply(DocId, const ArithmeticValueUpdate & )
     return false;
 }
 
+std::unique_ptr<tensor::PrepareResult>
+StringAttribute::prepare_update(DocId, const vespalib::string &) const
+{
+    return {};
+}
+
+bool
+StringAttribute::complete_update(DocId doc, const vespalib::string & v, std::unique_ptr<tensor::PrepareResult>)
+{
+    return update(doc, v);
+}
+
+bool
+StringAttribute::prefer_prepared_update(DocId) const
+{
+    return false;
+}
+
 bool
 StringAttribute::onLoadEnumerated(ReaderBase &attrReader)
 {
@@ -8,6 +8,8 @@
 #include "loadedenumvalue.h"
 #include "string_search_context.h"
 
+namespace search::tensor { class PrepareResult; }
+
 namespace search {
 
 class ReaderBase;
@@ -37,6 +39,20 @@ public:
     bool update(DocId doc, const vespalib::string & v) {
         return AttributeVector::update(_changes, doc, StringChangeData(v));
     }
+    /**
+     * Two-phase update of a document. The prepare step is thread safe and
+     * can be performed by any thread, while the complete step must be
+     * performed by the attribute write thread. Returns nullptr if there is
+     * nothing to prepare, in which case complete is a plain update.
+     */
+    virtual std::unique_ptr<tensor::PrepareResult> prepare_update(DocId doc, const vespalib::string & v) const;
+    virtual bool complete_update(DocId doc, const vespalib::string & v, std::unique_ptr<tensor::PrepareResult> prepare_result);
+    /**
+     * Tell if a two-phase update of the given document is likely to pay off,
+     * i.e. if the prepare step is likely to do work that the complete step
+     * then can skip. Can be called by any thread.
+     */
+    virtual bool prefer_prepared_update(DocId doc) const;
     bool apply(DocId doc, const ArithmeticValueUpdate & op);
     bool applyWeight(DocId doc, const FieldValue & fv, const ArithmeticValueUpdate & wAdjust) override;
     bool applyWeight(DocId doc, const FieldValue& fv, const document::AssignValueUpdate& wAdjust) override;
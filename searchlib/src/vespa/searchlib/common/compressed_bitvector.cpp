@@ -0,0 +1,132 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "compressed_bitvector.h"
+#include "bitvector.h"
+#include <cassert>
+
+namespace search {
+
+CompressedBitVector::Builder::Builder(Index size)
+    : _size(size),
+      _num_chunks((uint64_t(size) + chunk_size - 1) >> chunk_bits),
+      _pending(),
+      _pending_chunk(0),
+      _values(),
+      _words(),
+      _index(),
+      _offsets(),
+      _counts(),
+      _count(0)
+{
+    _offsets.reserve(_num_chunks);
+    _counts.reserve(_num_chunks);
+    _index.reserve(size_t(_num_chunks) * index_size);
+}
+
+CompressedBitVector::Builder::~Builder() = default;
+
+void
+CompressedBitVector::Builder::append_array(const uint16_t *values, uint32_t count)
+{
+    assert(_pending_chunk < _num_chunks);
+    _counts.push_back(count);
+    _count += count;
+    if (is_bitmap(count)) {
+        _offsets.push_back(_words.size());
+        _words.resize(_words.size() + bitmap_words, 0);
+        uint64_t *words = _words.data() + _offsets.back();
+        for (uint32_t i = 0; i < count; ++i) {
+            words[values[i] >> 6] |= (uint64_t(1) << (values[i] & 63));
+        }
+        _index.resize(_index.size() + index_size, 0);
+    } else {
+        _offsets.push_back(_values.size());
+        _values.insert(_values.end(), values, values + count);
+        uint32_t i = 0;
+        for (uint32_t bucket = 0; bucket < index_size; ++bucket) {
+            while ((i < count) && ((values[i] >> bucket_bits) < bucket)) {
+                ++i;
+            }
+            _index.push_back(i);
+        }
+    }
+    ++_pending_chunk;
+}
+
+void
+CompressedBitVector::Builder::flush_chunk()
+{
+    append_array(_pending.data(), _pending.size());
+    _pending.clear();
+}
+
+void
+CompressedBitVector::Builder::add(Index id)
+{
+    assert(id < _size);
+    uint32_t chunk = id >> chunk_bits;
+    assert(chunk >= _pending_chunk);
+    while (chunk > _pending_chunk) {
+        flush_chunk();
+    }
+    uint16_t low = id & (chunk_size - 1);
+    assert(_pending.empty() || _pending.back() < low);
+    _pending.push_back(low);
+}
+
+CompressedBitVector
+CompressedBitVector::Builder::build()
+{
+    while (_pending_chunk < _num_chunks) {
+        flush_chunk();
+    }
+    _values.shrink_to_fit();
+    _words.shrink_to_fit();
+    return {_size, _count, std::move(_offsets), std::move(_counts), std::move(_values), std::move(_words), std::move(_index)};
+}
+
+CompressedBitVector::CompressedBitVector(Index size, uint32_t count, std::vector<uint32_t> offsets, std::vector<uint32_t> counts,
+                                         std::vector<uint16_t> values, std::vector<uint64_t> words,
+                                         std::vector<uint16_t> index) noexcept
+    : _size(size),
+      _count(count),
+      _offsets(std::move(offsets)),
+      _counts(std::move(counts)),
+      _values(std::move(values)),
+      _words(std::move(words)),
+      _index(std::move(index))
+{
+}
+
+CompressedBitVector::CompressedBitVector(CompressedBitVector &&) noexcept = default;
+CompressedBitVector & CompressedBitVector::operator = (CompressedBitVector &&) noexcept = default;
+CompressedBitVector::~CompressedBitVector() = default;
+
+size_t
+CompressedBitVector::memory_usage() const noexcept
+{
+    return sizeof(CompressedBitVector) +
+           (_offsets.capacity() + _counts.capacity()) * sizeof(uint32_t) +
+           (_values.capacity() + _index.capacity()) * sizeof(uint16_t) +
+           _words.capacity() * sizeof(uint64_t);
+}
+
+CompressedBitVector
+CompressedBitVector::create(const BitVector &bv)
+{
+    Builder builder(bv.size());
+    bv.foreach_truebit([&builder](Index id) { builder.add(id); });
+    return builder.build();
+}
+
+CompressedBitVector
+CompressedBitVector::create(const std::vector<Index> &ids, Index size)
+{
+    Builder builder(size);
+    for (Index id : ids) {
+        builder.add(id);
+    }
+    return builder.build();
+}
+
+}
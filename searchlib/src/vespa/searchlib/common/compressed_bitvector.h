@@ -0,0 +1,136 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace search {
+
+class BitVector;
+
+/**
+ * Read-only compressed representation of a set of document ids below
+ * a given size, organized like a roaring bitmap.
+ *
+ * The id space is split in chunks of 64Ki ids. A chunk with few ids
+ * stores them as a sorted array of 16 bit values, while a chunk with
+ * more than 4096 ids (where the array would be larger than a plain
+ * bitmap) stores a bitmap of 8 KiB. Memory usage is thus proportional
+ * to the number of ids for sparse sets, and never much larger than a
+ * BitVector for dense sets.
+ *
+ * Each array chunk has an index with the start of each bucket of 256
+ * ids, so a lookup only scans the few values sharing the bucket of
+ * the id. A lookup is still slower than in a plain BitVector unless
+ * the set is very sparse, see bitvector_benchmark.
+ **/
+class CompressedBitVector
+{
+public:
+    using Index = uint32_t;
+    static constexpr uint32_t chunk_bits = 16;
+    static constexpr uint32_t chunk_size = 1u << chunk_bits;
+    static constexpr uint32_t bitmap_words = chunk_size / 64;
+    static constexpr uint32_t max_array_size = 4096;
+    static constexpr uint32_t bucket_bits = 8;
+    static constexpr uint32_t index_size = (chunk_size >> bucket_bits) + 1;
+
+    /**
+     * Builds a compressed bitvector from ids added in increasing order.
+     **/
+    class Builder {
+    private:
+        friend class CompressedBitVector;
+        Index                 _size;
+        uint32_t              _num_chunks;
+        std::vector<uint16_t> _pending;
+        uint32_t              _pending_chunk;
+        std::vector<uint16_t> _values;
+        std::vector<uint64_t> _words;
+        std::vector<uint16_t> _index;
+        std::vector<uint32_t> _offsets;
+        std::vector<uint32_t> _counts;
+        uint32_t              _count;
+        void append_array(const uint16_t *values, uint32_t count);
+        void flush_chunk();
+    public:
+        explicit Builder(Index size);
+        ~Builder();
+        void add(Index id);
+        CompressedBitVector build();
+    };
+
+private:
+    Index                 _size;
+    uint32_t              _count;
+    // per chunk: offset into _values (array) or _words (bitmap), and number of ids
+    std::vector<uint32_t> _offsets;
+    std::vector<uint32_t> _counts;
+    std::vector<uint16_t> _values;
+    std::vector<uint64_t> _words;
+    // per chunk: index_size offsets into the array of the chunk, one per bucket plus the end
+    std::vector<uint16_t> _index;
+
+    static bool is_bitmap(uint32_t count) noexcept { return count > max_array_size; }
+    const uint16_t *array(uint32_t chunk) const noexcept { return _values.data() + _offsets[chunk]; }
+    const uint64_t *bitmap(uint32_t chunk) const noexcept { return _words.data() + _offsets[chunk]; }
+    const uint16_t *index(uint32_t chunk) const noexcept { return _index.data() + size_t(chunk) * index_size; }
+
+    CompressedBitVector(Index size, uint32_t count, std::vector<uint32_t> offsets, std::vector<uint32_t> counts,
+                        std::vector<uint16_t> values, std::vector<uint64_t> words, std::vector<uint16_t> index) noexcept;
+public:
+    CompressedBitVector(CompressedBitVector &&) noexcept;
+    CompressedBitVector & operator = (CompressedBitVector &&) noexcept;
+    ~CompressedBitVector();
+
+    Index size() const noexcept { return _size; }
+    Index countTrueBits() const noexcept { return _count; }
+    bool testBit(Index id) const noexcept {
+        if (id >= _size) {
+            return false;
+        }
+        uint32_t chunk = id >> chunk_bits;
+        uint32_t low = id & (chunk_size - 1);
+        uint32_t count = _counts[chunk];
+        if (is_bitmap(count)) {
+            return (bitmap(chunk)[low >> 6] >> (low & 63)) & 1;
+        }
+        const uint16_t *values = array(chunk);
+        const uint16_t *buckets = index(chunk);
+        uint32_t bucket = low >> bucket_bits;
+        for (uint32_t i = buckets[bucket], end = buckets[bucket + 1]; i < end; ++i) {
+            if (values[i] >= low) {
+                return (values[i] == low);
+            }
+        }
+        return false;
+    }
+    size_t memory_usage() const noexcept;
+
+    template <typename FunctionType>
+    void foreach_truebit(FunctionType func) const {
+        for (uint32_t chunk = 0; chunk < _counts.size(); ++chunk) {
+            Index base = Index(chunk) << chunk_bits;
+            uint32_t count = _counts[chunk];
+            if (is_bitmap(count)) {
+                const uint64_t *words = bitmap(chunk);
+                for (uint32_t i = 0; i < bitmap_words; ++i) {
+                    for (uint64_t word = words[i]; word != 0; word &= (word - 1)) {
+                        func(base + i * 64 + __builtin_ctzl(word));
+                    }
+                }
+            } else {
+                const uint16_t *values = array(chunk);
+                for (uint32_t i = 0; i < count; ++i) {
+                    func(base + values[i]);
+                }
+            }
+        }
+    }
+
+    static CompressedBitVector create(const BitVector &bv);
+    static CompressedBitVector create(const std::vector<Index> &ids, Index size);
+};
+
+}
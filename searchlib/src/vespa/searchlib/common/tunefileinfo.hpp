@@ -15,6 +15,7 @@ TuneFileRandRead::setFromConfig(const enum TuneControlConfig::Io & tuneControlCo
         case TuneControlConfig::Io::NORMAL:   _tuneControl = NORMAL; break;
         case TuneControlConfig::Io::DIRECTIO: _tuneControl = DIRECTIO; break;
         case TuneControlConfig::Io::MMAP:     _tuneControl = MMAP; break;
+        case TuneControlConfig::Io::ASYNCIO:  _tuneControl = ASYNCIO; break;
         default:                          _tuneControl = NORMAL; break;
     }
     setFromMmapConfig(mmapFlags);
@@ -2,6 +2,7 @@
 #pragma once
 
 #include "pagedict4file.h"
+#include <vector>
 
 
 namespace search::diskindex {
@@ -15,22 +16,49 @@ class WordAggregator
 private:
     vespalib::string _word;
     uint64_t _wordNum;
+    uint64_t _bitLength;            // Accumulated posting list size for words so far
+    uint64_t _rangeBitLength;       // Wanted posting list size for each word range, 0 means no ranges
+    uint64_t _nextRangeBitLength;
+    std::vector<uint64_t> _rangeStarts;
 
 public:
     WordAggregator()
+        : WordAggregator(0u)
+    {
+    }
+
+    /*
+     * Also split the new word numbers into ranges with approximately
+     * rangeBitLength bits of (old) posting lists each.
+     */
+    explicit WordAggregator(uint64_t rangeBitLength)
         : _word(),
-          _wordNum(0)
+          _wordNum(0),
+          _bitLength(0),
+          _rangeBitLength(rangeBitLength),
+          _nextRangeBitLength(rangeBitLength),
+          _rangeStarts()
     {
     }
 
-    void tryWriteWord(vespalib::stringref word) {
+    void tryWriteWord(vespalib::stringref word, uint64_t bitLength) {
         if (word != _word || _wordNum == 0) {
             ++_wordNum;
             _word = word;
+            if (_rangeBitLength != 0 && _bitLength >= _nextRangeBitLength) {
+                _rangeStarts.push_back(_wordNum);
+                _nextRangeBitLength = _bitLength + _rangeBitLength;
+            }
         }
+        _bitLength += bitLength;
     }
 
     uint64_t getWordNum() const { return _wordNum; }
+
+    /*
+     * First word number in each word range except the first one.
+     */
+    const std::vector<uint64_t> &getRangeStarts() const { return _rangeStarts; }
 };
 
 
@@ -85,7 +113,7 @@ public:
     void writeNewWordNum(uint64_t newWordNum);
 
     void write(WordAggregator &writer) {
-        writer.tryWriteWord(_word);
+        writer.tryWriteWord(_word, _counts._bitLength);
         writeNewWordNum(writer.getWordNum());
     }
 };
@@ -12,7 +12,6 @@
 LOG_SETUP(".diskindex.extposocc");
 
 using search::index::PostingListFileSeqRead;
-using search::index::PostingListFileSeqWrite;
 using search::index::PostingListCountFileSeqRead;
 using search::index::PostingListCountFileSeqWrite;
 using search::index::DocIdAndFeatures;
@@ -51,7 +50,7 @@ setupDefaultPosOccParameters(PostingListParams *countParams,
 }
 
 
-std::unique_ptr<PostingListFileSeqWrite>
+std::unique_ptr<Zc4PostingSeqWrite>
 makePosOccWrite(PostingListCountFileSeqWrite *const posOccCountWrite,
                 bool dynamicK,
                 const PostingListParams &params,
@@ -60,7 +59,7 @@ makePosOccWrite(PostingListCountFileSeqWrite *const posOccCountWrite,
                 uint32_t indexId,
                 const index::FieldLengthInfo &field_length_info)
 {
-    std::unique_ptr<PostingListFileSeqWrite> posOccWrite;
+    std::unique_ptr<Zc4PostingSeqWrite> posOccWrite;
 
     if (dynamicK) {
         posOccWrite = std::make_unique<ZcPosOccSeqWrite>(schema, indexId, field_length_info, posOccCountWrite);
@@ -15,13 +15,13 @@ namespace search::index {
     class PostingListParams;
     class PostingListCountFileSeqWrite;
     class PostingListCountFileSeqRead;
-    class PostingListFileSeqWrite;
     class PostingListFileSeqRead;
     class Schema;
 }
 
 namespace search::diskindex {
 
+class Zc4PostingSeqWrite;
 
 void
 setupDefaultPosOccParameters(index::PostingListParams *countParams,
@@ -29,7 +29,7 @@ setupDefaultPosOccParameters(index::PostingListParams *countParams,
                              uint64_t numWordIds,
                              uint32_t docIdLimit);
 
-std::unique_ptr<index::PostingListFileSeqWrite>
+std::unique_ptr<Zc4PostingSeqWrite>
 makePosOccWrite(index::PostingListCountFileSeqWrite *const posOccCountWrite,
                 bool dynamicK,
                 const index::PostingListParams &params,
@@ -2,6 +2,7 @@
 
 #include "field_merger.h"
 #include "fieldreader.h"
+#include "fieldwriter.h"
 #include "field_length_scanner.h"
 #include "fusion_input_index.h"
 #include "fusion_output_index.h"
@@ -10,12 +11,14 @@
 #include <vespa/fastos/file.h>
 #include <vespa/searchlib/bitcompression/posocc_fields_params.h>
 #include <vespa/searchlib/common/i_flush_token.h>
+#include <vespa/searchlib/index/field_length_info.h>
 #include <vespa/searchlib/index/schemautil.h>
 #include <vespa/searchlib/util/filekit.h>
 #include <vespa/searchlib/util/posting_priority_queue_merger.hpp>
 #include <vespa/vespalib/io/fileutil.h>
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/size_literals.h>
 #include <filesystem>
 #include <system_error>
 
@@ -45,6 +48,11 @@ constexpr uint32_t renumber_word_ids_merge_chunk = 1000000;
 constexpr uint32_t merge_postings_heap_limit = 4;
 constexpr uint32_t merge_postings_merge_chunk = 50000;
 constexpr uint32_t scan_chunk = 80000;
+// Word range partitions smaller than this are not worth the extra pass when appending
+constexpr uint64_t min_word_range_partition_bit_length = 64_Mi * 8;
+// Estimated memory used for each input and for the output of a word range partition
+constexpr size_t partition_reader_memory = 1_Mi;
+constexpr size_t partition_writer_memory = 2_Mi;
 
 vespalib::string
 createTmpPath(const vespalib::string & base, uint32_t index) {
@@ -55,8 +63,45 @@ createTmpPath(const vespalib::string & base, uint32_t index) {
     return os.str();
 }
 
+vespalib::string
+createPartitionPath(const vespalib::string & base, uint32_t partition) {
+    vespalib::asciistream os;
+    os << base;
+    os << "/tmppart";
+    os << partition;
+    return os.str();
 }
 
+}
+
+/*
+ * Merge state for a range of new word numbers, written to a separate
+ * temporary field writer that is later appended to the field output.
+ */
+struct FieldMerger::Partition {
+    const uint64_t                            _word_num_begin;
+    const uint64_t                            _word_num_end;
+    const vespalib::string                    _dir;
+    std::vector<std::unique_ptr<FieldReader>> _readers;
+    std::unique_ptr<PostingsHeap>             _heap;
+    std::unique_ptr<FieldWriter>              _writer;
+    FieldLengthInfo                           _field_length_info;
+
+    Partition(uint64_t word_num_begin, uint64_t word_num_end, vespalib::string dir)
+        : _word_num_begin(word_num_begin),
+          _word_num_end(word_num_end),
+          _dir(std::move(dir)),
+          _readers(),
+          _heap(),
+          _writer(),
+          _field_length_info()
+    {
+    }
+    ~Partition();
+};
+
+FieldMerger::Partition::~Partition() = default;
+
 FieldMerger::FieldMerger(uint32_t id, const FusionOutputIndex& fusion_out_index, std::shared_ptr<IFlushToken> flush_token)
     : _id(id),
       _field_name(SchemaUtil::IndexIterator(fusion_out_index.get_schema(), id).getName()),
@@ -73,6 +118,11 @@ FieldMerger::FieldMerger(uint32_t id, const FusionOutputIndex& fusion_out_index,
       _writer(),
       _field_length_scanner(),
       _open_reader_idx(std::numeric_limits<uint32_t>::max()),
+      _word_range_starts(),
+      _partitions(),
+      _active_partitions(0u),
+      _partition_failed(false),
+      _append_partition_idx(0u),
       _state(State::MERGE_START),
       _failed(false)
 {
@@ -176,6 +226,41 @@ FieldMerger::read_mapping_files()
     return true;
 }
 
+uint64_t
+FieldMerger::calc_word_range_bit_length() const
+{
+    uint32_t partitions = _fusion_out_index.get_max_word_range_partitions();
+    if (partitions <= 1) {
+        return 0;
+    }
+    SchemaUtil::IndexIterator index(_fusion_out_index.get_schema(), _id);
+    uint32_t num_inputs = 0;
+    uint64_t input_bit_length = 0;
+    for (const auto & oi : _fusion_out_index.get_old_indexes()) {
+        if (!index.hasOldFields(oi.getSchema())) {
+            continue;
+        }
+        ++num_inputs;
+        std::error_code ec;
+        auto size = std::filesystem::file_size(std::filesystem::path(oi.getPath() + "/" + _field_name + "/posocc.dat.compressed"), ec);
+        if (!ec) {
+            input_bit_length += size * 8;
+        }
+    }
+    // Each partition has its own readers, writer and bitvector candidate.
+    size_t partition_memory = _fusion_out_index.get_doc_id_limit() / 8 + num_inputs * partition_reader_memory + partition_writer_memory;
+    size_t memory_limit = _fusion_out_index.get_word_range_partitions_memory_limit();
+    if (memory_limit != 0) {
+        partitions = std::min(partitions, static_cast<uint32_t>(std::min(memory_limit / partition_memory, size_t(partitions))));
+    }
+    if (partitions <= 1) {
+        return 0;
+    }
+    uint64_t bit_length = input_bit_length / partitions;
+    uint64_t min_bit_length = _fusion_out_index.get_force_small_merge_chunk() ? 1u : min_word_range_partition_bit_length;
+    return (bit_length >= min_bit_length) ? bit_length : 0;
+}
+
 bool
 FieldMerger::renumber_word_ids_start()
 {
@@ -183,7 +268,7 @@ FieldMerger::renumber_word_ids_start()
     if (!open_input_word_readers()) {
         return false;
     }
-    _word_aggregator = std::make_unique<WordAggregator>();
+    _word_aggregator = std::make_unique<WordAggregator>(calc_word_range_bit_length());
     _word_heap->setup(renumber_word_ids_heap_limit);
     _word_heap->set_merge_chunk(_fusion_out_index.get_force_small_merge_chunk() ? 1u : renumber_word_ids_merge_chunk);
     return true;
@@ -205,6 +290,7 @@ FieldMerger::renumber_word_ids_finish()
 {
     _word_heap.reset();
     _num_word_ids = _word_aggregator->getWordNum();
+    _word_range_starts = _word_aggregator->getRangeStarts();
     _word_aggregator.reset();
 
     // Close files
@@ -312,6 +398,18 @@ FieldMerger::scan_element_lengths()
     }
 }
 
+void
+FieldMerger::open_field_writer(FieldWriter& writer, const FieldLengthInfo& field_length_info, const vespalib::string& dir) const
+{
+    SchemaUtil::IndexIterator index(_fusion_out_index.get_schema(), _id);
+    if (!writer.open(64, 262144, _fusion_out_index.get_dynamic_k_pos_index_format(),
+                     index.use_interleaved_features(), index.getSchema(),
+                     index.getIndex(),
+                     field_length_info,
+                     _fusion_out_index.get_tune_file_indexing()._write, _fusion_out_index.get_file_header_context())) {
+        throw IllegalArgumentException(make_string("Could not open output posocc + dictionary in %s", dir.c_str()));
+    }
+}
 
 bool
 FieldMerger::open_field_writer()
@@ -320,19 +418,12 @@ FieldMerger::open_field_writer()
     if (!_readers.empty()) {
         field_length_info = _readers.back()->get_field_length_info();
     }
-    SchemaUtil::IndexIterator index(_fusion_out_index.get_schema(), _id);
-    if (!_writer->open(64, 262144, _fusion_out_index.get_dynamic_k_pos_index_format(),
-                       index.use_interleaved_features(), index.getSchema(),
-                       index.getIndex(),
-                       field_length_info,
-                       _fusion_out_index.get_tune_file_indexing()._write, _fusion_out_index.get_file_header_context())) {
-        throw IllegalArgumentException(make_string("Could not open output posocc + dictionary in %s", _field_dir.c_str()));
-    }
+    open_field_writer(*_writer, field_length_info, _field_dir);
     return true;
 }
 
 bool
-FieldMerger::select_cooked_or_raw_features(FieldReader& reader)
+FieldMerger::select_cooked_or_raw_features(FieldReader& reader, FieldWriter& writer)
 {
     bool rawFormatOK = true;
     bool cookedFormatOK = true;
@@ -345,7 +436,7 @@ FieldMerger::select_cooked_or_raw_features(FieldReader& reader)
         return true;
     }
     {
-        _writer->getFeatureParams(featureParams);
+        writer.getFeatureParams(featureParams);
         cookedFormat = featureParams.getStr("cookedEncoding");
         rawFormat = featureParams.getStr("encoding");
         if (rawFormat == "") {
@@ -391,32 +482,43 @@ FieldMerger::select_cooked_or_raw_features(FieldReader& reader)
 }
 
 bool
-FieldMerger::setup_merge_heap()
+FieldMerger::setup_merge_heap(std::vector<std::unique_ptr<FieldReader>>& readers, FieldWriter& writer, std::unique_ptr<PostingsHeap>& heap)
 {
-    _heap = std::make_unique<PostingPriorityQueueMerger<FieldReader, FieldWriter>>();
-    for (auto &reader : _readers) {
-        if (!select_cooked_or_raw_features(*reader)) {
+    heap = std::make_unique<PostingsHeap>();
+    for (auto &reader : readers) {
+        if (!select_cooked_or_raw_features(*reader, writer)) {
             return false;
         }
         if (reader->isValid()) {
             reader->read();
         }
         if (reader->isValid()) {
-            _heap->initialAdd(reader.get());
+            heap->initialAdd(reader.get());
         }
     }
-    _heap->setup(merge_postings_heap_limit);
-    _heap->set_merge_chunk(_fusion_out_index.get_force_small_merge_chunk() ? 1u : merge_postings_merge_chunk);
+    heap->setup(merge_postings_heap_limit);
+    heap->set_merge_chunk(_fusion_out_index.get_force_small_merge_chunk() ? 1u : merge_postings_merge_chunk);
     return true;
 }
 
+bool
+FieldMerger::setup_merge_heap()
+{
+    return setup_merge_heap(_readers, *_writer, _heap);
+}
+
 void
 FieldMerger::merge_postings_start()
 {
+    allocate_field_length_scanner();
+    if (!_word_range_starts.empty() && !_field_length_scanner) {
+        make_partitions();
+        _state = State::MERGE_PARTITIONS;
+        return;
+    }
     /* OUTPUT */
     _writer = std::make_unique<FieldWriter>(_fusion_out_index.get_doc_id_limit(), _num_word_ids, _field_dir + "/");
     _readers.reserve(_fusion_out_index.get_old_indexes().size());
-    allocate_field_length_scanner();
     _open_reader_idx = 0;
     _state = State::OPEN_POSTINGS_FIELD_READERS;
 }
@@ -471,6 +573,138 @@ FieldMerger::merge_postings_failed()
                                                _field_name.c_str(), _field_dir.c_str()));
 }
 
+void
+FieldMerger::make_partitions()
+{
+    uint64_t word_num_begin = 1;
+    _partitions.reserve(_word_range_starts.size() + 1);
+    for (uint32_t i = 0; i <= _word_range_starts.size(); ++i) {
+        uint64_t word_num_end = (i < _word_range_starts.size()) ? _word_range_starts[i] : _num_word_ids + 1;
+        _partitions.push_back(std::make_unique<Partition>(word_num_begin, word_num_end, createPartitionPath(_field_dir, i)));
+        word_num_begin = word_num_end;
+    }
+    _word_range_starts.clear();
+    _active_partitions = _partitions.size();
+    _append_partition_idx = 0;
+    LOG(debug, "Merging postings for field %s in %zu word range partitions", _field_name.c_str(), _partitions.size());
+}
+
+bool
+FieldMerger::open_partition(Partition& partition)
+{
+    std::filesystem::create_directory(std::filesystem::path(partition._dir));
+    SchemaUtil::IndexIterator index(_fusion_out_index.get_schema(), _id);
+    for (const auto & oi : _fusion_out_index.get_old_indexes()) {
+        const Schema &oldSchema = oi.getSchema();
+        if (!index.hasOldFields(oldSchema)) {
+            continue; // drop data
+        }
+        auto reader = FieldReader::allocFieldReader(index, oldSchema, {});
+        reader->setup(_word_num_mappings[oi.getIndex()], oi.getDocIdMapping());
+        reader->set_word_num_range(partition._word_num_begin, partition._word_num_end);
+        if (!reader->open(oi.getPath() + "/" + _field_name + "/", _fusion_out_index.get_tune_file_indexing()._read)) {
+            return false;
+        }
+        partition._readers.push_back(std::move(reader));
+    }
+    if (!partition._readers.empty()) {
+        partition._field_length_info = partition._readers.back()->get_field_length_info();
+    }
+    partition._writer = std::make_unique<FieldWriter>(_fusion_out_index.get_doc_id_limit(), _num_word_ids, partition._dir + "/");
+    open_field_writer(*partition._writer, partition._field_length_info, partition._dir);
+    return setup_merge_heap(partition._readers, *partition._writer, partition._heap);
+}
+
+bool
+FieldMerger::close_partition(Partition& partition)
+{
+    partition._heap.reset();
+    bool ok = true;
+    for (auto &reader : partition._readers) {
+        if (!reader->close()) {
+            ok = false;
+        }
+    }
+    partition._readers.clear();
+    if (!partition._writer->close()) {
+        ok = false;
+    }
+    return ok;
+}
+
+bool
+FieldMerger::process_merge_partition(uint32_t partition_id)
+{
+    auto& partition = *_partitions[partition_id];
+    try {
+        if (_partition_failed.load(std::memory_order_relaxed) || _flush_token->stop_requested()) {
+            _partition_failed = true;
+            return false;
+        }
+        if (!partition._heap) {
+            if (!open_partition(partition)) {
+                LOG(error, "Could not open word range partition %u for field %s", partition_id, _field_name.c_str());
+                _partition_failed = true;
+                return false;
+            }
+            return true;
+        }
+        partition._heap->merge(*partition._writer, *_flush_token);
+        if (_flush_token->stop_requested()) {
+            _partition_failed = true;
+            return false;
+        }
+        if (!partition._heap->empty()) {
+            return true;
+        }
+        if (!close_partition(partition)) {
+            LOG(error, "Could not close word range partition %u for field %s", partition_id, _field_name.c_str());
+            _partition_failed = true;
+        }
+    } catch (const std::exception& e) {
+        LOG(error, "Could not merge word range partition %u for field %s: %s", partition_id, _field_name.c_str(), e.what());
+        _partition_failed = true;
+    }
+    return false;
+}
+
+bool
+FieldMerger::partition_done()
+{
+    if (_active_partitions.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return false;
+    }
+    _state = State::APPEND_PARTITIONS;
+    return true;
+}
+
+void
+FieldMerger::append_partition()
+{
+    if (_partition_failed) {
+        _partitions.clear();
+        merge_postings_failed();
+        return;
+    }
+    if (!_writer) {
+        _writer = std::make_unique<FieldWriter>(_fusion_out_index.get_doc_id_limit(), _num_word_ids, _field_dir + "/");
+        open_field_writer(*_writer, _partitions.front()->_field_length_info, _field_dir);
+    }
+    auto& partition = *_partitions[_append_partition_idx];
+    if (!_writer->append_part(*partition._writer, _fusion_out_index.get_tune_file_indexing()._read)) {
+        LOG(error, "Could not append word range partition %u for field %s", _append_partition_idx, _field_name.c_str());
+        merge_postings_failed();
+        return;
+    }
+    partition._writer.reset();
+    std::error_code ec;
+    std::filesystem::remove_all(std::filesystem::path(partition._dir), ec);
+    if (++_append_partition_idx == _partitions.size()) {
+        _partitions.clear();
+        _state = State::MERGE_POSTINGS_FINISH;
+    }
+}
+
 void
 FieldMerger::merge_field_start()
 {
@@ -531,6 +765,9 @@ FieldMerger::process_merge_field()
             break;
         } else {
             merge_postings_start();
+            if (_state == State::MERGE_PARTITIONS) {
+                break;
+            }
         }
         [[fallthrough]];
     case State::OPEN_POSTINGS_FIELD_READERS:
@@ -545,6 +782,9 @@ FieldMerger::process_merge_field()
     case State::MERGE_POSTINGS:
         merge_postings_main();
         break;
+    case State::APPEND_PARTITIONS:
+        append_partition();
+        break;
     case State::MERGE_POSTINGS_FINISH:
         merge_field_finish();
         break;
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <vespa/vespalib/stllike/string.h>
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <vector>
@@ -12,6 +13,8 @@ class IFlushToken;
 template <class Reader, class Writer> class PostingPriorityQueueMerger;
 }
 
+namespace search::index { class FieldLengthInfo; }
+
 namespace search::diskindex {
 
 class DictionaryWordReader;
@@ -28,6 +31,8 @@ class WordNumMapping;
 class FieldMerger
 {
     using WordNumMappingList = std::vector<WordNumMapping>;
+    using PostingsHeap = PostingPriorityQueueMerger<FieldReader, FieldWriter>;
+    struct Partition;
 
     enum class State {
         MERGE_START,
@@ -37,6 +42,8 @@ class FieldMerger
         SCAN_ELEMENT_LENGTHS,
         OPEN_POSTINGS_FIELD_READERS_FINISH,
         MERGE_POSTINGS,
+        MERGE_PARTITIONS,
+        APPEND_PARTITIONS,
         MERGE_POSTINGS_FINISH,
         MERGE_DONE
     };
@@ -52,10 +59,15 @@ class FieldMerger
     WordNumMappingList _word_num_mappings;
     uint64_t _num_word_ids;
     std::vector<std::unique_ptr<FieldReader>> _readers;
-    std::unique_ptr<PostingPriorityQueueMerger<FieldReader, FieldWriter>> _heap;
+    std::unique_ptr<PostingsHeap> _heap;
     std::unique_ptr<FieldWriter> _writer;
     std::shared_ptr<FieldLengthScanner> _field_length_scanner;
     uint32_t _open_reader_idx;
+    std::vector<uint64_t> _word_range_starts;
+    std::vector<std::unique_ptr<Partition>> _partitions;
+    std::atomic<uint32_t> _active_partitions;
+    std::atomic<bool> _partition_failed;
+    uint32_t _append_partition_idx;
     State _state;
     bool _failed;
 
@@ -63,6 +75,7 @@ class FieldMerger
     bool clean_tmp_dirs();
     bool open_input_word_readers();
     bool read_mapping_files();
+    uint64_t calc_word_range_bit_length() const;
     bool renumber_word_ids_start();
     void renumber_word_ids_main();
     bool renumber_word_ids_finish();
@@ -71,14 +84,20 @@ class FieldMerger
     bool open_input_field_reader();
     void open_input_field_readers();
     void scan_element_lengths();
+    void open_field_writer(FieldWriter& writer, const index::FieldLengthInfo& field_length_info, const vespalib::string& dir) const;
     bool open_field_writer();
-    bool select_cooked_or_raw_features(FieldReader& reader);
+    bool select_cooked_or_raw_features(FieldReader& reader, FieldWriter& writer);
+    bool setup_merge_heap(std::vector<std::unique_ptr<FieldReader>>& readers, FieldWriter& writer, std::unique_ptr<PostingsHeap>& heap);
     bool setup_merge_heap();
     void merge_postings_start();
     void merge_postings_open_field_readers_done();
     void merge_postings_main();
     bool merge_postings_finish();
     void merge_postings_failed();
+    void make_partitions();
+    bool open_partition(Partition& partition);
+    bool close_partition(Partition& partition);
+    void append_partition();
 public:
     FieldMerger(uint32_t id, const FusionOutputIndex& fusion_out_index, std::shared_ptr<IFlushToken> flush_token);
     ~FieldMerger();
@@ -88,6 +107,10 @@ public:
     uint32_t get_id() const noexcept { return _id; }
     bool done() const noexcept { return _state == State::MERGE_DONE; }
     bool failed() const noexcept { return _failed; }
+    bool merging_partitions() const noexcept { return _state == State::MERGE_PARTITIONS; }
+    uint32_t get_num_partitions() const noexcept { return _partitions.size(); }
+    bool process_merge_partition(uint32_t partition_id); // Called multiple times, returns true if more work remains
+    bool partition_done(); // Returns true when all partitions are done
 };
 
 }
@@ -14,6 +14,11 @@ FieldMergerTask::run()
         _field_mergers_state.field_merger_done(_field_merger, true);
     } else if (_field_merger.done()) {
         _field_mergers_state.field_merger_done(_field_merger, false);
+    } else if (_field_merger.merging_partitions()) {
+        uint32_t num_partitions = _field_merger.get_num_partitions();
+        for (uint32_t partition_id = 0; partition_id < num_partitions; ++partition_id) {
+            _field_mergers_state.schedule_partition_task(_field_merger, partition_id);
+        }
     } else {
         _field_mergers_state.schedule_task(_field_merger);
     }
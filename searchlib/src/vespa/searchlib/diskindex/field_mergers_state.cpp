@@ -3,6 +3,7 @@
 #include "field_mergers_state.h"
 #include "field_merger.h"
 #include "field_merger_task.h"
+#include "field_partition_merger_task.h"
 #include "fusion_output_index.h"
 #include <vespa/searchcommon/common/schema.h>
 #include <vespa/vespalib/util/cpu_usage.h>
@@ -74,4 +75,12 @@ FieldMergersState::schedule_task(FieldMerger& field_merger)
     assert(!rejected);
 }
 
+void
+FieldMergersState::schedule_partition_task(FieldMerger& field_merger, uint32_t partition_id)
+{
+    auto task = std::make_unique<FieldPartitionMergerTask>(field_merger, *this, partition_id);
+    auto rejected = _executor.execute(CpuUsage::wrap(std::move(task), CpuUsage::Category::COMPACT));
+    assert(!rejected);
+}
+
 }
@@ -0,0 +1,19 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "field_partition_merger_task.h"
+#include "field_merger.h"
+#include "field_mergers_state.h"
+
+namespace search::diskindex {
+
+void
+FieldPartitionMergerTask::run()
+{
+    if (_field_merger.process_merge_partition(_partition_id)) {
+        _field_mergers_state.schedule_partition_task(_field_merger, _partition_id);
+    } else if (_field_merger.partition_done()) {
+        _field_mergers_state.schedule_task(_field_merger);
+    }
+}
+
+}
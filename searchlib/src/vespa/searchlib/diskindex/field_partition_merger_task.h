@@ -0,0 +1,32 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/util/threadexecutor.h>
+
+namespace search::diskindex {
+
+class FieldMerger;
+class FieldMergersState;
+
+/*
+ * Task for processing a portion of a word range partition of a field merge.
+ */
+class FieldPartitionMergerTask : public vespalib::Executor::Task
+{
+    FieldMerger&       _field_merger;
+    FieldMergersState& _field_mergers_state;
+    uint32_t           _partition_id;
+
+    void run() override;
+public:
+    FieldPartitionMergerTask(FieldMerger& field_merger, FieldMergersState& field_mergers_state, uint32_t partition_id)
+        : vespalib::Executor::Task(),
+          _field_merger(field_merger),
+          _field_mergers_state(field_mergers_state),
+          _partition_id(partition_id)
+    {
+    }
+};
+
+}
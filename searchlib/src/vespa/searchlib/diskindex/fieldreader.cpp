@@ -38,6 +38,8 @@ FieldReader::FieldReader()
       _wordNumMapper(),
       _docIdMapper(),
       _oldWordNum(noWordNumHigh()),
+      _wordNumBegin(noWordNum()),
+      _wordNumEnd(noWordNumHigh()),
       _residue(0u),
       _docIdLimit(0u),
       _word()
@@ -52,12 +54,27 @@ void
 FieldReader::readCounts()
 {
     PostingListCounts counts;
-    _dictFile->readWord(_word, _oldWordNum, counts);
-    _oldposoccfile->readCounts(counts);
-    if (_oldWordNum != noWordNumHigh()) {
+    uint64_t skipBits = 0;
+    for (;;) {
+        _dictFile->readWord(_word, _oldWordNum, counts);
+        if (_oldWordNum == noWordNumHigh()) {
+            break;
+        }
         _wordNum = _wordNumMapper.map(_oldWordNum);
         assert(_wordNum != noWordNum());
         assert(_wordNum != noWordNumHigh());
+        if (__builtin_expect(_wordNum >= _wordNumBegin, true)) {
+            if (__builtin_expect(_wordNum >= _wordNumEnd, false)) {
+                _oldWordNum = noWordNumHigh();
+                counts.clear();
+            }
+            break;
+        }
+        skipBits += counts._bitLength;
+    }
+    _oldposoccfile->skipPostingLists(skipBits);
+    _oldposoccfile->readCounts(counts);
+    if (_oldWordNum != noWordNumHigh()) {
         _residue = counts._numDocs;
     } else
         _wordNum = _oldWordNum;
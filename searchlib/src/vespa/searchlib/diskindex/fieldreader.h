@@ -48,6 +48,8 @@ protected:
     WordNumMapper _wordNumMapper;
     DocIdMapper _docIdMapper;
     uint64_t _oldWordNum;
+    uint64_t _wordNumBegin;
+    uint64_t _wordNumEnd;
     uint32_t _residue;
     uint32_t _docIdLimit;
     vespalib::string _word;
@@ -91,6 +93,15 @@ public:
     }
 
     virtual void setup(const WordNumMapping &wordNumMapping, const DocIdMapping &docIdMapping);
+    /*
+     * Limit reading to words with new word numbers in [begin, end).
+     * Posting lists for words before the range are skipped without
+     * being decoded.
+     */
+    void set_word_num_range(uint64_t begin, uint64_t end) {
+        _wordNumBegin = begin;
+        _wordNumEnd = end;
+    }
     virtual bool open(const vespalib::string &prefix, const TuneFileSeqRead &tuneFileRead);
     virtual bool close();
     virtual void setFeatureParams(const PostingListParams &params);
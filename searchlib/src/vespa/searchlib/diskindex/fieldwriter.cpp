@@ -4,6 +4,7 @@
 #include "zcposocc.h"
 #include "extposocc.h"
 #include "pagedict4file.h"
+#include "bitvectordictionary.h"
 #include <vespa/vespalib/util/error.h>
 #include <filesystem>
 
@@ -20,6 +21,7 @@ using common::FileHeaderContext;
 FieldWriter::FieldWriter(uint32_t docIdLimit, uint64_t numWordIds, vespalib::stringref prefix)
     : _dictFile(),
       _posoccfile(),
+      _appendInfo(),
       _bvc(docIdLimit),
       _bmapfile(BitVectorKeyScope::PERFIELD_WORDS),
       _prefix(prefix),
@@ -109,7 +111,7 @@ FieldWriter::flush()
     } else {
         assert(counts._bitLength == 0);
         assert(_bvc.empty());
-        assert(_compactWordNum == 0);
+        assert(_wordNum == noWordNum());
     }
 }
 
@@ -144,6 +146,7 @@ FieldWriter::close()
             LOG(error, "Could not close posocc file for write");
             ret = false;
         }
+        _appendInfo = _posoccfile->get_append_info();
         _posoccfile.reset();
     }
     if (_dictFile) {
@@ -159,6 +162,63 @@ FieldWriter::close()
     return ret;
 }
 
+bool
+FieldWriter::append_part(const FieldWriter &part, const TuneFileSeqRead &tuneFileRead)
+{
+    assert(_wordNum == noWordNum());
+    assert(!part._posoccfile);
+    const auto &info = part._appendInfo;
+    vespalib::string name = part._prefix + "posocc.dat.compressed";
+    int64_t bitLengthAdjustment = 0;
+    if (!_posoccfile->append(name, info, bitLengthAdjustment)) {
+        LOG(error, "Could not append posocc file %s", name.c_str());
+        return false;
+    }
+    // Word in appended file (starting at 1) with posting list size changed by append
+    uint64_t adjustedWordNum = (info._first_byte_align_pos != 0) ? info._first_byte_align_word + 1 : 0;
+
+    PageDict4FileSeqRead dictFile;
+    vespalib::string cname = part._prefix + "dictionary";
+    if (!dictFile.open(cname, tuneFileRead)) {
+        LOG(error, "Could not open posocc count file %s for read", cname.c_str());
+        return false;
+    }
+    vespalib::string word;
+    uint64_t wordNum = noWordNum();
+    uint64_t numWords = 0;
+    PostingListCounts counts;
+    for (;;) {
+        dictFile.readWord(word, wordNum, counts);
+        if (wordNum == std::numeric_limits<uint64_t>::max()) {
+            break;
+        }
+        ++numWords;
+        if (wordNum == adjustedWordNum) {
+            counts._bitLength += bitLengthAdjustment;
+            if (!counts._segments.empty()) {
+                counts._segments.front()._bitLength += bitLengthAdjustment;
+            }
+        }
+        _dictFile->writeWord(word, counts);
+    }
+    assert(numWords == info._num_words);
+    if (!dictFile.close()) {
+        LOG(error, "Could not close posocc count file %s for read", cname.c_str());
+        return false;
+    }
+
+    BitVectorDictionary bitVectors;
+    if (!bitVectors.open(part._prefix, TuneFileRandRead(), BitVectorKeyScope::PERFIELD_WORDS)) {
+        return false;
+    }
+    for (const auto &entry : bitVectors.getEntries()) {
+        auto bitVector = bitVectors.lookup(entry._wordNum);
+        _bmapfile.addWordSingle(_compactWordNum + entry._wordNum, *bitVector);
+    }
+    _compactWordNum += info._num_words;
+    return true;
+}
+
 void
 FieldWriter::getFeatureParams(PostingListParams &params)
 {
@@ -2,8 +2,8 @@
 #pragma once
 
 #include "bitvectorfile.h"
+#include "zcposting.h"
 #include <vespa/searchlib/index/dictionaryfile.h>
-#include <vespa/searchlib/index/postinglistfile.h>
 #include <vespa/searchlib/bitcompression/posocccompression.h>
 #include <vespa/searchlib/bitcompression/countcompression.h>
 #include <cassert>
@@ -54,14 +54,22 @@ public:
 
     bool close();
 
+    /*
+     * Append the output of a closed field writer, opened with the same
+     * parameters and used for a range of words following all words
+     * already appended to this writer. Words can not be added directly
+     * to a field writer that is used for appending.
+     */
+    bool append_part(const FieldWriter &part, const TuneFileSeqRead &tuneFileRead);
+
     void getFeatureParams(PostingListParams &params);
     static void remove(const vespalib::string &prefix);
 private:
     using DictionaryFileSeqWrite = index::DictionaryFileSeqWrite;
-    using PostingListFileSeqWrite = index::PostingListFileSeqWrite;
     using PostingListCounts = index::PostingListCounts;
     std::unique_ptr<DictionaryFileSeqWrite>  _dictFile;
-    std::unique_ptr<PostingListFileSeqWrite> _posoccfile;
+    std::unique_ptr<Zc4PostingSeqWrite>      _posoccfile;
+    Zc4PostingSeqWrite::AppendInfo _appendInfo;
     BitVectorCandidate      _bvc;
     BitVectorFileWrite      _bmapfile;
     const vespalib::string  _prefix;
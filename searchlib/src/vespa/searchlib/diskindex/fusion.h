@@ -43,6 +43,8 @@ public:
     ~Fusion();
     void set_dynamic_k_pos_index_format(bool dynamic_k_pos_index_format) { _fusion_out_index.set_dynamic_k_pos_index_format(dynamic_k_pos_index_format); }
     void set_force_small_merge_chunk(bool force_small_merge_chunk) { _fusion_out_index.set_force_small_merge_chunk(force_small_merge_chunk); }
+    void set_max_word_range_partitions(uint32_t max_word_range_partitions) { _fusion_out_index.set_max_word_range_partitions(max_word_range_partitions); }
+    void set_word_range_partitions_memory_limit(size_t memory_limit) { _fusion_out_index.set_word_range_partitions_memory_limit(memory_limit); }
     bool merge(vespalib::Executor& shared_executor, std::shared_ptr<IFlushToken> flush_token);
 };
 
@@ -26,6 +26,8 @@ private:
     const uint32_t                       _doc_id_limit;
     bool                                 _dynamic_k_pos_index_format;
     bool                                 _force_small_merge_chunk;
+    uint32_t                             _max_word_range_partitions;
+    size_t                               _word_range_partitions_memory_limit;
     const TuneFileIndexing&              _tune_file_indexing;
     const common::FileHeaderContext&     _file_header_context;
 public:
@@ -34,12 +36,16 @@ public:
 
     void set_dynamic_k_pos_index_format(bool dynamic_k_pos_index_format) { _dynamic_k_pos_index_format = dynamic_k_pos_index_format; }
     void set_force_small_merge_chunk(bool force_small_merge_chunk) { _force_small_merge_chunk = force_small_merge_chunk; }
+    void set_max_word_range_partitions(uint32_t max_word_range_partitions) { _max_word_range_partitions = max_word_range_partitions; }
+    void set_word_range_partitions_memory_limit(size_t memory_limit) { _word_range_partitions_memory_limit = memory_limit; }
     const index::Schema& get_schema() const noexcept { return _schema; }
     const vespalib::string& get_path() const noexcept { return _path; }
     const std::vector<FusionInputIndex>& get_old_indexes() const noexcept { return _old_indexes; }
     uint32_t get_doc_id_limit() const noexcept { return _doc_id_limit; }
     bool get_dynamic_k_pos_index_format() const noexcept { return _dynamic_k_pos_index_format; }
     bool get_force_small_merge_chunk() const noexcept { return _force_small_merge_chunk; }
+    uint32_t get_max_word_range_partitions() const noexcept { return _max_word_range_partitions; }
+    size_t get_word_range_partitions_memory_limit() const noexcept { return _word_range_partitions_memory_limit; }
     const TuneFileIndexing& get_tune_file_indexing() const noexcept { return _tune_file_indexing; }
     const common::FileHeaderContext& get_file_header_context() const noexcept { return _file_header_context; }
 };
@@ -89,6 +89,10 @@ Zc4PostingWriter<bigEndian>::flush_word_with_skip(bool hasMore)
                           K_VALUE_ZCPOSTING_LASTDOCID);
     }
 
+    if (_first_byte_align_pos == 0) {
+        _first_byte_align_pos = e.getWriteOffset();
+        _first_byte_align_word = _numWords;
+    }
     e.smallAlign(8);    // Byte align
 
     uint8_t *docIds = _zcDocIds._mallocStart;
@@ -240,9 +244,20 @@ void
 Zc4PostingWriter<bigEndian>::on_open()
 {
     _numWords = 0;
+    _first_byte_align_pos = 0;
+    _first_byte_align_word = 0;
     _writePos = _encode_context.getWriteOffset(); // Position after file header 
 }
 
+template <bool bigEndian>
+void
+Zc4PostingWriter<bigEndian>::on_append(uint64_t num_words)
+{
+    assert(_docIds.empty() && _counts._segments.empty());
+    _numWords += num_words;
+    _writePos = _encode_context.getWriteOffset();
+}
+
 template <bool bigEndian>
 void
 Zc4PostingWriter<bigEndian>::on_close()
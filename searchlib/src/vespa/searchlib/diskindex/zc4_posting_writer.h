@@ -43,6 +43,7 @@ public:
     void set_encode_features(EncodeContext *encode_features);
     void on_open();
     void on_close();
+    void on_append(uint64_t num_words);
 
     EncodeContext &get_encode_features() { return *_encode_features; }
     EncodeContext &get_encode_context() { return _encode_context; }
@@ -214,6 +214,8 @@ Zc4PostingWriterBase::Zc4PostingWriterBase(PostingListCounts &counts)
       _l3Skip(),
       _l4Skip(),
       _numWords(0),
+      _first_byte_align_pos(0),
+      _first_byte_align_word(0),
       _counts(counts),
       _writeContext(sizeof(uint64_t)),
       _featureWriteContext(sizeof(uint64_t))
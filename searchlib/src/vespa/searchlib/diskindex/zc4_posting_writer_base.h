@@ -51,6 +51,15 @@ protected:
     ZcBuf _l4Skip;      // L4 skip info
 
     uint64_t _numWords; // Number of words in file
+    /*
+     * Bit position of the first byte alignment within a posting list
+     * (0 if none) and the number of the word (starting at 0) it belongs
+     * to. Encoding before that point does not depend on the absolute
+     * bit position in the file, which allows for appending the file to
+     * another posting list file.
+     */
+    uint64_t _first_byte_align_pos;
+    uint64_t _first_byte_align_word;
     index::PostingListCounts &_counts;
     search::ComprFileWriteContext _writeContext;
     search::ComprFileWriteContext _featureWriteContext;
@@ -71,6 +80,8 @@ public:
     uint32_t get_min_skip_docs() const { return _minSkipDocs; }
     uint32_t get_docid_limit() const { return _docIdLimit; }
     uint64_t get_num_words() const { return _numWords; }
+    uint64_t get_first_byte_align_pos() const { return _first_byte_align_pos; }
+    uint64_t get_first_byte_align_word() const { return _first_byte_align_word; }
     bool get_dynamic_k() const { return _dynamicK; }
     bool get_encode_interleaved_features() const { return _encode_interleaved_features; }
     void set_dynamic_k(bool dynamicK) { _dynamicK = dynamicK; }
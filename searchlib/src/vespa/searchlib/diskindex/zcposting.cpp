@@ -8,6 +8,7 @@
 #include <vespa/searchlib/index/postinglistparams.h>
 #include <vespa/searchlib/common/fileheadercontext.h>
 #include <vespa/vespalib/data/fileheader.h>
+#include <vespa/vespalib/util/size_literals.h>
 #include <cassert>
 
 #include <vespa/log/log.h>
@@ -19,6 +20,27 @@ vespalib::string myId5("Zc.5");
 vespalib::string myId4("Zc.4");
 vespalib::string interleaved_features("interleaved_features");
 
+constexpr size_t append_buffer_words = 64_Ki;
+
+/*
+ * Copy bits [start, end) from a posting list file to an encode context.
+ */
+void
+copy_bits(FastOS_FileInterface &file, uint64_t start, uint64_t end,
+          search::bitcompression::FeatureEncodeContextBE &e, std::vector<uint64_t> &buffer)
+{
+    while (start < end) {
+        uint64_t first_word = start >> 6;
+        uint64_t end_word = (end + 63) >> 6;
+        size_t words = std::min(end_word - first_word, static_cast<uint64_t>(buffer.size()));
+        file.ReadBuf(buffer.data(), words * sizeof(uint64_t), first_word * sizeof(uint64_t));
+        uint32_t bit_offset = start & 63;
+        uint64_t bit_length = std::min(end - start, words * 64 - bit_offset);
+        e.writeBits(buffer.data(), bit_offset, bit_length);
+        start += bit_length;
+    }
+}
+
 }
 
 namespace search::diskindex {
@@ -63,6 +85,21 @@ Zc4PostingSeqRead::readCounts(const PostingListCounts &counts)
 }
 
 
+void
+Zc4PostingSeqRead::skipPostingLists(uint64_t bitLength)
+{
+    if (bitLength == 0) {
+        return;
+    }
+    auto &readContext = _reader.get_read_context();
+    auto &d = _reader.get_decode_features();
+    readContext.setPosition(d.getReadOffset() + bitLength);
+    if (d._valI >= d._valE) {
+        readContext.readComprBuffer();
+    }
+}
+
+
 bool
 Zc4PostingSeqRead::open(const vespalib::string &name,
                         const TuneFileSeqRead &tuneFileRead)
@@ -375,6 +412,51 @@ getFeatureParams(PostingListParams &params)
 }
 
 
+Zc4PostingSeqWrite::AppendInfo
+Zc4PostingSeqWrite::get_append_info() const
+{
+    AppendInfo info;
+    info._num_words = _writer.get_num_words();
+    info._first_byte_align_pos = _writer.get_first_byte_align_pos();
+    info._first_byte_align_word = _writer.get_first_byte_align_word();
+    return info;
+}
+
+
+bool
+Zc4PostingSeqWrite::append(const vespalib::string &name, const AppendInfo &info, int64_t &bit_length_adjustment)
+{
+    FastOS_File file;
+    if (!file.OpenReadOnly(name.c_str())) {
+        LOG(error, "could not open %s: %s", name.c_str(), getLastErrorString().c_str());
+        return false;
+    }
+    vespalib::FileHeader header;
+    uint32_t headerLen = header.readFile(file);
+    headerLen += (-headerLen & 7);
+    assert(header.getTag("frozen").asInteger() != 0);
+    assert(static_cast<uint64_t>(header.getTag("numWords").asInteger()) == info._num_words);
+    uint64_t fileBitSize = header.getTag("fileBitSize").asInteger();
+    uint64_t pos = static_cast<uint64_t>(headerLen) * 8;
+    EncodeContext &e = _writer.get_encode_context();
+    std::vector<uint64_t> buffer(append_buffer_words);
+    bit_length_adjustment = 0;
+    if (info._first_byte_align_pos != 0) {
+        // Encoding up to the first byte alignment is independent of position, redo the alignment here.
+        copy_bits(file, pos, info._first_byte_align_pos, e, buffer);
+        uint64_t oldPad = (- info._first_byte_align_pos) & 7;
+        uint64_t writePos = e.getWriteOffset();
+        e.smallAlign(8);
+        bit_length_adjustment = static_cast<int64_t>(e.getWriteOffset() - writePos) - static_cast<int64_t>(oldPad);
+        pos = info._first_byte_align_pos + oldPad;
+    }
+    // Remaining encoding has the same position modulo 8 as in the appended file.
+    copy_bits(file, pos, fileBitSize, e, buffer);
+    _writer.on_append(info._num_words);
+    return file.Close();
+}
+
+
 ZcPostingSeqWrite::ZcPostingSeqWrite(PostingListCountFileSeqWrite *countFile)
     : Zc4PostingSeqWrite(countFile)
 {
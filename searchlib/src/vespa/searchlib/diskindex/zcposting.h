@@ -38,6 +38,7 @@ public:
 
     void readDocIdAndFeatures(DocIdAndFeatures &features) override;
     void readCounts(const PostingListCounts &counts) override; // Fill in for next word
+    void skipPostingLists(uint64_t bitLength) override;
     bool open(const vespalib::string &name, const TuneFileSeqRead &tuneFileRead) override;
     bool close() override;
     void getParams(PostingListParams &params) override;
@@ -65,6 +66,21 @@ protected:
     void makeHeader(const search::common::FileHeaderContext &fileHeaderContext);
     bool updateHeader();
 public:
+    /*
+     * Information about a closed posting list file, needed to append
+     * it to another posting list file.
+     */
+    struct AppendInfo {
+        uint64_t _num_words;
+        uint64_t _first_byte_align_pos;
+        uint64_t _first_byte_align_word;
+        AppendInfo() noexcept
+            : _num_words(0),
+              _first_byte_align_pos(0),
+              _first_byte_align_word(0)
+        { }
+    };
+
     Zc4PostingSeqWrite(index::PostingListCountFileSeqWrite *countFile);
     ~Zc4PostingSeqWrite();
 
@@ -84,6 +100,15 @@ public:
     void getParams(PostingListParams &params) override;
     void setFeatureParams(const PostingListParams &params) override;
     void getFeatureParams(PostingListParams &params) override;
+    AppendInfo get_append_info() const;
+    /*
+     * Append all posting lists in a closed file written with the same
+     * parameters, after the posting lists already written. The bit
+     * length of the appended word containing the first byte alignment
+     * changes by bit_length_adjustment, which must be applied to its
+     * counts (and its first segment) when writing the dictionary.
+     */
+    bool append(const vespalib::string &name, const AppendInfo &info, int64_t &bit_length_adjustment);
 };
 
 class ZcPostingSeqWrite : public Zc4PostingSeqWrite
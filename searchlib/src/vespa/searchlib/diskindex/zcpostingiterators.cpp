@@ -194,6 +194,7 @@ ZcPostingIteratorBase::ZcPostingIteratorBase(TermFieldMatchDataArray matchData,
     : ZcIteratorBase(std::move(matchData), start, docIdLimit),
       _valI(nullptr),
       _valIBase(nullptr),
+      _valIEnd(nullptr),
       _featureSeekPos(0),
       _l1(),
       _l2(),
@@ -311,6 +312,7 @@ ZcPostingIterator<bigEndian>::readWordStart(uint32_t docIdLimit)
     const uint8_t *bcompr = d.getByteCompr();
     _valIBase = _valI = bcompr;
     bcompr += docIdsSize;
+    _valIEnd = bcompr;
     _l1.setup(prevDocId, _chunk._lastDocId, bcompr, l1SkipSize);
     _l2.setup(prevDocId, _chunk._lastDocId, bcompr, l2SkipSize);
     _l3.setup(prevDocId, _chunk._lastDocId, bcompr, l3SkipSize);
@@ -545,6 +547,18 @@ ZcPostingIteratorBase::doSeek(uint32_t docId)
     assert(docId <= _l4._skipDocId);
 #endif
     const uint8_t *oCompr = _valI;
+    if (!_decode_interleaved_features) {
+        if (oDocId + zc_skip_min_docid_distance < docId) {
+            addNeedUnpack(zc_skip_single_byte_docid_deltas(oCompr, _valIEnd, oDocId, docId));
+        }
+        while (__builtin_expect(oDocId < docId, true)) {
+            ZCDECODE(oCompr, oDocId += 1 +);
+            incNeedUnpack();
+        }
+        _valI = oCompr;
+        setDocId(oDocId);
+        return;
+    }
     uint32_t field_length = _field_length;
     uint32_t num_occs = _num_occs;
     while (__builtin_expect(oDocId < docId, true)) {
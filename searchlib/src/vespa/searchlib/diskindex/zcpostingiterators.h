@@ -5,6 +5,7 @@
 #include <vespa/searchlib/index/postinglistfile.h>
 #include <vespa/searchlib/bitcompression/compression.h>
 #include <vespa/searchlib/queryeval/iterators.h>
+#include <cstring>
 
 namespace search::diskindex {
 
@@ -40,6 +41,44 @@ do {                                                         \
     }                                                        \
 } while (0)
 
+/*
+ * Skip groups of 8 docid deltas as long as all of them are encoded in a
+ * single byte (typical for dense posting lists) and the last docid in
+ * the group is below the target docid. The 8 byte group is checked and
+ * summed as a single 64-bit word instead of decoding one delta at a
+ * time. Never reads beyond valIEnd. Returns the number of skipped
+ * documents.
+ *
+ * Seeks shorter than zc_skip_min_docid_distance rarely get past a
+ * group, so callers only try skipping for longer seeks.
+ */
+constexpr uint32_t zc_skip_min_docid_distance = 32;
+
+inline uint32_t
+zc_skip_single_byte_docid_deltas(const uint8_t *&valI, const uint8_t *valIEnd, uint32_t &docId, uint32_t target)
+{
+    constexpr uint64_t high_bits = 0x8080808080808080ul;
+    constexpr uint64_t even_bytes = 0x00ff00ff00ff00fful;
+    uint32_t skipped = 0;
+    while (valIEnd - valI >= 8) {
+        uint64_t bytes;
+        memcpy(&bytes, valI, sizeof(bytes));
+        if (bytes & high_bits) {
+            break;
+        }
+        // Each byte is (delta - 1). Sum pairwise into 16-bit lanes before summing lanes.
+        uint64_t lanes = (bytes & even_bytes) + ((bytes >> 8) & even_bytes);
+        uint32_t last_docid = docId + 8 + static_cast<uint32_t>((lanes * 0x0001000100010001ul) >> 48);
+        if (last_docid >= target) {
+            break;
+        }
+        docId = last_docid;
+        valI += 8;
+        skipped += 8;
+    }
+    return skipped;
+}
+
 class ZcIteratorBase : public queryeval::RankedSearchIteratorBase
 {
 protected:
@@ -139,6 +178,7 @@ class ZcPostingIteratorBase : public ZcIteratorBase
 protected:
     const uint8_t *_valI;     // docid deltas
     const uint8_t *_valIBase; // start of docid deltas
+    const uint8_t *_valIEnd;  // end of docid deltas
     uint64_t _featureSeekPos;
 
     // Helper class for L1 skip info
@@ -2,6 +2,7 @@
 
 #include "chunkformats.h"
 #include <vespa/vespalib/util/compressor.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 #include <vespa/vespalib/util/stringfmt.h>
 
 namespace search {
@@ -19,7 +20,8 @@ ChunkException::ChunkException(const vespalib::string & msg, vespalib::stringref
 }
 
 void
-ChunkFormat::pack(uint64_t lastSerial, vespalib::DataBuffer & compressed, CompressionConfig compression)
+ChunkFormat::pack(uint64_t lastSerial, vespalib::DataBuffer & compressed, CompressionConfig compression,
+                  Dictionary * dictionary)
 {
     vespalib::nbostream & os = _dataBuf;
     os << lastSerial;
@@ -33,9 +35,19 @@ ChunkFormat::pack(uint64_t lastSerial, vespalib::DataBuffer & compressed, Compre
     const size_t oldPos(compressed.getDataLen());
     compressed.writeInt8(compression.type);
     compressed.writeInt32(os.size());
-    CompressionConfig::Type type(compress(compression, vespalib::ConstBufferRef(os.data(), os.size()), compressed, false));
-    if (compression.type != type) {
-        compressed.getData()[oldPos] = type;
+    vespalib::ConstBufferRef uncompressed(os.data(), os.size());
+    if ((dictionary != nullptr) && (compression.type == CompressionConfig::ZSTD)) {
+        if (compress(*dictionary, compression, uncompressed, compressed) == CompressionConfig::ZSTD) {
+            compressed.getData()[oldPos] = ZSTD_DICTIONARY;
+        } else {
+            compressed.writeBytes(uncompressed.c_str(), uncompressed.size());
+            compressed.getData()[oldPos] = CompressionConfig::NONE;
+        }
+    } else {
+        CompressionConfig::Type type(compress(compression, uncompressed, compressed, false));
+        if (compression.type != type) {
+            compressed.getData()[oldPos] = type;
+        }
     }
     if (includeSerializedSize()) {
         const uint32_t serializedSize = htonl(compressed.getDataLen()+4);
@@ -67,7 +79,7 @@ ChunkFormat::verifyCompression(uint8_t type)
 }
 
 ChunkFormat::UP
-ChunkFormat::deserialize(const void * buffer, size_t len)
+ChunkFormat::deserialize(const void * buffer, size_t len, Dictionary * dictionary)
 {
     uint8_t version(0);
     vespalib::nbostream raw(buffer, len);
@@ -82,9 +94,9 @@ ChunkFormat::deserialize(const void * buffer, size_t len)
     raw >> crc32;
     raw.rp(currPos);
     if (version == ChunkFormatV1::VERSION) {
-        return std::make_unique<ChunkFormatV1>(raw, crc32);
+        return std::make_unique<ChunkFormatV1>(raw, crc32, dictionary);
     } else if (version == ChunkFormatV2::VERSION) {
-            return std::make_unique<ChunkFormatV2>(raw, crc32);
+            return std::make_unique<ChunkFormatV2>(raw, crc32, dictionary);
     } else {
         throw ChunkException(make_string("Unknown version %d", version), VESPA_STRLOC);
     }
@@ -109,7 +121,7 @@ ChunkFormat::verifyCrc(const vespalib::nbostream & is, uint32_t expectedCrc) con
 }
 
 void
-ChunkFormat::deserializeBody(vespalib::nbostream & is)
+ChunkFormat::deserializeBody(vespalib::nbostream & is, Dictionary * dictionary)
 {
     if (includeSerializedSize()) {
         uint32_t serializedSize(0);
@@ -122,13 +134,23 @@ ChunkFormat::deserializeBody(vespalib::nbostream & is)
     }
     uint8_t type(0);
     is >> type;
-    verifyCompression(type);
+    if (type == ZSTD_DICTIONARY) {
+        if (dictionary == nullptr) {
+            throw ChunkException("Chunk is compressed with a dictionary, but none is available", VESPA_STRLOC);
+        }
+    } else {
+        verifyCompression(type);
+    }
     uint32_t uncompressedLen(0);
     is >> uncompressedLen;
     // This is a dirty trick to fool some odd sanity checking in DataBuffer::swap
     vespalib::DataBuffer uncompressed(const_cast<char *>(is.peek()), (size_t)0);
     vespalib::ConstBufferRef data(is.peek(), is.size() - sizeof(uint32_t));
-    decompress(CompressionConfig::Type(type), uncompressedLen, data, uncompressed, true);
+    if (type == ZSTD_DICTIONARY) {
+        decompress(*dictionary, uncompressedLen, data, uncompressed, true);
+    } else {
+        decompress(CompressionConfig::Type(type), uncompressedLen, data, uncompressed, true);
+    }
     assert(uncompressed.getData() == uncompressed.getDead());
     if (uncompressed.getData() != data.c_str()) {
         const size_t sz(uncompressed.getDataLen());
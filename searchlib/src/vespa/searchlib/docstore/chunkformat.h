@@ -7,6 +7,8 @@
 #include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/util/exception.h>
 
+namespace vespalib::compression { class ZStdDictionaryCompressor; }
+
 namespace search {
 
 class ChunkException : public vespalib::Exception
@@ -22,6 +24,12 @@ public:
     virtual ~ChunkFormat();
     using UP = std::unique_ptr<ChunkFormat>;
     using CompressionConfig = vespalib::compression::CompressionConfig;
+    using Dictionary = vespalib::compression::ZStdDictionaryCompressor;
+    /**
+     * Compression type stored for chunks compressed with zstd using the dictionary of the file.
+     * It is not a CompressionConfig::Type, as it is only meaningful together with that dictionary.
+     */
+    static constexpr uint8_t ZSTD_DICTIONARY = 0x80 | CompressionConfig::ZSTD;
     vespalib::nbostream & getBuffer() { return _dataBuf; }
     const vespalib::nbostream & getBuffer() const { return _dataBuf; }
 
@@ -30,14 +38,17 @@ public:
      * @param lastSerial The last serial number of any entry in the packet.
      * @param compressed The buffer where the serialized data shall be placed.
      * @param compression What kind of compression shall be employed.
+     * @param dictionary Optional dictionary used when compression is zstd.
      */
-    void pack(uint64_t lastSerial, vespalib::DataBuffer & compressed, CompressionConfig compression);
+    void pack(uint64_t lastSerial, vespalib::DataBuffer & compressed, CompressionConfig compression,
+              Dictionary * dictionary = nullptr);
     /**
      * Will deserialize and create a representation of the uncompressed data.
      * param buffer Pointer to the serialized data
      * @param len Length of serialized data
+     * @param dictionary The dictionary of the file, required if the chunk was packed with one.
      */
-    static ChunkFormat::UP deserialize(const void * buffer, size_t len);
+    static ChunkFormat::UP deserialize(const void * buffer, size_t len, Dictionary * dictionary = nullptr);
     /**
      * return the maximum size a packet can have. It allows correct size estimation
      * need for direct io alignment.
@@ -58,8 +69,9 @@ protected:
     /**
      * Will deserialize and uncompress the body.
      * @param the potentially compressed stream.
+     * @param dictionary used if the body is compressed with a dictionary.
      */
-    void deserializeBody(vespalib::nbostream & is);
+    void deserializeBody(vespalib::nbostream & is, Dictionary * dictionary);
     /**
      * Wille compute and check the crc of the incoming stream.
      * Will start 1 byte earlier and stop 4 bytes ahead of end.
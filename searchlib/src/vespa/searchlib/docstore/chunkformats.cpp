@@ -9,11 +9,11 @@ namespace search {
 
 using vespalib::make_string;
 
-ChunkFormatV1::ChunkFormatV1(vespalib::nbostream & is, uint32_t expectedCrc) :
+ChunkFormatV1::ChunkFormatV1(vespalib::nbostream & is, uint32_t expectedCrc, Dictionary * dictionary) :
     ChunkFormat()
 {
     verifyCrc(is, expectedCrc);
-    deserializeBody(is);
+    deserializeBody(is, dictionary);
 }
 
 ChunkFormatV1::ChunkFormatV1(size_t maxSize) :
@@ -27,12 +27,12 @@ ChunkFormatV1::computeCrc(const void * buf, size_t sz) const
     return vespalib::crc_32_type::crc(buf, sz);
 }
 
-ChunkFormatV2::ChunkFormatV2(vespalib::nbostream & is, uint32_t expectedCrc) :
+ChunkFormatV2::ChunkFormatV2(vespalib::nbostream & is, uint32_t expectedCrc, Dictionary * dictionary) :
     ChunkFormat()
 {
     verifyCrc(is, expectedCrc);
     verifyMagic(is);
-    deserializeBody(is);
+    deserializeBody(is, dictionary);
 }
 
 
@@ -10,7 +10,7 @@ class ChunkFormatV1 : public ChunkFormat
 {
 public:
     enum {VERSION=0};
-    ChunkFormatV1(vespalib::nbostream & is, uint32_t expectedCrc);
+    ChunkFormatV1(vespalib::nbostream & is, uint32_t expectedCrc, Dictionary * dictionary);
     ChunkFormatV1(size_t maxSize);
 private:
     bool includeSerializedSize() const override { return false; }
@@ -26,7 +26,7 @@ class ChunkFormatV2 : public ChunkFormat
 {
 public:
     enum {VERSION=1, MAGIC=0x5ba32de7};
-    ChunkFormatV2(vespalib::nbostream & is, uint32_t expectedCrc);
+    ChunkFormatV2(vespalib::nbostream & is, uint32_t expectedCrc, Dictionary * dictionary);
     ChunkFormatV2(size_t maxSize);
 private:
     bool includeSerializedSize() const override { return true; }
@@ -7,6 +7,7 @@
 #include <vespa/document/fieldvalue/document.h>
 #include <vespa/vespalib/stllike/cache.hpp>
 #include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
 #include <vespa/vespalib/util/compressor.h>
 #include <vespa/vespalib/util/size_literals.h>
 
@@ -57,6 +58,7 @@ public:
     { }
 
     bool read(DocumentIdT key, Value &value) const;
+    void read(const IDocumentStore::LidVector &lids, IBufferVisitor &visitor) const;
     void visit(const IDocumentStore::LidVector &lids, const DocumentTypeRepo &repo, IDocumentVisitor &visitor) const;
     void write(DocumentIdT, const Value &);
     void erase(DocumentIdT) {}
@@ -74,6 +76,11 @@ BackingStore::visit(const IDocumentStore::LidVector &lids, const DocumentTypeRep
     _backingStore.read(lids, adapter);
 }
 
+void
+BackingStore::read(const IDocumentStore::LidVector &lids, IBufferVisitor &visitor) const {
+    _backingStore.read(lids, visitor);
+}
+
 bool
 BackingStore::read(DocumentIdT key, Value &value) const {
     bool found(false);
@@ -110,6 +117,42 @@ public:
     Cache(BackingStore & b, size_t maxBytes) : vespalib::cache<CacheParams>(b, maxBytes) { }
 };
 
+namespace {
+
+// Populates the cache with blobs read directly from the backing store,
+// in the same form as BackingStore::read would have cached them.
+// The cache generation of each lid must be sampled before it is read.
+class CachePopulatingVisitor : public IBufferVisitor
+{
+public:
+    using Generations = vespalib::hash_map<uint32_t, size_t>;
+    CachePopulatingVisitor(Cache & cache, Generations generations, CompressionConfig compression,
+                           const DocumentTypeRepo & repo, IDocumentVisitor & visitor)
+        : _cache(cache),
+          _generations(std::move(generations)),
+          _compression(compression),
+          _adapter(repo, visitor)
+    { }
+    void visit(uint32_t lid, vespalib::ConstBufferRef buf) override {
+        auto found = _generations.find(lid);
+        if ((buf.size() > 0) && (found != _generations.end())) {
+            vespalib::DataBuffer copy(buf.size());
+            copy.writeBytes(buf.c_str(), buf.size());
+            Value value;
+            value.set(std::move(copy), buf.size(), _compression);
+            _cache.populate(lid, std::move(value), found->second);
+        }
+        _adapter.visit(lid, buf);
+    }
+private:
+    Cache                 & _cache;
+    Generations             _generations;
+    CompressionConfig       _compression;
+    DocumentVisitorAdapter  _adapter;
+};
+
+}
+
 }
 
 using docstore::Value;
@@ -197,6 +240,40 @@ DocumentStore::read(DocumentIdT lid, const DocumentTypeRepo &repo) const
     return std::unique_ptr<document::Document>();
 }
 
+void
+DocumentStore::read(const LidVector & lids, const DocumentTypeRepo &repo, IDocumentVisitor & visitor) const
+{
+    if ( ! useCache()) {
+        _uncached_lookups.fetch_add(lids.size());
+        _store->visit(lids, repo, visitor);
+        return;
+    }
+    LidVector misses;
+    misses.reserve(lids.size());
+    docstore::CachePopulatingVisitor::Generations generations(lids.size() * 2);
+    for (DocumentIdT lid : lids) {
+        // Sampled before checking the cache, so that any later write or invalidate is noticed.
+        size_t generation = _cache->generation(lid);
+        if (_cache->hasKey(lid)) {
+            auto doc = read(lid, repo);
+            if (doc) {
+                visitor.visit(lid, std::move(doc));
+            }
+        } else {
+            misses.push_back(lid);
+            generations[lid] = generation;
+        }
+    }
+    if (misses.empty()) {
+        return;
+    }
+    // Misses are read from the backing store grouped by chunk, and then inserted in the cache
+    // unless something in the same cache lock stripe was modified while reading.
+    _uncached_lookups.fetch_add(misses.size());
+    docstore::CachePopulatingVisitor populator(*_cache, std::move(generations), _store->getCompression(), repo, visitor);
+    _store->read(misses, populator);
+}
+
 void
 DocumentStore::write(uint64_t syncToken, DocumentIdT lid, const document::Document& doc) {
     nbostream stream(12345);
@@ -221,6 +298,8 @@ DocumentStore::write(uint64_t syncToken, DocumentIdT lid, const vespalib::nbostr
                     _cache->write(lid, std::move(value));
                 } else {
                     _backingStore.write(syncToken, lid, stream.peek(), stream.size());
+                    // Stops a concurrent batched read from populating the cache with the old document.
+                    _cache->invalidate(lid);
                 }
                 break;
         }
@@ -8,9 +8,11 @@
 #include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/data/fileheader.h>
 #include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/encoding/base64.h>
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/vespalib/util/executor.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 #include <vespa/vespalib/util/arrayqueue.hpp>
 #include <vespa/fastos/file.h>
 #include <filesystem>
@@ -30,6 +32,7 @@ namespace {
 constexpr size_t ALIGNMENT=0x1000;
 constexpr size_t ENTRY_BIAS_SIZE=8;
 const vespalib::string DOC_ID_LIMIT_KEY("docIdLimit");
+const vespalib::string DICTIONARY_KEY("zstdDictionary");
 
 }
 
@@ -83,7 +86,8 @@ FileChunk::FileChunk(FileId fileId, NameId nameId, const vespalib::string & base
       _idxHeaderLen(0u),
       _numLids(0),
       _docIdLimit(std::numeric_limits<uint32_t>::max()),
-      _modificationTime()
+      _modificationTime(),
+      _dictionary()
 {
     FastOS_File dataFile(_dataFileName.c_str());
     if (dataFile.OpenReadOnly()) {
@@ -223,6 +227,9 @@ FileChunk::enableRead()
     if (_tune._randRead.getWantDirectIO()) {
         LOG(debug, "enableRead(): DirectIORandRead: file='%s'", _dataFileName.c_str());
         _file = std::make_unique<DirectIORandRead>(_dataFileName);
+    } else if (_tune._randRead.getWantAsyncIO()) {
+        LOG(debug, "enableRead(): AsyncIORandRead: file='%s'", _dataFileName.c_str());
+        _file = std::make_unique<AsyncIORandRead>(_dataFileName);
     } else if (_tune._randRead.getWantMemoryMap()) {
         const int mmapFlags(_tune._randRead.getMemoryMapFlags());
         const int fadviseOptions(_tune._randRead.getAdvise());
@@ -241,6 +248,14 @@ FileChunk::enableRead()
     if (_dataHeaderLen == 0u) {
         throw std::runtime_error(make_string("bad file header: %s", _dataFileName.c_str()));
     }
+    if ( ! _dictionary) {
+        vespalib::DataBuffer h(_dataHeaderLen, ALIGNMENT);
+        FileRandRead::FSP keepAlive = _file->read(0, h, _dataHeaderLen);
+        GenericHeader::BufferReader rd(h);
+        GenericHeader header;
+        header.read(rd);
+        _dictionary = readDictionary(header);
+    }
 }
 
 size_t FileChunk::adjustSize(size_t sz) {
@@ -316,7 +331,7 @@ FileChunk::appendTo(vespalib::Executor & executor, const IGetLid & db, IWriteDat
             const ChunkInfo & cInfo(_chunkInfo[chunkId]);
             vespalib::DataBuffer whole(0ul, ALIGNMENT);
             FileRandRead::FSP keepAlive(_file->read(cInfo.getOffset(), whole, cInfo.getSize()));
-            promise.set_value(std::make_unique<Chunk>(chunkId, whole.getData(), whole.getDataLen()));
+            promise.set_value(std::make_unique<Chunk>(chunkId, whole.getData(), whole.getDataLen(), _dictionary.get()));
         });
         executor.execute(CpuUsage::wrap(std::move(task), cpu_category));
 
@@ -338,19 +353,51 @@ void
 FileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor) const
 {
     if (count == 0) { return; }
+    if ( ! _file->supports_read_batch()) {
+        uint32_t prevChunk = begin->getChunkId();
+        uint32_t start(0);
+        for (size_t i(0); i < count; i++) {
+            const LidInfoWithLid & li = *(begin + i);
+            if (li.getChunkId() != prevChunk) {
+                ChunkInfo ci = _chunkInfo[prevChunk];
+                read(begin + start, i - start, ci, visitor);
+                prevChunk = li.getChunkId();
+                start = i;
+            }
+        }
+        ChunkInfo ci = _chunkInfo[prevChunk];
+        read(begin + start, count - start, ci, visitor);
+        return;
+    }
+    // Find the lid range belonging to each chunk, then fetch all chunks in one batch.
+    std::vector<size_t> starts;
     uint32_t prevChunk = begin->getChunkId();
-    uint32_t start(0);
+    starts.push_back(0);
     for (size_t i(0); i < count; i++) {
-        const LidInfoWithLid & li = *(begin + i);
-        if (li.getChunkId() != prevChunk) {
-            ChunkInfo ci = _chunkInfo[prevChunk];
-            read(begin + start, i - start, ci, visitor);
-            prevChunk = li.getChunkId();
-            start = i;
+        uint32_t chunkId = (begin + i)->getChunkId();
+        if (chunkId != prevChunk) {
+            starts.push_back(i);
+            prevChunk = chunkId;
         }
     }
-    ChunkInfo ci = _chunkInfo[prevChunk];
-    read(begin + start, count - start, ci, visitor);
+    if (starts.size() == 1) {
+        read(begin, count, _chunkInfo[prevChunk], visitor);
+        return;
+    }
+    std::vector<vespalib::DataBuffer> buffers;
+    std::vector<FileRandRead::ReadRequest> requests;
+    buffers.reserve(starts.size());
+    requests.reserve(starts.size());
+    for (size_t start : starts) {
+        const ChunkInfo & ci = _chunkInfo[(begin + start)->getChunkId()];
+        buffers.emplace_back(0ul, ALIGNMENT);
+        requests.push_back({ci.getOffset(), ci.getSize(), &buffers.back()});
+    }
+    std::vector<FileRandRead::FSP> keepAlive = _file->read_batch(requests);
+    starts.push_back(count);
+    for (size_t c(0); c + 1 < starts.size(); c++) {
+        visit(begin + starts[c], starts[c + 1] - starts[c], buffers[c], visitor);
+    }
 }
 
 void
@@ -358,7 +405,13 @@ FileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, ChunkInfo c
 {
     vespalib::DataBuffer whole(0ul, ALIGNMENT);
     FileRandRead::FSP keepAlive = _file->read(ci.getOffset(), whole, ci.getSize());
-    Chunk chunk(begin->getChunkId(), whole.getData(), whole.getDataLen());
+    visit(begin, count, whole, visitor);
+}
+
+void
+FileChunk::visit(LidInfoWithLidV::const_iterator begin, size_t count, const vespalib::DataBuffer & whole, IBufferVisitor & visitor) const
+{
+    Chunk chunk(begin->getChunkId(), whole.getData(), whole.getDataLen(), _dictionary.get());
     for (size_t i(0); i < count; i++) {
         const LidInfoWithLid & li = *(begin + i);
         vespalib::ConstBufferRef buf = chunk.getLid(li.getLid());
@@ -383,7 +436,7 @@ FileChunk::read(uint32_t lid, SubChunkId chunkId, const ChunkInfo & chunkInfo,
 {
     vespalib::DataBuffer whole(0ul, ALIGNMENT);
     FileRandRead::FSP keepAlive(_file->read(chunkInfo.getOffset(), whole, chunkInfo.getSize()));
-    Chunk chunk(chunkId, whole.getData(), whole.getDataLen());
+    Chunk chunk(chunkId, whole.getData(), whole.getDataLen(), _dictionary.get());
     return chunk.read(lid, buffer);
 }
 
@@ -445,6 +498,53 @@ FileChunk::writeDocIdLimit(vespalib::GenericHeader &header, uint32_t docIdLimit)
     header.putTag(vespalib::GenericHeader::Tag(DOC_ID_LIMIT_KEY, docIdLimit));
 }
 
+FileChunk::DictionarySP
+FileChunk::readDictionary(const vespalib::GenericHeader &header)
+{
+    if ( ! header.hasTag(DICTIONARY_KEY)) {
+        return {};
+    }
+    std::string dictionary = vespalib::Base64::decode(header.getTag(DICTIONARY_KEY).asString());
+    return std::make_shared<Chunk::Dictionary>(vespalib::ConstBufferRef(dictionary.data(), dictionary.size()));
+}
+
+void
+FileChunk::writeDictionary(vespalib::GenericHeader &header, const Chunk::Dictionary & dictionary)
+{
+    vespalib::ConstBufferRef raw = dictionary.getDictionary();
+    header.putTag(vespalib::GenericHeader::Tag(DICTIONARY_KEY, vespalib::Base64::encode(raw.c_str(), raw.size())));
+}
+
+std::vector<std::vector<char>>
+FileChunk::sampleChunks(size_t maxBytes) const
+{
+    std::vector<std::vector<char>> samples;
+    const size_t numChunks = _chunkInfo.size();
+    size_t stride = 1;
+    size_t sampledBytes = 0;
+    for (size_t chunkId(0); (chunkId < numChunks) && (sampledBytes < maxBytes); chunkId += stride) {
+        const ChunkInfo & ci = _chunkInfo[chunkId];
+        if (ci.getSize() == 0) {
+            continue;
+        }
+        vespalib::DataBuffer whole(0ul, ALIGNMENT);
+        FileRandRead::FSP keepAlive(_file->read(ci.getOffset(), whole, ci.getSize()));
+        const Chunk chunk(chunkId, whole.getData(), whole.getDataLen(), _dictionary.get());
+        const vespalib::nbostream & data = chunk.getData();
+        if (data.empty()) {
+            continue;
+        }
+        samples.emplace_back(data.data(), data.data() + data.size());
+        sampledBytes += data.size();
+        if (samples.size() == 1) {
+            // Use the size of the first chunk to spread the samples evenly over the file.
+            size_t wantedChunks = std::max(1ul, maxBytes / data.size());
+            stride = std::max(1ul, numChunks / wantedChunks);
+        }
+    }
+    return samples;
+}
+
 void
 FileChunk::verify(bool reportOnly) const
 {
@@ -459,7 +559,7 @@ FileChunk::verify(bool reportOnly) const
         vespalib::DataBuffer whole(0ul, ALIGNMENT);
         FileRandRead::FSP keepAlive(_file->read(ci.getOffset(), whole, ci.getSize()));
         try {
-            Chunk chunk(chunkId++, whole.getData(), whole.getDataLen());
+            Chunk chunk(chunkId++, whole.getData(), whole.getDataLen(), _dictionary.get());
             assert(chunk.getLastSerial() >= lastSerial);
             lastSerial = chunk.getLastSerial();
             if (errorInPrev) {
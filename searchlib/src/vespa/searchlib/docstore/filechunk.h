@@ -104,6 +104,7 @@ public:
     };
     using LidBufferMap = vespalib::hash_map<uint32_t, std::unique_ptr<vespalib::DataBuffer>>;
     using UP = std::unique_ptr<FileChunk>;
+    using DictionarySP = std::shared_ptr<Chunk::Dictionary>;
     using SubChunkId = uint32_t;
     FileChunk(FileId fileId, NameId nameId, const vespalib::string &baseName, const TuneFileSummary &tune,
               const IBucketizer *bucketizer);
@@ -197,6 +198,12 @@ public:
     static bool isIdxFileEmpty(const vespalib::string & name);
     static void eraseIdxFile(const vespalib::string & name);
     static void eraseDatFile(const vespalib::string & name);
+    /**
+     * Returns uncompressed chunks spread evenly over the file, up to approximately maxBytes in total.
+     * Used as samples for training a compression dictionary.
+     */
+    std::vector<std::vector<char>> sampleChunks(size_t maxBytes) const;
+    const DictionarySP & getDictionary() const { return _dictionary; }
     static vespalib::string createIdxFileName(const vespalib::string & name);
     static vespalib::string createDatFileName(const vespalib::string & name);
 private:
@@ -244,7 +251,10 @@ protected:
     void setNumUniqueBuckets(size_t numUniqueBuckets) { _numUniqueBuckets = numUniqueBuckets; }
     ssize_t read(uint32_t lid, SubChunkId chunkId, const ChunkInfo & chunkInfo, vespalib::DataBuffer & buffer) const;
     void read(LidInfoWithLidV::const_iterator begin, size_t count, ChunkInfo ci, IBufferVisitor & visitor) const;
+    void visit(LidInfoWithLidV::const_iterator begin, size_t count, const vespalib::DataBuffer & whole, IBufferVisitor & visitor) const;
     static uint32_t readDocIdLimit(vespalib::GenericHeader &header);
+    static DictionarySP readDictionary(const vespalib::GenericHeader &header);
+    static void writeDictionary(vespalib::GenericHeader &header, const Chunk::Dictionary & dictionary);
     static void writeDocIdLimit(vespalib::GenericHeader &header, uint32_t docIdLimit);
 
     using ChunkInfoVector = std::vector<ChunkInfo, vespalib::allocator_large<ChunkInfo>>;
@@ -260,6 +270,7 @@ protected:
     uint32_t               _numLids;
     uint32_t               _docIdLimit; // Limit when the file was created. Stored in idx file header.
     vespalib::system_time  _modificationTime;
+    DictionarySP           _dictionary; // Stored in dat file header.
 };
 
 } // namespace search
@@ -5,6 +5,15 @@
 
 namespace search {
 
+void IDocumentStore::read(const LidVector & lids, const document::DocumentTypeRepo &repo, IDocumentVisitor & visitor) const {
+    for (uint32_t lid : lids) {
+        auto doc = read(lid, repo);
+        if (doc) {
+            visitor.visit(lid, std::move(doc));
+        }
+    }
+}
+
 void IDocumentStore::visit(const LidVector & lids, const document::DocumentTypeRepo &repo, IDocumentVisitor & visitor) const {
     for (uint32_t lid : lids) {
         visitor.visit(lid, read(lid, repo));
@@ -75,6 +75,12 @@ public:
      * @return NULL if there is no document associated with the lid.
      **/
     virtual DocumentUP read(DocumentIdT lid, const document::DocumentTypeRepo &repo) const = 0;
+    /**
+     * Make Documents for all the given lids. Implementations should group the lookups
+     * so that documents sharing a chunk are read and decompressed together.
+     * Only lids with an associated document are passed to the visitor, in no particular order.
+     **/
+    virtual void read(const LidVector & lids, const document::DocumentTypeRepo &repo, IDocumentVisitor & visitor) const;
     virtual void visit(const LidVector & lidVector, const document::DocumentTypeRepo &repo, IDocumentVisitor & visitor) const;
 
     /**
@@ -10,6 +10,7 @@
 #include <vespa/vespalib/util/cpu_usage.h>
 #include <vespa/vespalib/util/exceptions.h>
 #include <vespa/vespalib/util/size_literals.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 #include <thread>
 #include <cassert>
 #include <filesystem>
@@ -48,6 +49,7 @@ LogDataStore::Config::Config()
       _minFileSizeFactor(0.2),
       _maxNumLids(DEFAULT_MAX_LIDS_PER_FILE),
       _compactCompression(CompressionConfig::LZ4),
+      _compactDictionaryMaxBytes(0),
       _fileConfig()
 { }
 
@@ -57,6 +59,7 @@ LogDataStore::Config::operator == (const Config & rhs) const {
             (_maxFileSize == rhs._maxFileSize) &&
             (_minFileSizeFactor == rhs._minFileSizeFactor) &&
             (_compactCompression == rhs._compactCompression) &&
+            (_compactDictionaryMaxBytes == rhs._compactDictionaryMaxBytes) &&
             (_fileConfig == rhs._fileConfig);
 }
 
@@ -461,9 +464,11 @@ void LogDataStore::compactFile(FileId fileId)
             compacted_size = (disk_footprint <= disk_bloat) ? 0u : (disk_footprint - disk_bloat);
         }
         if ( ! shouldCompactToActiveFile(compacted_size)) {
+            FileChunk::DictionarySP dictionary = trainDictionary(*fc);
             MonitorGuard guard(_updateLock);
             destinationFileId = allocateFileId(guard);
-            setNewFileChunk(guard, createWritableFile(destinationFileId, fc->getLastPersistedSerialNum(), fc->getNameId().next()));
+            setNewFileChunk(guard, createWritableFile(destinationFileId, fc->getLastPersistedSerialNum(),
+                                                      fc->getNameId().next(), std::move(dictionary)));
         }
         size_t numSignificantBucketBits = computeNumberOfSignificantBucketIdBits(*_bucketizer, fc->getFileId());
         compacter = std::make_unique<BucketCompacter>(numSignificantBucketBits, _config.compactCompression(), *this,
@@ -642,8 +647,34 @@ LogDataStore::createReadOnlyFile(FileId fileId, NameId nameId) {
     return file;
 }
 
+FileChunk::DictionarySP
+LogDataStore::trainDictionary(const FileChunk & source) const
+{
+    const size_t maxBytes = _config.getCompactDictionaryMaxBytes();
+    if ((maxBytes == 0) || (_config.getFileConfig().getCompression().type != CompressionConfig::ZSTD)) {
+        return {};
+    }
+    // zstd recommends around 100 times the dictionary size as training input.
+    std::vector<std::vector<char>> samples = source.sampleChunks(100 * maxBytes);
+    std::vector<vespalib::ConstBufferRef> sampleRefs;
+    sampleRefs.reserve(samples.size());
+    for (const auto & sample : samples) {
+        sampleRefs.emplace_back(sample.data(), sample.size());
+    }
+    std::vector<char> dictionary = vespalib::compression::ZStdDictionaryCompressor::train(sampleRefs, maxBytes);
+    if (dictionary.empty()) {
+        LOG(info, "Could not train compression dictionary from %zu chunks of file '%s'",
+            samples.size(), source.getName().c_str());
+        return {};
+    }
+    LOG(info, "Trained compression dictionary of %zu bytes from %zu chunks of file '%s'",
+        dictionary.size(), samples.size(), source.getName().c_str());
+    return std::make_shared<vespalib::compression::ZStdDictionaryCompressor>(
+            vespalib::ConstBufferRef(dictionary.data(), dictionary.size()));
+}
+
 FileChunk::UP
-LogDataStore::createWritableFile(FileId fileId, SerialNum serialNum, NameId nameId)
+LogDataStore::createWritableFile(FileId fileId, SerialNum serialNum, NameId nameId, FileChunk::DictionarySP dictionary)
 {
     for (const auto & fc : _fileChunks) {
         if (fc && (fc->getNameId() == nameId)) {
@@ -655,7 +686,7 @@ LogDataStore::createWritableFile(FileId fileId, SerialNum serialNum, NameId name
     uint32_t docIdLimit = (getDocIdLimit() != 0) ? getDocIdLimit() : std::numeric_limits<uint32_t>::max();
     auto file = std::make_unique< WriteableFileChunk>(_executor, fileId, nameId, getBaseDir(), serialNum,docIdLimit,
                                                       _config.getFileConfig(), _tune, _fileHeaderContext,
-                                                      _bucketizer.get());
+                                                      _bucketizer.get(), std::move(dictionary));
     file->enableRead();
     return file;
 }
@@ -50,6 +50,7 @@ public:
         Config & setMinFileSizeFactor(double v) { _minFileSizeFactor = v; return *this; }
 
         Config & compactCompression(CompressionConfig v) { _compactCompression = v; return *this; }
+        Config & setCompactDictionaryMaxBytes(size_t v) { _compactDictionaryMaxBytes = v; return *this; }
         Config & setFileConfig(WriteableFileChunk::Config v) { _fileConfig = v; return *this; }
 
         size_t getMaxFileSize() const { return _maxFileSize; }
@@ -58,6 +59,8 @@ public:
         uint32_t getMaxNumLids() const { return _maxNumLids; }
 
         CompressionConfig compactCompression() const { return _compactCompression; }
+        /// Max size of the zstd dictionary trained for files written by compaction. 0 means no dictionary.
+        size_t getCompactDictionaryMaxBytes() const { return _compactDictionaryMaxBytes; }
 
         const WriteableFileChunk::Config & getFileConfig() const { return _fileConfig; }
 
@@ -68,6 +71,7 @@ public:
         double                      _minFileSizeFactor;
         uint32_t                    _maxNumLids;
         CompressionConfig           _compactCompression;
+        size_t                      _compactDictionaryMaxBytes;
         WriteableFileChunk::Config  _fileConfig;
     };
 public:
@@ -214,7 +218,9 @@ private:
 
     FileChunk::UP createReadOnlyFile(FileId fileId, NameId nameId);
     FileChunk::UP createWritableFile(FileId fileId, SerialNum serialNum);
-    FileChunk::UP createWritableFile(FileId fileId, SerialNum serialNum, NameId nameId);
+    FileChunk::UP createWritableFile(FileId fileId, SerialNum serialNum, NameId nameId,
+                                     FileChunk::DictionarySP dictionary = {});
+    FileChunk::DictionarySP trainDictionary(const FileChunk & source) const;
     vespalib::string createFileName(NameId id) const;
     vespalib::string createDatFileName(NameId id) const;
     vespalib::string createIdxFileName(NameId id) const;
@@ -5,6 +5,8 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <span>
+#include <vector>
 
 class FastOS_FileInterface;
 
@@ -16,8 +18,30 @@ class FileRandRead
 {
 public:
     using FSP = std::shared_ptr<FastOS_FileInterface>;
+    struct ReadRequest {
+        size_t                 offset;
+        size_t                 sz;
+        vespalib::DataBuffer * buffer;
+    };
     virtual ~FileRandRead() = default;
     virtual FSP read(size_t offset, vespalib::DataBuffer & buffer, size_t sz) = 0;
+    /**
+     * Tells whether read_batch() fetches the ranges concurrently. If not, callers
+     * are better off reading and consuming one range at a time.
+     */
+    virtual bool supports_read_batch() const noexcept { return false; }
+    /**
+     * Read several ranges of the file. Implementations may issue the reads concurrently.
+     * The returned handles must be kept alive for as long as the buffers are in use.
+     */
+    virtual std::vector<FSP> read_batch(std::span<const ReadRequest> requests) {
+        std::vector<FSP> keepAlive;
+        keepAlive.reserve(requests.size());
+        for (const ReadRequest & req : requests) {
+            keepAlive.push_back(read(req.offset, *req.buffer, req.sz));
+        }
+        return keepAlive;
+    }
     virtual int64_t getSize() const = 0;
 };
 
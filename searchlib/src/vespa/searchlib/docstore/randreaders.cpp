@@ -3,6 +3,7 @@
 #include "randreaders.h"
 #include "summaryexceptions.h"
 #include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/io/file_read_batch.h>
 #include <vespa/fastos/file.h>
 
 #include <vespa/log/log.h>
@@ -166,4 +167,40 @@ NormalRandRead::getSize() const
     return _file->getSize();
 }
 
+AsyncIORandRead::AsyncIORandRead(const vespalib::string & fileName)
+    : _file(fileName)
+{
+    _file.open(vespalib::File::READONLY);
+}
+
+FileRandRead::FSP
+AsyncIORandRead::read(size_t offset, vespalib::DataBuffer & buffer, size_t sz)
+{
+    ReadRequest req{offset, sz, &buffer};
+    return std::move(read_batch(std::span<const ReadRequest>(&req, 1)).front());
+}
+
+std::vector<FileRandRead::FSP>
+AsyncIORandRead::read_batch(std::span<const ReadRequest> requests)
+{
+    std::vector<vespalib::FileReadBatch::Request> batch;
+    batch.reserve(requests.size());
+    for (const ReadRequest & req : requests) {
+        req.buffer->clear();
+        req.buffer->ensureFree(req.sz);
+        batch.push_back({req.buffer->getFree(), req.sz, off_t(req.offset)});
+    }
+    vespalib::FileReadBatch::read(_file, batch);
+    for (const ReadRequest & req : requests) {
+        req.buffer->moveFreeToData(req.sz);
+    }
+    return std::vector<FSP>(requests.size());
+}
+
+int64_t
+AsyncIORandRead::getSize() const
+{
+    return _file.getFileSize();
+}
+
 }
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "randread.h"
+#include <vespa/vespalib/io/fileutil.h>
 #include <vespa/vespalib/util/ptrholder.h>
 #include <vespa/vespalib/stllike/string.h>
 
@@ -60,4 +61,20 @@ private:
     std::unique_ptr<FastOS_FileInterface>  _file;
 };
 
+/**
+ * Reads using pread, but submits batched reads through io_uring (when available)
+ * so that all chunks needed by a request are fetched from the device concurrently.
+ */
+class AsyncIORandRead : public FileRandRead
+{
+public:
+    AsyncIORandRead(const vespalib::string & fileName);
+    FSP read(size_t offset, vespalib::DataBuffer & buffer, size_t sz) override;
+    bool supports_read_batch() const noexcept override { return true; }
+    std::vector<FSP> read_batch(std::span<const ReadRequest> requests) override;
+    int64_t getSize() const override;
+private:
+    vespalib::File _file;
+};
+
 }
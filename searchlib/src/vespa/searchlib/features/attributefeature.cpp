@@ -121,6 +121,10 @@ public:
         o[3].as_number = 1;  // count
     }
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return true; }
+    void execute_batch(vespalib::ConstArrayRef<uint32_t> docids,
+                       vespalib::ConstArrayRef<const feature_t *> inputs,
+                       vespalib::ConstArrayRef<feature_t *> outputs) override;
 };
 
 class BoolAttributeExecutor final : public fef::FeatureExecutor {
@@ -236,6 +240,28 @@ SingleAttributeExecutor<T>::execute(uint32_t docId)
                      : util::getAsFeature(v);
 }
 
+template <typename T>
+void
+SingleAttributeExecutor<T>::execute_batch(vespalib::ConstArrayRef<uint32_t> docids,
+                                          vespalib::ConstArrayRef<const feature_t *>,
+                                          vespalib::ConstArrayRef<feature_t *> outputs)
+{
+    if (feature_t *values = outputs[0]) {
+        for (size_t i = 0; i < docids.size(); ++i) {
+            typename T::LoadedValueType v = _attribute.getFast(docids[i]);
+            values[i] = __builtin_expect(attribute::isUndefined(v), false)
+                        ? attribute::getUndefined<feature_t>()
+                        : util::getAsFeature(v);
+        }
+    }
+    const feature_t constant_outputs[] = { 0.0, 0.0, 1.0 }; // weight, contains, count
+    for (size_t out_idx = 1; out_idx < outputs.size(); ++out_idx) {
+        if (feature_t *values = outputs[out_idx]) {
+            std::fill_n(values, docids.size(), constant_outputs[out_idx - 1]);
+        }
+    }
+}
+
 template <typename BaseType>
 void
 ArrayAttributeExecutor<BaseType>::execute(uint32_t docId)
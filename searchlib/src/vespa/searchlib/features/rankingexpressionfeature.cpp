@@ -58,6 +58,9 @@ public:
     FastForestExecutor(ArrayRef<float> param_space, const FastForest &forest);
     bool isPure() override { return true; }
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return true; }
+    void execute_batch(ConstArrayRef<uint32_t> docids, ConstArrayRef<const feature_t *> inputs,
+                       ConstArrayRef<feature_t *> outputs) override;
 };
 
 //-----------------------------------------------------------------------------
@@ -76,6 +79,9 @@ public:
     CompiledRankingExpressionExecutor(const CompiledFunction &compiled_function);
     bool isPure() override { return true; }
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return true; }
+    void execute_batch(ConstArrayRef<uint32_t> docids, ConstArrayRef<const feature_t *> inputs,
+                       ConstArrayRef<feature_t *> outputs) override;
 };
 
 //-----------------------------------------------------------------------------
@@ -93,6 +99,9 @@ public:
     LazyCompiledRankingExpressionExecutor(const CompiledFunction &compiled_function);
     bool isPure() override { return true; }
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return true; }
+    void execute_batch(ConstArrayRef<uint32_t> docids, ConstArrayRef<const feature_t *> inputs,
+                       ConstArrayRef<feature_t *> outputs) override;
 };
 
 //-----------------------------------------------------------------------------
@@ -171,6 +180,18 @@ FastForestExecutor::execute(uint32_t)
     outputs().set_number(0, _forest.eval(*_ctx, &_params[0]));
 }
 
+void
+FastForestExecutor::execute_batch(ConstArrayRef<uint32_t> docids, ConstArrayRef<const feature_t *> inputs,
+                                  ConstArrayRef<feature_t *> outputs)
+{
+    for (size_t row = 0; row < docids.size(); ++row) {
+        for (size_t i = 0; i < _params.size(); ++i) {
+            _params[i] = inputs[i][row];
+        }
+        outputs[0][row] = _forest.eval(*_ctx, &_params[0]);
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 CompiledRankingExpressionExecutor::CompiledRankingExpressionExecutor(const CompiledFunction &compiled_function)
@@ -195,6 +216,18 @@ CompiledRankingExpressionExecutor::execute(uint32_t)
     outputs().set_number(0, _ranking_function(_params.data()));
 }
 
+void
+CompiledRankingExpressionExecutor::execute_batch(ConstArrayRef<uint32_t> docids, ConstArrayRef<const feature_t *> inputs,
+                                                 ConstArrayRef<feature_t *> outputs)
+{
+    for (size_t row = 0; row < docids.size(); ++row) {
+        for (size_t i = 0; i < _params.size(); ++i) {
+            _params[i] = inputs[i][row];
+        }
+        outputs[0][row] = _ranking_function(_params.data());
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 namespace {
@@ -203,6 +236,15 @@ using Context = fef::FeatureExecutor::Inputs;
 double resolve_input(void *ctx, size_t idx) { return ((const Context *)(ctx))->get_number(idx); }
 Context *make_ctx(const Context &inputs) { return const_cast<Context *>(&inputs); }
 
+struct BatchContext {
+    ConstArrayRef<const feature_t *> columns;
+    size_t row;
+};
+double resolve_batch_input(void *ctx, size_t idx) {
+    const auto *batch = (const BatchContext *)(ctx);
+    return batch->columns[idx][batch->row];
+}
+
 }
 
 LazyCompiledRankingExpressionExecutor::LazyCompiledRankingExpressionExecutor(const CompiledFunction &compiled_function)
@@ -216,6 +258,16 @@ LazyCompiledRankingExpressionExecutor::execute(uint32_t)
     outputs().set_number(0, _ranking_function(resolve_input, make_ctx(inputs())));
 }
 
+void
+LazyCompiledRankingExpressionExecutor::execute_batch(ConstArrayRef<uint32_t> docids, ConstArrayRef<const feature_t *> inputs,
+                                                     ConstArrayRef<feature_t *> outputs)
+{
+    BatchContext ctx{inputs, 0};
+    for (; ctx.row < docids.size(); ++ctx.row) {
+        outputs[0][ctx.row] = _ranking_function(resolve_batch_input, &ctx);
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 InterpretedRankingExpressionExecutor::InterpretedRankingExpressionExecutor(const InterpretedFunction &function,
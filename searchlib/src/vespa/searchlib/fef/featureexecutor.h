@@ -148,6 +148,33 @@ public:
      **/
     virtual bool isPure();
 
+    /**
+     * Check if this feature executor is able to calculate its number
+     * outputs for a batch of documents at a time (see
+     * execute_batch). Executors supporting this may neither produce
+     * objects nor depend on match data, since match data is only
+     * unpacked for a single document at a time. The default is
+     * false.
+     *
+     * @return true if this feature executor supports batch execution
+     **/
+    virtual bool supports_batch() const;
+
+    /**
+     * Calculate number outputs for a batch of documents. Each input
+     * is given as a column with one value per document (in the same
+     * order as the docids). Output columns are only given for the
+     * outputs in use, the others are nullptr. Only called if
+     * supports_batch returns true.
+     *
+     * @param docids the local document ids being evaluated
+     * @param inputs one column of input values per input
+     * @param outputs one column for output values per output
+     **/
+    virtual void execute_batch(vespalib::ConstArrayRef<uint32_t> docids,
+                               vespalib::ConstArrayRef<const feature_t *> inputs,
+                               vespalib::ConstArrayRef<feature_t *> outputs);
+
     /**
      * Make sure this executor has been executed for the given
      * document.
@@ -346,6 +346,36 @@ TermwiseLimit::lookup(const Properties &props, double defaultValue)
     return lookupDouble(props, NAME, defaultValue);
 }
 
+const vespalib::string FirstPhaseBatchSize::NAME("vespa.matching.first_phase.batch_size");
+const uint32_t FirstPhaseBatchSize::DEFAULT_VALUE(128);
+
+uint32_t
+FirstPhaseBatchSize::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+uint32_t
+FirstPhaseBatchSize::lookup(const Properties &props, uint32_t defaultValue)
+{
+    return lookupUint32(props, NAME, defaultValue);
+}
+
+const vespalib::string ProfileSampleInterval::NAME("vespa.matching.profile_sample_interval");
+const uint32_t ProfileSampleInterval::DEFAULT_VALUE(0);
+
+uint32_t
+ProfileSampleInterval::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+uint32_t
+ProfileSampleInterval::lookup(const Properties &props, uint32_t defaultValue)
+{
+    return lookupUint32(props, NAME, defaultValue);
+}
+
 const vespalib::string NumThreadsPerSearch::NAME("vespa.matching.numthreadspersearch");
 const uint32_t NumThreadsPerSearch::DEFAULT_VALUE(std::numeric_limits<uint32_t>::max());
 
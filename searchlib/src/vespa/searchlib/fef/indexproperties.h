@@ -255,6 +255,34 @@ namespace matching {
         static double lookup(const Properties &props, double defaultValue);
     };
 
+    /**
+     * The number of matching documents to collect before calculating
+     * first phase rank for all of them at once. This is only done
+     * when all features needed by first phase ranking support batch
+     * execution (typically attributes and ranking expressions over
+     * them). 0 means always calculate rank for one document at a
+     * time.
+     **/
+    struct FirstPhaseBatchSize {
+        static const vespalib::string NAME;
+        static const uint32_t DEFAULT_VALUE;
+        static uint32_t lookup(const Properties &props);
+        static uint32_t lookup(const Properties &props, uint32_t defaultValue);
+    };
+
+    /**
+     * Sample every n'th query with a low overhead (flat) execution
+     * profile of matching and ranking. The profile is returned in the
+     * query trace and summarized in the rank profile metrics. 0 means
+     * that no queries are sampled.
+     **/
+    struct ProfileSampleInterval {
+        static const vespalib::string NAME;
+        static const uint32_t DEFAULT_VALUE;
+        static uint32_t lookup(const Properties &props);
+        static uint32_t lookup(const Properties &props, uint32_t defaultValue);
+    };
+
     /**
      * Property for the number of threads used per search.
      **/
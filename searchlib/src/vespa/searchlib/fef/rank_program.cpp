@@ -222,7 +222,11 @@ RankProgram::RankProgram(BlueprintResolver::SP resolver)
       _cold_stash(),
       _executors(),
       _unboxed_seeds(),
-      _is_const()
+      _is_const(),
+      _batch_size(0),
+      _batch_columns(),
+      _batch_steps(),
+      _batch_result(nullptr)
 {
 }
 
@@ -305,6 +309,98 @@ RankProgram::setup(const MatchData &md,
     }
 }
 
+RankProgram::BatchStep::BatchStep(FeatureExecutor *executor_in) noexcept
+    : executor(executor_in),
+      inputs(),
+      outputs()
+{
+}
+
+RankProgram::BatchStep::BatchStep(BatchStep &&) noexcept = default;
+RankProgram::BatchStep::~BatchStep() = default;
+
+bool
+RankProgram::setup_batch(size_t max_batch_size)
+{
+    _batch_size = 0;
+    _batch_columns.clear();
+    _batch_steps.clear();
+    _batch_result = nullptr;
+    const auto &seeds = _resolver->getSeedMap();
+    if ((max_batch_size == 0) || (seeds.size() != 1)) {
+        return false;
+    }
+    const auto &specs = _resolver->getExecutorSpecs();
+    auto seed = seeds.begin()->second;
+    if (specs[seed.executor].output_types[seed.output].is_object()) {
+        return false;
+    }
+    // Inputs always refer to earlier executors, so a single backwards pass finds all outputs in use.
+    std::vector<std::vector<bool>> used(seed.executor + 1);
+    used[seed.executor].resize(specs[seed.executor].output_types.size(), false);
+    used[seed.executor][seed.output] = true;
+    size_t num_columns = 0;
+    for (size_t i = used.size(); i-- > 0; ) {
+        if (used[i].empty()) {
+            continue;
+        }
+        num_columns += std::count(used[i].begin(), used[i].end(), true);
+        if (check_const(_executors[i]->outputs().get_raw(0))) {
+            continue;
+        }
+        if (!_executors[i]->supports_batch()) {
+            return false;
+        }
+        for (const auto &ref: specs[i].inputs) {
+            if (specs[ref.executor].output_types[ref.output].is_object()) {
+                return false;
+            }
+            used[ref.executor].resize(specs[ref.executor].output_types.size(), false);
+            used[ref.executor][ref.output] = true;
+        }
+    }
+    _batch_columns.resize(num_columns * max_batch_size);
+    std::vector<std::vector<feature_t *>> columns(used.size());
+    feature_t *next_column = _batch_columns.data();
+    for (size_t i = 0; i < used.size(); ++i) {
+        if (used[i].empty()) {
+            continue;
+        }
+        const auto &outputs = _executors[i]->outputs();
+        bool is_const = check_const(outputs.get_raw(0));
+        columns[i].resize(used[i].size(), nullptr);
+        for (size_t out_idx = 0; out_idx < used[i].size(); ++out_idx) {
+            if (used[i][out_idx]) {
+                columns[i][out_idx] = next_column;
+                next_column += max_batch_size;
+                if (is_const) {
+                    std::fill_n(columns[i][out_idx], max_batch_size, outputs.get_number(out_idx));
+                }
+            }
+        }
+        if (!is_const) {
+            auto &step = _batch_steps.emplace_back(_executors[i]);
+            for (const auto &ref: specs[i].inputs) {
+                step.inputs.push_back(columns[ref.executor][ref.output]);
+            }
+            step.outputs = columns[i];
+        }
+    }
+    _batch_result = columns[seed.executor][seed.output];
+    _batch_size = max_batch_size;
+    return true;
+}
+
+vespalib::ConstArrayRef<feature_t>
+RankProgram::execute_batch(vespalib::ConstArrayRef<uint32_t> docids)
+{
+    assert(docids.size() <= _batch_size);
+    for (const auto &step: _batch_steps) {
+        step.executor->execute_batch(docids, step.inputs, step.outputs);
+    }
+    return {_batch_result, docids.size()};
+}
+
 FeatureResolver
 RankProgram::get_seeds(bool unbox_seeds) const
 {
@@ -34,12 +34,25 @@ private:
     using ValueSet = vespalib::hash_set<const NumberOrObject *, vespalib::hash<const NumberOrObject *>,
                                         std::equal_to<>, vespalib::hashtable_base::and_modulator>;
 
+    struct BatchStep {
+        FeatureExecutor                *executor;
+        std::vector<const feature_t *>  inputs;
+        std::vector<feature_t *>        outputs;
+        BatchStep(FeatureExecutor *executor_in) noexcept;
+        BatchStep(BatchStep &&) noexcept;
+        ~BatchStep();
+    };
+
     BlueprintResolver::SP            _resolver;
     vespalib::Stash                  _hot_stash;
     vespalib::Stash                  _cold_stash;
     std::vector<FeatureExecutor *>   _executors;
     MappedValues                     _unboxed_seeds;
     ValueSet                         _is_const;
+    size_t                           _batch_size;
+    std::vector<feature_t>           _batch_columns;
+    std::vector<BatchStep>           _batch_steps;
+    const feature_t                 *_batch_result;
 
     bool check_const(const NumberOrObject *value) const { return (_is_const.count(value) == 1); }
     bool check_const(FeatureExecutor *executor, const std::vector<BlueprintResolver::FeatureRef> &inputs) const;
@@ -91,6 +104,29 @@ public:
      * @params unbox_seeds make sure seeds values are numbers
      **/
     FeatureResolver get_all_features(bool unbox_seeds = true) const;
+
+    /**
+     * Prepare for calculating the single seed of this program for
+     * batches of up to max_batch_size documents at a time. This is
+     * only possible if all non-constant features the seed depends on
+     * are numbers calculated by executors supporting batch
+     * execution. Must be called after setup.
+     *
+     * @return true if batch execution is possible
+     **/
+    bool setup_batch(size_t max_batch_size);
+
+    size_t get_batch_size() const { return _batch_size; }
+
+    /**
+     * Calculate the seed for a batch of documents in increasing docid
+     * order. Match data is not used. The returned values are valid
+     * until the next call.
+     *
+     * @param docids the documents to evaluate, at most the prepared batch size
+     * @return seed values for the documents
+     **/
+    vespalib::ConstArrayRef<feature_t> execute_batch(vespalib::ConstArrayRef<uint32_t> docids);
 };
 
 }
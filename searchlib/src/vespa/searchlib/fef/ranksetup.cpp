@@ -39,6 +39,8 @@ RankSetup::RankSetup(const BlueprintFactory &factory, const IIndexEnvironment &i
       _secondPhaseRankFeature(),
       _degradationAttribute(),
       _termwise_limit(1.0),
+      _first_phase_batch_size(matching::FirstPhaseBatchSize::DEFAULT_VALUE),
+      _profile_sample_interval(matching::ProfileSampleInterval::DEFAULT_VALUE),
       _numThreads(0),
       _minHitsPerThread(0),
       _numSearchPartitions(0),
@@ -102,6 +104,8 @@ RankSetup::configure()
         _feature_rename_map[rename.first] = rename.second;
     }
     set_termwise_limit(matching::TermwiseLimit::lookup(_indexEnv.getProperties()));
+    set_first_phase_batch_size(matching::FirstPhaseBatchSize::lookup(_indexEnv.getProperties()));
+    set_profile_sample_interval(matching::ProfileSampleInterval::lookup(_indexEnv.getProperties()));
     setNumThreadsPerSearch(matching::NumThreadsPerSearch::lookup(_indexEnv.getProperties()));
     setMinHitsPerThread(matching::MinHitsPerThread::lookup(_indexEnv.getProperties()));
     setNumSearchPartitions(matching::NumSearchPartitions::lookup(_indexEnv.getProperties()));
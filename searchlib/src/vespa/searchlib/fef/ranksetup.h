@@ -48,6 +48,8 @@ private:
     vespalib::string         _secondPhaseRankFeature;
     vespalib::string         _degradationAttribute;
     double                   _termwise_limit;
+    uint32_t                 _first_phase_batch_size;
+    uint32_t                 _profile_sample_interval;
     uint32_t                 _numThreads;
     uint32_t                 _minHitsPerThread;
     uint32_t                 _numSearchPartitions;
@@ -166,6 +168,20 @@ public:
      **/
     double get_termwise_limit() const { return _termwise_limit; }
 
+    /**
+     * Set/get the number of matching documents to collect before
+     * calculating first phase rank for all of them at once.
+     **/
+    void set_first_phase_batch_size(uint32_t value) { _first_phase_batch_size = value; }
+    uint32_t get_first_phase_batch_size() const { return _first_phase_batch_size; }
+
+    /**
+     * Set/get how often (every n'th query) matching and ranking is
+     * profiled. 0 means never.
+     **/
+    void set_profile_sample_interval(uint32_t value) { _profile_sample_interval = value; }
+    uint32_t get_profile_sample_interval() const { return _profile_sample_interval; }
+
     /**
      * Sets the number of threads per search.
      *
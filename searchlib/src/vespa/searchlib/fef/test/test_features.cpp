@@ -4,6 +4,7 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/vespalib/locale/c.h>
 #include <vespa/vespalib/util/stash.h>
+#include <algorithm>
 
 
 using vespalib::eval::DoubleValue;
@@ -38,6 +39,12 @@ ImpureValueBlueprint::createExecutor(const IQueryEnvironment &, vespalib::Stash
 
 struct DocidExecutor : FeatureExecutor {
     void execute(uint32_t docid) override { outputs().set_number(0, docid); }
+    bool supports_batch() const override { return true; }
+    void execute_batch(vespalib::ConstArrayRef<uint32_t> docids, vespalib::ConstArrayRef<const feature_t *>,
+                       vespalib::ConstArrayRef<feature_t *> outputs) override
+    {
+        std::copy(docids.begin(), docids.end(), outputs[0]);
+    }
 };
 
 bool
@@ -36,6 +36,12 @@ public:
      */
     virtual void readCounts(const PostingListCounts &counts) = 0;
 
+    /**
+     * Skip posting lists for words that should not be read, given
+     * their total size in bits. Must be called between words.
+     */
+    virtual void skipPostingLists(uint64_t bitLength) = 0;
+
     /**
      * Open posting list file for sequential read.
      */
@@ -7,6 +7,7 @@ namespace search::memoryindex {
 BundledFieldsContext::BundledFieldsContext(vespalib::ISequencedTaskExecutor::ExecutorId id)
     : _id(id),
       _fields(),
+      _field_shards(),
       _uri_fields()
 {
 }
@@ -14,9 +15,10 @@ BundledFieldsContext::BundledFieldsContext(vespalib::ISequencedTaskExecutor::Exe
 BundledFieldsContext::~BundledFieldsContext() = default;
 
 void
-BundledFieldsContext::add_field(uint32_t field_id)
+BundledFieldsContext::add_field(uint32_t field_id, uint32_t shard)
 {
     _fields.emplace_back(field_id);
+    _field_shards.emplace_back(shard);
 }
 
 void
@@ -50,6 +50,11 @@ DocumentInverter::DocumentInverter(DocumentInverterContext& context)
                                  _inverters[urlField._fragment].get(),
                                  _inverters[urlField._hostname].get()));
     }
+    if (context.get_field_shards() > 1) {
+        for (auto field_id : schema_index_fields._textFields) {
+            _inverters[field_id]->make_shards(context.get_field_shards());
+        }
+    }
 }
 
 DocumentInverter::~DocumentInverter()
@@ -107,7 +112,21 @@ DocumentInverter::pushDocuments(OnWriteDoneType on_write_done)
             assert(pusher < all_push_tasks.size());
             push_tasks.emplace_back(all_push_tasks[pusher]);
         }
-        invert_threads.execute(invert_context.get_id(), [push_tasks(std::move(push_tasks))]() { });
+        // Field inverter shards are sorted by the invert thread, before the push task merges them.
+        std::vector<FieldInverter*> shards;
+        auto field_shard_itr = invert_context.get_field_shards().begin();
+        for (auto field_id : invert_context.get_fields()) {
+            auto& inverter = *_inverters[field_id];
+            if (inverter.get_num_shards() > 0) {
+                shards.emplace_back(&inverter.get_shard(*field_shard_itr));
+            }
+            ++field_shard_itr;
+        }
+        invert_threads.execute(invert_context.get_id(), [shards(std::move(shards)), push_tasks(std::move(push_tasks))]() {
+            for (auto shard : shards) {
+                shard->sort_positions();
+            }
+        });
     }
 }
 
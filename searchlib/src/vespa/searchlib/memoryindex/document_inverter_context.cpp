@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "document_inverter_context.h"
+#include <algorithm>
 #include <cassert>
 #include <optional>
 
@@ -12,7 +13,7 @@ using index::SchemaIndexFields;
 namespace {
 
 template <typename Context>
-void make_contexts(const index::Schema& schema, const SchemaIndexFields& schema_index_fields, ISequencedTaskExecutor& executor, std::vector<Context>& contexts)
+void make_contexts(const index::Schema& schema, const SchemaIndexFields& schema_index_fields, ISequencedTaskExecutor& executor, uint32_t field_shards, std::vector<Context>& contexts)
 {
     using ExecutorId = ISequencedTaskExecutor::ExecutorId;
     using IdMapping = std::vector<std::tuple<ExecutorId, bool, uint32_t, uint32_t>>;
@@ -22,6 +23,9 @@ void make_contexts(const index::Schema& schema, const SchemaIndexFields& schema_
         auto& name = schema.getIndexField(field_id).getName();
         auto id = executor.getExecutorIdFromName(name);
         map.emplace_back(id, false, field_id, 0);
+        for (uint32_t shard = 1; shard < field_shards; ++shard) {
+            map.emplace_back(executor.get_alternate_executor_id(id, shard), false, field_id, shard);
+        }
     }
     uint32_t uri_field_id = 0;
     for (auto& uri_field : schema_index_fields._uriFields) {
@@ -41,7 +45,7 @@ void make_contexts(const index::Schema& schema, const SchemaIndexFields& schema_
         if (std::get<1>(entry)) {
             contexts.back().add_uri_field(std::get<2>(entry), std::get<3>(entry));
         } else {
-            contexts.back().add_field(std::get<2>(entry));
+            contexts.back().add_field(std::get<2>(entry), std::get<3>(entry));
         }
     }
 }
@@ -127,11 +131,21 @@ DocumentInverterContext::DocumentInverterContext(const index::Schema& schema,
                                                  ISequencedTaskExecutor &invert_threads,
                                                  ISequencedTaskExecutor &push_threads,
                                                  IFieldIndexCollection& field_indexes)
+    : DocumentInverterContext(schema, invert_threads, push_threads, field_indexes, 1)
+{
+}
+
+DocumentInverterContext::DocumentInverterContext(const index::Schema& schema,
+                                                 ISequencedTaskExecutor &invert_threads,
+                                                 ISequencedTaskExecutor &push_threads,
+                                                 IFieldIndexCollection& field_indexes,
+                                                 uint32_t field_shards)
     : _schema(schema),
       _schema_index_fields(),
       _invert_threads(invert_threads),
       _push_threads(push_threads),
       _field_indexes(field_indexes),
+      _field_shards(std::clamp(field_shards, 1u, invert_threads.getNumExecutors())),
       _invert_contexts(),
       _push_contexts()
 {
@@ -144,8 +158,8 @@ DocumentInverterContext::~DocumentInverterContext() = default;
 void
 DocumentInverterContext::setup_contexts()
 {
-    make_contexts(_schema, _schema_index_fields, _invert_threads, _invert_contexts);
-    make_contexts(_schema, _schema_index_fields, _push_threads, _push_contexts);
+    make_contexts(_schema, _schema_index_fields, _invert_threads, _field_shards, _invert_contexts);
+    make_contexts(_schema, _schema_index_fields, _push_threads, 1, _push_contexts);
     if (&_invert_threads == &_push_threads) {
         uint32_t bias = _schema_index_fields._textFields.size() + _schema_index_fields._uriFields.size();
         switch_to_alternate_ids(_push_threads, _push_contexts, bias);
@@ -22,6 +22,7 @@ class DocumentInverterContext {
     vespalib::ISequencedTaskExecutor& _invert_threads;
     vespalib::ISequencedTaskExecutor& _push_threads;
     IFieldIndexCollection&            _field_indexes;
+    uint32_t                          _field_shards;
     std::vector<InvertContext>        _invert_contexts;
     std::vector<PushContext>          _push_contexts;
     void setup_contexts();
@@ -30,12 +31,22 @@ public:
                             vespalib::ISequencedTaskExecutor &invert_threads,
                             vespalib::ISequencedTaskExecutor &push_threads,
                             IFieldIndexCollection& field_indexes);
+    /*
+     * Inverting of each text field is split in the given number of
+     * shards, limited by the number of invert threads.
+     */
+    DocumentInverterContext(const index::Schema &schema,
+                            vespalib::ISequencedTaskExecutor &invert_threads,
+                            vespalib::ISequencedTaskExecutor &push_threads,
+                            IFieldIndexCollection& field_indexes,
+                            uint32_t field_shards);
     ~DocumentInverterContext();
     const index::Schema& get_schema() const noexcept { return _schema; }
     const index::SchemaIndexFields& get_schema_index_fields() const noexcept { return _schema_index_fields; }
     vespalib::ISequencedTaskExecutor& get_invert_threads() noexcept { return _invert_threads; }
     vespalib::ISequencedTaskExecutor& get_push_threads() noexcept { return _push_threads; }
     IFieldIndexCollection& get_field_indexes() noexcept { return _field_indexes; }
+    uint32_t get_field_shards() const noexcept { return _field_shards; }
     const std::vector<InvertContext>& get_invert_contexts() const noexcept { return _invert_contexts; }
     const std::vector<PushContext>& get_push_contexts() const noexcept { return _push_contexts; }
 };
@@ -72,6 +72,7 @@ FieldInverter::reset()
     _pendingDocs.clear();
     _abortedDocs.clear();
     _removeDocs.clear();
+    _field_lengths.clear();
     _oldPosSize = 0u;
 }
 
@@ -182,7 +183,11 @@ FieldInverter::endDoc()
             ++itr;
         }
     }
-    _calculator.add_field_length(field_length);
+    if (_is_shard) {
+        _field_lengths.push_back(field_length);
+    } else {
+        _calculator.add_field_length(field_length);
+    }
     uint32_t newPosSize = static_cast<uint32_t>(_positions.size());
     _pendingDocs.insert({ _docId, { _oldPosSize, newPosSize - _oldPosSize } });
     _docId = 0;
@@ -259,6 +264,9 @@ FieldInverter::FieldInverter(const Schema &schema, uint32_t fieldId,
       _abortedDocs(),
       _pendingDocs(),
       _removeDocs(),
+      _shards(),
+      _is_shard(false),
+      _field_lengths(),
       _remover(remover),
       _inserter(inserter),
       _calculator(calculator)
@@ -267,6 +275,16 @@ FieldInverter::FieldInverter(const Schema &schema, uint32_t fieldId,
 
 FieldInverter::~FieldInverter() = default;
 
+void
+FieldInverter::make_shards(uint32_t num_shards)
+{
+    assert(_shards.empty() && !_is_shard);
+    for (uint32_t shard = 0; shard < num_shards; ++shard) {
+        _shards.push_back(std::make_unique<FieldInverter>(_schema, _fieldId, _remover, _inserter, _calculator));
+        _shards.back()->_is_shard = true;
+    }
+}
+
 void
 FieldInverter::abortPendingDoc(uint32_t docId)
 {
@@ -408,16 +426,22 @@ FieldInverter::applyRemoves()
         _remover.remove(docId, *this);
     }
     _removeDocs.clear();
+    // Words in old versions of documents are removed by this field inverter
+    for (auto &shard : _shards) {
+        for (auto docId : shard->_removeDocs) {
+            _remover.remove(docId, *this);
+        }
+        shard->_removeDocs.clear();
+    }
 }
 
 void
-FieldInverter::push_documents_internal()
+FieldInverter::sort_positions()
 {
     trimAbortedDocs();
 
     if (_positions.empty()) {
-        reset();
-        return;             // All documents with words aborted
+        return;
     }
 
     sortWords();
@@ -425,72 +449,148 @@ FieldInverter::push_documents_internal()
     // Sort for terms.
     ShiftBasedRadixSorter<PosInfo, FullRadix, std::less<PosInfo>, 56, true>::
         radix_sort(FullRadix(), std::less<PosInfo>(), &_positions[0], _positions.size(), 16);
+}
 
+const FieldInverter::PosInfo *
+FieldInverter::push_word_doc(const PosInfo *pos, const PosInfo *end,
+                             DocIdAndPosOccFeatures &features,
+                             IOrderedFieldIndexInserter &inserter) const
+{
     constexpr uint32_t NO_ELEMENT_ID = std::numeric_limits<uint32_t>::max();
     constexpr uint32_t NO_WORD_POS = std::numeric_limits<uint32_t>::max();
-    uint32_t lastWordNum = 0;
-    uint32_t lastElemId = 0;
-    uint32_t lastWordPos = 0;
-    uint32_t numWordIds = _wordRefs.size() - 1;
-    uint32_t lastDocId = 0;
-    vespalib::stringref word;
-    bool emptyFeatures = true;
-    uint32_t last_field_length = 0;
-
-    _inserter.rewind();
-
-    for (auto &i : _positions) {
-        assert(i._wordNum <= numWordIds);
-        (void) numWordIds;
-        if (lastWordNum != i._wordNum || lastDocId != i._docId) {
-            if (!emptyFeatures) {
-                _features.set_num_occs(_features.word_positions().size());
-                _inserter.add(lastDocId, _features);
-                emptyFeatures = true;
-            }
-            if (lastWordNum != i._wordNum) {
-                lastWordNum = i._wordNum;
-                word = getWordFromNum(lastWordNum);
-                _inserter.setNextWord(word);
-            }
-            lastDocId = i._docId;
-            if (i.removed()) {
-                _inserter.remove(lastDocId);
-                continue;
-            }
+    uint32_t wordNum = pos->_wordNum;
+    uint32_t docId = pos->_docId;
+    auto same_word_doc = [&](const PosInfo *p) { return p != end && p->_wordNum == wordNum && p->_docId == docId; };
+    if (pos->removed()) {
+        inserter.remove(docId);
+        while (same_word_doc(pos) && pos->removed()) {
+            ++pos; // ignore dup remove
         }
-        if (emptyFeatures) {
-            if (!i.removed()) {
-                emptyFeatures = false;
-                _features.clear(lastDocId);
-                lastElemId = NO_ELEMENT_ID;
-                lastWordPos = NO_WORD_POS;
-                const ElemInfo &elem = _elems[i._elemRef];
-                _features.set_field_length(elem.get_field_length());
-                last_field_length = elem.get_field_length();
-            } else {
-                continue; // ignore dup remove
-            }
-        } else {
-            // removes must come before non-removes
-            assert(!i.removed());
-            const ElemInfo &elem = _elems[i._elemRef];
-            assert(last_field_length == elem.get_field_length());
+        if (!same_word_doc(pos)) {
+            return pos;
         }
-        const ElemInfo &elem = _elems[i._elemRef];
-        if (i._wordPos != lastWordPos || i._elemId != lastElemId) {
-            _features.addNextOcc(i._elemId, i._wordPos,
-                                 elem._weight, elem._len);
-            lastElemId = i._elemId;
-            lastWordPos = i._wordPos;
+    }
+    features.clear(docId);
+    uint32_t field_length = _elems[pos->_elemRef].get_field_length();
+    features.set_field_length(field_length);
+    uint32_t lastElemId = NO_ELEMENT_ID;
+    uint32_t lastWordPos = NO_WORD_POS;
+    for (; same_word_doc(pos); ++pos) {
+        // removes must come before non-removes
+        assert(!pos->removed());
+        const ElemInfo &elem = _elems[pos->_elemRef];
+        assert(field_length == elem.get_field_length());
+        if (pos->_wordPos != lastWordPos || pos->_elemId != lastElemId) {
+            features.addNextOcc(pos->_elemId, pos->_wordPos, elem._weight, elem._len);
+            lastElemId = pos->_elemId;
+            lastWordPos = pos->_wordPos;
         } else {
             // silently ignore duplicate annotations
         }
     }
+    features.set_num_occs(features.word_positions().size());
+    inserter.add(docId, features);
+    return pos;
+}
 
-    if (!emptyFeatures) {
-        _features.set_num_occs(_features.word_positions().size());
-        _inserter.add(lastDocId, _features);
+void
+FieldInverter::push_sharded_documents()
+{
+    sort_positions();
+    struct Input {
+        const FieldInverter *inverter;
+        const PosInfo       *pos;
+        const PosInfo       *end;
+        const char          *word;
+
+        Input(const FieldInverter &inverter_)
+            : inverter(&inverter_),
+              pos(inverter_._positions.data()),
+              end(pos + inverter_._positions.size()),
+              word(inverter_.getWordFromNum(pos->_wordNum))
+        {
+        }
+        bool before(const Input &rhs) const {
+            int cmpres = strcmp(word, rhs.word);
+            return (cmpres < 0) || (cmpres == 0 && pos->_docId < rhs.pos->_docId);
+        }
+    };
+    // Removes in this field inverter must come before inverted documents in the shards for the same
+    // {word, docId}, thus it is the first input and ties are resolved by input order.
+    std::vector<Input> inputs;
+    inputs.reserve(_shards.size() + 1);
+    if (!_positions.empty()) {
+        inputs.emplace_back(*this);
+    }
+    for (auto &shard : _shards) {
+        if (!shard->_positions.empty()) {
+            inputs.emplace_back(*shard);
+        }
+        for (auto field_length : shard->_field_lengths) {
+            _calculator.add_field_length(field_length);
+        }
+    }
+    if (!inputs.empty()) {
+        _inserter.rewind();
+        const char *lastWord = nullptr;
+        while (!inputs.empty()) {
+            auto best = inputs.begin();
+            for (auto itr = best + 1; itr != inputs.end(); ++itr) {
+                if (itr->before(*best)) {
+                    best = itr;
+                }
+            }
+            if (lastWord == nullptr || strcmp(lastWord, best->word) != 0) {
+                _inserter.setNextWord(best->word);
+            }
+            lastWord = best->word;
+            uint32_t wordNum = best->pos->_wordNum;
+            best->pos = best->inverter->push_word_doc(best->pos, best->end, _features, _inserter);
+            if (best->pos == best->end) {
+                inputs.erase(best);
+            } else if (best->pos->_wordNum != wordNum) {
+                best->word = best->inverter->getWordFromNum(best->pos->_wordNum);
+            }
+        }
+        _inserter.flush();
+        _inserter.commit();
+    }
+    reset();
+    for (auto &shard : _shards) {
+        shard->reset();
+    }
+}
+
+void
+FieldInverter::push_documents_internal()
+{
+    if (!_shards.empty()) {
+        push_sharded_documents();
+        return;
+    }
+
+    sort_positions();
+
+    if (_positions.empty()) {
+        reset();
+        return;             // All documents with words aborted
+    }
+
+    uint32_t numWordIds = _wordRefs.size() - 1;
+    uint32_t lastWordNum = 0;
+    const PosInfo *pos = _positions.data();
+    const PosInfo *end = pos + _positions.size();
+
+    _inserter.rewind();
+
+    while (pos != end) {
+        assert(pos->_wordNum <= numWordIds);
+        (void) numWordIds;
+        if (lastWordNum != pos->_wordNum) {
+            lastWordNum = pos->_wordNum;
+            _inserter.setNextWord(getWordFromNum(lastWordNum));
+        }
+        pos = push_word_doc(pos, end, _features, _inserter);
     }
     _inserter.flush();
     _inserter.commit();
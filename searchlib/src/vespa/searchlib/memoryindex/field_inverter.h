@@ -32,6 +32,10 @@ class FieldIndexRemover;
  *
  * It creates a set of sorted {word, docId, features} tuples based on the field content of the documents,
  * and uses this when updating the posting lists of the FieldIndex.
+ *
+ * Inverting can be split in shards (see make_shards()), each handling a subset of the documents, allowing
+ * a single field to be inverted by multiple threads. The sorted output of the shards is then merged when
+ * pushing documents.
  */
 class FieldInverter : public IFieldIndexRemoveListener {
 public:
@@ -189,6 +193,10 @@ private:
     vespalib::hash_map<uint32_t, PositionRange> _pendingDocs;
     UInt32Vector                                _removeDocs;
 
+    std::vector<std::unique_ptr<FieldInverter>> _shards;
+    bool                                        _is_shard;
+    UInt32Vector                                _field_lengths; // Added to calculator when pushing (shards only)
+
     FieldIndexRemover                &_remover;
     IOrderedFieldIndexInserter       &_inserter;
     index::FieldLengthCalculator     &_calculator;
@@ -267,6 +275,19 @@ private:
      */
     void sortWords();
 
+    /**
+     * Add {docId, features} for the positions of one word in one document, starting at the given position.
+     * Returns the position after the ones used.
+     */
+    const PosInfo *push_word_doc(const PosInfo *pos, const PosInfo *end,
+                                 index::DocIdAndPosOccFeatures &features,
+                                 IOrderedFieldIndexInserter &inserter) const;
+
+    /**
+     * Merge the sorted removes in this field inverter with the sorted documents inverted by the shards.
+     */
+    void push_sharded_documents();
+
     void moveNotAbortedDocs(uint32_t &dstIdx, uint32_t srcIdx, uint32_t nextTrimIdx);
 
     void trimAbortedDocs();
@@ -290,6 +311,34 @@ public:
     FieldInverter &operator=(const FieldInverter &&) = delete;
     ~FieldInverter() override;
 
+    /**
+     * Split inverting of documents in the given number of shards, where a document is
+     * inverted by the shard given by docId % num_shards. Each shard can be used by a separate
+     * thread. This field inverter still tracks the removes, and merges the output of the shards
+     * in pushDocuments(). sort_positions() must be called for each shard before pushing.
+     */
+    void make_shards(uint32_t num_shards);
+
+    uint32_t get_num_shards() const noexcept { return _shards.size(); }
+
+    /**
+     * Returns the field inverter that should handle the given document when used by the given shard,
+     * or nullptr if the document is handled by another shard.
+     */
+    FieldInverter *get_shard_inverter(uint32_t docId, uint32_t shard) noexcept {
+        if (_shards.empty()) {
+            return this;
+        }
+        return ((docId % _shards.size()) == shard) ? _shards[shard].get() : nullptr;
+    }
+
+    FieldInverter &get_shard(uint32_t shard) noexcept { return *_shards[shard]; }
+
+    /**
+     * Trim aborted documents and sort words and positions.
+     */
+    void sort_positions();
+
     /**
      * Apply pending removes using the given remover.
      *
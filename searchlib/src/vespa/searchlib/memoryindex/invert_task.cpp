@@ -43,9 +43,14 @@ InvertTask::run()
 {
     _context.set_data_type(_inv_context, _doc);
     auto document_field_itr = _context.get_document_fields().begin();
+    auto field_shard_itr = _context.get_field_shards().begin();
     for (auto field_id : _context.get_fields()) {
-        _inverters[field_id]->invertField(_lid, get_field_value(_doc, *document_field_itr), _doc);
+        auto inverter = _inverters[field_id]->get_shard_inverter(_lid, *field_shard_itr);
+        if (inverter != nullptr) {
+            inverter->invertField(_lid, get_field_value(_doc, *document_field_itr), _doc);
+        }
         ++document_field_itr;
+        ++field_shard_itr;
     }
     auto document_uri_field_itr = _context.get_document_uri_fields().begin();
     for (auto uri_field_id : _context.get_uri_fields()) {
@@ -95,6 +95,16 @@ public:
                 ISequencedTaskExecutor& invertThreads,
                 ISequencedTaskExecutor& pushThreads);
 
+    /**
+     * Create a new memory index where inverting of each text field is split in the
+     * given number of shards, each using a separate invert thread (see FieldInverter).
+     */
+    MemoryIndex(const index::Schema& schema,
+                const index::IFieldLengthInspector& inspector,
+                ISequencedTaskExecutor& invertThreads,
+                ISequencedTaskExecutor& pushThreads,
+                uint32_t field_inverter_shards);
+
     MemoryIndex(const MemoryIndex &) = delete;
     MemoryIndex(MemoryIndex &&) = delete;
     MemoryIndex &operator=(const MemoryIndex &) = delete;
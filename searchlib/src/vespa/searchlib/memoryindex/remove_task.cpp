@@ -33,8 +33,16 @@ RemoveTask::~RemoveTask() = default;
 void
 RemoveTask::run()
 {
+    auto field_shard_itr = _context.get_field_shards().begin();
     for (auto field_id : _context.get_fields()) {
-        remove_documents(*_inverters[field_id], _lids);
+        auto& inverter = *_inverters[field_id];
+        for (auto lid : _lids) {
+            auto shard_inverter = inverter.get_shard_inverter(lid, *field_shard_itr);
+            if (shard_inverter != nullptr) {
+                shard_inverter->removeDocument(lid);
+            }
+        }
+        ++field_shard_itr;
     }
     for (auto uri_field_id : _context.get_uri_fields()) {
         remove_documents(*_uri_inverters[uri_field_id], _lids);
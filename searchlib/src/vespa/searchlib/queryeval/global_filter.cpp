@@ -7,8 +7,10 @@
 #include <vespa/vespalib/util/thread_bundle.h>
 #include <vespa/vespalib/util/execution_profiler.h>
 #include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/common/compressed_bitvector.h>
 #include <vespa/searchlib/engine/trace.h>
 #include <vespa/vespalib/data/slime/slime.h>
+#include <algorithm>
 #include <cassert>
 
 using search::engine::Trace;
@@ -52,6 +54,23 @@ struct BitVectorFilter : public GlobalFilter {
     bool check(uint32_t docid) const override { return vector->testBit(docid); }
 };
 
+struct CompressedBitVectorFilter : public GlobalFilter {
+    CompressedBitVector vector;
+    explicit CompressedBitVectorFilter(CompressedBitVector vector_in) noexcept
+      : vector(std::move(vector_in)) {}
+    bool is_active() const override { return true; }
+    uint32_t size() const override { return vector.size(); }
+    uint32_t count() const override { return vector.countTrueBits(); }
+    bool check(uint32_t docid) const override { return vector.testBit(docid); }
+};
+
+// Lookups in a compressed bitvector are slower than in a plain bitvector unless it is very
+// sparse (about 2x at 1 hit per 1024 documents, see bitvector_benchmark), so only use it
+// for filters where it saves most of the memory without hurting nearest neighbor search.
+bool should_compress(uint32_t count, uint32_t size) {
+    return (uint64_t(count) * 1024) < size;
+}
+
 struct MultiBitVectorFilter : public GlobalFilter {
     std::vector<std::unique_ptr<BitVector>> vectors;
     std::vector<uint32_t> splits;
@@ -80,12 +99,16 @@ struct MultiBitVectorFilter : public GlobalFilter {
 struct PartResult {
     Trinary matches_any;
     std::unique_ptr<BitVector> bits;
+    // hits of a sparse part, used when 'bits' is not set
+    std::vector<uint32_t> docids;
     PartResult()
-      : matches_any(Trinary::False), bits() {}
+      : matches_any(Trinary::False), bits(), docids() {}
     explicit PartResult(Trinary matches_any_in)
-      : matches_any(matches_any_in), bits() {}
+      : matches_any(matches_any_in), bits(), docids() {}
     explicit PartResult(std::unique_ptr<BitVector> &&bits_in)
-      : matches_any(Trinary::Undefined), bits(std::move(bits_in)) {}
+      : matches_any(Trinary::Undefined), bits(std::move(bits_in)), docids() {}
+    explicit PartResult(std::vector<uint32_t> &&docids_in)
+      : matches_any(Trinary::Undefined), bits(), docids(std::move(docids_in)) {}
 };
 
 struct MakePart : Runnable {
@@ -108,6 +131,29 @@ struct MakePart : Runnable {
     }
     bool is_first_thread() const { return (begin == 1); }
     bool should_trace(int level) const { return trace && trace->shouldTrace(level); }
+    // Collect hits as a list of docids while the part is sparse enough to be compressed,
+    // switching to a bitvector for the rest of the part when it is not.
+    PartResult collect_hits(SearchIterator &filter) const {
+        std::vector<uint32_t> docids;
+        uint32_t docid = std::max(begin, filter.getDocId());
+        while (!filter.isAtEnd(docid)) {
+            if (filter.seek(docid)) {
+                if (!should_compress(docids.size() + 1, end - begin)) {
+                    auto bits = BitVector::create(begin, end);
+                    for (uint32_t hit: docids) {
+                        bits->setBit(hit);
+                    }
+                    filter.or_hits_into(*bits, docid);
+                    // count bits in parallel and cache the results for later
+                    bits->countTrueBits();
+                    return PartResult(std::move(bits));
+                }
+                docids.push_back(docid);
+            }
+            docid = std::max(docid + 1, filter.getDocId());
+        }
+        return PartResult(std::move(docids));
+    }
     void run() override {
         auto constraint = Blueprint::FilterConstraint::UPPER_BOUND;
         auto filter = blueprint.createFilterSearch(constraint);
@@ -121,10 +167,7 @@ struct MakePart : Runnable {
                 filter = ProfiledIterator::profile(*profiler, std::move(filter));
             }
             filter->initRange(begin, end);
-            auto bits = filter->get_hits(begin);
-            // count bits in parallel and cache the results for later
-            bits->countTrueBits();
-            result = PartResult(std::move(bits));
+            result = collect_hits(*filter);
         } else {
             result = PartResult(matches_any);
         }
@@ -161,13 +204,18 @@ std::shared_ptr<GlobalFilter>
 GlobalFilter::create(const std::vector<uint32_t> & docids, uint32_t size)
 {
     uint32_t prev = 0;
-    auto bits = BitVector::create(1, size);
     for (uint32_t docid: docids) {
         REQUIRE(docid > prev);
         REQUIRE(docid < size);
-        bits->setBit(docid);
         prev = docid;
     }
+    if (should_compress(docids.size(), size)) {
+        return std::make_shared<CompressedBitVectorFilter>(CompressedBitVector::create(docids, size));
+    }
+    auto bits = BitVector::create(1, size);
+    for (uint32_t docid: docids) {
+        bits->setBit(docid);
+    }
     bits->invalidateCachedCount();
     return create(std::move(bits));
 }
@@ -217,15 +265,36 @@ GlobalFilter::create(Blueprint &blueprint, uint32_t docid_limit, ThreadBundle &t
     assert((docid == docid_limit) || parts.empty());
     thread_bundle.run(parts);
     insert_traces(trace, parts);
-    std::vector<std::unique_ptr<BitVector>> vectors;
-    vectors.reserve(parts.size());
-    for (MakePart &part: parts) {
+    bool all_sparse = true;
+    for (const MakePart &part: parts) {
         switch (part.result.matches_any) {
         case Trinary::False: return std::make_unique<EmptyFilter>(docid_limit);
         case Trinary::True: return create(); // filter not needed after all
         case Trinary::Undefined:
-            vectors.push_back(std::move(part.result.bits));
+            all_sparse = all_sparse && !part.result.bits;
+        }
+    }
+    if (!parts.empty() && all_sparse) {
+        CompressedBitVector::Builder builder(docid_limit);
+        for (const MakePart &part: parts) {
+            for (uint32_t hit: part.result.docids) {
+                builder.add(hit);
+            }
+        }
+        return std::make_shared<CompressedBitVectorFilter>(builder.build());
+    }
+    std::vector<std::unique_ptr<BitVector>> vectors;
+    vectors.reserve(parts.size());
+    for (MakePart &part: parts) {
+        if (!part.result.bits) {
+            auto bits = BitVector::create(part.begin, part.end);
+            for (uint32_t hit: part.result.docids) {
+                bits->setBit(hit);
+            }
+            bits->invalidateCachedCount();
+            part.result.bits = std::move(bits);
         }
+        vectors.push_back(std::move(part.result.bits));
     }
     if (vectors.size() == 1) {
         return create(std::move(vectors[0]));
@@ -44,11 +44,14 @@ private:
     void seek_strict(uint32_t docid) {
         _algo.set_candidate(_terms, _heaps, docid);
         while (_algo.solve_wand_constraint(_terms, _heaps, GreaterThan(_boostedThreshold))) {
-            if (_algo.check_score(_terms, _heaps, DotProductScorer(), GreaterThan(_threshold))) {
+            docid_t skip_to = _algo.get_candidate() + 1;
+            if (_algo.check_block_max_score(_terms, _heaps, DotProductScorer(), GreaterThan(_threshold), skip_to) &&
+                _algo.check_score(_terms, _heaps, DotProductScorer(), GreaterThan(_threshold)))
+            {
                 setDocId(_algo.get_candidate());
                 return;
             } else {
-                _algo.set_candidate(_terms, _heaps, _algo.get_candidate() + 1);
+                _algo.set_candidate(_terms, _heaps, skip_to);
             }
         }
         setAtEnd();
@@ -58,7 +61,10 @@ private:
         if (docid > _algo.get_candidate()) {
             _algo.set_candidate(_terms, _heaps, docid);
             if (_algo.check_wand_constraint(_terms, _heaps, GreaterThan(_boostedThreshold))) {
-                if (_algo.check_score(_terms, _heaps, DotProductScorer(), GreaterThan(_threshold))) {
+                docid_t skip_to = _algo.get_candidate() + 1;
+                if (_algo.check_block_max_score(_terms, _heaps, DotProductScorer(), GreaterThan(_threshold), skip_to) &&
+                    _algo.check_score(_terms, _heaps, DotProductScorer(), GreaterThan(_threshold)))
+                {
                     setDocId(_algo.get_candidate());
                 }
             }
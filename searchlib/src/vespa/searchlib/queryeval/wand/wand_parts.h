@@ -148,6 +148,16 @@ vespalib::string do_stringify(const vespalib::string &title, ITR begin, ITR end,
 
 //-----------------------------------------------------------------------------
 
+/**
+ * Iterator packs that can report the extent and max weight of the
+ * posting list block containing the current position of each child.
+ **/
+template <typename IteratorPack>
+concept BlockMaxIteratorPack = requires(const IteratorPack &pack, ref_t ref) {
+    { pack.get_block_end(ref) } -> std::convertible_to<docid_t>;
+    { pack.get_block_max_weight(ref) } -> std::convertible_to<int32_t>;
+};
+
 template <typename IteratorPack>
 class VectorizedState
 {
@@ -158,6 +168,8 @@ private:
     IteratorPack         _iteratorPack;
 
 public:
+    static constexpr bool has_block_max = BlockMaxIteratorPack<IteratorPack>;
+
     VectorizedState();
     VectorizedState(VectorizedState &&) noexcept;
     VectorizedState & operator=(VectorizedState &&) noexcept;
@@ -179,6 +191,8 @@ public:
 
     uint32_t seek(uint16_t ref, uint32_t docid) { return _iteratorPack.seek(ref, docid); }
     int32_t get_weight(uint16_t ref, uint32_t docid) { return _iteratorPack.get_weight(ref, docid); }
+    docid_t get_block_end(uint16_t ref) const requires has_block_max { return _iteratorPack.get_block_end(ref); }
+    int32_t get_block_max_weight(uint16_t ref) const requires has_block_max { return _iteratorPack.get_block_max_weight(ref); }
 
     vespalib::string stringify_docid() const;
 };
@@ -338,6 +352,8 @@ public:
     }
     ref_t *present_begin() const { return _present; }
     ref_t *present_end() const { return _past; }
+    ref_t *past_begin() const { return _past; }
+    ref_t *past_end() const { return _trash; }
     vespalib::string stringify() const;
 };
 
@@ -447,6 +463,11 @@ struct DotProductScorer
     static score_t calculateScore(VectorizedTerms &terms, ref_t ref, docid_t docId) {
         return terms.weight(ref) * (score_t)terms.get_weight(ref, docId);
     }
+
+    template <typename VectorizedTerms>
+    static score_t calculate_block_max_score(const VectorizedTerms &terms, ref_t ref) {
+        return std::min(terms.maxScore(ref), terms.weight(ref) * (score_t)terms.get_block_max_weight(ref));
+    }
 };
 
 //-----------------------------------------------------------------------------
@@ -521,6 +542,17 @@ private:
         _maxUpperBound += _upperBound;
     }
 
+    template <typename VectorizedTerms, typename Scorer>
+    score_t block_max_score(const VectorizedTerms &terms, ref_t ref, docid_t &limit, const Scorer &) const {
+        docid_t block_end = terms.get_block_end(ref);
+        if (block_end <= _candidate) {
+            // current block of a lagging term does not cover the candidate
+            return terms.maxScore(ref);
+        }
+        limit = std::min(limit, block_end);
+        return Scorer::calculate_block_max_score(terms, ref);
+    }
+
     template <typename VectorizedTerms, typename Heaps, typename Scorer, typename AboveThreshold>
     bool check_present_score(VectorizedTerms &terms, Heaps &heaps, score_t &max_score, const Scorer &, AboveThreshold &&aboveThreshold) {
         ref_t *end = heaps.present_end();
@@ -630,6 +662,36 @@ public:
         return false;
     }
 
+    /**
+     * Check the candidate against the max weights of the posting list
+     * blocks covering it (block-max WAND). Returns true if the
+     * candidate might score above the threshold and must be
+     * scored. Returns false if no document from the candidate up to
+     * (but not including) 'skip_to' can score above the threshold.
+     * Always returns true for terms without block max information.
+     **/
+    template <typename VectorizedTerms, typename Heaps, typename Scorer, typename AboveThreshold>
+    bool check_block_max_score([[maybe_unused]] VectorizedTerms &terms, [[maybe_unused]] const Heaps &heaps,
+                               [[maybe_unused]] const Scorer &scorer, [[maybe_unused]] AboveThreshold &&aboveThreshold,
+                               [[maybe_unused]] docid_t &skip_to) const
+    {
+        if constexpr (VectorizedTerms::has_block_max) {
+            docid_t limit = heaps.has_future() ? terms.docId(heaps.future()) : search::endDocId;
+            score_t max_score = 0;
+            for (const ref_t *ref = heaps.present_begin(); ref != heaps.present_end(); ++ref) {
+                max_score += block_max_score(terms, *ref, limit, scorer);
+            }
+            for (const ref_t *ref = heaps.past_begin(); ref != heaps.past_end(); ++ref) {
+                max_score += block_max_score(terms, *ref, limit, scorer);
+            }
+            if (!aboveThreshold(max_score)) {
+                skip_to = limit;
+                return false;
+            }
+        }
+        return true;
+    }
+
     template <typename VectorizedTerms, typename Heaps, typename Scorer>
     score_t get_full_score(VectorizedTerms &terms, Heaps &heaps, Scorer &&) {
         score_t score = _partial_score;
@@ -49,6 +49,13 @@ private:
     mutable TemporaryVectorStore<FloatType> _tmpSpace;
     const vespalib::ConstArrayRef<FloatType> _lhs;
     double _lhs_norm_sq;
+    double distance_from(double dot_product, double b_norm_sq) const noexcept {
+        double squared_norms = _lhs_norm_sq * b_norm_sq;
+        double div = (squared_norms > 0) ? sqrt(squared_norms) : 1.0;
+        double cosine_similarity = dot_product / div;
+        double distance = 1.0 - cosine_similarity; // in range [0,2]
+        return distance;
+    }
 public:
     BoundAngularDistance(const vespalib::eval::TypedCells& lhs)
         : _computer(vespalib::hwaccelrated::IAccelrated::getAccelerator()),
@@ -60,17 +67,18 @@ public:
     }
     double calc(const vespalib::eval::TypedCells& rhs) const override {
         size_t sz = _lhs.size();
+        if constexpr (std::is_same<FloatType, float>::value) {
+            if (rhs.type == vespalib::eval::CellType::BFLOAT16) {
+                assert(sz == rhs.size);
+                auto b = rhs.unsafe_typify<vespalib::BFloat16>().data();
+                return distance_from(_computer.dotProduct(_lhs.data(), b, sz), _computer.dotProduct(b, b, sz));
+            }
+        }
         vespalib::ConstArrayRef<FloatType> rhs_vector = _tmpSpace.convertRhs(rhs);
         assert(sz == rhs_vector.size());
         auto a = _lhs.data();
         auto b = rhs_vector.data();
-        double b_norm_sq = _computer.dotProduct(b, b, sz);
-        double squared_norms = _lhs_norm_sq * b_norm_sq;
-        double dot_product = _computer.dotProduct(a, b, sz);
-        double div = (squared_norms > 0) ? sqrt(squared_norms) : 1.0;
-        double cosine_similarity = dot_product / div;
-        double distance = 1.0 - cosine_similarity; // in range [0,2]
-        return distance;
+        return distance_from(_computer.dotProduct(a, b, sz), _computer.dotProduct(b, b, sz));
     }
     double convert_threshold(double threshold) const override {
         if (threshold < 0.0) {
@@ -94,6 +102,12 @@ public:
     double calc_with_limit(const vespalib::eval::TypedCells& rhs, double) const override {
         return calc(rhs);
     }
+    vespalib::eval::TypedCells bound_vector() const override {
+        return vespalib::eval::TypedCells(_lhs);
+    }
+    double calc_from_products(double dot_product, double rhs_norm_sq) const override {
+        return distance_from(dot_product, rhs_norm_sq);
+    }
 };
 
 template class BoundAngularDistance<float>;
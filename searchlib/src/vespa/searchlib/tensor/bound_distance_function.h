@@ -33,6 +33,20 @@ public:
     // calculate internal distance, early return allowed if > limit
     virtual double calc_with_limit(const vespalib::eval::TypedCells& rhs,
                                    double limit) const = 0;
+
+    // The bound vector, or empty cells if calc_from_products() is not supported.
+    virtual vespalib::eval::TypedCells bound_vector() const { return {}; }
+    /**
+     * Calculate internal distance given the dot product between the bound vector
+     * and rhs, and the squared norm of rhs. Used to calculate distances to
+     * quantized vectors without decoding them.
+     * Only called when bound_vector() returns non-empty cells.
+     */
+    virtual double calc_from_products(double dot_product, double rhs_norm_sq) const {
+        (void) dot_product;
+        (void) rhs_norm_sq;
+        return 0.0;
+    }
 };
 
 }
@@ -7,8 +7,13 @@
 #include "distance_function_factory.h"
 #include <vespa/searchcommon/attribute/config.h>
 
+#include <vespa/log/log.h>
+LOG_SETUP(".searchlib.tensor.default_nearest_neighbor_index_factory");
+
 namespace search::tensor {
 
+using search::attribute::DistanceMetric;
+using vespalib::eval::CellType;
 using vespalib::eval::ValueType;
 
 namespace {
@@ -23,6 +28,15 @@ make_random_level_generator(uint32_t m)
     return std::make_unique<InvLogLevelGenerator>(m);
 }
 
+bool
+supports_quantization(DistanceMetric distance_metric, CellType cell_type)
+{
+    if (distance_metric == DistanceMetric::Hamming || distance_metric == DistanceMetric::GeoDegrees) {
+        return false;
+    }
+    return (cell_type == CellType::FLOAT || cell_type == CellType::DOUBLE || cell_type == CellType::BFLOAT16);
+}
+
 } // namespace <unnamed>
 
 std::unique_ptr<NearestNeighborIndex>
@@ -39,6 +53,15 @@ DefaultNearestNeighborIndexFactory::make(const DocVectorAccess& vectors,
                         params.neighbors_to_explore_at_insert(),
                         10000,
                         true);
+    if (supports_quantization(params.distance_metric(), cell_type)) {
+        cfg.set_quantization(params.quantization());
+    }
+    if (params.mapped_graph() && cfg.quantization().enabled()) {
+        LOG(warning, "Memory mapped hnsw graph is not supported together with vector quantization, "
+                     "the graph will be loaded into memory");
+    } else {
+        cfg.set_mapped_graph(params.mapped_graph());
+    }
     if (multi_vector_index) {
         return std::make_unique<HnswIndex<HnswIndexType::MULTI>>(vectors,
                                                                   make_distance_function_factory(params.distance_metric(), cell_type),
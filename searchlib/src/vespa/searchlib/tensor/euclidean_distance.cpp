@@ -40,6 +40,7 @@ private:
     const vespalib::hwaccelrated::IAccelrated & _computer;
     mutable TemporaryVectorStore<FloatType> _tmpSpace;
     const vespalib::ConstArrayRef<FloatType> _lhs_vector;
+    double _lhs_norm_sq;
     static const double *cast(const double * p) { return p; }
     static const float *cast(const float * p) { return p; }
     static const int8_t *cast(const Int8Float * p) { return reinterpret_cast<const int8_t *>(p); }
@@ -48,9 +49,19 @@ public:
         : _computer(vespalib::hwaccelrated::IAccelrated::getAccelerator()),
           _tmpSpace(lhs.size),
           _lhs_vector(_tmpSpace.storeLhs(lhs))
-    {}
+    {
+        auto a = _lhs_vector.data();
+        _lhs_norm_sq = _computer.dotProduct(cast(a), cast(a), lhs.size);
+    }
     double calc(const vespalib::eval::TypedCells& rhs) const override {
         size_t sz = _lhs_vector.size();
+        if constexpr (std::is_same<FloatType, float>::value) {
+            if (rhs.type == vespalib::eval::CellType::BFLOAT16) {
+                // widen bfloat16 inside the kernel instead of converting rhs up front
+                assert(sz == rhs.size);
+                return _computer.squaredEuclideanDistance(_lhs_vector.data(), rhs.unsafe_typify<BFloat16>().data(), sz);
+            }
+        }
         vespalib::ConstArrayRef<FloatType> rhs_vector = _tmpSpace.convertRhs(rhs);
         assert(sz == rhs_vector.size());
         auto a = _lhs_vector.data();
@@ -76,6 +87,12 @@ public:
         }
         return sum;
     }
+    vespalib::eval::TypedCells bound_vector() const override {
+        return vespalib::eval::TypedCells(_lhs_vector);
+    }
+    double calc_from_products(double dot_product, double rhs_norm_sq) const override {
+        return std::max(0.0, _lhs_norm_sq - 2.0 * dot_product + rhs_norm_sq);
+    }
 };
 
 template class BoundEuclideanDistance<Int8Float>;
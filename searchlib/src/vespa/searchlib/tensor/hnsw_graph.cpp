@@ -58,6 +58,9 @@ HnswGraph<type>::remove_node(uint32_t nodeid)
     nodes[nodeid].levels_ref().store_release(invalid);
     // Ensure data referenced through the old ref can be recycled:
     levels_store.remove(levels_ref);
+    if (is_mapped(nodeid)) {
+        mapped_links->set_mapped(nodeid, false);
+    }
     for (size_t i = 0; i < levels.size(); ++i) {
         auto old_links_ref = levels[i].load_relaxed();
         links_store.remove(old_links_ref);
@@ -88,11 +91,35 @@ HnswGraph<type>::set_link_array(uint32_t nodeid, uint32_t level, const LinkArray
     assert(levels_ref.valid());
     auto levels = levels_store.get_writable(levels_ref);
     assert(level < levels.size());
+    if (is_mapped(nodeid)) [[unlikely]] {
+        // Move all link arrays for the node to the store before readers stop using the mapped ones.
+        for (uint32_t i = 0; i < levels.size(); ++i) {
+            if (i != level) {
+                levels[i].store_release(links_store.add(mapped_links->get(nodeid, i)));
+            }
+        }
+        levels[level].store_release(new_links_ref);
+        mapped_links->set_mapped(nodeid, false);
+        return;
+    }
     auto old_links_ref = levels[level].load_relaxed();
     levels[level].store_release(new_links_ref);
     links_store.remove(old_links_ref);
 }
 
+template <HnswIndexType type>
+void
+HnswGraph<type>::set_mapped_node(uint32_t nodeid)
+{
+    assert(mapped_links && nodeid < mapped_links->num_nodes());
+    auto levels_ref = get_levels_ref(nodeid);
+    assert(levels_ref.valid());
+    for (const auto& links_ref : levels_store.get(levels_ref)) {
+        assert(!links_ref.load_relaxed().valid());
+    }
+    mapped_links->set_mapped(nodeid, true);
+}
+
 template <HnswIndexType type>
 typename HnswGraph<type>::Histograms
 HnswGraph<type>::histograms() const
@@ -107,8 +134,7 @@ HnswGraph<type>::histograms() const
             auto level_array = levels_store.get(levels_ref);
             levels = level_array.size();
             if (levels > 0) {
-                auto links_ref = level_array[0].load_acquire();
-                auto link_array = links_store.get(links_ref);
+                auto link_array = get_link_array(i, level_array, 0);
                 l0links = link_array.size();
             }
             while (result.level_histogram.size() <= levels) {
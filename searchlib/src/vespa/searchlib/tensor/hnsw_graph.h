@@ -3,6 +3,7 @@
 #pragma once
 
 #include "hnsw_index_traits.h"
+#include "hnsw_mapped_links.h"
 #include "hnsw_simple_node.h"
 #include "hnsw_node.h"
 #include <vespa/vespalib/datastore/array_store.h>
@@ -50,6 +51,8 @@ struct HnswGraph {
     std::atomic<uint32_t> active_nodes;
     LevelArrayStore levels_store;
     LinkArrayStore links_store;
+    // Link arrays from a memory mapped saved graph, used for nodes not yet updated.
+    std::shared_ptr<HnswMappedLinks> mapped_links;
 
     std::atomic<uint64_t> entry_nodeid_and_level;
 
@@ -95,8 +98,15 @@ struct HnswGraph {
         return get_level_array(levels_ref);
     }
 
-    LinkArrayRef get_link_array(LevelArrayRef levels, uint32_t level) const {
+    bool is_mapped(uint32_t nodeid) const noexcept {
+        return mapped_links && mapped_links->is_mapped(nodeid);
+    }
+
+    LinkArrayRef get_link_array(uint32_t nodeid, LevelArrayRef levels, uint32_t level) const {
         if (level < levels.size()) {
+            if (is_mapped(nodeid)) [[unlikely]] {
+                return mapped_links->get(nodeid, level);
+            }
             auto links_ref = levels[level].load_acquire();
             if (links_ref.valid()) {
                 return links_store.get(links_ref);
@@ -107,21 +117,24 @@ struct HnswGraph {
 
     LinkArrayRef get_link_array(uint32_t nodeid, uint32_t level) const {
         auto levels = get_level_array(nodeid);
-        return get_link_array(levels, level);
+        return get_link_array(nodeid, levels, level);
     }
 
     LinkArrayRef acquire_link_array(uint32_t nodeid, uint32_t level) const {
         auto levels = acquire_level_array(nodeid);
-        return get_link_array(levels, level);
+        return get_link_array(nodeid, levels, level);
     }
 
-    LinkArrayRef get_link_array(LevelsRef levels_ref, uint32_t level) const {
+    LinkArrayRef get_link_array(uint32_t nodeid, LevelsRef levels_ref, uint32_t level) const {
         auto levels = get_level_array(levels_ref);
-        return get_link_array(levels, level);
+        return get_link_array(nodeid, levels, level);
     }
 
     void set_link_array(uint32_t nodeid, uint32_t level, const LinkArrayRef& new_links);
 
+    // Let the node use its link arrays in the mapped graph.
+    void set_mapped_node(uint32_t nodeid);
+
     struct EntryNode {
         uint32_t nodeid;
         LevelsRef levels_ref;
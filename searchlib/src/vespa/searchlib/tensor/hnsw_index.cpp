@@ -6,12 +6,15 @@
 #include "hash_set_visited_tracker.h"
 #include "hnsw_index_loader.hpp"
 #include "hnsw_index_saver.h"
+#include "hnsw_mapped_index_loader.h"
 #include "mips_distance_transform.h"
 #include "random_level_generator.h"
 #include "vector_bundle.h"
 #include <vespa/searchlib/attribute/address_space_components.h>
 #include <vespa/searchlib/attribute/address_space_usage.h>
 #include <vespa/searchlib/queryeval/global_filter.h>
+#include <vespa/fastos/file.h>
+#include <vespa/searchlib/util/filesizecalculator.h>
 #include <vespa/searchlib/util/fileutil.h>
 #include <vespa/searchlib/util/state_explorer_utils.h>
 #include <vespa/vespalib/data/slime/cursor.h>
@@ -29,6 +32,7 @@ LOG_SETUP(".searchlib.tensor.hnsw_index");
 namespace search::tensor {
 
 using search::AddressSpaceComponents;
+using search::attribute::VectorQuantizationType;
 using search::StateExplorerUtils;
 using search::queryeval::GlobalFilter;
 using vespalib::datastore::ArrayStoreConfig;
@@ -44,8 +48,15 @@ constexpr float alloc_grow_factor = 0.3;
 constexpr size_t max_level_array_size = 16;
 constexpr size_t max_link_array_size = 193;
 constexpr vespalib::duration MAX_COUNT_DURATION(100ms);
+// Max number of nodes encoded per generation by the writer thread after a quantizer is trained.
+constexpr uint32_t max_quantizer_encode_nodes_per_generation = 4_Ki;
 
 const vespalib::string hnsw_max_squared_norm = "hnsw.max_squared_norm";
+const vespalib::string hnsw_quantizer_type = "hnsw.quantizer.type";
+const vespalib::string hnsw_quantizer_dims = "hnsw.quantizer.dims";
+const vespalib::string hnsw_quantizer_code_size = "hnsw.quantizer.code_size";
+const vespalib::string hnsw_quantizer_codebook_size = "hnsw.quantizer.codebook_size";
+const vespalib::string hnsw_mapped_links = "hnsw.mapped_links";
 
 void save_mips_max_distance(GenericHeader& header, DistanceFunctionFactory& dff) {
     auto* mips_dff = dynamic_cast<MipsDistanceFunctionFactoryBase*>(&dff);
@@ -68,6 +79,16 @@ void load_mips_max_distance(const GenericHeader& header, DistanceFunctionFactory
     }
 }
 
+uint32_t get_integer_tag(const GenericHeader& header, const vespalib::string& name) {
+    if (header.hasTag(name)) {
+        auto& tag = header.getTag(name);
+        if (tag.getType() == GenericHeader::Tag::Type::TYPE_INTEGER) {
+            return tag.asInteger();
+        }
+    }
+    return 0;
+}
+
 bool has_link_to(vespalib::ConstArrayRef<uint32_t> links, uint32_t id) {
     for (uint32_t link : links) {
         if (link == id) return true;
@@ -319,6 +340,17 @@ HnswIndex<type>::calc_distance(const BoundDistanceFunction &df, uint32_t rhs_doc
     return df.calc(rhs);
 }
 
+template <HnswIndexType type>
+double
+HnswIndex<type>::calc_traversal_distance(const BoundDistanceFunction &df, QuantizedVectorReader* quantized,
+                                         uint32_t rhs_nodeid, uint32_t rhs_docid, uint32_t rhs_subspace) const
+{
+    if (quantized != nullptr && quantized->has_code(rhs_nodeid)) {
+        return quantized->calc_distance(rhs_nodeid);
+    }
+    return calc_distance(df, rhs_docid, rhs_subspace);
+}
+
 template <HnswIndexType type>
 uint32_t
 HnswIndex<type>::estimate_visited_nodes(uint32_t level, uint32_t nodeid_limit, uint32_t neighbors_to_find, const GlobalFilter* filter) const
@@ -347,18 +379,19 @@ template <HnswIndexType type>
 HnswCandidate
 HnswIndex<type>::find_nearest_in_layer(
         const BoundDistanceFunction &df,
-        const HnswCandidate& entry_point, uint32_t level) const
+        const HnswCandidate& entry_point, uint32_t level,
+        QuantizedVectorReader* quantized) const
 {
     HnswCandidate nearest = entry_point;
     bool keep_searching = true;
     while (keep_searching) {
         keep_searching = false;
-        for (uint32_t neighbor_nodeid : _graph.get_link_array(nearest.levels_ref, level)) {
+        for (uint32_t neighbor_nodeid : _graph.get_link_array(nearest.nodeid, nearest.levels_ref, level)) {
             auto& neighbor_node = _graph.acquire_node(neighbor_nodeid);
             auto neighbor_ref = neighbor_node.levels_ref().load_acquire();
             uint32_t neighbor_docid = acquire_docid(neighbor_node, neighbor_nodeid);
             uint32_t neighbor_subspace = neighbor_node.acquire_subspace();
-            double dist = calc_distance(df, neighbor_docid, neighbor_subspace);
+            double dist = calc_traversal_distance(df, quantized, neighbor_nodeid, neighbor_docid, neighbor_subspace);
             if (_graph.still_valid(neighbor_nodeid, neighbor_ref)
                 && dist < nearest.distance)
             {
@@ -378,7 +411,8 @@ HnswIndex<type>::search_layer_helper(
         uint32_t neighbors_to_find,
         BestNeighbors& best_neighbors, uint32_t level, const GlobalFilter *filter,
         uint32_t nodeid_limit, const vespalib::Doom* const doom,
-        uint32_t estimated_visited_nodes) const
+        uint32_t estimated_visited_nodes,
+        QuantizedVectorReader* quantized) const
 {
     NearestPriQ candidates;
     GlobalFilterWrapper<type> filter_wrapper(filter);
@@ -409,7 +443,7 @@ HnswIndex<type>::search_layer_helper(
             break;
         }
         candidates.pop();
-        for (uint32_t neighbor_nodeid : _graph.get_link_array(cand.levels_ref, level)) {
+        for (uint32_t neighbor_nodeid : _graph.get_link_array(cand.nodeid, cand.levels_ref, level)) {
             if (neighbor_nodeid >= nodeid_limit) {
                 continue;
             }
@@ -422,7 +456,7 @@ HnswIndex<type>::search_layer_helper(
             }
             uint32_t neighbor_docid = acquire_docid(neighbor_node, neighbor_nodeid);
             uint32_t neighbor_subspace = neighbor_node.acquire_subspace();
-            double dist_to_input = calc_distance(df, neighbor_docid, neighbor_subspace);
+            double dist_to_input = calc_traversal_distance(df, quantized, neighbor_nodeid, neighbor_docid, neighbor_subspace);
             if (dist_to_input < limit_dist) {
                 candidates.emplace(neighbor_nodeid, neighbor_ref, dist_to_input);
                 if (filter_wrapper.check(neighbor_docid)) {
@@ -447,14 +481,15 @@ HnswIndex<type>::search_layer(
         const BoundDistanceFunction &df,
         uint32_t neighbors_to_find,
         BestNeighbors& best_neighbors, uint32_t level,
-        const vespalib::Doom* const doom, const GlobalFilter *filter) const
+        const vespalib::Doom* const doom, const GlobalFilter *filter,
+        QuantizedVectorReader* quantized) const
 {
     uint32_t nodeid_limit = _graph.nodes_size.load(std::memory_order_acquire);
     uint32_t estimated_visited_nodes = estimate_visited_nodes(level, nodeid_limit, neighbors_to_find, filter);
     if (estimated_visited_nodes >= nodeid_limit / 128) {
-        search_layer_helper<BitVectorVisitedTracker>(df, neighbors_to_find, best_neighbors, level, filter, nodeid_limit, doom, estimated_visited_nodes);
+        search_layer_helper<BitVectorVisitedTracker>(df, neighbors_to_find, best_neighbors, level, filter, nodeid_limit, doom, estimated_visited_nodes, quantized);
     } else {
-        search_layer_helper<HashSetVisitedTracker>(df, neighbors_to_find, best_neighbors, level, filter, nodeid_limit, doom, estimated_visited_nodes);
+        search_layer_helper<HashSetVisitedTracker>(df, neighbors_to_find, best_neighbors, level, filter, nodeid_limit, doom, estimated_visited_nodes, quantized);
     }
 }
 
@@ -466,7 +501,10 @@ HnswIndex<type>::HnswIndex(const DocVectorAccess& vectors, DistanceFunctionFacto
       _distance_ff(std::move(distance_ff)),
       _level_generator(std::move(level_generator)),
       _id_mapping(),
-      _cfg(cfg)
+      _cfg(cfg),
+      _quantized(),
+      _quantizer_trainer(),
+      _quantizer_encode_nodeid(0)
 {
     assert(_distance_ff);
 }
@@ -593,6 +631,10 @@ void
 HnswIndex<type>::internal_complete_add_node(uint32_t nodeid, uint32_t docid, uint32_t subspace, PreparedAddNode &prepared_node)
 {
     int32_t num_levels = prepared_node.connections.size();
+    if (_quantized.quantizer() != nullptr) {
+        // Code must be present before the node is reachable by readers.
+        _quantized.encode(nodeid, get_vector(docid, subspace));
+    }
     auto levels_ref = _graph.make_node(nodeid, docid, subspace, num_levels);
     for (int level = 0; level < num_levels; ++level) {
         auto neighbors = filter_valid_nodeids(level, prepared_node.connections[level], nodeid);
@@ -601,6 +643,130 @@ HnswIndex<type>::internal_complete_add_node(uint32_t nodeid, uint32_t docid, uin
     if (num_levels - 1 > get_entry_level()) {
         _graph.set_entry_node({nodeid, levels_ref, num_levels - 1});
     }
+    maybe_train_quantizer();
+}
+
+template <HnswIndexType type>
+void
+HnswIndex<type>::maybe_train_quantizer()
+{
+    const auto& params = _cfg.quantization();
+    if (params.enabled() && _quantized.quantizer() == nullptr && !_quantizer_trainer.active() &&
+        _graph.get_active_nodes() >= std::max(1u, params.training_samples()))
+    {
+        start_quantizer_training();
+    }
+}
+
+template <HnswIndexType type>
+void
+HnswIndex<type>::start_quantizer_training()
+{
+    const auto& params = _cfg.quantization();
+    uint32_t nodeid_limit = _graph.size();
+    uint32_t max_samples = std::max(1u, params.training_samples());
+    uint32_t stride = std::max(1u, _graph.get_active_nodes() / max_samples);
+    std::vector<float> samples;
+    std::vector<float> buffer;
+    uint32_t dims = 0;
+    uint32_t num_samples = 0;
+    for (uint32_t nodeid = 1; nodeid < nodeid_limit && num_samples < max_samples; nodeid += stride) {
+        if (!_graph.get_levels_ref(nodeid).valid()) {
+            continue;
+        }
+        auto vector = QuantizedVectorStore::to_float(get_vector(nodeid), buffer);
+        if (dims == 0) {
+            dims = vector.size();
+            samples.reserve(size_t(dims) * max_samples);
+        }
+        if (vector.size() != dims) {
+            continue;
+        }
+        samples.insert(samples.end(), vector.begin(), vector.end());
+        ++num_samples;
+    }
+    auto quantizer = make_vector_quantizer(params, dims);
+    if (!quantizer || num_samples == 0) {
+        return;
+    }
+    LOG(debug, "Training %s vector quantizer with %u samples, code size %u bytes for %u dimensions",
+        VectorQuantizer::type_to_string(quantizer->type()).c_str(), num_samples, quantizer->code_size(), dims);
+    // Samples are copied, so training does not access the vectors or the graph.
+    _quantizer_trainer.start(std::move(quantizer), std::move(samples), num_samples);
+}
+
+template <HnswIndexType type>
+void
+HnswIndex<type>::install_quantizer(VectorQuantizer::UP quantizer)
+{
+    // Nodes added from now on are encoded when added, existing nodes by encode_quantized_vectors().
+    _quantized.set_quantizer(std::move(quantizer));
+    _quantizer_encode_nodeid = 1;
+}
+
+template <HnswIndexType type>
+bool
+HnswIndex<type>::encode_quantized_vectors(uint32_t max_nodes)
+{
+    if (_quantizer_encode_nodeid == 0) {
+        return true;
+    }
+    uint32_t nodeid_limit = _graph.size();
+    uint32_t end = std::min(nodeid_limit, _quantizer_encode_nodeid + max_nodes);
+    for (uint32_t nodeid = _quantizer_encode_nodeid; nodeid < end; ++nodeid) {
+        if (_graph.get_levels_ref(nodeid).valid()) {
+            _quantized.encode(nodeid, get_vector(nodeid));
+        }
+    }
+    if (end < nodeid_limit) {
+        _quantizer_encode_nodeid = end;
+        return false;
+    }
+    _quantizer_encode_nodeid = 0;
+    _quantized.publish();
+    return true;
+}
+
+template <HnswIndexType type>
+void
+HnswIndex<type>::update_quantized_vectors()
+{
+    auto quantizer = _quantizer_trainer.take_trained();
+    if (quantizer) {
+        LOG(debug, "Installing trained %s vector quantizer", VectorQuantizer::type_to_string(quantizer->type()).c_str());
+        install_quantizer(std::move(quantizer));
+    }
+    encode_quantized_vectors(max_quantizer_encode_nodes_per_generation);
+}
+
+template <HnswIndexType type>
+bool
+HnswIndex<type>::install_loaded_quantizer(uint32_t dims, uint32_t code_size, std::vector<float> codebook)
+{
+    for (uint32_t nodeid = 1; nodeid < _graph.size(); ++nodeid) {
+        if (_graph.get_levels_ref(nodeid).valid()) {
+            size_t vector_dims = get_vector(nodeid).size;
+            if (vector_dims != dims) {
+                LOG(warning, "Saved vector quantizer has %u dimensions, while vectors have %zu. Training a new one",
+                    dims, vector_dims);
+                return false;
+            }
+            break;
+        }
+    }
+    auto quantizer = make_vector_quantizer(_cfg.quantization(), dims);
+    if (quantizer && quantizer->code_size() == code_size && quantizer->set_codebook(std::move(codebook))) {
+        install_quantizer(std::move(quantizer));
+        return true;
+    }
+    return false;
+}
+
+template <HnswIndexType type>
+void
+HnswIndex<type>::wait_for_quantizer_training()
+{
+    _quantizer_trainer.sync();
 }
 
 template <HnswIndexType type>
@@ -714,6 +880,8 @@ HnswIndex<type>::assign_generation(generation_t current_gen)
     _graph.levels_store.assign_generation(current_gen);
     _graph.links_store.assign_generation(current_gen);
     _id_mapping.assign_generation(current_gen);
+    update_quantized_vectors();
+    _quantized.assign_generation(current_gen);
 }
 
 template <HnswIndexType type>
@@ -724,6 +892,7 @@ HnswIndex<type>::reclaim_memory(generation_t oldest_used_gen)
     _graph.levels_store.reclaim_memory(oldest_used_gen);
     _graph.links_store.reclaim_memory(oldest_used_gen);
     _id_mapping.reclaim_memory(oldest_used_gen);
+    _quantized.reclaim_memory(oldest_used_gen);
 }
 
 template <HnswIndexType type>
@@ -788,6 +957,7 @@ HnswIndex<type>::update_stat(const CompactionStrategy& compaction_strategy)
     result.merge(_graph.levels_store.update_stat(compaction_strategy));
     result.merge(_graph.links_store.update_stat(compaction_strategy));
     result.merge(_id_mapping.update_stat(compaction_strategy));
+    result.merge(_quantized.memory_usage());
     return result;
 }
 
@@ -800,6 +970,7 @@ HnswIndex<type>::memory_usage() const
     result.merge(_graph.levels_store.getMemoryUsage());
     result.merge(_graph.links_store.getMemoryUsage());
     result.merge(_id_mapping.memory_usage());
+    result.merge(_quantized.memory_usage());
     return result;
 }
 
@@ -853,6 +1024,13 @@ HnswIndex<type>::get_state(const vespalib::slime::Inserter& inserter) const
     cfgObj.setLong("max_links_on_inserts", _cfg.max_links_on_inserts());
     cfgObj.setLong("neighbors_to_explore_at_construction",
                    _cfg.neighbors_to_explore_at_construction());
+    if (_cfg.quantization().enabled()) {
+        auto& quantizationObj = object.setObject("quantization");
+        quantizationObj.setString("type", VectorQuantizer::type_to_string(_cfg.quantization().type()));
+        quantizationObj.setBool("ready", _quantized.ready());
+        quantizationObj.setLong("code_size", _quantized.code_size());
+        StateExplorerUtils::memory_usage_to_slime(_quantized.memory_usage(), quantizationObj.setObject("memory_usage"));
+    }
 }
 
 template <HnswIndexType type>
@@ -875,15 +1053,115 @@ std::unique_ptr<NearestNeighborIndexSaver>
 HnswIndex<type>::make_saver(GenericHeader& header) const
 {
     save_mips_max_distance(header, distance_function_factory());
+    if (_quantized.quantizer() != nullptr) {
+        // The codebook never changes after the quantizer is installed, even if not all nodes are encoded yet.
+        const auto& quantizer = *_quantized.quantizer();
+        header.putTag(GenericHeader::Tag(hnsw_quantizer_type, VectorQuantizer::type_to_string(quantizer.type())));
+        header.putTag(GenericHeader::Tag(hnsw_quantizer_dims, quantizer.dims()));
+        header.putTag(GenericHeader::Tag(hnsw_quantizer_code_size, quantizer.code_size()));
+        header.putTag(GenericHeader::Tag(hnsw_quantizer_codebook_size, quantizer.get_codebook().size()));
+        return std::make_unique<HnswIndexSaver<type>>(_graph, quantizer.get_codebook());
+    }
+    if (_cfg.mapped_graph()) {
+        header.putTag(GenericHeader::Tag(hnsw_mapped_links, 1));
+        return std::make_unique<HnswIndexSaver<type>>(_graph, std::vector<float>(), true);
+    }
     return std::make_unique<HnswIndexSaver<type>>(_graph);
 }
 
+template <HnswIndexType type>
+std::unique_ptr<NearestNeighborIndexLoader>
+HnswIndex<type>::make_mapped_loader(FastOS_FileInterface& file, const vespalib::GenericHeader& header)
+{
+    auto mapped_file = HnswMappedIndexLoader<type>::map_file(file.GetFileName());
+    if (!mapped_file) {
+        LOG(warning, "Could not memory map hnsw graph in '%s', loading it into memory instead", file.GetFileName());
+        return {};
+    }
+    size_t header_len = header.getSize();
+    uint64_t file_size = mapped_file->getSize();
+    if (!FileSizeCalculator::extractFileSize(header, header_len, file.GetFileName(), file_size) ||
+        file_size < header_len)
+    {
+        return {};
+    }
+    const void* data = mapped_file->MemoryMapPtr(header_len);
+    try {
+        return std::make_unique<HnswMappedIndexLoader<type>>(_graph, _id_mapping, std::move(mapped_file),
+                                                             data, file_size - header_len);
+    } catch (const std::runtime_error& e) {
+        LOG(warning, "%s in '%s', loading it into memory instead", e.what(), file.GetFileName());
+        return {};
+    }
+}
+
+/**
+ * Loads the graph, then installs the saved quantizer codebook and encodes the
+ * vectors for all loaded nodes in batches. If the saved codebook does not match
+ * current config, a new quantizer is trained in the background instead.
+ */
+template <HnswIndexType type>
+class HnswIndex<type>::QuantizedIndexLoader : public NearestNeighborIndexLoader {
+    using ReaderType = FileReader<uint32_t>;
+    using GraphLoaderType = HnswIndexLoader<ReaderType, type>;
+    HnswIndex<type>&                 _index;
+    std::unique_ptr<GraphLoaderType> _graph_loader;
+    VectorQuantizationType           _saved_type;
+    uint32_t                         _dims;
+    uint32_t                         _code_size;
+public:
+    QuantizedIndexLoader(HnswIndex<type>& index, FastOS_FileInterface& file, const GenericHeader& header)
+        : _index(index),
+          _graph_loader(),
+          _saved_type(VectorQuantizationType::None),
+          _dims(get_integer_tag(header, hnsw_quantizer_dims)),
+          _code_size(get_integer_tag(header, hnsw_quantizer_code_size))
+    {
+        uint32_t codebook_size = 0;
+        if (header.hasTag(hnsw_quantizer_type)) {
+            _saved_type = VectorQuantizer::type_from_string(header.getTag(hnsw_quantizer_type).asString());
+            codebook_size = get_integer_tag(header, hnsw_quantizer_codebook_size);
+        }
+        _graph_loader = std::make_unique<GraphLoaderType>(index._graph, index._id_mapping,
+                                                          std::make_unique<ReaderType>(&file), codebook_size);
+    }
+    ~QuantizedIndexLoader() override;
+    bool load_next() override {
+        if (_graph_loader) {
+            if (_graph_loader->load_next()) {
+                return true;
+            }
+            auto& codebook = _graph_loader->quantizer_codebook();
+            bool installed = (!codebook.empty() && _saved_type == _index._cfg.quantization().type() &&
+                              _index.install_loaded_quantizer(_dims, _code_size, std::move(codebook)));
+            _graph_loader.reset();
+            if (!installed) {
+                _index.maybe_train_quantizer();
+                return false;
+            }
+        }
+        return !_index.encode_quantized_vectors(max_quantizer_encode_nodes_per_generation);
+    }
+};
+
+template <HnswIndexType type>
+HnswIndex<type>::QuantizedIndexLoader::~QuantizedIndexLoader() = default;
+
 template <HnswIndexType type>
 std::unique_ptr<NearestNeighborIndexLoader>
 HnswIndex<type>::make_loader(FastOS_FileInterface& file, const vespalib::GenericHeader& header)
 {
     assert(get_entry_nodeid() == 0); // cannot load after index has data
     load_mips_max_distance(header, distance_function_factory());
+    if (_cfg.quantization().enabled()) {
+        return std::make_unique<QuantizedIndexLoader>(*this, file, header);
+    }
+    if (_cfg.mapped_graph() && header.hasTag(hnsw_mapped_links)) {
+        auto loader = make_mapped_loader(file, header);
+        if (loader) {
+            return loader;
+        }
+    }
     using ReaderType = FileReader<uint32_t>;
     using LoaderType = HnswIndexLoader<ReaderType, type>;
     return std::make_unique<LoaderType>(_graph, _id_mapping, std::make_unique<ReaderType>(&file));
@@ -906,7 +1184,16 @@ HnswIndex<type>::top_k_by_docid(
         const vespalib::Doom& doom,
         double distance_threshold) const
 {
-    SearchBestNeighbors candidates = top_k_candidates(df, std::max(k, explore_k), filter, doom);
+    uint32_t candidates_k = std::max(k, explore_k);
+    SearchBestNeighbors candidates;
+    if (_quantized.ready()) {
+        QuantizedVectorReader quantized(_quantized, df);
+        uint32_t traversal_k = candidates_k * _cfg.quantization().rescore_factor();
+        auto traversal_candidates = top_k_candidates(df, std::max(candidates_k, traversal_k), filter, doom, &quantized);
+        candidates = rescore_candidates(df, traversal_candidates, candidates_k);
+    } else {
+        candidates = top_k_candidates(df, candidates_k, filter, doom, nullptr);
+    }
     auto result = candidates.get_neighbors(k, distance_threshold);
     std::sort(result.begin(), result.end(), NeighborsByDocId());
     return result;
@@ -942,6 +1229,17 @@ HnswIndex<type>::top_k_candidates(
         const BoundDistanceFunction &df,
         uint32_t k, const GlobalFilter *filter,
         const vespalib::Doom& doom) const
+{
+    return top_k_candidates(df, k, filter, doom, nullptr);
+}
+
+template <HnswIndexType type>
+typename HnswIndex<type>::SearchBestNeighbors
+HnswIndex<type>::top_k_candidates(
+        const BoundDistanceFunction &df,
+        uint32_t k, const GlobalFilter *filter,
+        const vespalib::Doom& doom,
+        QuantizedVectorReader* quantized) const
 {
     SearchBestNeighbors best_neighbors;
     auto entry = _graph.get_entry_node();
@@ -950,19 +1248,39 @@ HnswIndex<type>::top_k_candidates(
         return best_neighbors;
     }
     int search_level = entry.level;
-    double entry_dist = calc_distance(df, entry.nodeid);
     uint32_t entry_docid = get_docid(entry.nodeid);
+    uint32_t entry_subspace = _graph.acquire_node(entry.nodeid).acquire_subspace();
+    double entry_dist = calc_traversal_distance(df, quantized, entry.nodeid, entry_docid, entry_subspace);
     // TODO: check if entry docid/levels_ref is still valid here
     HnswCandidate entry_point(entry.nodeid, entry_docid, entry.levels_ref, entry_dist);
     while (search_level > 0) {
-        entry_point = find_nearest_in_layer(df, entry_point, search_level);
+        entry_point = find_nearest_in_layer(df, entry_point, search_level, quantized);
         --search_level;
     }
     best_neighbors.push(entry_point);
-    search_layer(df, k, best_neighbors, 0, &doom, filter);
+    search_layer(df, k, best_neighbors, 0, &doom, filter, quantized);
     return best_neighbors;
 }
 
+template <HnswIndexType type>
+typename HnswIndex<type>::SearchBestNeighbors
+HnswIndex<type>::rescore_candidates(
+        const BoundDistanceFunction &df,
+        const SearchBestNeighbors& candidates,
+        uint32_t k) const
+{
+    SearchBestNeighbors result;
+    for (const auto& candidate : candidates.peek()) {
+        // Original vector cells are only fetched for the candidates that survived traversal.
+        double dist = calc_distance(df, candidate.nodeid);
+        result.emplace(candidate.nodeid, candidate.docid, candidate.levels_ref, dist);
+        while (result.size() > k) {
+            result.pop();
+        }
+    }
+    return result;
+}
+
 template <HnswIndexType type>
 HnswTestNode
 HnswIndex<type>::get_node(uint32_t nodeid) const
@@ -973,8 +1291,8 @@ HnswIndex<type>::get_node(uint32_t nodeid) const
     }
     auto levels = _graph.levels_store.get(levels_ref);
     HnswTestNode::LevelArray result;
-    for (const auto& links_ref : levels) {
-        auto links = _graph.links_store.get(links_ref.load_acquire());
+    for (uint32_t level = 0; level < levels.size(); ++level) {
+        auto links = _graph.get_link_array(nodeid, levels, level);
         HnswTestNode::LinkArray result_links(links.begin(), links.end());
         std::sort(result_links.begin(), result_links.end());
         result.push_back(result_links);
@@ -1008,9 +1326,8 @@ HnswIndex<type>::check_link_symmetry() const
         auto levels_ref = _graph.acquire_levels_ref(nodeid);
         if (levels_ref.valid()) {
             auto levels = _graph.levels_store.get(levels_ref);
-            uint32_t level = 0;
-            for (const auto& links_ref : levels) {
-                auto links = _graph.links_store.get(links_ref.load_acquire());
+            for (uint32_t level = 0; level < levels.size(); ++level) {
+                auto links = _graph.get_link_array(nodeid, levels, level);
                 for (auto neighbor_nodeid : links) {
                     auto neighbor_links = _graph.acquire_link_array(neighbor_nodeid, level);
                     if (! has_link_to(neighbor_links, nodeid)) {
@@ -1019,7 +1336,6 @@ HnswIndex<type>::check_link_symmetry() const
                             nodeid, neighbor_nodeid, level);
                     }
                 }
-                ++level;
             }
         }
     }
@@ -13,6 +13,8 @@
 #include "hnsw_single_best_neighbors.h"
 #include "hnsw_test_node.h"
 #include "nearest_neighbor_index.h"
+#include "quantized_vector_store.h"
+#include "quantizer_trainer.h"
 #include "random_level_generator.h"
 #include "hnsw_graph.h"
 #include "vector_bundle.h"
@@ -37,6 +39,15 @@ namespace search::tensor {
  * "Efficient and robust approximate nearest neighbor search using Hierarchical Navigable Small World graphs" (Yu. A. Malkov, D. A. Yashunin),
  * but some adjustments are made to support proper removes.
  *
+ * Optionally, a quantized representation of the vectors (see QuantizedVectorStore) is trained
+ * in a background thread when enough nodes have been added. The writer thread then encodes the
+ * vectors of existing nodes in bounded batches per generation, and publishes the quantized
+ * vectors to readers when all nodes are encoded. It is then used for distance calculations (directly on the
+ * codes) when traversing the graph at query time, and the best candidates are rescored using the
+ * original vector cells. Graph construction still uses the original vector cells.
+ * The quantized vectors are kept in addition to the original ones, so this trades extra memory
+ * for cheaper traversal. Memory mapping of the saved graph is not supported with quantization.
+ *
  * TODO: Add details on how to handle removes.
  */
 
@@ -109,6 +120,14 @@ protected:
     RandomLevelGenerator::UP _level_generator;
     IdMapping _id_mapping; // mapping from docid to nodeid vector
     HnswIndexConfig _cfg;
+    QuantizedVectorStore _quantized;
+    QuantizerTrainer _quantizer_trainer;
+    uint32_t _quantizer_encode_nodeid; // next node to encode before publishing quantized vectors, 0 if none
+
+    class QuantizedIndexLoader;
+
+    // Returns nullptr if the saved graph cannot be memory mapped.
+    std::unique_ptr<NearestNeighborIndexLoader> make_mapped_loader(FastOS_FileInterface& file, const vespalib::GenericHeader& header);
 
     uint32_t max_links_for_level(uint32_t level) const;
     void add_link_to(uint32_t nodeid, uint32_t level, const LinkArrayRef& old_links, uint32_t new_link) {
@@ -160,22 +179,31 @@ protected:
 
     double calc_distance(const BoundDistanceFunction &df, uint32_t rhs_nodeid) const;
     double calc_distance(const BoundDistanceFunction &df, uint32_t rhs_docid, uint32_t rhs_subspace) const;
+    double calc_traversal_distance(const BoundDistanceFunction &df, QuantizedVectorReader* quantized,
+                                   uint32_t rhs_nodeid, uint32_t rhs_docid, uint32_t rhs_subspace) const;
     uint32_t estimate_visited_nodes(uint32_t level, uint32_t nodeid_limit, uint32_t neighbors_to_find, const GlobalFilter* filter) const;
 
     /**
      * Performs a greedy search in the given layer to find the candidate that is nearest the input vector.
      */
-    HnswCandidate find_nearest_in_layer(const BoundDistanceFunction &df, const HnswCandidate& entry_point, uint32_t level) const;
+    HnswCandidate find_nearest_in_layer(const BoundDistanceFunction &df, const HnswCandidate& entry_point, uint32_t level,
+                                        QuantizedVectorReader* quantized = nullptr) const;
     template <class VisitedTracker, class BestNeighbors>
     void search_layer_helper(const BoundDistanceFunction &df, uint32_t neighbors_to_find, BestNeighbors& best_neighbors,
                              uint32_t level, const GlobalFilter *filter,
                              uint32_t nodeid_limit,
                              const vespalib::Doom* const doom,
-                             uint32_t estimated_visited_nodes) const;
+                             uint32_t estimated_visited_nodes,
+                             QuantizedVectorReader* quantized) const;
     template <class BestNeighbors>
     void search_layer(const BoundDistanceFunction &df, uint32_t neighbors_to_find, BestNeighbors& best_neighbors,
                       uint32_t level, const vespalib::Doom* const doom,
-                      const GlobalFilter *filter = nullptr) const;
+                      const GlobalFilter *filter = nullptr,
+                      QuantizedVectorReader* quantized = nullptr) const;
+    SearchBestNeighbors top_k_candidates(const BoundDistanceFunction &df, uint32_t k, const GlobalFilter *filter,
+                                         const vespalib::Doom& doom, QuantizedVectorReader* quantized) const;
+    SearchBestNeighbors rescore_candidates(const BoundDistanceFunction &df, const SearchBestNeighbors& candidates,
+                                           uint32_t k) const;
     std::vector<Neighbor> top_k_by_docid(uint32_t k, const BoundDistanceFunction &df,
                                          const GlobalFilter *filter, uint32_t explore_k,
                                          const vespalib::Doom& doom,
@@ -187,6 +215,13 @@ protected:
     LinkArray filter_valid_nodeids(uint32_t level, const internal::PreparedAddNode::Links &neighbors, uint32_t self_nodeid);
     void internal_complete_add(uint32_t docid, internal::PreparedAddDoc &op);
     void internal_complete_add_node(uint32_t nodeid, uint32_t docid, uint32_t subspace, internal::PreparedAddNode &prepared_node);
+    void maybe_train_quantizer();
+    void start_quantizer_training();
+    void install_quantizer(VectorQuantizer::UP quantizer);
+    bool install_loaded_quantizer(uint32_t dims, uint32_t code_size, std::vector<float> codebook);
+    // Returns true when all nodes are encoded and the quantized vectors are published.
+    bool encode_quantized_vectors(uint32_t max_nodes);
+    void update_quantized_vectors();
 public:
     HnswIndex(const DocVectorAccess& vectors, DistanceFunctionFactory::UP distance_ff,
               RandomLevelGenerator::UP level_generator, const HnswIndexConfig& cfg);
@@ -241,8 +276,10 @@ public:
     int32_t get_entry_level() const { return _graph.get_entry_node().level; }
 
     uint32_t get_active_nodes() const noexcept { return _graph.get_active_nodes(); }
+    const QuantizedVectorStore& get_quantized_vectors() const noexcept { return _quantized; }
 
     // Should only be used by unit tests.
+    void wait_for_quantizer_training();
     HnswTestNode get_node(uint32_t nodeid) const;
     void set_node(uint32_t nodeid, const HnswTestNode &node);
     bool check_link_symmetry() const;
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <vespa/searchcommon/attribute/vector_quantization_params.h>
 #include <cstdint>
 
 namespace search::tensor {
@@ -16,6 +17,8 @@ private:
     uint32_t _neighbors_to_explore_at_construction;
     uint32_t _min_size_before_two_phase;
     bool     _heuristic_select_neighbors;
+    search::attribute::VectorQuantizationParams _quantization;
+    bool     _mapped_graph;
 
 public:
     HnswIndexConfig(uint32_t max_links_at_level_0_in,
@@ -27,13 +30,26 @@ public:
           _max_links_on_inserts(max_links_on_inserts_in),
           _neighbors_to_explore_at_construction(neighbors_to_explore_at_construction_in),
           _min_size_before_two_phase(min_size_before_two_phase_in),
-          _heuristic_select_neighbors(heuristic_select_neighbors_in)
+          _heuristic_select_neighbors(heuristic_select_neighbors_in),
+          _quantization(),
+          _mapped_graph(false)
     {}
     uint32_t max_links_at_level_0() const { return _max_links_at_level_0; }
     uint32_t max_links_on_inserts() const { return _max_links_on_inserts; }
     uint32_t neighbors_to_explore_at_construction() const { return _neighbors_to_explore_at_construction; }
     uint32_t min_size_before_two_phase() const { return _min_size_before_two_phase; }
     bool heuristic_select_neighbors() const { return _heuristic_select_neighbors; }
+    const search::attribute::VectorQuantizationParams& quantization() const { return _quantization; }
+    HnswIndexConfig& set_quantization(const search::attribute::VectorQuantizationParams& quantization_in) {
+        _quantization = quantization_in;
+        return *this;
+    }
+    // Save link offsets with the graph, and memory map the link arrays instead of copying them when loading.
+    bool mapped_graph() const { return _mapped_graph; }
+    HnswIndexConfig& set_mapped_graph(bool mapped_graph_in) {
+        _mapped_graph = mapped_graph_in;
+        return *this;
+    }
 };
 
 }
@@ -18,6 +18,7 @@ struct HnswGraph;
 
 /**
  * Implements loading of HNSW graph structure from binary format.
+ * A quantizer codebook of the given size is loaded after the graph.
  **/
 template <typename ReaderType, HnswIndexType type>
 class HnswIndexLoader : public NearestNeighborIndexLoader {
@@ -33,6 +34,7 @@ private:
     std::vector<uint32_t> _link_array;
     bool _complete;
     IdMapping& _id_mapping;
+    std::vector<float> _quantizer_codebook;
 
     void init();
     uint32_t next_int() {
@@ -41,8 +43,11 @@ private:
 
 public:
     HnswIndexLoader(HnswGraph<type>& graph, IdMapping& id_mapping, std::unique_ptr<ReaderType> reader);
+    HnswIndexLoader(HnswGraph<type>& graph, IdMapping& id_mapping, std::unique_ptr<ReaderType> reader,
+                    uint32_t quantizer_codebook_size);
     virtual ~HnswIndexLoader();
     bool load_next() override;
+    std::vector<float>& quantizer_codebook() noexcept { return _quantizer_codebook; }
 };
 
 }
@@ -6,6 +6,7 @@
 #include "hnsw_graph.h"
 #include <vespa/searchlib/util/fileutil.h>
 #include <cassert>
+#include <cstring>
 
 namespace search::tensor {
 
@@ -23,6 +24,13 @@ HnswIndexLoader<ReaderType, type>::~HnswIndexLoader() = default;
 
 template <typename ReaderType, HnswIndexType type>
 HnswIndexLoader<ReaderType, type>::HnswIndexLoader(HnswGraph<type>& graph, IdMapping& id_mapping, std::unique_ptr<ReaderType> reader)
+    : HnswIndexLoader(graph, id_mapping, std::move(reader), 0u)
+{
+}
+
+template <typename ReaderType, HnswIndexType type>
+HnswIndexLoader<ReaderType, type>::HnswIndexLoader(HnswGraph<type>& graph, IdMapping& id_mapping, std::unique_ptr<ReaderType> reader,
+                                                   uint32_t quantizer_codebook_size)
     : _graph(graph),
       _reader(std::move(reader)),
       _entry_nodeid(0),
@@ -31,7 +39,8 @@ HnswIndexLoader<ReaderType, type>::HnswIndexLoader(HnswGraph<type>& graph, IdMap
       _nodeid(0),
       _link_array(),
       _complete(false),
-      _id_mapping(id_mapping)
+      _id_mapping(id_mapping),
+      _quantizer_codebook(quantizer_codebook_size)
 {
     init();
 }
@@ -67,6 +76,11 @@ HnswIndexLoader<ReaderType, type>::load_next()
         auto entry_levels_ref = _graph.get_levels_ref(_entry_nodeid);
         _graph.set_entry_node({_entry_nodeid, entry_levels_ref, _entry_level});
         _id_mapping.on_load(_graph.nodes.make_read_view(_graph.size()));
+        static_assert(sizeof(float) == sizeof(uint32_t));
+        for (auto& value : _quantizer_codebook) {
+            uint32_t bits = next_int();
+            memcpy(&value, &bits, sizeof(float));
+        }
         _complete = true;
         return false;
     }
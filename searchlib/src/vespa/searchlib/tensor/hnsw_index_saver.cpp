@@ -31,7 +31,9 @@ HnswIndexSaver<type>::MetaData::MetaData()
     : entry_nodeid(0),
       entry_level(-1),
       refs(),
-      nodes()
+      nodes(),
+      mapped_links(),
+      mapped_nodes()
 {}
 
 template <HnswIndexType type>
@@ -42,7 +44,23 @@ HnswIndexSaver<type>::~HnswIndexSaver() = default;
 
 template <HnswIndexType type>
 HnswIndexSaver<type>::HnswIndexSaver(const HnswGraph<type> &graph)
-    : _graph_links(graph.links_store), _meta_data()
+    : HnswIndexSaver(graph, std::vector<float>())
+{
+}
+
+template <HnswIndexType type>
+HnswIndexSaver<type>::HnswIndexSaver(const HnswGraph<type> &graph, std::vector<float> quantizer_codebook)
+    : HnswIndexSaver(graph, std::move(quantizer_codebook), false)
+{
+}
+
+template <HnswIndexType type>
+HnswIndexSaver<type>::HnswIndexSaver(const HnswGraph<type> &graph, std::vector<float> quantizer_codebook,
+                                     bool save_link_offsets)
+    : _graph(graph),
+      _meta_data(),
+      _quantizer_codebook(std::move(quantizer_codebook)),
+      _save_link_offsets(save_link_offsets)
 {
     auto entry = graph.get_entry_node();
     _meta_data.entry_nodeid = entry.nodeid;
@@ -53,6 +71,10 @@ HnswIndexSaver<type>::HnswIndexSaver(const HnswGraph<type> &graph)
     assert (link_array_count <= std::numeric_limits<uint32_t>::max());
     _meta_data.refs.reserve(link_array_count);
     _meta_data.nodes.reserve(num_nodes+1);
+    if (graph.mapped_links) {
+        _meta_data.mapped_links = graph.mapped_links;
+        _meta_data.mapped_nodes.resize(num_nodes);
+    }
     for (size_t i = 0; i < num_nodes; ++i) {
         auto& node = graph.nodes.get_elem_ref(i);
         _meta_data.nodes.emplace_back(_meta_data.refs.size(), node);
@@ -62,6 +84,9 @@ HnswIndexSaver<type>::HnswIndexSaver(const HnswGraph<type> &graph)
             for (const auto& links_ref : levels) {
                 _meta_data.refs.push_back(links_ref.load_relaxed());
             }
+            if (graph.is_mapped(i)) {
+                _meta_data.mapped_nodes[i] = true;
+            }
         }
     }
     _meta_data.nodes.emplace_back(_meta_data.refs.size());
@@ -71,40 +96,102 @@ template <HnswIndexType type>
 void
 HnswIndexSaver<type>::save(BufferWriter& writer) const
 {
+    std::vector<uint64_t, vespalib::allocator_large<uint64_t>> link_offsets;
+    if (_save_link_offsets) {
+        link_offsets.reserve(_meta_data.refs.size());
+    }
     writer.write(&_meta_data.entry_nodeid, sizeof(uint32_t));
     writer.write(&_meta_data.entry_level, sizeof(int32_t));
     uint32_t num_nodes = _meta_data.nodes.size() - 1;
     writer.write(&num_nodes, sizeof(uint32_t));
+    uint64_t words_written = 3;
     for (uint32_t i(0); i < num_nodes; i++) {
         auto& node = _meta_data.nodes[i];
         uint32_t offset = node.get_refs_offset();
         uint32_t next_offset = _meta_data.nodes[i+1].get_refs_offset();
         uint32_t num_levels = next_offset - offset;
         writer.write(&num_levels, sizeof(uint32_t));
+        ++words_written;
         if (num_levels > 0) {
             if constexpr (!HnswIndexSaverMetaDataNode<type>::identity_mapping) {
                 uint32_t docid = node.get_docid();
                 uint32_t subspace = node.get_subspace();
                 writer.write(&docid, sizeof(uint32_t));
                 writer.write(&subspace, sizeof(uint32_t));
+                words_written += 2;
             }
         }
-        for (; offset < next_offset; offset++) {
+        bool mapped = (i < _meta_data.mapped_nodes.size() && _meta_data.mapped_nodes[i]);
+        for (uint32_t level = 0; offset < next_offset; offset++, level++) {
+            if (_save_link_offsets) {
+                link_offsets.push_back(words_written);
+            }
             auto links_ref = _meta_data.refs[offset];
-            if (links_ref.valid()) {
-                vespalib::ConstArrayRef<uint32_t> link_array = _graph_links.get(links_ref);
+            if (mapped) {
+                auto link_array = _meta_data.mapped_links->get(i, level);
                 uint32_t num_links = link_array.size();
                 writer.write(&num_links, sizeof(uint32_t));
                 writer.write(link_array.cbegin(), sizeof(uint32_t)*num_links);
+                words_written += 1 + num_links;
+            } else if (links_ref.valid()) {
+                vespalib::ConstArrayRef<uint32_t> link_array = _graph.links_store.get(links_ref);
+                uint32_t num_links = link_array.size();
+                writer.write(&num_links, sizeof(uint32_t));
+                writer.write(link_array.cbegin(), sizeof(uint32_t)*num_links);
+                words_written += 1 + num_links;
             } else {
                 uint32_t num_links = 0;
                 writer.write(&num_links, sizeof(uint32_t));
+                ++words_written;
             }
         }
     }
+    if (!_quantizer_codebook.empty()) {
+        writer.write(_quantizer_codebook.data(), sizeof(float) * _quantizer_codebook.size());
+        words_written += _quantizer_codebook.size();
+    }
+    if (_save_link_offsets) {
+        save_link_offsets(writer, words_written, link_offsets);
+    }
     writer.flush();
 }
 
+template <HnswIndexType type>
+void
+HnswIndexSaver<type>::save_link_offsets(BufferWriter& writer, uint64_t words_written,
+                                        const std::vector<uint64_t, vespalib::allocator_large<uint64_t>>& link_offsets) const
+{
+    const uint32_t zero = 0;
+    // Keep the offset table 8 byte aligned relative to start of data
+    if ((words_written % 2) != 0) {
+        writer.write(&zero, sizeof(uint32_t));
+        ++words_written;
+    }
+    HnswMappedLinks::Footer footer;
+    footer.trailer_offset = words_written;
+    footer.num_link_arrays = link_offsets.size();
+    footer.magic = HnswMappedLinks::footer_magic;
+    writer.write(link_offsets.data(), sizeof(uint64_t) * link_offsets.size());
+    uint64_t trailer_words = 0;
+    for (const auto& node : _meta_data.nodes) {
+        uint32_t first_link_array = node.get_refs_offset();
+        writer.write(&first_link_array, sizeof(uint32_t));
+        ++trailer_words;
+    }
+    if constexpr (!HnswIndexSaverMetaDataNode<type>::identity_mapping) {
+        for (uint32_t i(0); i + 1 < _meta_data.nodes.size(); ++i) {
+            uint32_t docid = _meta_data.nodes[i].get_docid();
+            uint32_t subspace = _meta_data.nodes[i].get_subspace();
+            writer.write(&docid, sizeof(uint32_t));
+            writer.write(&subspace, sizeof(uint32_t));
+        }
+    }
+    if ((trailer_words % 2) != 0) {
+        writer.write(&zero, sizeof(uint32_t));
+    }
+    writer.write(&footer, sizeof(footer));
+}
+
 template class HnswIndexSaver<HnswIndexType::SINGLE>;
 template class HnswIndexSaver<HnswIndexType::MULTI>;
 
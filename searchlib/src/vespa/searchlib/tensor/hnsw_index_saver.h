@@ -16,11 +16,16 @@ namespace search::tensor {
  * The constructor takes a snapshot of all meta-data, but
  * the links will be fetched from the graph in the save()
  * method.
+ * A trained quantizer codebook, if given, is saved after the graph.
+ * Optionally a trailer with link array offsets is saved at the end,
+ * allowing the graph to be memory mapped when loaded (see HnswMappedLinks).
  **/
 template <HnswIndexType type>
 class HnswIndexSaver : public NearestNeighborIndexSaver {
 public:
     HnswIndexSaver(const HnswGraph<type> &graph);
+    HnswIndexSaver(const HnswGraph<type> &graph, std::vector<float> quantizer_codebook);
+    HnswIndexSaver(const HnswGraph<type> &graph, std::vector<float> quantizer_codebook, bool save_link_offsets);
     ~HnswIndexSaver() override;
     void save(BufferWriter& writer) const override;
 
@@ -31,11 +36,19 @@ private:
         int32_t  entry_level;
         std::vector<EntryRef, vespalib::allocator_large<EntryRef>> refs;
         std::vector<HnswIndexSaverMetaDataNode<type>, vespalib::allocator_large<HnswIndexSaverMetaDataNode<type>>> nodes;
+        // Nodes with link arrays in a memory mapped graph at the time of the snapshot.
+        std::shared_ptr<const HnswMappedLinks> mapped_links;
+        std::vector<bool> mapped_nodes;
         MetaData();
         ~MetaData();
     };
-    const typename HnswGraph<type>::LinkArrayStore &_graph_links;
+    const HnswGraph<type> &_graph;
     MetaData _meta_data;
+    std::vector<float> _quantizer_codebook;
+    bool _save_link_offsets;
+
+    void save_link_offsets(BufferWriter& writer, uint64_t words_written,
+                           const std::vector<uint64_t, vespalib::allocator_large<uint64_t>>& link_offsets) const;
 };
 
 }
@@ -0,0 +1,181 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "hnsw_mapped_index_loader.h"
+#include "hnsw_graph.h"
+#include "hnsw_identity_mapping.h"
+#include "hnsw_mapped_links.h"
+#include "hnsw_nodeid_mapping.h"
+#include <vespa/fastos/file.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <cassert>
+#include <cinttypes>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+
+using vespalib::make_string;
+
+namespace search::tensor {
+
+template <HnswIndexType type>
+HnswMappedIndexLoader<type>::HnswMappedIndexLoader(HnswGraph<type>& graph, IdMapping& id_mapping,
+                                                   std::unique_ptr<FastOS_FileInterface> file,
+                                                   const void* data, size_t data_size)
+    : _graph(graph),
+      _id_mapping(id_mapping),
+      _first_link_array(nullptr),
+      _docids_and_subspaces(nullptr),
+      _entry_nodeid(0),
+      _entry_level(0),
+      _num_nodes(0),
+      _nodeid(0),
+      _complete(false)
+{
+    static constexpr bool identity_mapping = (type == HnswIndexType::SINGLE);
+    HnswMappedLinks::Footer footer;
+    if ((reinterpret_cast<uintptr_t>(data) % sizeof(uint64_t)) != 0 ||
+        data_size < 3 * sizeof(uint32_t) + sizeof(footer))
+    {
+        throw std::runtime_error(make_string("Cannot map hnsw graph: bad data alignment or size (%zu bytes)", data_size));
+    }
+    memcpy(&footer, static_cast<const char*>(data) + data_size - sizeof(footer), sizeof(footer));
+    auto words = static_cast<const uint32_t*>(data);
+    _entry_nodeid = words[0];
+    _entry_level = words[1];
+    _num_nodes = words[2];
+    uint64_t trailer_size = sizeof(uint64_t) * footer.num_link_arrays + sizeof(uint32_t) * (uint64_t(_num_nodes) + 1);
+    if constexpr (!identity_mapping) {
+        trailer_size += 2 * sizeof(uint32_t) * uint64_t(_num_nodes);
+    }
+    if (footer.magic != HnswMappedLinks::footer_magic ||
+        (footer.trailer_offset % 2) != 0 ||
+        footer.trailer_offset * sizeof(uint32_t) + trailer_size + sizeof(footer) > data_size)
+    {
+        throw std::runtime_error(make_string("Cannot map hnsw graph: bad link offsets trailer (magic=0x%x, %u link arrays)",
+                                             footer.magic, footer.num_link_arrays));
+    }
+    auto link_offsets = reinterpret_cast<const uint64_t*>(words + footer.trailer_offset);
+    _first_link_array = reinterpret_cast<const uint32_t*>(link_offsets + footer.num_link_arrays);
+    validate_first_link_arrays(footer.num_link_arrays);
+    validate_link_offsets(link_offsets, footer.num_link_arrays, footer.trailer_offset);
+    validate_entry_node();
+    if constexpr (!identity_mapping) {
+        _docids_and_subspaces = _first_link_array + _num_nodes + 1;
+    }
+    _graph.mapped_links = std::make_shared<HnswMappedLinks>(std::move(file), words, link_offsets, _first_link_array,
+                                                            footer.trailer_offset, footer.num_link_arrays, _num_nodes);
+}
+
+template <HnswIndexType type>
+HnswMappedIndexLoader<type>::~HnswMappedIndexLoader() = default;
+
+template <HnswIndexType type>
+void
+HnswMappedIndexLoader<type>::validate_first_link_arrays(uint32_t num_link_arrays) const
+{
+    uint32_t prev = 0;
+    for (uint32_t nodeid = 0; nodeid <= _num_nodes; ++nodeid) {
+        uint32_t first_link_array = _first_link_array[nodeid];
+        if (first_link_array < prev || first_link_array > num_link_arrays) {
+            throw std::runtime_error(make_string("Cannot map hnsw graph: first link array %u for node %u is out of order "
+                                                 "or beyond %u link arrays",
+                                                 first_link_array, nodeid, num_link_arrays));
+        }
+        prev = first_link_array;
+    }
+    if (_first_link_array[0] != 0 || prev != num_link_arrays) {
+        throw std::runtime_error(make_string("Cannot map hnsw graph: %u nodes have link arrays [%u, %u), expected [0, %u)",
+                                             _num_nodes, _first_link_array[0], prev, num_link_arrays));
+    }
+}
+
+template <HnswIndexType type>
+void
+HnswMappedIndexLoader<type>::validate_link_offsets(const uint64_t* link_offsets, uint32_t num_link_arrays,
+                                                   uint64_t trailer_offset) const
+{
+    // Link arrays start after entry nodeid, entry level and number of nodes, and each has a size word.
+    uint64_t min_offset = 3;
+    for (uint32_t link_array = 0; link_array < num_link_arrays; ++link_array) {
+        uint64_t offset = link_offsets[link_array];
+        if (offset < min_offset || offset >= trailer_offset) {
+            throw std::runtime_error(make_string("Cannot map hnsw graph: offset %" PRIu64 " for link array %u "
+                                                 "is out of order or beyond trailer offset %" PRIu64,
+                                                 offset, link_array, trailer_offset));
+        }
+        min_offset = offset + 1;
+    }
+}
+
+template <HnswIndexType type>
+void
+HnswMappedIndexLoader<type>::validate_entry_node() const
+{
+    // The entry node is used to index the node and link arrays when the graph is set up.
+    if (_num_nodes == 0) {
+        if (_entry_nodeid != 0) {
+            throw std::runtime_error(make_string("Cannot map hnsw graph: entry node %u in empty graph", _entry_nodeid));
+        }
+        return;
+    }
+    if (_entry_nodeid >= _num_nodes) {
+        throw std::runtime_error(make_string("Cannot map hnsw graph: entry node %u is beyond %u nodes",
+                                             _entry_nodeid, _num_nodes));
+    }
+    uint32_t num_levels = _first_link_array[_entry_nodeid + 1] - _first_link_array[_entry_nodeid];
+    if (_entry_level >= 0 && uint32_t(_entry_level) >= num_levels) {
+        throw std::runtime_error(make_string("Cannot map hnsw graph: entry level %d for entry node %u with %u levels",
+                                             _entry_level, _entry_nodeid, num_levels));
+    }
+}
+
+template <HnswIndexType type>
+bool
+HnswMappedIndexLoader<type>::load_next()
+{
+    assert(!_complete);
+    if (_nodeid < _num_nodes) {
+        uint32_t first_link_array = _first_link_array[_nodeid];
+        uint32_t num_levels = _first_link_array[_nodeid + 1] - first_link_array;
+        if (num_levels > 0) {
+            uint32_t docid = _nodeid;
+            uint32_t subspace = 0;
+            if (_docids_and_subspaces != nullptr) {
+                docid = _docids_and_subspaces[2 * _nodeid];
+                subspace = _docids_and_subspaces[2 * _nodeid + 1];
+            }
+            _graph.make_node(_nodeid, docid, subspace, num_levels);
+            _graph.set_mapped_node(_nodeid);
+        }
+    }
+    if (++_nodeid < _num_nodes) {
+        return true;
+    } else {
+        _graph.nodes.ensure_size(std::max(_num_nodes, 1u));
+        _graph.nodes_size.store(std::max(_num_nodes, 1u), std::memory_order_release);
+        _graph.trim_nodes_size();
+        auto entry_levels_ref = _graph.get_levels_ref(_entry_nodeid);
+        _graph.set_entry_node({_entry_nodeid, entry_levels_ref, _entry_level});
+        _id_mapping.on_load(_graph.nodes.make_read_view(_graph.size()));
+        _complete = true;
+        return false;
+    }
+}
+
+template <HnswIndexType type>
+std::unique_ptr<FastOS_FileInterface>
+HnswMappedIndexLoader<type>::map_file(const vespalib::string& file_name)
+{
+    auto file = std::make_unique<FastOS_File>(file_name.c_str());
+    file->enableMemoryMap(0);
+    file->setFAdviseOptions(POSIX_FADV_RANDOM);
+    if (!file->OpenReadOnly() || !file->IsMemoryMapped()) {
+        return {};
+    }
+    return file;
+}
+
+template class HnswMappedIndexLoader<HnswIndexType::SINGLE>;
+template class HnswMappedIndexLoader<HnswIndexType::MULTI>;
+
+}
@@ -0,0 +1,65 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "nearest_neighbor_index_loader.h"
+#include "hnsw_index_traits.h"
+#include <vespa/vespalib/stllike/string.h>
+#include <cstdint>
+#include <memory>
+
+class FastOS_FileInterface;
+
+namespace search::tensor {
+
+template <HnswIndexType type>
+struct HnswGraph;
+
+/**
+ * Loads the HNSW graph structure from a saved graph with link offsets
+ * without copying the link arrays. The link arrays are instead read
+ * from the memory mapped file (see HnswMappedLinks), and are moved to
+ * the link array store when updated.
+ *
+ * Only the node vector and the level arrays are populated, making load
+ * time and memory usage independent of the number of links. All link
+ * offsets in the trailer are validated before the graph is populated.
+ **/
+template <HnswIndexType type>
+class HnswMappedIndexLoader : public NearestNeighborIndexLoader {
+private:
+    using IdMapping = typename HnswIndexTraits<type>::IdMapping;
+
+    HnswGraph<type>& _graph;
+    IdMapping&       _id_mapping;
+    const uint32_t*  _first_link_array;
+    const uint32_t*  _docids_and_subspaces;
+    uint32_t         _entry_nodeid;
+    int32_t          _entry_level;
+    uint32_t         _num_nodes;
+    uint32_t         _nodeid;
+    bool             _complete;
+
+    // Throw std::runtime_error unless offsets are monotonic and within the mapped data.
+    void validate_first_link_arrays(uint32_t num_link_arrays) const;
+    void validate_link_offsets(const uint64_t* link_offsets, uint32_t num_link_arrays, uint64_t trailer_offset) const;
+    void validate_entry_node() const;
+public:
+    /**
+     * The data (starting after the file header) must stay valid as long as the graph uses it,
+     * which is ensured by handing over ownership of the (memory mapped) file.
+     *
+     * @throw std::runtime_error if the data does not contain valid link offsets.
+     */
+    HnswMappedIndexLoader(HnswGraph<type>& graph, IdMapping& id_mapping,
+                          std::unique_ptr<FastOS_FileInterface> file, const void* data, size_t data_size);
+    ~HnswMappedIndexLoader() override;
+    bool load_next() override;
+
+    /**
+     * Memory maps the given file. Returns nullptr if the file could not be mapped.
+     */
+    static std::unique_ptr<FastOS_FileInterface> map_file(const vespalib::string& file_name);
+};
+
+}
@@ -0,0 +1,33 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "hnsw_mapped_links.h"
+#include <vespa/fastos/file.h>
+
+namespace search::tensor {
+
+HnswMappedLinks::HnswMappedLinks(std::unique_ptr<FastOS_FileInterface> file, const uint32_t* data,
+                                 const uint64_t* link_offsets, const uint32_t* first_link_array,
+                                 uint64_t trailer_offset, uint32_t num_link_arrays, uint32_t num_nodes)
+    : _file(std::move(file)),
+      _data(data),
+      _link_offsets(link_offsets),
+      _first_link_array(first_link_array),
+      _trailer_offset(trailer_offset),
+      _num_link_arrays(num_link_arrays),
+      _num_nodes(num_nodes),
+      _mapped_nodes((size_t(num_nodes) + 63) / 64)
+{
+}
+
+HnswMappedLinks::~HnswMappedLinks() = default;
+
+void
+HnswMappedLinks::set_mapped(uint32_t nodeid, bool mapped) noexcept
+{
+    auto& word = _mapped_nodes[nodeid / 64];
+    uint64_t bit = uint64_t(1) << (nodeid % 64);
+    uint64_t old_value = word.load(std::memory_order_relaxed);
+    word.store(mapped ? (old_value | bit) : (old_value & ~bit), std::memory_order_release);
+}
+
+}
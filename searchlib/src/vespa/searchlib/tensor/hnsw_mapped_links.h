@@ -0,0 +1,85 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/util/arrayref.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class FastOS_FileInterface;
+
+namespace search::tensor {
+
+/**
+ * Read-only view of the link arrays in a saved hnsw graph that is
+ * memory mapped instead of being copied into the link array store.
+ *
+ * A saved graph written with link offsets has a trailer after the
+ * graph (and quantizer codebook) containing:
+ *   - the word offset (relative to start of data) of each link array,
+ *   - the index of the first link array for each node (num_nodes + 1 entries),
+ *   - docid and subspace for each node (only when nodeid != docid),
+ * followed by a fixed size footer locating the trailer.
+ *
+ * A per node flag tells whether the links of a node are still read from
+ * the mapped file, using the first link array of the node plus the level
+ * as index into the link offsets. The flag is cleared by the writer
+ * thread when the links of the node are moved to the link array store.
+ **/
+class HnswMappedLinks {
+public:
+    using LinkArrayRef = vespalib::ConstArrayRef<uint32_t>;
+    static constexpr uint32_t footer_magic = 0x4d4c4e4b; // "KNLM"
+    struct Footer {
+        uint64_t trailer_offset; // in words, relative to start of data
+        uint32_t num_link_arrays;
+        uint32_t magic;
+    };
+    static_assert(sizeof(Footer) == 16);
+private:
+    std::unique_ptr<FastOS_FileInterface> _file;
+    const uint32_t*                       _data;
+    const uint64_t*                       _link_offsets;
+    const uint32_t*                       _first_link_array;
+    uint64_t                              _trailer_offset;
+    uint32_t                              _num_link_arrays;
+    uint32_t                              _num_nodes;
+    std::vector<std::atomic<uint64_t>>    _mapped_nodes; // one bit per node
+
+    uint64_t link_array_limit(uint32_t link_array) const noexcept {
+        return (link_array + 1 < _num_link_arrays) ? _link_offsets[link_array + 1] : _trailer_offset;
+    }
+public:
+    /**
+     * The link offsets and first link array offsets must have been validated
+     * to be monotonic and within the trailer offset.
+     */
+    HnswMappedLinks(std::unique_ptr<FastOS_FileInterface> file, const uint32_t* data,
+                    const uint64_t* link_offsets, const uint32_t* first_link_array,
+                    uint64_t trailer_offset, uint32_t num_link_arrays, uint32_t num_nodes);
+    ~HnswMappedLinks();
+    bool is_mapped(uint32_t nodeid) const noexcept {
+        if (nodeid >= _num_nodes) {
+            return false;
+        }
+        return ((_mapped_nodes[nodeid / 64].load(std::memory_order_acquire) >> (nodeid % 64)) & 1) != 0;
+    }
+    // Called by writer thread only.
+    void set_mapped(uint32_t nodeid, bool mapped) noexcept;
+    // Only valid when is_mapped(nodeid) returns true, and level is less than the number of levels for the node.
+    LinkArrayRef get(uint32_t nodeid, uint32_t level) const noexcept {
+        uint32_t link_array = _first_link_array[nodeid] + level;
+        uint64_t offset = _link_offsets[link_array];
+        const uint32_t* links = _data + offset;
+        // A corrupt link count cannot make the array extend past the next link array.
+        uint64_t max_links = link_array_limit(link_array) - offset - 1;
+        return {links + 1, size_t(std::min(uint64_t(links[0]), max_links))};
+    }
+    uint32_t num_link_arrays() const noexcept { return _num_link_arrays; }
+    uint32_t num_nodes() const noexcept { return _num_nodes; }
+};
+
+}
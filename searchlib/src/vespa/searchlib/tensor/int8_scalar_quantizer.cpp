@@ -0,0 +1,129 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "int8_scalar_quantizer.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace search::tensor {
+
+namespace {
+
+constexpr float min_code = std::numeric_limits<int8_t>::min();
+constexpr float max_code = std::numeric_limits<int8_t>::max();
+constexpr float code_range = max_code - min_code;
+
+}
+
+/**
+ * The approximate value for dimension d is zero_value(d) + step(d) * code[d].
+ * The query weights are precomputed so that the dot product is a weighted sum
+ * of the codes.
+ */
+class Int8ScalarQuantizer::PreparedQuery : public VectorQuantizer::QueryProducts {
+    const Int8ScalarQuantizer& _quantizer;
+    std::vector<float>         _weights;
+    double                     _zero_dot_product;
+public:
+    PreparedQuery(const Int8ScalarQuantizer& quantizer, vespalib::ConstArrayRef<float> query)
+        : _quantizer(quantizer),
+          _weights(quantizer.dims()),
+          _zero_dot_product(0.0)
+    {
+        for (uint32_t dim = 0; dim < _weights.size(); ++dim) {
+            _weights[dim] = query[dim] * quantizer.step(dim);
+            _zero_dot_product += double(query[dim]) * quantizer.zero_value(dim);
+        }
+    }
+    ~PreparedQuery() override;
+    Products calc(vespalib::ConstArrayRef<uint8_t> code) const noexcept override {
+        float weighted_codes = 0.0f;
+        float norm_sq = 0.0f;
+        for (uint32_t dim = 0; dim < _weights.size(); ++dim) {
+            float c = code_value(code[dim]);
+            weighted_codes += _weights[dim] * c;
+            float value = _quantizer.zero_value(dim) + _quantizer.step(dim) * c;
+            norm_sq += value * value;
+        }
+        return {_zero_dot_product + weighted_codes, norm_sq};
+    }
+};
+
+Int8ScalarQuantizer::PreparedQuery::~PreparedQuery() = default;
+
+Int8ScalarQuantizer::Int8ScalarQuantizer(uint32_t dims)
+    : VectorQuantizer(),
+      _dims(dims),
+      _codebook(2 * dims, 0.0f)
+{
+    // Untrained quantizer maps [-1, 1] to the code range.
+    for (uint32_t dim = 0; dim < _dims; ++dim) {
+        _codebook[_dims + dim] = 2.0f / code_range;
+        _codebook[dim] = -1.0f - min_code * _codebook[_dims + dim];
+    }
+}
+
+Int8ScalarQuantizer::~Int8ScalarQuantizer() = default;
+
+void
+Int8ScalarQuantizer::train(vespalib::ConstArrayRef<float> samples, uint32_t num_samples)
+{
+    assert(samples.size() >= size_t(num_samples) * _dims);
+    if (num_samples == 0) {
+        return;
+    }
+    std::vector<float> lo(_dims, std::numeric_limits<float>::max());
+    std::vector<float> hi(_dims, std::numeric_limits<float>::lowest());
+    for (uint32_t i = 0; i < num_samples; ++i) {
+        const float* sample = samples.data() + size_t(i) * _dims;
+        for (uint32_t dim = 0; dim < _dims; ++dim) {
+            lo[dim] = std::min(lo[dim], sample[dim]);
+            hi[dim] = std::max(hi[dim], sample[dim]);
+        }
+    }
+    for (uint32_t dim = 0; dim < _dims; ++dim) {
+        float range = hi[dim] - lo[dim];
+        float step = (range > 0.0f) ? (range / code_range) : 1.0f;
+        _codebook[dim] = lo[dim] - min_code * step;
+        _codebook[_dims + dim] = step;
+    }
+}
+
+void
+Int8ScalarQuantizer::encode(vespalib::ConstArrayRef<float> vector, vespalib::ArrayRef<uint8_t> code) const
+{
+    assert(vector.size() == _dims && code.size() == _dims);
+    for (uint32_t dim = 0; dim < _dims; ++dim) {
+        float scaled = std::round((vector[dim] - zero_value(dim)) / step(dim));
+        code[dim] = static_cast<uint8_t>(static_cast<int8_t>(std::clamp(scaled, min_code, max_code)));
+    }
+}
+
+void
+Int8ScalarQuantizer::decode(vespalib::ConstArrayRef<uint8_t> code, vespalib::ArrayRef<float> vector) const
+{
+    assert(vector.size() == _dims && code.size() == _dims);
+    for (uint32_t dim = 0; dim < _dims; ++dim) {
+        vector[dim] = zero_value(dim) + code_value(code[dim]) * step(dim);
+    }
+}
+
+std::unique_ptr<VectorQuantizer::QueryProducts>
+Int8ScalarQuantizer::prepare_query(vespalib::ConstArrayRef<float> query) const
+{
+    assert(query.size() == _dims);
+    return std::make_unique<PreparedQuery>(*this, query);
+}
+
+bool
+Int8ScalarQuantizer::set_codebook(std::vector<float> codebook)
+{
+    if (codebook.size() != _codebook.size()) {
+        return false;
+    }
+    _codebook = std::move(codebook);
+    return true;
+}
+
+}
@@ -0,0 +1,38 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "vector_quantizer.h"
+
+namespace search::tensor {
+
+/**
+ * Scalar quantizer that maps each vector cell to a signed byte (int8)
+ * using a per dimension range [min, max] learned from the training samples.
+ *
+ * The codebook contains the value represented by code 0 for all dimensions
+ * followed by the step size for all dimensions.
+ */
+class Int8ScalarQuantizer : public VectorQuantizer {
+    uint32_t           _dims;
+    std::vector<float> _codebook;
+
+    float zero_value(uint32_t dim) const noexcept { return _codebook[dim]; }
+    float step(uint32_t dim) const noexcept { return _codebook[_dims + dim]; }
+    static int8_t code_value(uint8_t code) noexcept { return static_cast<int8_t>(code); }
+public:
+    class PreparedQuery;
+    explicit Int8ScalarQuantizer(uint32_t dims);
+    ~Int8ScalarQuantizer() override;
+    VectorQuantizationType type() const noexcept override { return VectorQuantizationType::Int8; }
+    uint32_t dims() const noexcept override { return _dims; }
+    uint32_t code_size() const noexcept override { return _dims; }
+    void train(vespalib::ConstArrayRef<float> samples, uint32_t num_samples) override;
+    void encode(vespalib::ConstArrayRef<float> vector, vespalib::ArrayRef<uint8_t> code) const override;
+    void decode(vespalib::ConstArrayRef<uint8_t> code, vespalib::ArrayRef<float> vector) const override;
+    std::unique_ptr<QueryProducts> prepare_query(vespalib::ConstArrayRef<float> query) const override;
+    const std::vector<float>& get_codebook() const noexcept override { return _codebook; }
+    bool set_codebook(std::vector<float> codebook) override;
+};
+
+}
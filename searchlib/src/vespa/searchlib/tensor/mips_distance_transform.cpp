@@ -23,6 +23,7 @@ class BoundMipsDistanceFunction : public BoundDistanceFunction {
     static const double *cast(const double * p) { return p; }
     static const float *cast(const float * p) { return p; }
     static const int8_t *cast(const Int8Float * p) { return reinterpret_cast<const int8_t *>(p); }
+    static const vespalib::BFloat16 *cast(const vespalib::BFloat16 * p) { return p; }
 public:
     BoundMipsDistanceFunction(const vespalib::eval::TypedCells& lhs, MaximumSquaredNormStore& sq_norm_store)
         : BoundDistanceFunction(),
@@ -44,13 +45,12 @@ public:
         return _lhs_extra_dim;
     }
 
-    double calc(const vespalib::eval::TypedCells &rhs) const override {
-        vespalib::ConstArrayRef<FloatType> rhs_vector = _tmpSpace.convertRhs(rhs);
+    template <typename RhsType>
+    double calc(const RhsType * b, size_t sz) const noexcept {
         const FloatType * a = _lhs_vector.data();
-        const FloatType * b = rhs_vector.data();
-        double dp = _computer.dotProduct(cast(a), cast(b), rhs.size);
+        double dp = _computer.dotProduct(cast(a), cast(b), sz);
         if constexpr (extra_dim) {
-            double rhs_sq_norm = _computer.dotProduct(cast(b), cast(b), rhs.size);
+            double rhs_sq_norm = _computer.dotProduct(cast(b), cast(b), sz);
 	    // avoid sqrt(negative) for robustness:
             double diff = std::max(0.0, _max_sq_norm - rhs_sq_norm);
             double rhs_extra_dim = std::sqrt(diff);
@@ -58,6 +58,16 @@ public:
         }
         return -dp;
     }
+
+    double calc(const vespalib::eval::TypedCells &rhs) const override {
+        if constexpr (std::is_same<FloatType, float>::value) {
+            if (rhs.type == vespalib::eval::CellType::BFLOAT16) {
+                return calc(rhs.unsafe_typify<vespalib::BFloat16>().data(), rhs.size);
+            }
+        }
+        vespalib::ConstArrayRef<FloatType> rhs_vector = _tmpSpace.convertRhs(rhs);
+        return calc(rhs_vector.data(), rhs.size);
+    }
     double convert_threshold(double threshold) const override {
         return threshold;
     }
@@ -73,6 +83,18 @@ public:
     double calc_with_limit(const vespalib::eval::TypedCells& rhs, double) const override {
         return calc(rhs);
     }
+    vespalib::eval::TypedCells bound_vector() const override {
+        return vespalib::eval::TypedCells(_lhs_vector);
+    }
+    double calc_from_products(double dot_product, double rhs_norm_sq) const override {
+        if constexpr (extra_dim) {
+            double diff = std::max(0.0, _max_sq_norm - rhs_norm_sq);
+            dot_product += _lhs_extra_dim * std::sqrt(diff);
+        } else {
+            (void) rhs_norm_sq;
+        }
+        return -dot_product;
+    }
 };
 
 template<typename FloatType>
@@ -29,6 +29,13 @@ public:
     }
     double calc(const vespalib::eval::TypedCells& rhs) const override {
         size_t sz = _lhs.size();
+        if constexpr (std::is_same<FloatType, float>::value) {
+            if (rhs.type == vespalib::eval::CellType::BFLOAT16) {
+                assert(sz == rhs.size);
+                double dot_product = _computer.dotProduct(_lhs.data(), rhs.unsafe_typify<vespalib::BFloat16>().data(), sz);
+                return _lhs_norm_sq - dot_product;
+            }
+        }
         vespalib::ConstArrayRef<FloatType> rhs_vector = _tmpSpace.convertRhs(rhs);
         assert(sz == rhs_vector.size());
         auto a = _lhs.data();
@@ -56,6 +63,12 @@ public:
     double calc_with_limit(const vespalib::eval::TypedCells& rhs, double) const override {
         return calc(rhs);
     }
+    vespalib::eval::TypedCells bound_vector() const override {
+        return vespalib::eval::TypedCells(_lhs);
+    }
+    double calc_from_products(double dot_product, double) const override {
+        return _lhs_norm_sq - dot_product;
+    }
 };
 
 template class BoundPrenormalizedAngularDistance<float>;
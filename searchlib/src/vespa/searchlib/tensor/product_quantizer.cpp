@@ -0,0 +1,198 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "product_quantizer.h"
+#include <cassert>
+#include <cstring>
+#include <limits>
+
+namespace search::tensor {
+
+namespace {
+
+float
+squared_distance(const float* a, const float* b, uint32_t sz) noexcept
+{
+    float sum = 0.0f;
+    for (uint32_t i = 0; i < sz; ++i) {
+        float diff = a[i] - b[i];
+        sum += diff * diff;
+    }
+    return sum;
+}
+
+float
+dot_product(const float* a, const float* b, uint32_t sz) noexcept
+{
+    float sum = 0.0f;
+    for (uint32_t i = 0; i < sz; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+}
+
+class ProductQuantizer::PreparedQuery : public VectorQuantizer::QueryProducts {
+    const ProductQuantizer& _quantizer;
+    std::vector<float>      _dot_products; // indexed by sub * num_centroids + c
+public:
+    PreparedQuery(const ProductQuantizer& quantizer, vespalib::ConstArrayRef<float> query)
+        : _quantizer(quantizer),
+          _dot_products(size_t(quantizer._subvectors) * num_centroids)
+    {
+        for (uint32_t sub = 0; sub < quantizer._subvectors; ++sub) {
+            const float* sub_query = query.data() + quantizer._offsets[sub];
+            float* dst = _dot_products.data() + size_t(sub) * num_centroids;
+            for (uint32_t c = 0; c < num_centroids; ++c) {
+                dst[c] = dot_product(sub_query, quantizer.centroid(sub, c), quantizer.sub_dims(sub));
+            }
+        }
+    }
+    ~PreparedQuery() override;
+    Products calc(vespalib::ConstArrayRef<uint8_t> code) const noexcept override {
+        const float* dot_products = _dot_products.data();
+        const float* norms = _quantizer._centroid_norms.data();
+        double dot_sum = 0.0;
+        double norm_sum = 0.0;
+        for (size_t sub = 0; sub < code.size(); ++sub) {
+            size_t idx = sub * num_centroids + code[sub];
+            dot_sum += dot_products[idx];
+            norm_sum += norms[idx];
+        }
+        return {dot_sum, norm_sum};
+    }
+};
+
+ProductQuantizer::PreparedQuery::~PreparedQuery() = default;
+
+ProductQuantizer::ProductQuantizer(uint32_t dims, uint32_t subvectors)
+    : VectorQuantizer(),
+      _dims(dims),
+      _subvectors(subvectors),
+      _offsets(),
+      _codebook(size_t(dims) * num_centroids, 0.0f),
+      _centroid_norms(size_t(subvectors) * num_centroids, 0.0f)
+{
+    assert(subvectors > 0 && subvectors <= dims);
+    _offsets.reserve(_subvectors + 1);
+    for (uint32_t sub = 0; sub <= _subvectors; ++sub) {
+        _offsets.push_back(uint64_t(sub) * _dims / _subvectors);
+    }
+}
+
+ProductQuantizer::~ProductQuantizer() = default;
+
+uint32_t
+ProductQuantizer::nearest_centroid(uint32_t sub, const float* sub_vector) const noexcept
+{
+    uint32_t sz = sub_dims(sub);
+    uint32_t best = 0;
+    float best_dist = std::numeric_limits<float>::max();
+    for (uint32_t c = 0; c < num_centroids; ++c) {
+        float dist = squared_distance(sub_vector, centroid(sub, c), sz);
+        if (dist < best_dist) {
+            best_dist = dist;
+            best = c;
+        }
+    }
+    return best;
+}
+
+void
+ProductQuantizer::train_sub_vector(uint32_t sub, vespalib::ConstArrayRef<float> samples, uint32_t num_samples)
+{
+    uint32_t offset = _offsets[sub];
+    uint32_t sz = sub_dims(sub);
+    // Initial centroids are picked evenly spread among the samples.
+    for (uint32_t c = 0; c < num_centroids; ++c) {
+        size_t sample = (size_t(c) * num_samples) / num_centroids;
+        memcpy(centroid(sub, c), samples.data() + sample * _dims + offset, sz * sizeof(float));
+    }
+    std::vector<double> sums(size_t(num_centroids) * sz);
+    std::vector<uint32_t> counts(num_centroids);
+    for (uint32_t iter = 0; iter < max_training_iterations; ++iter) {
+        std::fill(sums.begin(), sums.end(), 0.0);
+        std::fill(counts.begin(), counts.end(), 0u);
+        for (uint32_t i = 0; i < num_samples; ++i) {
+            const float* sub_vector = samples.data() + size_t(i) * _dims + offset;
+            uint32_t c = nearest_centroid(sub, sub_vector);
+            double* sum = sums.data() + size_t(c) * sz;
+            for (uint32_t d = 0; d < sz; ++d) {
+                sum[d] += sub_vector[d];
+            }
+            ++counts[c];
+        }
+        for (uint32_t c = 0; c < num_centroids; ++c) {
+            if (counts[c] == 0) {
+                continue; // keep old centroid
+            }
+            float* dst = centroid(sub, c);
+            const double* sum = sums.data() + size_t(c) * sz;
+            for (uint32_t d = 0; d < sz; ++d) {
+                dst[d] = sum[d] / counts[c];
+            }
+        }
+    }
+}
+
+void
+ProductQuantizer::train(vespalib::ConstArrayRef<float> samples, uint32_t num_samples)
+{
+    assert(samples.size() >= size_t(num_samples) * _dims);
+    if (num_samples == 0) {
+        return;
+    }
+    for (uint32_t sub = 0; sub < _subvectors; ++sub) {
+        train_sub_vector(sub, samples, num_samples);
+    }
+    calc_centroid_norms();
+}
+
+void
+ProductQuantizer::calc_centroid_norms()
+{
+    for (uint32_t sub = 0; sub < _subvectors; ++sub) {
+        for (uint32_t c = 0; c < num_centroids; ++c) {
+            const float* values = centroid(sub, c);
+            _centroid_norms[size_t(sub) * num_centroids + c] = dot_product(values, values, sub_dims(sub));
+        }
+    }
+}
+
+void
+ProductQuantizer::encode(vespalib::ConstArrayRef<float> vector, vespalib::ArrayRef<uint8_t> code) const
+{
+    assert(vector.size() == _dims && code.size() == _subvectors);
+    for (uint32_t sub = 0; sub < _subvectors; ++sub) {
+        code[sub] = nearest_centroid(sub, vector.data() + _offsets[sub]);
+    }
+}
+
+void
+ProductQuantizer::decode(vespalib::ConstArrayRef<uint8_t> code, vespalib::ArrayRef<float> vector) const
+{
+    assert(vector.size() == _dims && code.size() == _subvectors);
+    for (uint32_t sub = 0; sub < _subvectors; ++sub) {
+        memcpy(vector.data() + _offsets[sub], centroid(sub, code[sub]), sub_dims(sub) * sizeof(float));
+    }
+}
+
+std::unique_ptr<VectorQuantizer::QueryProducts>
+ProductQuantizer::prepare_query(vespalib::ConstArrayRef<float> query) const
+{
+    assert(query.size() == _dims);
+    return std::make_unique<PreparedQuery>(*this, query);
+}
+
+bool
+ProductQuantizer::set_codebook(std::vector<float> codebook)
+{
+    if (codebook.size() != _codebook.size()) {
+        return false;
+    }
+    _codebook = std::move(codebook);
+    calc_centroid_norms();
+    return true;
+}
+
+}
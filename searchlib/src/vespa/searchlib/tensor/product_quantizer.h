@@ -0,0 +1,59 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "vector_quantizer.h"
+
+namespace search::tensor {
+
+/**
+ * Product quantizer that splits a vector into a number of sub-vectors and
+ * represents each sub-vector with the index (one byte) of the nearest
+ * centroid in a per sub-vector codebook with 256 centroids.
+ *
+ * The centroids are trained using k-means on the training samples.
+ * The codebook contains, for each sub-vector in order, 256 centroids
+ * of the sub-vector length stored back to back.
+ *
+ * Distances to a query vector are calculated using asymmetric distance
+ * computation: a per query table with the dot product between each query
+ * sub-vector and each centroid is combined with the (query independent)
+ * squared norms of the centroids by table lookups per code byte.
+ */
+class ProductQuantizer : public VectorQuantizer {
+public:
+    static constexpr uint32_t num_centroids = 256;
+    static constexpr uint32_t max_training_iterations = 6;
+private:
+    uint32_t              _dims;
+    uint32_t              _subvectors;
+    std::vector<uint32_t> _offsets; // start dimension of each sub-vector, plus sentinel
+    std::vector<float>    _codebook;
+    std::vector<float>    _centroid_norms; // squared norm of each centroid, indexed by sub * num_centroids + c
+
+    uint32_t sub_dims(uint32_t sub) const noexcept { return _offsets[sub + 1] - _offsets[sub]; }
+    const float* centroid(uint32_t sub, uint32_t c) const noexcept {
+        return _codebook.data() + size_t(_offsets[sub]) * num_centroids + size_t(c) * sub_dims(sub);
+    }
+    float* centroid(uint32_t sub, uint32_t c) noexcept {
+        return _codebook.data() + size_t(_offsets[sub]) * num_centroids + size_t(c) * sub_dims(sub);
+    }
+    uint32_t nearest_centroid(uint32_t sub, const float* sub_vector) const noexcept;
+    void train_sub_vector(uint32_t sub, vespalib::ConstArrayRef<float> samples, uint32_t num_samples);
+    void calc_centroid_norms();
+public:
+    class PreparedQuery;
+    ProductQuantizer(uint32_t dims, uint32_t subvectors);
+    ~ProductQuantizer() override;
+    VectorQuantizationType type() const noexcept override { return VectorQuantizationType::Product; }
+    uint32_t dims() const noexcept override { return _dims; }
+    uint32_t code_size() const noexcept override { return _subvectors; }
+    void train(vespalib::ConstArrayRef<float> samples, uint32_t num_samples) override;
+    void encode(vespalib::ConstArrayRef<float> vector, vespalib::ArrayRef<uint8_t> code) const override;
+    void decode(vespalib::ConstArrayRef<uint8_t> code, vespalib::ArrayRef<float> vector) const override;
+    std::unique_ptr<QueryProducts> prepare_query(vespalib::ConstArrayRef<float> query) const override;
+    const std::vector<float>& get_codebook() const noexcept override { return _codebook; }
+    bool set_codebook(std::vector<float> codebook) override;
+};
+
+}
@@ -0,0 +1,141 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "quantized_vector_store.h"
+#include <vespa/vespalib/util/typify.h>
+#include <cassert>
+
+using vespalib::ArrayRef;
+using vespalib::ConstArrayRef;
+using vespalib::eval::TypedCells;
+
+namespace search::tensor {
+
+namespace {
+
+struct ConvertToFloat {
+    template <typename FromType> static ConstArrayRef<float> invoke(TypedCells cells, std::vector<float>& buffer) {
+        auto src = cells.unsafe_typify<FromType>();
+        buffer.resize(src.size());
+        for (size_t i = 0; i < src.size(); ++i) {
+            buffer[i] = float(src[i]);
+        }
+        return buffer;
+    }
+};
+
+}
+
+QuantizedVectorStore::QuantizedVectorStore()
+    : _quantizer(),
+      _ready(false),
+      _code_size(0),
+      _codes(),
+      _nodeid_limit(0),
+      _encode_buffer()
+{
+}
+
+QuantizedVectorStore::~QuantizedVectorStore() = default;
+
+void
+QuantizedVectorStore::set_quantizer(VectorQuantizer::UP quantizer)
+{
+    assert(!ready());
+    _quantizer = std::move(quantizer);
+    _code_size = _quantizer ? _quantizer->code_size() : 0;
+    _codes.reset();
+    _nodeid_limit.store(0, std::memory_order_release);
+}
+
+void
+QuantizedVectorStore::encode(uint32_t nodeid, TypedCells cells)
+{
+    assert(_quantizer);
+    // A node left without a code would still be below the nodeid limit, and traversed using garbage.
+    assert(cells.size == _quantizer->dims());
+    size_t code_end = (size_t(nodeid) + 1) * _code_size;
+    if (_codes.size() < code_end) {
+        _codes.ensure_size(code_end);
+    }
+    auto vector = to_float(cells, _encode_buffer);
+    ArrayRef<uint8_t> code(&_codes[size_t(nodeid) * _code_size], _code_size);
+    _quantizer->encode(vector, code);
+    if (nodeid >= _nodeid_limit.load(std::memory_order_relaxed)) {
+        _nodeid_limit.store(nodeid + 1, std::memory_order_release);
+    }
+}
+
+void
+QuantizedVectorStore::assign_generation(generation_t current_gen)
+{
+    // Note: RcuVector transfers hold lists as part of reallocation based on current generation.
+    //       We need to set the next generation here, as it is incremented on a higher level right after this call.
+    _codes.setGeneration(current_gen + 1);
+}
+
+void
+QuantizedVectorStore::reclaim_memory(generation_t oldest_used_gen)
+{
+    _codes.reclaim_memory(oldest_used_gen);
+}
+
+vespalib::MemoryUsage
+QuantizedVectorStore::memory_usage() const
+{
+    auto result = _codes.getMemoryUsage();
+    if (_quantizer) {
+        size_t codebook_bytes = _quantizer->get_codebook().size() * sizeof(float);
+        result.incAllocatedBytes(codebook_bytes);
+        result.incUsedBytes(codebook_bytes);
+    }
+    return result;
+}
+
+ConstArrayRef<float>
+QuantizedVectorStore::to_float(TypedCells cells, std::vector<float>& buffer)
+{
+    if (cells.type == vespalib::eval::CellType::FLOAT) {
+        return cells.unsafe_typify<float>();
+    }
+    using MyTypify = vespalib::eval::TypifyCellType;
+    return vespalib::typify_invoke<1,MyTypify,ConvertToFloat>(cells.type, cells, buffer);
+}
+
+QuantizedVectorReader::QuantizedVectorReader(const QuantizedVectorStore& store, const BoundDistanceFunction& df)
+    : _store(store),
+      _quantizer(*store.quantizer()),
+      _df(df),
+      _nodeid_limit(store.acquire_nodeid_limit()),
+      _query(),
+      _decoded()
+{
+    auto query_cells = df.bound_vector();
+    if (query_cells.size == _quantizer.dims()) {
+        _query = _quantizer.prepare_query(QuantizedVectorStore::to_float(query_cells, _decoded));
+    }
+    _decoded.resize(_quantizer.dims());
+}
+
+QuantizedVectorReader::~QuantizedVectorReader() = default;
+
+double
+QuantizedVectorReader::calc_distance(uint32_t nodeid)
+{
+    if (_query) {
+        auto products = _query->calc(_store.acquire_code(nodeid));
+        return _df.calc_from_products(products.dot_product, products.norm_sq);
+    }
+    return _df.calc(decode(nodeid));
+}
+
+TypedCells
+QuantizedVectorReader::decode(uint32_t nodeid)
+{
+    if (nodeid >= _nodeid_limit) {
+        return {};
+    }
+    _quantizer.decode(_store.acquire_code(nodeid), _decoded);
+    return TypedCells(ConstArrayRef<float>(_decoded));
+}
+
+}
@@ -0,0 +1,88 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "bound_distance_function.h"
+#include "vector_quantizer.h"
+#include <vespa/eval/eval/typed_cells.h>
+#include <vespa/vespalib/util/generationhandler.h>
+#include <vespa/vespalib/util/memoryusage.h>
+#include <vespa/vespalib/util/rcuvector.h>
+#include <atomic>
+
+namespace search::tensor {
+
+/**
+ * Storage of quantized vector codes for the nodes in a hnsw graph, indexed by nodeid.
+ * The codes are kept in addition to the original vectors, which are still needed when
+ * adding nodes and rescoring, so memory usage grows by code_size bytes per node.
+ *
+ * The store is populated by the single writer thread. The quantizer is
+ * installed and all existing nodes encoded before the store is published as
+ * ready, after which the quantizer (codebook) never changes. Readers holding a
+ * generation guard can decode codes without locking. A code for a nodeid that
+ * is being rewritten might be observed in a partially updated state, which only
+ * affects the approximate traversal distance and not the rescored result.
+ */
+class QuantizedVectorStore {
+    using generation_t = vespalib::GenerationHandler::generation_t;
+
+    VectorQuantizer::UP             _quantizer;
+    std::atomic<bool>               _ready;
+    uint32_t                        _code_size;
+    vespalib::RcuVector<uint8_t>    _codes;
+    std::atomic<uint32_t>           _nodeid_limit;
+    std::vector<float>              _encode_buffer;
+
+public:
+    QuantizedVectorStore();
+    ~QuantizedVectorStore();
+
+    // Called by writer before publish() only.
+    void set_quantizer(VectorQuantizer::UP quantizer);
+    void encode(uint32_t nodeid, vespalib::eval::TypedCells cells);
+    void publish() { _ready.store(true, std::memory_order_release); }
+
+    bool ready() const noexcept { return _ready.load(std::memory_order_acquire); }
+    // Only valid when ready() returns true, or from the writer thread.
+    const VectorQuantizer* quantizer() const noexcept { return _quantizer.get(); }
+    uint32_t code_size() const noexcept { return _code_size; }
+    uint32_t acquire_nodeid_limit() const noexcept { return _nodeid_limit.load(std::memory_order_acquire); }
+    vespalib::ConstArrayRef<uint8_t> acquire_code(uint32_t nodeid) const noexcept {
+        return {&_codes.acquire_elem_ref(size_t(nodeid) * _code_size), _code_size};
+    }
+
+    void assign_generation(generation_t current_gen);
+    void reclaim_memory(generation_t oldest_used_gen);
+    vespalib::MemoryUsage memory_usage() const;
+
+    // Converts the given vector cells to float, using the given buffer as temporary storage.
+    static vespalib::ConstArrayRef<float> to_float(vespalib::eval::TypedCells cells, std::vector<float>& buffer);
+};
+
+/**
+ * Calculates approximate distances between a query vector and the quantized
+ * vectors in a ready QuantizedVectorStore during a single query. Distances are
+ * calculated directly on the codes when the distance function supports it (see
+ * BoundDistanceFunction::calc_from_products()), otherwise the codes are decoded.
+ * Not thread safe.
+ */
+class QuantizedVectorReader {
+    const QuantizedVectorStore&                     _store;
+    const VectorQuantizer&                          _quantizer;
+    const BoundDistanceFunction&                    _df;
+    uint32_t                                        _nodeid_limit;
+    std::unique_ptr<VectorQuantizer::QueryProducts> _query;
+    std::vector<float>                              _decoded;
+public:
+    QuantizedVectorReader(const QuantizedVectorStore& store, const BoundDistanceFunction& df);
+    ~QuantizedVectorReader();
+    // Returns false if no code is available for the node (e.g. added after this reader was created).
+    bool has_code(uint32_t nodeid) const noexcept { return nodeid < _nodeid_limit; }
+    // Returns the approximate distance to the given node. Only valid when has_code() returns true.
+    double calc_distance(uint32_t nodeid);
+    // Returns the approximate vector for the given node, or empty cells if no code is available for the node.
+    vespalib::eval::TypedCells decode(uint32_t nodeid);
+};
+
+}
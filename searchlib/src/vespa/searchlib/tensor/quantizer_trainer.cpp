@@ -0,0 +1,77 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "quantizer_trainer.h"
+#include <vespa/vespalib/util/cpu_usage.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
+#include <cassert>
+
+using vespalib::CpuUsage;
+
+namespace search::tensor {
+
+namespace {
+
+VESPA_THREAD_STACK_TAG(hnsw_quantizer_trainer);
+
+}
+
+QuantizerTrainer::QuantizerTrainer()
+    : _quantizer(),
+      _samples(),
+      _num_samples(0),
+      _done(false),
+      _active(false),
+      _executor()
+{
+}
+
+QuantizerTrainer::~QuantizerTrainer()
+{
+    // Waits for an ongoing training task before the state it uses is destroyed.
+    _executor.reset();
+}
+
+void
+QuantizerTrainer::train()
+{
+    _quantizer->train(_samples, _num_samples);
+    _done.store(true, std::memory_order_release);
+}
+
+void
+QuantizerTrainer::start(VectorQuantizer::UP quantizer, std::vector<float> samples, uint32_t num_samples)
+{
+    assert(!_active);
+    _quantizer = std::move(quantizer);
+    _samples = std::move(samples);
+    _num_samples = num_samples;
+    _done.store(false, std::memory_order_relaxed);
+    _active = true;
+    if (!_executor) {
+        _executor = std::make_unique<vespalib::ThreadStackExecutor>(1, CpuUsage::wrap(hnsw_quantizer_trainer, CpuUsage::Category::WRITE));
+    }
+    auto rejected = _executor->execute(vespalib::makeLambdaTask([this]() { train(); }));
+    assert(!rejected);
+}
+
+VectorQuantizer::UP
+QuantizerTrainer::take_trained()
+{
+    if (!_active || !_done.load(std::memory_order_acquire)) {
+        return {};
+    }
+    _active = false;
+    std::vector<float>().swap(_samples);
+    return std::move(_quantizer);
+}
+
+void
+QuantizerTrainer::sync()
+{
+    if (_executor) {
+        _executor->sync();
+    }
+}
+
+}
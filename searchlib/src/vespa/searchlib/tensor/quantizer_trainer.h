@@ -0,0 +1,43 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "vector_quantizer.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace vespalib { class ThreadStackExecutor; }
+
+namespace search::tensor {
+
+/**
+ * Trains a vector quantizer on a copy of the training samples using a
+ * background thread, so that training (e.g. k-means for product quantization)
+ * does not block the writer thread.
+ *
+ * All functions are called by the writer thread. The thread is created when
+ * training is first started.
+ */
+class QuantizerTrainer {
+    VectorQuantizer::UP                             _quantizer;
+    std::vector<float>                              _samples;
+    uint32_t                                        _num_samples;
+    std::atomic<bool>                               _done;
+    bool                                            _active;
+    std::unique_ptr<vespalib::ThreadStackExecutor>  _executor;
+
+    void train();
+public:
+    QuantizerTrainer();
+    ~QuantizerTrainer();
+    // Returns true if training has been started, and the trained quantizer not yet taken.
+    bool active() const noexcept { return _active; }
+    void start(VectorQuantizer::UP quantizer, std::vector<float> samples, uint32_t num_samples);
+    // Returns the trained quantizer if training is done, otherwise nullptr.
+    VectorQuantizer::UP take_trained();
+    // Waits until ongoing training is done.
+    void sync();
+};
+
+}
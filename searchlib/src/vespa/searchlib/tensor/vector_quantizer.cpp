@@ -0,0 +1,58 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "vector_quantizer.h"
+#include "int8_scalar_quantizer.h"
+#include "product_quantizer.h"
+
+using search::attribute::VectorQuantizationParams;
+using search::attribute::VectorQuantizationType;
+
+namespace search::tensor {
+
+vespalib::string
+VectorQuantizer::type_to_string(VectorQuantizationType type)
+{
+    switch (type) {
+    case VectorQuantizationType::Int8:
+        return "int8";
+    case VectorQuantizationType::Product:
+        return "product";
+    default:
+        return "none";
+    }
+}
+
+VectorQuantizationType
+VectorQuantizer::type_from_string(const vespalib::string& name)
+{
+    if (name == "int8") {
+        return VectorQuantizationType::Int8;
+    } else if (name == "product") {
+        return VectorQuantizationType::Product;
+    }
+    return VectorQuantizationType::None;
+}
+
+VectorQuantizer::UP
+make_vector_quantizer(const VectorQuantizationParams& params, uint32_t dims)
+{
+    if (dims == 0) {
+        return {};
+    }
+    switch (params.type()) {
+    case VectorQuantizationType::Int8:
+        return std::make_unique<Int8ScalarQuantizer>(dims);
+    case VectorQuantizationType::Product:
+    {
+        uint32_t subvectors = params.subvectors();
+        if (subvectors == 0) {
+            subvectors = std::max(1u, dims / 4);
+        }
+        return std::make_unique<ProductQuantizer>(dims, std::min(subvectors, dims));
+    }
+    default:
+        return {};
+    }
+}
+
+}
@@ -0,0 +1,70 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/searchcommon/attribute/vector_quantization_params.h>
+#include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/util/arrayref.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace search::tensor {
+
+/**
+ * Interface for a lossy, compact (quantized) representation of vectors.
+ *
+ * A quantizer is trained once using a sample of the vectors, after which the
+ * codebook is immutable. Vectors are encoded into fixed size codes, and codes
+ * can be decoded to approximate vectors. The codebook can be extracted and
+ * restored to persist a trained quantizer.
+ *
+ * Distances to a query vector are calculated directly on the codes, using
+ * per query state (see QueryProducts) prepared once per query.
+ */
+class VectorQuantizer {
+public:
+    using UP = std::unique_ptr<VectorQuantizer>;
+    using VectorQuantizationType = search::attribute::VectorQuantizationType;
+
+    /**
+     * Calculates the dot product between a prepared query vector and the
+     * approximate vector represented by a code, and the squared norm of the
+     * approximate vector, without decoding the code.
+     */
+    class QueryProducts {
+    public:
+        struct Products {
+            double dot_product;
+            double norm_sq;
+        };
+        virtual ~QueryProducts() = default;
+        virtual Products calc(vespalib::ConstArrayRef<uint8_t> code) const noexcept = 0;
+    };
+
+    virtual ~VectorQuantizer() = default;
+    virtual VectorQuantizationType type() const noexcept = 0;
+    virtual uint32_t dims() const noexcept = 0;
+    // Number of bytes used to represent a single vector.
+    virtual uint32_t code_size() const noexcept = 0;
+    // Train the quantizer using num_samples vectors stored back to back in samples.
+    virtual void train(vespalib::ConstArrayRef<float> samples, uint32_t num_samples) = 0;
+    virtual void encode(vespalib::ConstArrayRef<float> vector, vespalib::ArrayRef<uint8_t> code) const = 0;
+    virtual void decode(vespalib::ConstArrayRef<uint8_t> code, vespalib::ArrayRef<float> vector) const = 0;
+    // The returned object refers to this quantizer, and must not outlive it.
+    virtual std::unique_ptr<QueryProducts> prepare_query(vespalib::ConstArrayRef<float> query) const = 0;
+    virtual const std::vector<float>& get_codebook() const noexcept = 0;
+    // Returns false if the codebook does not match the quantizer geometry.
+    virtual bool set_codebook(std::vector<float> codebook) = 0;
+
+    static vespalib::string type_to_string(VectorQuantizationType type);
+    static VectorQuantizationType type_from_string(const vespalib::string& name);
+};
+
+/**
+ * Creates an untrained quantizer of the given type for vectors with the given number of dimensions.
+ * Returns nullptr if quantization is not enabled.
+ */
+VectorQuantizer::UP make_vector_quantizer(const search::attribute::VectorQuantizationParams& params, uint32_t dims);
+
+}
@@ -0,0 +1,188 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "commit_scheduler.h"
+#include "domainpart.h"
+#include <vespa/vespalib/util/cpu_usage.h>
+#include <algorithm>
+#include <cassert>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".transactionlog.commit_scheduler");
+
+using vespalib::CpuUsage;
+
+namespace search::transactionlog {
+
+namespace {
+
+uint64_t
+to_nanos(vespalib::duration d) {
+    return std::max(vespalib::count_ns(d), int64_t(0));
+}
+
+}
+
+CommitLatencyHistogram::CommitLatencyHistogram()
+    : _buckets(),
+      _count(0),
+      _sumNanos(0),
+      _maxNanos(0)
+{ }
+
+CommitLatencyHistogram::~CommitLatencyHistogram() = default;
+
+void
+CommitLatencyHistogram::add(vespalib::duration latency)
+{
+    size_t bucket = 0;
+    while ((bucket + 1 < CommitLatencyStats::num_buckets) && (latency >= CommitLatencyStats::bucket_limit(bucket))) {
+        ++bucket;
+    }
+    uint64_t nanos = to_nanos(latency);
+    _buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    _sumNanos.fetch_add(nanos, std::memory_order_relaxed);
+    uint64_t max = _maxNanos.load(std::memory_order_relaxed);
+    while ((nanos > max) && !_maxNanos.compare_exchange_weak(max, nanos, std::memory_order_relaxed)) { }
+    _count.fetch_add(1, std::memory_order_release);
+}
+
+CommitLatencyStats
+CommitLatencyHistogram::getStats() const
+{
+    CommitLatencyStats stats;
+    stats.count = _count.load(std::memory_order_acquire);
+    for (size_t i = 0; i < stats.buckets.size(); ++i) {
+        stats.buckets[i] = _buckets[i].load(std::memory_order_relaxed);
+    }
+    stats.sumSeconds = _sumNanos.load(std::memory_order_relaxed) * 1e-9;
+    stats.maxSeconds = _maxNanos.load(std::memory_order_relaxed) * 1e-9;
+    return stats;
+}
+
+CommitScheduler::Pending::Pending(DomainPartSP part_in, SerializedChunk chunk_in,
+                                  CommitLatencyHistogram &latency_in, vespalib::steady_time start_in)
+    : part(std::move(part_in)),
+      chunk(std::move(chunk_in)),
+      latency(&latency_in),
+      start(start_in)
+{ }
+
+CommitScheduler::Pending::Pending(Pending &&) noexcept = default;
+CommitScheduler::Pending & CommitScheduler::Pending::operator=(Pending &&) noexcept = default;
+CommitScheduler::Pending::~Pending() = default;
+
+CommitScheduler::CommitScheduler(vespalib::duration maxLatency)
+    : _lock(),
+      _cond(),
+      _drainCond(),
+      _pending(),
+      _maxLatency(maxLatency),
+      _scheduled(0),
+      _completed(0),
+      _numSyncs(0),
+      _closed(false),
+      _thread()
+{ }
+
+CommitScheduler::~CommitScheduler()
+{
+    drain();
+    {
+        std::lock_guard guard(_lock);
+        _closed = true;
+    }
+    _cond.notify_all();
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+}
+
+void
+CommitScheduler::schedule(DomainPartSP part, SerializedChunk chunk, CommitLatencyHistogram &latency, vespalib::steady_time start)
+{
+    bool wasEmpty;
+    {
+        std::lock_guard guard(_lock);
+        assert(!_closed);
+        if (!_thread.joinable()) {
+            _thread = std::thread([this]() {
+                auto cpu_usage = CpuUsage::use(CpuUsage::Category::WRITE);
+                run();
+            });
+        }
+        wasEmpty = _pending.empty();
+        _pending.emplace_back(std::move(part), std::move(chunk), latency, start);
+        ++_scheduled;
+    }
+    if (wasEmpty) {
+        _cond.notify_all();
+    }
+}
+
+void
+CommitScheduler::drain()
+{
+    std::unique_lock guard(_lock);
+    uint64_t target = _scheduled;
+    _drainCond.wait(guard, [this, target]() { return _completed >= target; });
+}
+
+void
+CommitScheduler::setMaxLatency(vespalib::duration maxLatency)
+{
+    std::lock_guard guard(_lock);
+    _maxLatency = maxLatency;
+}
+
+vespalib::duration
+CommitScheduler::getMaxLatency() const
+{
+    std::lock_guard guard(_lock);
+    return _maxLatency;
+}
+
+void
+CommitScheduler::run()
+{
+    std::unique_lock guard(_lock);
+    while (true) {
+        _cond.wait(guard, [this]() { return _closed || !_pending.empty(); });
+        if (_pending.empty()) {
+            return;
+        }
+        // Let the window stay open so that commits from other domains can join the batch.
+        auto windowEnd = vespalib::steady_clock::now() + _maxLatency;
+        _cond.wait_until(guard, windowEnd, [this]() { return _closed; });
+        PendingList batch;
+        batch.swap(_pending);
+        guard.unlock();
+        size_t batchSize = batch.size();
+        syncBatch(std::move(batch));
+        guard.lock();
+        _completed += batchSize;
+        _drainCond.notify_all();
+    }
+}
+
+void
+CommitScheduler::syncBatch(PendingList batch)
+{
+    std::vector<DomainPart *> synced;
+    for (const auto & pending : batch) {
+        DomainPart * part = pending.part.get();
+        if (std::find(synced.begin(), synced.end(), part) == synced.end()) {
+            part->sync();
+            synced.push_back(part);
+        }
+    }
+    _numSyncs.fetch_add(synced.size(), std::memory_order_relaxed);
+    LOG(spam, "Synced %zu domain parts for %zu chunks.", synced.size(), batch.size());
+    auto now = vespalib::steady_clock::now();
+    for (auto & pending : batch) {
+        pending.latency->add(now - pending.start);
+    }
+    // Releasing the chunks acks the operations they contain, in the order they were committed.
+    batch.clear();
+}
+
+}
@@ -0,0 +1,90 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "domainconfig.h"
+#include "ichunk.h"
+#include <vespa/vespalib/util/time.h>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace search::transactionlog {
+
+class DomainPart;
+
+/**
+ * Thread safe histogram of commit latencies for a domain.
+ */
+class CommitLatencyHistogram {
+public:
+    CommitLatencyHistogram();
+    ~CommitLatencyHistogram();
+    void add(vespalib::duration latency);
+    CommitLatencyStats getStats() const;
+private:
+    std::array<std::atomic<uint64_t>, CommitLatencyStats::num_buckets> _buckets;
+    std::atomic<uint64_t> _count;
+    std::atomic<uint64_t> _sumNanos;
+    std::atomic<uint64_t> _maxNanos;
+};
+
+/**
+ * Coalesces fsync of committed chunks across all domains in a transaction log server.
+ *
+ * Chunks written by the domain committers are handed over here instead of being synced
+ * one by one. All chunks arriving within a window of maxLatency from the first pending
+ * chunk are grouped, each distinct domain part is synced once, and then the chunks are
+ * released in the order they arrived, which acks the feed operations they contain.
+ * Domains only hand over their chunks when the configured max latency is above zero.
+ * The sync thread is started when the first chunk is scheduled.
+ */
+class CommitScheduler {
+public:
+    using DomainPartSP = std::shared_ptr<DomainPart>;
+    explicit CommitScheduler(vespalib::duration maxLatency);
+    CommitScheduler(const CommitScheduler &) = delete;
+    CommitScheduler & operator=(const CommitScheduler &) = delete;
+    ~CommitScheduler();
+
+    /**
+     * Schedule sync of a chunk already written to the given domain part. The chunk is
+     * released when synced, and the latency since start is added to the histogram,
+     * which must be kept alive until drain() has returned.
+     */
+    void schedule(DomainPartSP part, SerializedChunk chunk, CommitLatencyHistogram &latency, vespalib::steady_time start);
+    // Wait until all chunks scheduled before this call have been synced and released.
+    void drain();
+    void setMaxLatency(vespalib::duration maxLatency);
+    vespalib::duration getMaxLatency() const;
+    uint64_t getNumSyncs() const { return _numSyncs.load(std::memory_order_relaxed); }
+private:
+    struct Pending {
+        DomainPartSP            part;
+        SerializedChunk         chunk;
+        CommitLatencyHistogram *latency;
+        vespalib::steady_time   start;
+        Pending(DomainPartSP part_in, SerializedChunk chunk_in, CommitLatencyHistogram &latency_in, vespalib::steady_time start_in);
+        Pending(Pending &&) noexcept;
+        Pending & operator=(Pending &&) noexcept;
+        ~Pending();
+    };
+    using PendingList = std::vector<Pending>;
+    void run();
+    void syncBatch(PendingList batch);
+
+    mutable std::mutex      _lock;
+    std::condition_variable _cond;
+    std::condition_variable _drainCond;
+    PendingList             _pending;
+    vespalib::duration      _maxLatency;
+    uint64_t                _scheduled;
+    uint64_t                _completed;
+    std::atomic<uint64_t>   _numSyncs;
+    bool                    _closed;
+    std::thread             _thread;
+};
+
+}
@@ -43,7 +43,8 @@ VESPA_THREAD_STACK_TAG(tls_domain_commit);
 }
 
 Domain::Domain(const string &domainName, const string & baseDir, vespalib::Executor & executor,
-               const DomainConfig & cfg, const FileHeaderContext &fileHeaderContext)
+               const DomainConfig & cfg, const FileHeaderContext &fileHeaderContext,
+               std::shared_ptr<CommitScheduler> commitScheduler)
     : _config(cfg),
       _currentChunk(createCommitChunk(cfg)),
       _lastSerial(0),
@@ -59,6 +60,8 @@ Domain::Domain(const string &domainName, const string & baseDir, vespalib::Execu
       _maxSessionRunTime(),
       _baseDir(baseDir),
       _fileHeaderContext(fileHeaderContext),
+      _commitScheduler(std::move(commitScheduler)),
+      _commitLatency(),
       _markedDeleted(false)
 {
     assert(_config.getEncoding().getCompression() != Encoding::Compression::none);
@@ -123,6 +126,9 @@ Domain::~Domain() {
     vespalib::Gate gate;
     _singleCommitter->execute(makeLambdaTask([callback=std::make_unique<vespalib::GateCallback>(gate)]() { (void) callback;}));
     gate.await();
+    if (_commitScheduler) {
+        _commitScheduler->drain();
+    }
 }
 
 DomainInfo
@@ -134,6 +140,7 @@ Domain::getDomainInfo() const
         const DomainPart &part = *entry.second;
         info.parts.emplace_back(PartInfo(part.range(), part.size(), part.byteSize(), part.fileName()));
     }
+    info.commitLatency = _commitLatency.getStats();
     return info;
 }
 
@@ -376,23 +383,31 @@ Domain::commitChunk(std::unique_ptr<CommitChunk> chunk, const UniqueLock & chunk
                                       encoding=_config.getEncoding(), compressionLevel=_config.getCompressionlevel()]() mutable {
         promise.set_value(SerializedChunk(std::move(chunk), encoding, compressionLevel));
     }));
-    _singleCommitter->execute( makeLambdaTask([this, future = std::move(future)]() mutable {
-        doCommit(future.get());
+    _singleCommitter->execute( makeLambdaTask([this, future = std::move(future), start = vespalib::steady_clock::now()]() mutable {
+        doCommit(future.get(), start);
     }));
 }
 
-
-
 void
-Domain::doCommit(const SerializedChunk & serialized) {
+Domain::doCommit(SerializedChunk serialized, vespalib::steady_time start) {
 
     SerialNumRange range = serialized.range();
     DomainPart::SP dp = optionallyRotateFile(range.from());
     dp->commit(serialized);
+    cleanSessions();
     if (_config.getFSyncOnCommit()) {
+        if (_commitScheduler && (_config.getGroupCommitMaxLatency() > vespalib::duration::zero())) {
+            // Acks are released by the scheduler when the part has been synced.
+            _commitScheduler->schedule(std::move(dp), std::move(serialized), _commitLatency, start);
+            return;
+        }
+        if (_commitScheduler) {
+            // Group commit might just have been turned off, keep acks in commit order.
+            _commitScheduler->drain();
+        }
         dp->sync();
     }
-    cleanSessions();
+    _commitLatency.add(vespalib::steady_clock::now() - start);
     LOG(debug, "Releasing %zu acks and %zu entries and %zu bytes.",
         serialized.getNumCallBacks(), serialized.getNumEntries(), serialized.getData().size());
 }
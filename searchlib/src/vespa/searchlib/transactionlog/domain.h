@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
+#include "commit_scheduler.h"
 #include "domainconfig.h"
 #include <vespa/vespalib/util/threadexecutor.h>
 #include <atomic>
@@ -19,8 +20,13 @@ public:
     using SP = std::shared_ptr<Domain>;
     using DomainPartSP = std::shared_ptr<DomainPart>;
     using FileHeaderContext = common::FileHeaderContext;
+    /**
+     * If a commit scheduler is given and group commit max latency is configured, fsync on
+     * commit is handed over to it, allowing syncs to be coalesced with commits in other domains.
+     */
     Domain(const vespalib::string &name, const vespalib::string &baseDir, vespalib::Executor & executor,
-           const DomainConfig & cfg, const FileHeaderContext &fileHeaderContext);
+           const DomainConfig & cfg, const FileHeaderContext &fileHeaderContext,
+           std::shared_ptr<CommitScheduler> commitScheduler = {});
 
     ~Domain() override;
 
@@ -63,7 +69,7 @@ private:
 
     std::unique_ptr<CommitChunk> grabCurrentChunk(const UniqueLock & guard);
     void commitChunk(std::unique_ptr<CommitChunk> chunk, const UniqueLock & chunkOrderGuard);
-    void doCommit(const SerializedChunk & serialized);
+    void doCommit(SerializedChunk serialized, vespalib::steady_time start);
     SerialNum begin(const UniqueLock & guard) const;
     SerialNum end(const UniqueLock & guard) const;
     size_t byteSize(const UniqueLock & guard) const;
@@ -97,6 +103,8 @@ private:
     DurationSeconds              _maxSessionRunTime;
     vespalib::string             _baseDir;
     const FileHeaderContext     &_fileHeaderContext;
+    std::shared_ptr<CommitScheduler> _commitScheduler;
+    CommitLatencyHistogram       _commitLatency;
     bool                         _markedDeleted;
 };
 
@@ -10,7 +10,8 @@ DomainConfig::DomainConfig()
       _compressionLevel(9),
       _fSyncOnCommit(false),
       _partSizeLimit(0x10000000), // 256M
-      _chunkSizeLimit(0x40000)   // 256k
+      _chunkSizeLimit(0x40000),  // 256k
+      _groupCommitMaxLatency(vespalib::duration::zero())
 { }
 
 DomainConfig &
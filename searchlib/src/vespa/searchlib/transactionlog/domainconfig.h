@@ -3,6 +3,7 @@
 
 #include "ichunk.h"
 #include <vespa/vespalib/util/time.h>
+#include <array>
 #include <map>
 
 namespace search::transactionlog {
@@ -16,17 +17,20 @@ public:
     DomainConfig & setChunkSizeLimit(size_t v)      { _chunkSizeLimit = v; return *this; }
     DomainConfig & setCompressionLevel(uint8_t v)   { _compressionLevel = v; return *this; }
     DomainConfig & setFSyncOnCommit(bool v)         { _fSyncOnCommit = v; return *this; }
+    DomainConfig & setGroupCommitMaxLatency(duration v) { _groupCommitMaxLatency = v; return *this; }
     Encoding          getEncoding() const { return _encoding; }
     size_t       getPartSizeLimit() const { return _partSizeLimit; }
     size_t      getChunkSizeLimit() const { return _chunkSizeLimit; }
     uint8_t   getCompressionlevel() const { return _compressionLevel; }
     bool         getFSyncOnCommit() const { return _fSyncOnCommit; }
+    duration getGroupCommitMaxLatency() const { return _groupCommitMaxLatency; }
 private:
     Encoding     _encoding;
     uint8_t      _compressionLevel;
     bool         _fSyncOnCommit;
     size_t       _partSizeLimit;
     size_t       _chunkSizeLimit;
+    duration     _groupCommitMaxLatency;
 };
 
 struct PartInfo {
@@ -42,6 +46,22 @@ struct PartInfo {
     {}
 };
 
+/*
+ * Histogram of the latency from a chunk is committed until it is synced
+ * and acked. Bucket i counts latencies below 2^i * 100us, the last bucket
+ * counts the rest.
+ */
+struct CommitLatencyStats {
+    static constexpr size_t num_buckets = 16;
+    static constexpr vespalib::duration first_bucket_limit = std::chrono::microseconds(100);
+    std::array<uint64_t, num_buckets> buckets;
+    uint64_t count;
+    double sumSeconds;
+    double maxSeconds;
+    CommitLatencyStats() : buckets(), count(0), sumSeconds(0.0), maxSeconds(0.0) {}
+    static vespalib::duration bucket_limit(size_t bucket) { return first_bucket_limit * (uint64_t(1) << bucket); }
+};
+
 struct DomainInfo {
     using DurationSeconds = std::chrono::duration<double>;
     SerialNumRange range;
@@ -49,10 +69,11 @@ struct DomainInfo {
     size_t byteSize;
     DurationSeconds maxSessionRunTime;
     std::vector<PartInfo> parts;
+    CommitLatencyStats commitLatency;
     DomainInfo(SerialNumRange range_in, size_t numEntries_in, size_t byteSize_in, DurationSeconds maxSessionRunTime_in)
-            : range(range_in), numEntries(numEntries_in), byteSize(byteSize_in), maxSessionRunTime(maxSessionRunTime_in), parts() {}
+            : range(range_in), numEntries(numEntries_in), byteSize(byteSize_in), maxSessionRunTime(maxSessionRunTime_in), parts(), commitLatency() {}
     DomainInfo()
-            : range(), numEntries(0), byteSize(0), maxSessionRunTime(), parts() {}
+            : range(), numEntries(0), byteSize(0), maxSessionRunTime(), parts(), commitLatency() {}
 };
 
 using DomainStats = std::map<vespalib::string, DomainInfo>;
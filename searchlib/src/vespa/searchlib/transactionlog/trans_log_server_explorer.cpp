@@ -26,7 +26,19 @@ struct DomainExplorer : vespalib::StateExplorer {
         state.setLong("to", info.range.to());
         state.setLong("numEntries", info.numEntries);
         state.setLong("byteSize", info.byteSize);
+        Cursor &latency = state.setObject("commitLatency");
+        latency.setLong("count", info.commitLatency.count);
+        latency.setDouble("sum", info.commitLatency.sumSeconds);
+        latency.setDouble("max", info.commitLatency.maxSeconds);
         if (full) {
+            Cursor &buckets = latency.setArray("buckets");
+            for (size_t i = 0; i < info.commitLatency.buckets.size(); ++i) {
+                Cursor &bucket = buckets.addObject();
+                if (i + 1 < info.commitLatency.buckets.size()) {
+                    bucket.setDouble("lessThan", vespalib::to_s(CommitLatencyStats::bucket_limit(i)));
+                }
+                bucket.setLong("count", info.commitLatency.buckets[i]);
+            }
             Cursor &array = state.setArray("parts");
             for (const PartInfo &part_in: info.parts) {
                 Cursor &part = array.addObject();
@@ -1,5 +1,6 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include "translogserver.h"
+#include "commit_scheduler.h"
 #include "domain.h"
 #include "client_common.h"
 #include <vespa/fnet/frt/rpcrequest.h>
@@ -101,6 +102,7 @@ TransLogServer::TransLogServer(FNET_Transport & transport, const vespalib::strin
       _executor(maxThreads, CpuUsage::wrap(tls_executor, CpuUsage::Category::WRITE)),
       _thread(),
       _supervisor(std::make_unique<FRT_Supervisor>(&transport)),
+      _commitScheduler(std::make_shared<CommitScheduler>(cfg.getGroupCommitMaxLatency())),
       _domains(),
       _reqQ(),
       _fileHeaderContext(fileHeaderContext),
@@ -115,7 +117,7 @@ TransLogServer::TransLogServer(FNET_Transport & transport, const vespalib::strin
                 domainDir >> domainName;
                 if ( ! domainName.empty()) {
                     try {
-                        auto domain = make_shared<Domain>(domainName, dir(), _executor, cfg, _fileHeaderContext);
+                        auto domain = make_shared<Domain>(domainName, dir(), _executor, cfg, _fileHeaderContext, _commitScheduler);
                         _domains[domain->name()] = domain;
                     } catch (const std::exception & e) {
                         LOG(warning, "Failed creating %s domain on startup. Exception = %s", domainName.c_str(), e.what());
@@ -209,6 +211,7 @@ TransLogServer &
 TransLogServer::setDomainConfig(const DomainConfig & cfg) {
     WriteGuard domainGuard(_domainMutex);
     _domainConfig = cfg;
+    _commitScheduler->setMaxLatency(cfg.getGroupCommitMaxLatency());
     for(auto &domain: _domains) {
         domain.second->setConfig(cfg);
     }
@@ -439,7 +442,7 @@ TransLogServer::createDomain(FRT_RPCRequest *req)
     Domain::SP domain(findDomain(domainName));
     if ( !domain ) {
         try {
-            domain = std::make_shared<Domain>(domainName, dir(), _executor, _domainConfig, _fileHeaderContext);
+            domain = std::make_shared<Domain>(domainName, dir(), _executor, _domainConfig, _fileHeaderContext, _commitScheduler);
             {
                 WriteGuard domainGuard(_domainMutex);
                 _domains[domain->name()] = domain;
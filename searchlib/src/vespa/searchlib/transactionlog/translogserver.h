@@ -17,6 +17,7 @@ namespace search::transactionlog {
 
 class TransLogServerExplorer;
 class Domain;
+class CommitScheduler;
 
 class TransLogServer : private FRT_Invokable, public WriterFactory
 {
@@ -34,6 +35,7 @@ public:
     DomainStats getDomainStats() const;
     std::shared_ptr<Writer> getWriter(const vespalib::string & domainName) const override;
     TransLogServer & setDomainConfig(const DomainConfig & cfg);
+    const CommitScheduler & getCommitScheduler() const { return *_commitScheduler; }
 
 private:
     void request_stop();
@@ -71,6 +73,7 @@ private:
     vespalib::ThreadStackExecutor       _executor;
     std::thread                         _thread;
     std::unique_ptr<FRT_Supervisor>     _supervisor;
+    std::shared_ptr<CommitScheduler>    _commitScheduler;
     DomainList                          _domains;
     mutable std::shared_mutex           _domainMutex;;          // Protects _domains
     std::condition_variable             _domainCondition;
@@ -36,6 +36,7 @@
 #include <vespa/vespalib/util/size_literals.h>
 #include <vespa/config-stor-filestor.h>
 #include <atomic>
+#include <future>
 #include <thread>
 
 #include <vespa/log/log.h>
@@ -2005,6 +2006,13 @@ struct FileStorHandlerTest : public FileStorTestBase {
     FileStorHandler::LockedMessage get_next_message() {
         return handler->getNextMessage(0);
     }
+    FileStorHandlerImpl& handler_impl() {
+        return dynamic_cast<FileStorHandlerImpl&>(*handler);
+    }
+    FileStorStripeMetrics& stripe_metrics() {
+        assert(c->metrics.stripes.size() == 1u);
+        return *c->metrics.stripes[0];
+    }
 };
 
 void
@@ -2082,4 +2090,103 @@ TEST_F(FileStorHandlerTest, inhibited_operations_are_skipped)
     EXPECT_EQ(30, get_next_message().msg->getPriority());
 }
 
+TEST_F(FileStorHandlerTest, skipped_inhibited_operations_are_counted)
+{
+    std::string docid_a = "id:foo:testdoctype1::a";
+    std::string docid_b = "id:foo:testdoctype1::b";
+    handler->schedule(make_put_command(20, docid_a));
+    auto locked_msg = get_next_message();
+    EXPECT_EQ(0, stripe_metrics().inhibited_operations_skipped.getValue());
+    handler->schedule(make_put_command(30, docid_a));
+    handler->schedule(make_put_command(40, docid_b));
+    // Put for the locked bucket is passed over
+    EXPECT_EQ(40, get_next_message().msg->getPriority());
+    EXPECT_EQ(1, stripe_metrics().inhibited_operations_skipped.getValue());
+}
+
+TEST_F(FileStorHandlerTest, waiting_for_stripe_lock_is_tracked_as_contention)
+{
+    auto cmd = make_put_command(20);
+    auto& stripe_lock = handler_impl().get_stripe_lock_for_testing(cmd->getBucket());
+    std::thread thread;
+    {
+        std::lock_guard guard(stripe_lock);
+        thread = std::thread([&]() { handler->schedule(cmd); });
+        std::this_thread::sleep_for(10ms);
+        EXPECT_EQ(0, handler->getQueueSize());
+    }
+    thread.join();
+    EXPECT_EQ(1, handler->getQueueSize());
+    EXPECT_EQ(1, stripe_metrics().lock_contentions.getValue());
+    EXPECT_EQ(1, stripe_metrics().lock_wait_time.getCount());
+    EXPECT_LT(0.0, stripe_metrics().lock_wait_time.getLast());
+    // Uncontended lock acquisition is not counted
+    EXPECT_EQ(20, get_next_message().msg->getPriority());
+    EXPECT_EQ(1, stripe_metrics().lock_contentions.getValue());
+}
+
+TEST_F(FileStorHandlerTest, release_of_last_shared_lock_wakes_up_exclusive_lock_waiter)
+{
+    auto bucket = makeDocumentBucket(document::BucketId(16, 1));
+    auto shared_lock_1 = handler->lock(bucket, api::LockingRequirements::Shared);
+    auto shared_lock_2 = handler->lock(bucket, api::LockingRequirements::Shared);
+    std::promise<std::shared_ptr<FileStorHandler::BucketLockInterface>> promise;
+    auto future = promise.get_future();
+    std::thread thread([&]() { promise.set_value(handler->lock(bucket, api::LockingRequirements::Exclusive)); });
+    EXPECT_EQ(std::future_status::timeout, future.wait_for(200ms));
+    shared_lock_1.reset();
+    EXPECT_EQ(std::future_status::timeout, future.wait_for(200ms));
+    shared_lock_2.reset();
+    EXPECT_EQ(std::future_status::ready, future.wait_for(60s));
+    thread.join();
+    auto exclusive_lock = future.get();
+    EXPECT_EQ(api::LockingRequirements::Exclusive, exclusive_lock->lockingRequirements());
+}
+
+TEST_F(FileStorHandlerTest, no_put_batch_taken_when_batching_is_disabled)
+{
+    handler->schedule(make_put_command(20, "id:foo:testdoctype1::a", 100));
+    handler->schedule(make_put_command(30, "id:foo:testdoctype1::a", 101));
+    auto locked_msg = get_next_message();
+    EXPECT_TRUE(handler->take_put_batch(locked_msg).empty());
+}
+
+TEST_F(FileStorHandlerTest, queued_puts_to_same_bucket_are_taken_as_batch)
+{
+    handler->set_max_put_batch_size(3);
+    handler->schedule(make_put_command(20, "id:foo:testdoctype1::a", 100));
+    handler->schedule(make_put_command(30, "id:foo:testdoctype1::a", 101));
+    handler->schedule(make_put_command(40, "id:foo:testdoctype1::a", 102));
+    handler->schedule(make_put_command(50, "id:foo:testdoctype1::a", 103));
+    {
+        auto locked_msg = get_next_message();
+        EXPECT_EQ(20, locked_msg.msg->getPriority());
+        auto batch = handler->take_put_batch(locked_msg);
+        ASSERT_EQ(2u, batch.size());
+        EXPECT_EQ(30, batch[0].msg->getPriority());
+        EXPECT_EQ(40, batch[1].msg->getPriority());
+        // All puts in the batch share the bucket lock of the first one
+        EXPECT_EQ(locked_msg.lock, batch[0].lock);
+        EXPECT_EQ(locked_msg.lock, batch[1].lock);
+    }
+    EXPECT_EQ(50, get_next_message().msg->getPriority());
+}
+
+TEST_F(FileStorHandlerTest, put_batch_stops_at_first_operation_that_is_not_an_unconditional_put)
+{
+    handler->set_max_put_batch_size(10);
+    handler->schedule(make_put_command(20, "id:foo:testdoctype1::a", 100));
+    handler->schedule(make_put_command(30, "id:foo:testdoctype1::a", 101));
+    handler->schedule(make_get_command(35, "id:foo:testdoctype1::a"));
+    handler->schedule(make_put_command(40, "id:foo:testdoctype1::a", 102));
+    {
+        auto locked_msg = get_next_message();
+        auto batch = handler->take_put_batch(locked_msg);
+        ASSERT_EQ(1u, batch.size());
+        EXPECT_EQ(30, batch[0].msg->getPriority());
+    }
+    EXPECT_EQ(35, get_next_message().msg->getPriority());
+    EXPECT_EQ(40, get_next_message().msg->getPriority());
+}
+
 } // storage
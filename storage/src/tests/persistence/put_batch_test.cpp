@@ -0,0 +1,89 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <tests/persistence/persistencetestutils.h>
+#include <vespa/document/test/make_document_bucket.h>
+#include <vespa/persistence/spi/test.h>
+#include <vespa/storage/persistence/persistencehandler.h>
+#include <vespa/storageapi/message/persistence.h>
+#include <vespa/vespalib/util/stringfmt.h>
+
+using document::test::makeDocumentBucket;
+using storage::spi::test::makeSpiBucket;
+
+namespace storage {
+
+struct PutBatchTest : PersistenceTestUtils {
+    const document::BucketId BUCKET_ID{16, 4};
+    const document::Bucket BUCKET = makeDocumentBucket(BUCKET_ID);
+
+    void SetUp() override {
+        PersistenceTestUtils::SetUp();
+        createBucket(BUCKET_ID);
+        getPersistenceProvider().createBucket(makeSpiBucket(BUCKET_ID));
+    }
+
+    std::shared_ptr<api::PutCommand> make_put(uint32_t location, const vespalib::string& name, api::Timestamp timestamp) {
+        auto id = vespalib::make_string("id:foo:testdoctype1:n=%u:%s", location, name.c_str());
+        std::shared_ptr<document::Document> doc = _env->_testDocMan.createDocument("some content", id);
+        // Always queued to BUCKET, even when the document belongs somewhere else
+        return std::make_shared<api::PutCommand>(BUCKET, std::move(doc), timestamp);
+    }
+
+    std::map<vespalib::string, api::ReturnCode::Result> put_reply_results() {
+        std::map<vespalib::string, api::ReturnCode::Result> results;
+        for (const auto& msg : messageKeeper()._msgs) {
+            auto reply = std::dynamic_pointer_cast<api::PutReply>(msg);
+            if (reply) {
+                results[reply->getDocumentId().toString()] = reply->getResult().getResult();
+            }
+        }
+        return results;
+    }
+};
+
+TEST_F(PutBatchTest, each_put_in_batch_gets_own_reply_and_bucket_lock_is_released_after_last_reply)
+{
+    fsHandler().set_max_put_batch_size(4);
+    fsHandler().schedule(make_put(4, "a", 1000));
+    fsHandler().schedule(make_put(5, "wrong_bucket", 1001));
+    fsHandler().schedule(make_put(4, "b", 1002));
+    fsHandler().schedule(make_put(4, "c", 1003));
+    fsHandler().schedule(make_put(4, "d", 1004));
+
+    auto locked = fsHandler().getNextMessage(0);
+    ASSERT_TRUE(locked.lock);
+    EXPECT_EQ(api::LockingRequirements::Shared, locked.lock->lockingRequirements());
+    EXPECT_EQ(1u, fsHandler().get_active_operations_stats(false).get_active_size());
+    std::weak_ptr<FileStorHandler::BucketLockInterface> weak_lock = locked.lock;
+    _persistenceHandler->processLockedMessage(std::move(locked));
+    _sequenceTaskExecutor->sync_all();
+
+    // The first put and the 3 following ones were processed as a batch, the last put is still queued
+    EXPECT_EQ(1u, fsHandler().getQueueSize());
+    auto results = put_reply_results();
+    ASSERT_EQ(4u, results.size());
+    EXPECT_EQ(api::ReturnCode::OK, results["id:foo:testdoctype1:n=4:a"]);
+    EXPECT_EQ(api::ReturnCode::INTERNAL_FAILURE, results["id:foo:testdoctype1:n=5:wrong_bucket"]);
+    EXPECT_EQ(api::ReturnCode::OK, results["id:foo:testdoctype1:n=4:b"]);
+    EXPECT_EQ(api::ReturnCode::OK, results["id:foo:testdoctype1:n=4:c"]);
+    // The shared bucket lock is released once all puts in the batch have replied
+    EXPECT_TRUE(weak_lock.expired());
+    EXPECT_EQ(0u, fsHandler().get_active_operations_stats(false).get_active_size());
+
+    EXPECT_TRUE(doGet(BUCKET_ID, document::DocumentId("id:foo:testdoctype1:n=4:a")).hasDocument());
+    EXPECT_TRUE(doGet(BUCKET_ID, document::DocumentId("id:foo:testdoctype1:n=4:b")).hasDocument());
+    EXPECT_TRUE(doGet(BUCKET_ID, document::DocumentId("id:foo:testdoctype1:n=4:c")).hasDocument());
+    EXPECT_FALSE(doGet(BUCKET_ID, document::DocumentId("id:foo:testdoctype1:n=4:d")).hasDocument());
+
+    // The remaining put is processed on its own
+    auto remaining = fsHandler().getNextMessage(0);
+    ASSERT_TRUE(remaining.lock);
+    _persistenceHandler->processLockedMessage(std::move(remaining));
+    _sequenceTaskExecutor->sync_all();
+    results = put_reply_results();
+    ASSERT_EQ(5u, results.size());
+    EXPECT_EQ(api::ReturnCode::OK, results["id:foo:testdoctype1:n=4:d"]);
+    EXPECT_TRUE(doGet(BUCKET_ID, document::DocumentId("id:foo:testdoctype1:n=4:d")).hasDocument());
+}
+
+}
@@ -178,6 +178,36 @@ AsyncHandler::handlePut(api::PutCommand& cmd, MessageTracker::UP trackerUP) cons
     return trackerUP;
 }
 
+void
+AsyncHandler::handlePutBatch(PutBatch batch) const
+{
+    auto& metrics = _env._metrics.put;
+    spi::Bucket bucket(batch.front().first->getBucket());
+    std::vector<spi::PutEntry> entries;
+    entries.reserve(batch.size());
+    for (auto& [cmd, tracker] : batch) {
+        tracker->setMetric(metrics);
+        metrics.request_size.addValue(cmd->getApproxByteSize());
+        try {
+            _env.getBucket(cmd->getDocumentId(), cmd->getBucket());
+        } catch (std::exception& e) {
+            LOG(debug, "Caught exception for %s: %s", cmd->toString().c_str(), e.what());
+            tracker->fail(api::ReturnCode::INTERNAL_FAILURE, e.what());
+            tracker->sendReply();
+            continue;
+        }
+        auto task = makeResultTask([tracker = std::move(tracker)](spi::Result::UP response) {
+            tracker->checkForError(*response);
+            tracker->sendReply();
+        });
+        entries.emplace_back(spi::Timestamp(cmd->getTimestamp()), cmd->getDocument(),
+                             std::make_unique<ResultTaskOperationDone>(_sequencedExecutor, cmd->getBucketId(), std::move(task)));
+    }
+    if (!entries.empty()) {
+        _spi.putBatchAsync(bucket, std::move(entries));
+    }
+}
+
 MessageTracker::UP
 AsyncHandler::handleCreateBucket(api::CreateBucketCommand& cmd, MessageTracker::UP tracker) const
 {
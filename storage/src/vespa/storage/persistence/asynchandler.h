@@ -24,9 +24,12 @@ class MessageTracker;
 class AsyncHandler {
     using MessageTrackerUP = std::unique_ptr<MessageTracker>;
 public:
+    // Unconditional puts to the same bucket, with their trackers
+    using PutBatch = std::vector<std::pair<std::shared_ptr<api::PutCommand>, MessageTrackerUP>>;
     AsyncHandler(const PersistenceUtil&, spi::PersistenceProvider&, BucketOwnershipNotifier&,
                  vespalib::ISequencedTaskExecutor& executor, const document::BucketIdFactory& bucketIdFactory);
     MessageTrackerUP handlePut(api::PutCommand& cmd, MessageTrackerUP tracker) const;
+    void handlePutBatch(PutBatch batch) const;
     MessageTrackerUP handleRemove(api::RemoveCommand& cmd, MessageTrackerUP tracker) const;
     MessageTrackerUP handleUpdate(api::UpdateCommand& cmd, MessageTrackerUP tracker) const;
     MessageTrackerUP handleRunTask(RunTaskCommand & cmd, MessageTrackerUP tracker) const;
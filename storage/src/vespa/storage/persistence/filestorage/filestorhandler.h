@@ -178,6 +178,14 @@ public:
         return getNextMessage(stripeId, vespalib::steady_clock::now() + _getNextMessageTimout);
     }
 
+    /**
+     * Used by file stor threads to take the queued unconditional puts to the bucket
+     * of the given (locked) put, so that they can be handed to the provider as a
+     * single batch. The returned messages share the bucket lock of the given message.
+     * Returns an empty vector if put batching is disabled or there is nothing to batch.
+     */
+    virtual std::vector<LockedMessage> take_put_batch(const LockedMessage& first) = 0;
+
     /**
      * Lock a bucket. By default, each file stor thread has the locks of all
      * buckets in their area of responsibility. If they need to access buckets
@@ -287,6 +295,8 @@ public:
     virtual void use_dynamic_operation_throttling(bool use_dynamic) noexcept = 0;
 
     virtual void set_throttle_apply_bucket_diff_ops(bool throttle_apply_bucket_diff) noexcept = 0;
+
+    virtual void set_max_put_batch_size(uint32_t max_batch_size) noexcept = 0;
 private:
     vespalib::duration _getNextMessageTimout;
 };
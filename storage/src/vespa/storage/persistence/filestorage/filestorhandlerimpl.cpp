@@ -60,6 +60,7 @@ FileStorHandlerImpl::FileStorHandlerImpl(uint32_t numThreads, uint32_t numStripe
       _max_active_merges_per_stripe(per_stripe_merge_limit(numThreads, numStripes)),
       _paused(false),
       _throttle_apply_bucket_diff_ops(false),
+      _max_put_batch_size(1),
       _last_active_operations_stats()
 {
     assert(numStripes > 0);
@@ -407,9 +408,19 @@ FileStorHandlerImpl::getNextMessage(uint32_t stripeId, vespalib::steady_time dea
     return _stripes[stripeId].getNextMessage(deadline);
 }
 
+std::vector<FileStorHandler::LockedMessage>
+FileStorHandlerImpl::take_put_batch(const LockedMessage& first)
+{
+    uint32_t max_batch_size = _max_put_batch_size.load(std::memory_order_relaxed);
+    if ((max_batch_size <= 1) || isPaused()) {
+        return {};
+    }
+    return stripe(first.lock->getBucket()).take_put_batch(first, max_batch_size - 1);
+}
+
 std::shared_ptr<FileStorHandler::BucketLockInterface>
 FileStorHandlerImpl::Stripe::lock(const document::Bucket &bucket, api::LockingRequirements lockReq) {
-    std::unique_lock guard(*_lock);
+    auto guard = acquire_guard();
 
     while (isLocked(guard, bucket, lockReq)) {
         LOG(spam, "Contending for filestor lock for %s with %s access",
@@ -911,6 +922,21 @@ FileStorHandlerImpl::Stripe::Stripe(const FileStorHandlerImpl & owner, MessageSe
       _active_operations_stats()
 {}
 
+FileStorHandlerImpl::monitor_guard
+FileStorHandlerImpl::Stripe::acquire_guard() const
+{
+    monitor_guard guard(*_lock, std::try_to_lock);
+    if (!guard.owns_lock()) {
+        Clock::time_point start_time = Clock::now();
+        guard.lock();
+        if (_metrics != nullptr) {
+            _metrics->lock_contentions.inc();
+            _metrics->lock_wait_time.addValue(std::chrono::duration<double, std::milli>(Clock::now() - start_time).count());
+        }
+    }
+    return guard;
+}
+
 bool
 FileStorHandlerImpl::Stripe::operation_type_should_be_throttled(api::MessageType::Id type_id) const noexcept
 {
@@ -941,7 +967,7 @@ FileStorHandlerImpl::Stripe::operation_type_should_be_throttled(api::MessageType
 FileStorHandler::LockedMessage
 FileStorHandlerImpl::Stripe::getNextMessage(vespalib::steady_time deadline)
 {
-    std::unique_lock guard(*_lock);
+    auto guard = acquire_guard();
     ThrottleToken throttle_token;
     // Try to grab a message+lock, immediately retrying once after a wait
     // if none can be found and then exiting if the same is the case on the
@@ -951,9 +977,14 @@ FileStorHandlerImpl::Stripe::getNextMessage(vespalib::steady_time deadline)
         PriorityIdx& idx(bmi::get<1>(*_queue));
         PriorityIdx::iterator iter(idx.begin()), end(idx.end());
         bool was_throttled = false;
+        uint64_t skipped = 0;
 
         while ((iter != end) && operationIsInhibited(guard, iter->_bucket, *iter->_command)) {
             iter++;
+            ++skipped;
+        }
+        if (skipped > 0) {
+            _metrics->inhibited_operations_skipped.inc(skipped);
         }
         if (iter != end) {
             const bool should_throttle_op = operation_type_should_be_throttled(iter->_command->getType().getId());
@@ -992,6 +1023,43 @@ FileStorHandlerImpl::Stripe::getNextMessage(vespalib::steady_time deadline)
     return {}; // No message fetched.
 }
 
+std::vector<FileStorHandler::LockedMessage>
+FileStorHandlerImpl::Stripe::take_put_batch(const FileStorHandler::LockedMessage& first, uint32_t max_count)
+{
+    std::vector<FileStorHandler::LockedMessage> batch;
+    std::vector<std::shared_ptr<api::StorageReply>> timed_out;
+    {
+        auto guard = acquire_guard();
+        BucketIdx& idx(bmi::get<2>(*_queue));
+        auto range = idx.equal_range(first.lock->getBucket());
+        // Operations to the same bucket are ordered by arrival, stop at the first one that can't be batched
+        // to avoid reordering puts with other operations to the bucket.
+        for (auto iter = range.first; (iter != range.second) && (batch.size() < max_count); ) {
+            const api::StorageMessage& msg = *iter->_command;
+            if ((msg.getType().getId() != api::MessageType::PUT_ID) || !AsyncHandler::is_async_unconditional_message(msg)) {
+                break;
+            }
+            auto throttle_token = _owner.operation_throttler().try_acquire_one();
+            if (!throttle_token.valid()) {
+                _metrics->throttled_persistence_thread_polls.inc();
+                break;
+            }
+            std::chrono::milliseconds waitTime(uint64_t(iter->_timer.stop(_metrics->averageQueueWaitingTime)));
+            if (messageTimedOutInQueue(msg, waitTime)) {
+                timed_out.emplace_back(makeQueueTimeoutReply(*iter->_command));
+            } else {
+                batch.emplace_back(first.lock, iter->_command, std::move(throttle_token));
+            }
+            iter = idx.erase(iter);
+        }
+        update_cached_queue_size(guard);
+    }
+    for (auto& reply : timed_out) {
+        _messageSender.sendReply(reply);
+    }
+    return batch;
+}
+
 FileStorHandler::LockedMessage
 FileStorHandlerImpl::Stripe::get_next_async_message(monitor_guard& guard)
 {
@@ -1093,7 +1161,7 @@ bool
 FileStorHandlerImpl::Stripe::schedule(MessageEntry messageEntry)
 {
     {
-        std::lock_guard guard(*_lock);
+        auto guard = acquire_guard();
         _queue->emplace_back(std::move(messageEntry));
         update_cached_queue_size(guard);
     }
@@ -1104,7 +1172,7 @@ FileStorHandlerImpl::Stripe::schedule(MessageEntry messageEntry)
 FileStorHandler::LockedMessage
 FileStorHandlerImpl::Stripe::schedule_and_get_next_async_message(MessageEntry entry)
 {
-    std::unique_lock guard(*_lock);
+    auto guard = acquire_guard();
     _queue->emplace_back(std::move(entry));
     update_cached_queue_size(guard);
     auto lockedMessage = get_next_async_message(guard);
@@ -1153,7 +1221,7 @@ FileStorHandlerImpl::Stripe::release(const document::Bucket & bucket,
                                      api::StorageMessage::Id lockMsgId,
                                      bool was_active_merge)
 {
-    std::unique_lock guard(*_lock);
+    auto guard = acquire_guard();
     auto iter = _lockedBuckets.find(bucket);
     assert(iter != _lockedBuckets.end());
     auto& entry = iter->second;
@@ -1179,10 +1247,12 @@ FileStorHandlerImpl::Stripe::release(const document::Bucket & bucket,
     Clock::time_point now_ts = Clock::now();
     double latency = std::chrono::duration<double, std::milli>(now_ts - start_time).count();
     _active_operations_stats.guard().stats().operation_done(latency);
-    if (!entry._exclusiveLock && entry._sharedLocks.empty()) {
+    bool emptySharedLocks = entry._sharedLocks.empty();
+    if (!entry._exclusiveLock && emptySharedLocks) {
         _lockedBuckets.erase(iter); // No more locks held
     }
-    bool emptySharedLocks = entry._sharedLocks.empty();
+    // Wake up waiters after releasing the stripe lock, so they don't immediately block on it
+    guard.unlock();
     if (wasExclusive) {
         _cond->notify_all();
     } else if (emptySharedLocks) {
@@ -1193,7 +1263,7 @@ FileStorHandlerImpl::Stripe::release(const document::Bucket & bucket,
 void
 FileStorHandlerImpl::Stripe::decrease_active_sync_merges_counter() noexcept
 {
-    std::unique_lock guard(*_lock);
+    auto guard = acquire_guard();
     assert(_active_merges > 0);
     const bool may_have_blocked_merge = (_active_merges == _owner._max_active_merges_per_stripe);
     --_active_merges;
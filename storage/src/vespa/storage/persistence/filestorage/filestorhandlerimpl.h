@@ -77,6 +77,11 @@ public:
     using monitor_guard = std::unique_lock<std::mutex>;
     using atomic_size_t = vespalib::datastore::AtomicValueWrapper<size_t>;
 
+    /**
+     * The queue and the bucket locks of a stripe are guarded by a single mutex.
+     * Waiting for it is tracked by the lock_contentions and lock_wait_time
+     * stripe metrics.
+     */
     class Stripe {
     public:
         struct LockEntry {
@@ -155,6 +160,8 @@ public:
         void failOperations(const document::Bucket & bucket, const api::ReturnCode & code);
 
         FileStorHandler::LockedMessage getNextMessage(vespalib::steady_time deadline);
+        std::vector<FileStorHandler::LockedMessage> take_put_batch(const FileStorHandler::LockedMessage& first,
+                                                                   uint32_t max_count);
         void dumpQueue(std::ostream & os) const;
         void dumpActiveHtml(std::ostream & os) const;
         void dumpQueueHtml(std::ostream & os) const;
@@ -164,6 +171,8 @@ public:
         void setMetrics(FileStorStripeMetrics * metrics) { _metrics = metrics; }
         ActiveOperationsStats get_active_operations_stats(bool reset_min_max) const;
     private:
+        // Acquires the stripe lock, tracking contention for it in the stripe metrics
+        monitor_guard acquire_guard() const;
         void update_cached_queue_size(const std::lock_guard<std::mutex> &) {
             _cached_queue_size.store_relaxed(_queue->size());
         }
@@ -234,6 +243,7 @@ public:
     ScheduleAsyncResult schedule_and_get_next_async_message(const std::shared_ptr<api::StorageMessage>& msg) override;
 
     FileStorHandler::LockedMessage getNextMessage(uint32_t stripeId, vespalib::steady_time deadline) override;
+    std::vector<LockedMessage> take_put_batch(const LockedMessage& first) override;
 
     void remapQueueAfterJoin(const RemapInfo& source, RemapInfo& target) override;
     void remapQueueAfterSplit(const RemapInfo& source, RemapInfo& target1, RemapInfo& target2) override;
@@ -292,11 +302,16 @@ public:
         _throttle_apply_bucket_diff_ops.store(throttle_apply_bucket_diff, std::memory_order_relaxed);
     }
 
+    void set_max_put_batch_size(uint32_t max_batch_size) noexcept override {
+        _max_put_batch_size.store(max_batch_size, std::memory_order_relaxed);
+    }
+
     // Implements ResumeGuard::Callback
     void resume() override;
 
     // Use only for testing
     framework::MetricUpdateHook& get_metric_update_hook_for_testing() { return *this; }
+    std::mutex& get_stripe_lock_for_testing(const document::Bucket& bucket) { return stripe(bucket).exposeLock(); }
 
 private:
     ServiceLayerComponent   _component;
@@ -315,6 +330,7 @@ private:
     mutable std::condition_variable _pauseCond;
     std::atomic<bool>               _paused;
     std::atomic<bool>               _throttle_apply_bucket_diff_ops;
+    std::atomic<uint32_t>           _max_put_batch_size;
     std::optional<ActiveOperationsStats> _last_active_operations_stats;
 
     // Returns the index in the targets array we are sending to, or -1 if none of them match.
@@ -244,6 +244,7 @@ FileStorManager::on_configure(const StorFilestorConfig& config)
         _filestorHandler->use_dynamic_operation_throttling(use_dynamic_throttling);
         _filestorHandler->set_throttle_apply_bucket_diff_ops(false);
     }
+    _filestorHandler->set_max_put_batch_size(std::max(1, config.maxPutBatchSize));
 }
 
 void
@@ -188,7 +188,14 @@ FileStorStripeMetrics::FileStorStripeMetrics(const std::string& name, const std:
                                          "queued async operation because it was disallowed by the throttle policy", this),
       timeouts_waiting_for_throttle_token("timeouts_waiting_for_throttle_token", {},
                                           "Number of times a persistence thread timed out waiting for an available "
-                                          "throttle policy token", this)
+                                          "throttle policy token", this),
+      lock_contentions("lock_contentions", {},
+                       "Number of times a thread had to wait for the stripe lock held by another thread", this),
+      lock_wait_time("lock_wait_time", {},
+                     "Average time (in ms) spent waiting for the stripe lock when it was held by another thread", this),
+      inhibited_operations_skipped("inhibited_operations_skipped", {},
+                                   "Number of queued operations passed over when looking for the next operation "
+                                   "to dispatch, because their bucket was locked or merges were throttled", this)
 {
 }
 
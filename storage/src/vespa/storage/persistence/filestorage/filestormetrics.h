@@ -121,6 +121,9 @@ public:
     metrics::LongCountMetric throttled_rpc_direct_dispatches;
     metrics::LongCountMetric throttled_persistence_thread_polls;
     metrics::LongCountMetric timeouts_waiting_for_throttle_token;
+    metrics::LongCountMetric lock_contentions;
+    metrics::DoubleAverageMetric lock_wait_time;
+    metrics::LongCountMetric inhibited_operations_skipped;
     FileStorStripeMetrics(const std::string& name, const std::string& description);
     ~FileStorStripeMetrics() override;
 };
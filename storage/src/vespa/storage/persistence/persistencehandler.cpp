@@ -159,10 +159,42 @@ PersistenceHandler::processMessage(api::StorageMessage& msg, MessageTracker::UP
     return tracker;
 }
 
+void
+PersistenceHandler::processLockedPutBatch(FileStorHandler::LockedMessage first,
+                                          std::vector<FileStorHandler::LockedMessage> rest) const
+{
+    LOG(debug, "NodeIndex %d, batch of %zu puts to %s", _env._nodeIndex, rest.size() + 1,
+        first.lock->getBucket().toString().c_str());
+    _env._metrics.operations.inc(rest.size() + 1);
+    AsyncHandler::PutBatch batch;
+    batch.reserve(rest.size() + 1);
+    auto add_to_batch = [this, &batch](FileStorHandler::LockedMessage& locked) {
+        MBUS_TRACE(locked.msg->getTrace(), 5, "PersistenceHandler: Processing message in persistence layer as part of a put batch");
+        auto cmd = std::static_pointer_cast<api::PutCommand>(locked.msg);
+        batch.emplace_back(std::move(cmd), std::make_unique<MessageTracker>(framework::MilliSecTimer(_clock), _env, _env._fileStorHandler,
+                                                                            std::move(locked.lock), std::move(locked.msg),
+                                                                            std::move(locked.throttle_token)));
+    };
+    add_to_batch(first);
+    for (auto& locked : rest) {
+        add_to_batch(locked);
+    }
+    // All puts in the batch share the same bucket lock, so a single sync phase notification covers them all.
+    OperationSyncPhaseTrackingGuard sync_guard(*batch.front().second);
+    _asyncHandler.handlePutBatch(std::move(batch));
+}
+
 void
 PersistenceHandler::processLockedMessage(FileStorHandler::LockedMessage lock) const {
     LOG(debug, "NodeIndex %d, ptr=%p", _env._nodeIndex, lock.msg.get());
     api::StorageMessage & msg(*lock.msg);
+    if ((msg.getType().getId() == api::MessageType::PUT_ID) && AsyncHandler::is_async_unconditional_message(msg)) {
+        auto rest = _env._fileStorHandler.take_put_batch(lock);
+        if (!rest.empty()) {
+            processLockedPutBatch(std::move(lock), std::move(rest));
+            return;
+        }
+    }
 
     // Important: we _copy_ the message shared_ptr instead of moving to ensure that `msg` remains
     // valid even if the tracker is destroyed by an exception in processMessage().
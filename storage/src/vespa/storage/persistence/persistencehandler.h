@@ -40,6 +40,7 @@ private:
     MessageTracker::UP handleReply(api::StorageReply&, MessageTracker::UP) const;
 
     MessageTracker::UP processMessage(api::StorageMessage& msg, MessageTracker::UP tracker) const;
+    void processLockedPutBatch(FileStorHandler::LockedMessage first, std::vector<FileStorHandler::LockedMessage> rest) const;
 
     const framework::Clock  & _clock;
     PersistenceUtil           _env;
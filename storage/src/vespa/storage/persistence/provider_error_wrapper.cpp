@@ -157,6 +157,15 @@ ProviderErrorWrapper::putAsync(const spi::Bucket &bucket, spi::Timestamp ts, spi
     _impl.putAsync(bucket, ts, std::move(doc), std::move(onComplete));
 }
 
+void
+ProviderErrorWrapper::putBatchAsync(const spi::Bucket &bucket, std::vector<spi::PutEntry> entries)
+{
+    for (auto& entry : entries) {
+        entry.on_complete->addResultHandler(this);
+    }
+    _impl.putBatchAsync(bucket, std::move(entries));
+}
+
 void
 ProviderErrorWrapper::removeAsync(const spi::Bucket &bucket, std::vector<spi::IdAndTimestamp> ids,
                                   spi::OperationComplete::UP onComplete)
@@ -0,0 +1,142 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/fieldvalue/stringfieldvalue.h>
+#include <vespa/searchlib/query/streaming/queryterm.h>
+#include <vespa/vsm/searcher/futf8strchrfieldsearcher.h>
+#include <vespa/vsm/searcher/mock_field_searcher_env.h>
+#include <vespa/vsm/searcher/utf8strchrfieldsearcher.h>
+#include <vespa/vsm/searcher/utf8substringsearcher.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+#include <random>
+
+using search::Normalizing;
+using search::streaming::QueryNodeResultFactory;
+using search::streaming::QueryTerm;
+using search::streaming::QueryTermList;
+using vespalib::BenchmarkTimer;
+using namespace vsm;
+
+using TermType = QueryTerm::Type;
+
+namespace {
+
+const std::vector<std::string> vocabulary = {
+    "the", "of", "and", "to", "in", "a", "is", "that", "for", "it", "as", "was", "with", "be", "by", "on",
+    "not", "he", "this", "are", "or", "his", "from", "at", "which", "but", "have", "an", "had", "they",
+    "you", "were", "their", "one", "all", "we", "can", "her", "has", "there", "been", "if", "more", "when",
+    "will", "would", "who", "so", "no", "search", "engine", "document", "streaming", "visitor", "bucket",
+    "personal", "mailbox", "message", "attachment", "calendar", "meeting", "invoice", "shipment", "delivery",
+    "tracking", "password", "account", "notification", "subscription", "newsletter", "conference", "schedule",
+    "reservation", "confirmation", "receipt", "payment", "transaction", "statement", "quarterly", "report",
+    "presentation", "spreadsheet", "agreement", "contract", "proposal", "deadline", "reminder", "birthday",
+    "vacation", "holiday", "weekend", "morning", "afternoon", "evening", "tomorrow", "yesterday", "photos"
+};
+
+// Documents with a skewed word distribution, resembling small personal
+// documents like mails where a few words are very common.
+std::vector<std::string> make_documents(size_t num_docs, size_t words_per_doc) {
+    std::mt19937 rnd(42);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    std::vector<std::string> docs;
+    for (size_t i = 0; i < num_docs; ++i) {
+        std::string doc;
+        for (size_t j = 0; j < words_per_doc; ++j) {
+            double u = dist(rnd);
+            const auto &word = vocabulary[size_t(u * u * u * vocabulary.size())];
+            if (!doc.empty()) {
+                doc += ((j % 12) == 0) ? ". " : " ";
+            }
+            doc += word;
+        }
+        docs.push_back(std::move(doc));
+    }
+    return docs;
+}
+
+struct Fixture {
+    QueryNodeResultFactory             eqnr;
+    std::vector<std::unique_ptr<QueryTerm>> terms;
+    QueryTermList                      qtl;
+    test::MockFieldSearcherEnv         env;
+    SharedFieldPathMap                 field_paths;
+    std::vector<std::unique_ptr<StorageDocument>> docs;
+
+    Fixture(const std::vector<std::string> &words, TermType type)
+        : eqnr(), terms(), qtl(), env(), field_paths(std::make_shared<FieldPathMapT>()), docs()
+    {
+        for (const auto &word : words) {
+            terms.push_back(std::make_unique<QueryTerm>(eqnr.create(), word, "index", type, Normalizing::LOWERCASE_AND_FOLD));
+            qtl.push_back(terms.back().get());
+        }
+        field_paths->emplace_back();
+        for (const auto &text : make_documents(1000, 200)) {
+            auto doc = std::make_unique<StorageDocument>(std::make_unique<document::Document>(), field_paths, 1);
+            doc->setField(0, std::make_unique<document::StringFieldValue>(text));
+            docs.push_back(std::move(doc));
+        }
+    }
+    ~Fixture();
+
+    size_t search_all(FieldSearcher &fs) {
+        size_t hits = 0;
+        for (const auto &doc : docs) {
+            for (auto *qt : qtl) {
+                qt->reset();
+            }
+            fs.search(*doc);
+            for (auto *qt : qtl) {
+                hits += qt->getHitList().size();
+            }
+        }
+        return hits;
+    }
+
+    void benchmark(const char *name, FieldSearcher &fs) {
+        env.prepare(fs, qtl);
+        size_t hits = 0;
+        double seconds = BenchmarkTimer::benchmark([&]() { hits = search_all(fs); }, 2.0);
+        fprintf(stderr, "%s (%zu terms): %g us per document (%zu hits)\n",
+                name, qtl.size(), seconds * 1000.0 * 1000.0 / docs.size(), hits);
+    }
+};
+
+Fixture::~Fixture() = default;
+
+const std::vector<std::string> one_term = {"meeting"};
+const std::vector<std::string> five_terms = {"meeting", "invoice", "birthday", "mailbox", "quarterly"};
+
+}
+
+TEST(StreamingSearcherBenchmark, word_match)
+{
+    for (const auto *words : {&one_term, &five_terms}) {
+        Fixture f(*words, TermType::WORD);
+        UTF8StrChrFieldSearcher utf8(0);
+        f.benchmark("utf8 word match", utf8);
+        FUTF8StrChrFieldSearcher futf8(0);
+        f.benchmark("fast utf8 word match", futf8);
+    }
+}
+
+TEST(StreamingSearcherBenchmark, prefix_match)
+{
+    for (const auto *words : {&one_term, &five_terms}) {
+        Fixture f(*words, TermType::PREFIXTERM);
+        FUTF8StrChrFieldSearcher futf8(0);
+        futf8.match_type(FieldSearcher::PREFIX);
+        f.benchmark("fast utf8 prefix match", futf8);
+    }
+}
+
+TEST(StreamingSearcherBenchmark, substring_match)
+{
+    for (const auto *words : {&one_term, &five_terms}) {
+        Fixture f(*words, TermType::SUBSTRINGTERM);
+        UTF8SubStringFieldSearcher substring(0);
+        f.benchmark("utf8 substring match", substring);
+    }
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -8,6 +8,7 @@
 #include <vespa/searchlib/query/streaming/queryterm.h>
 #include <vespa/vsm/searcher/boolfieldsearcher.h>
 #include <vespa/vsm/searcher/fieldsearcher.h>
+#include <vespa/vsm/searcher/first_char_filter.h>
 #include <vespa/vsm/searcher/floatfieldsearcher.h>
 #include <vespa/vsm/searcher/futf8strchrfieldsearcher.h>
 #include <vespa/vsm/searcher/intfieldsearcher.h>
@@ -632,6 +633,33 @@ TEST("utf8 substring search") {
     }
 }
 
+TEST("utf8 substring search verifies terms sharing the low byte of the first character")
+{
+    UTF8SubStringFieldSearcher fs(0);
+    // U+0461 and 'a' are the same character to the first char filter
+    assertString(fs, StringList().add("\xd1\xa1" "b").add("xy"), "ab \xd1\xa1" "b ab",
+                 HitsList().add(Hits().add({0, 1})).add(Hits()));
+    assertString(fs, StringList().add("\xd1\xa1" "b").add("ab"), "ab \xd1\xa1" "b ab",
+                 HitsList().add(Hits().add({0, 1})).add(Hits().add({0, 0}).add({0, 2})));
+}
+
+TEST("first char filter") {
+    FirstCharFilter filter;
+    EXPECT_FALSE(filter.may_start('a'));
+    filter.add('a');
+    filter.add(0x4e01);
+    EXPECT_TRUE(filter.may_start('a'));
+    EXPECT_TRUE(filter.may_start(0x4e61));
+    EXPECT_TRUE(filter.may_start(0x01));
+    EXPECT_FALSE(filter.may_start('b'));
+    EXPECT_FALSE(filter.may_start(0xff));
+    filter.add_all();
+    EXPECT_TRUE(filter.may_start('b'));
+    EXPECT_TRUE(filter.may_start(0xff));
+    filter.clear();
+    EXPECT_FALSE(filter.may_start('a'));
+}
+
 TEST("utf8 substring search with empty term")
 {
     UTF8SubStringFieldSearcher fs(0);
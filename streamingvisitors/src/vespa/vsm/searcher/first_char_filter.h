@@ -0,0 +1,33 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace vsm {
+
+/**
+ * Set of the first characters of a list of query terms, keyed on the
+ * lowest 8 bits of the character. Used by string field searchers
+ * matching several terms at once to skip positions where no term can
+ * start, instead of comparing every term at every position. False
+ * positives are possible (characters sharing the low byte), so a
+ * candidate position must always be verified.
+ **/
+class FirstCharFilter {
+private:
+    std::array<uint64_t, 4> _bits;
+public:
+    FirstCharFilter() noexcept : _bits() {}
+    void clear() noexcept { _bits.fill(0); }
+    // an empty term can start anywhere
+    void add_all() noexcept { _bits.fill(~uint64_t(0)); }
+    void add(uint32_t c) noexcept {
+        _bits[(c >> 6) & 3] |= (uint64_t(1) << (c & 63));
+    }
+    bool may_start(uint32_t c) const noexcept {
+        return ((_bits[(c >> 6) & 3] >> (c & 63)) & 1) != 0;
+    }
+};
+
+}
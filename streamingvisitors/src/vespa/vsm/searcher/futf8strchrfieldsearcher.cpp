@@ -8,6 +8,7 @@
 
 using search::byte;
 using search::streaming::QueryTerm;
+using search::streaming::QueryTermList;
 using search::v16qi;
 using vespalib::Optimized;
 
@@ -21,20 +22,45 @@ FUTF8StrChrFieldSearcher::duplicate() const
 
 FUTF8StrChrFieldSearcher::FUTF8StrChrFieldSearcher(FieldIdT fId)
     : UTF8StrChrFieldSearcher(fId),
-      _folded(4_Ki)
+      _folded(4_Ki),
+      _first_chars()
 { }
 FUTF8StrChrFieldSearcher::~FUTF8StrChrFieldSearcher() = default;
 
+void
+FUTF8StrChrFieldSearcher::prepare(QueryTermList& qtl,
+                                  const SharedSearcherBuf& buf,
+                                  const vsm::FieldPathMapT& field_paths,
+                                  search::fef::IQueryEnvironment& query_env)
+{
+    UTF8StrChrFieldSearcher::prepare(qtl, buf, field_paths, query_env);
+    _first_chars.clear();
+    for (auto qt : _qtl) {
+        const char * term;
+        if (qt->term(term) > 0) {
+            _first_chars.add(byte(term[0]));
+        } else {
+            _first_chars.add_all();
+        }
+    }
+}
+
 bool
 FUTF8StrChrFieldSearcher::ansiFold(const char * toFold, size_t sz, char * folded)
 {
-  bool retval(true);
+  // Check for non-ascii characters up front, keeping both loops free of
+  // early exits so that the compiler can vectorize the first one.
+  byte highBits(0);
   for(size_t i=0; i < sz; i++) {
-    byte c = toFold[i];
-    if (c>=128) { retval = false; break; }
-    folded[i] = fold(c);
+    highBits |= byte(toFold[i]);
   }
-  return retval;
+  if (highBits >= 128) {
+    return false;
+  }
+  for(size_t i=0; i < sz; i++) {
+    folded[i] = fold(toFold[i]);
+  }
+  return true;
 }
 
 bool
@@ -175,16 +201,18 @@ size_t FUTF8StrChrFieldSearcher::match(const char *folded, size_t sz, size_t min
   while (!*n) n++;
   for( ; ; ) {
     if (n>=e) break;
-    for(QueryTerm ** it=qtl, ** mt=qtl+qtlSize; it != mt; it++) {
-      QueryTerm & qt = **it;
-      const char * term;
-      termsize_t tsz = qt.term(term);
-
-      const char *et=term+tsz;
-      const char *fnt;
-      for (fnt = n; (term < et) && (*term == *fnt); term++, fnt++);
-      if ((term == et) && (prefix() || qt.isPrefix() || !*fnt)) {
-        addHit(qt, words);
+    if (_first_chars.may_start(byte(*n))) {
+      for(QueryTerm ** it=qtl, ** mt=qtl+qtlSize; it != mt; it++) {
+        QueryTerm & qt = **it;
+        const char * term;
+        termsize_t tsz = qt.term(term);
+
+        const char *et=term+tsz;
+        const char *fnt;
+        for (fnt = n; (term < et) && (*term == *fnt); term++, fnt++);
+        if ((term == et) && (prefix() || qt.isPrefix() || !*fnt)) {
+          addHit(qt, words);
+        }
       }
     }
     words++;
@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
+#include "first_char_filter.h"
 #include "utf8strchrfieldsearcher.h"
 
 namespace vsm {
@@ -11,6 +12,10 @@ public:
     std::unique_ptr<FieldSearcher> duplicate() const override;
     explicit FUTF8StrChrFieldSearcher(FieldIdT fId);
     ~FUTF8StrChrFieldSearcher() override;
+    void prepare(search::streaming::QueryTermList& qtl,
+                 const SharedSearcherBuf& buf,
+                 const vsm::FieldPathMapT& field_paths,
+                 search::fef::IQueryEnvironment& query_env) override;
     static bool ansiFold(const char * toFold, size_t sz, char * folded);
     static bool lfoldaa(const char * toFold, size_t sz, char * folded, size_t & unalignedStart);
     static bool lfoldua(const char * toFold, size_t sz, char * folded, size_t & alignedStart);
@@ -20,6 +25,7 @@ public:
     virtual size_t match(const char *folded, size_t sz, search::streaming::QueryTerm & qt);
     size_t match(const char *folded, size_t sz, size_t mintsz, search::streaming::QueryTerm ** qtl, size_t qtlSize);
     std::vector<char> _folded;
+    FirstCharFilter   _first_chars;
 };
 
 }
@@ -15,6 +15,24 @@ UTF8SubStringFieldSearcher::duplicate() const
     return std::make_unique<UTF8SubStringFieldSearcher>(*this);
 }
 
+void
+UTF8SubStringFieldSearcher::prepare(QueryTermList& qtl,
+                                    const SharedSearcherBuf& buf,
+                                    const vsm::FieldPathMapT& field_paths,
+                                    search::fef::IQueryEnvironment& query_env)
+{
+    UTF8StringFieldSearcherBase::prepare(qtl, buf, field_paths, query_env);
+    _first_chars.clear();
+    for (auto qt : _qtl) {
+        const cmptype_t * term;
+        if (qt->term(term) > 0) {
+            _first_chars.add(term[0]);
+        } else {
+            _first_chars.add_all();
+        }
+    }
+}
+
 size_t
 UTF8SubStringFieldSearcher::matchTerms(const FieldRef & f, const size_t mintsz)
 {
@@ -30,14 +48,16 @@ UTF8SubStringFieldSearcher::matchTerms(const FieldRef & f, const size_t mintsz)
     const cmptype_t * fre = fe - mintsz;
     termcount_t words(0);
     for(words = 0; fn <= fre; ) {
-        for (auto qt : _qtl) {
-            const cmptype_t * term;
-            termsize_t tsz = qt->term(term);
-
-            const cmptype_t *tt=term, *et=term+tsz, *fnt=fn;
-            for (; (tt < et) && (*tt == *fnt); tt++, fnt++);
-            if (tt == et) {
-                addHit(*qt, words);
+        if (_first_chars.may_start(*fn)) {
+            for (auto qt : _qtl) {
+                const cmptype_t * term;
+                termsize_t tsz = qt->term(term);
+
+                const cmptype_t *tt=term, *et=term+tsz, *fnt=fn;
+                for (; (tt < et) && (*tt == *fnt); tt++, fnt++);
+                if (tt == et) {
+                    addHit(*qt, words);
+                }
             }
         }
         if ( ! Fast_UnicodeUtil::IsWordChar(*fn++) ) {
@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
+#include "first_char_filter.h"
 #include "utf8strchrfieldsearcher.h"
 
 namespace vsm {
@@ -12,10 +13,16 @@ class UTF8SubStringFieldSearcher : public UTF8StringFieldSearcherBase
 {
 public:
     std::unique_ptr<FieldSearcher> duplicate() const override;
-    explicit UTF8SubStringFieldSearcher(FieldIdT fId) : UTF8StringFieldSearcherBase(fId) { }
+    explicit UTF8SubStringFieldSearcher(FieldIdT fId) : UTF8StringFieldSearcherBase(fId), _first_chars() { }
+    void prepare(search::streaming::QueryTermList& qtl,
+                 const SharedSearcherBuf& buf,
+                 const vsm::FieldPathMapT& field_paths,
+                 search::fef::IQueryEnvironment& query_env) override;
 protected:
     size_t matchTerm(const FieldRef & f, search::streaming::QueryTerm & qt) override;
     size_t matchTerms(const FieldRef & f, size_t shortestTerm) override;
+private:
+    FirstCharFilter _first_chars;
 };
 
 }
@@ -0,0 +1,56 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vbench/test/all.h>
+
+using namespace vbench;
+
+TEST("require that buckets are contiguous and precise") {
+    for (size_t i = 0; i < 50000; ++i) {
+        uint64_t lowest = HdrHistogram::lowest_of(i);
+        uint64_t highest = HdrHistogram::highest_of(i);
+        EXPECT_EQUAL(i, HdrHistogram::index_of(lowest));
+        EXPECT_EQUAL(i, HdrHistogram::index_of(highest));
+        EXPECT_EQUAL(highest + 1, HdrHistogram::lowest_of(i + 1));
+        EXPECT_LESS_EQUAL((highest - lowest) * 1024, lowest);
+    }
+}
+
+TEST("require that small values are counted exactly") {
+    HdrHistogram hist;
+    for (uint64_t i = 1; i <= 100; ++i) {
+        hist.record(i);
+    }
+    EXPECT_EQUAL(100u, hist.count());
+    EXPECT_EQUAL(1u, hist.min());
+    EXPECT_EQUAL(100u, hist.max());
+    EXPECT_APPROX(50.5, hist.mean(), 10e-6);
+    EXPECT_EQUAL(1u, hist.percentile(0.0));
+    EXPECT_EQUAL(50u, hist.percentile(50.0));
+    EXPECT_EQUAL(99u, hist.percentile(99.0));
+    EXPECT_EQUAL(100u, hist.percentile(100.0));
+}
+
+TEST("require that large values keep three significant digits") {
+    HdrHistogram hist;
+    for (uint64_t i = 1; i <= 100000; ++i) {
+        hist.record(i * 100);
+    }
+    EXPECT_EQUAL(100u, hist.min());
+    EXPECT_EQUAL(10000000u, hist.max());
+    EXPECT_APPROX(5000000.0, hist.percentile(50.0), 5000.0);
+    EXPECT_APPROX(9900000.0, hist.percentile(99.0), 9900.0);
+    EXPECT_APPROX(9990000.0, hist.percentile(99.9), 9990.0);
+    EXPECT_EQUAL(10000000u, hist.percentile(100.0));
+}
+
+TEST("require that empty histogram is well-behaved") {
+    HdrHistogram hist;
+    EXPECT_EQUAL(0u, hist.count());
+    EXPECT_EQUAL(0.0, hist.mean());
+    EXPECT_EQUAL(0u, hist.percentile(99.0));
+    size_t buckets = 0;
+    hist.each_bucket([&](uint64_t, uint64_t, size_t) { ++buckets; });
+    EXPECT_EQUAL(0u, buckets);
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
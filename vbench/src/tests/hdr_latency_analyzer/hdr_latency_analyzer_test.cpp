@@ -0,0 +1,55 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vbench/test/all.h>
+
+using namespace vbench;
+
+void post(double scheduledTime, double startTime, double endTime, Handler<Request> &handler,
+          Request::Status status = Request::STATUS_OK)
+{
+    Request::UP req(new Request());
+    req->scheduledTime(scheduledTime).status(status).startTime(startTime).endTime(endTime);
+    handler.handle(std::move(req));
+}
+
+TEST_FF("require that latency is measured from scheduled time by default",
+        RequestSink(), HdrLatencyAnalyzer(true, "", "", f1))
+{
+    post(1.0, 1.5, 1.6, f2);
+    post(2.0, 2.0, 2.2, f2);
+    post(3.0, 3.0, 3.0, f2, Request::STATUS_DROPPED);
+    post(4.0, 4.0, 4.5, f2, Request::STATUS_FAILED);
+    EXPECT_EQUAL(2u, f2.histogram().count());
+    EXPECT_EQUAL(1u, f2.dropped());
+    EXPECT_EQUAL(1u, f2.failed());
+    EXPECT_APPROX(200000.0, f2.histogram().min(), 200.0);
+    EXPECT_APPROX(600000.0, f2.histogram().max(), 600.0);
+}
+
+TEST_FF("require that latency can be measured from start time",
+        RequestSink(), HdrLatencyAnalyzer(false, "", "", f1))
+{
+    post(1.0, 1.5, 1.6, f2);
+    post(2.0, 2.0, 2.2, f2);
+    EXPECT_APPROX(100000.0, f2.histogram().min(), 100.0);
+    EXPECT_APPROX(200000.0, f2.histogram().max(), 200.0);
+}
+
+TEST_FF("require that percentile distribution can be exported",
+        RequestSink(), HdrLatencyAnalyzer(true, "", "", f1))
+{
+    for (size_t i = 1; i <= 1000; ++i) {
+        f2.addLatency(0.001 * i);
+    }
+    string csv = f2.toCsv();
+    EXPECT_EQUAL(0u, csv.find("latency_ms,percentile,total_count\n"));
+    EXPECT_TRUE(csv.find("1000,100.000000,1000\n") != string::npos);
+    vespalib::Slime slime;
+    EXPECT_TRUE(vespalib::slime::JsonFormat::decode(f2.toJson(), slime) > 0);
+    EXPECT_EQUAL(1000, slime.get()["count"].asLong());
+    EXPECT_EQUAL(7u, slime.get()["percentiles"].entries());
+    EXPECT_APPROX(990.0, slime.get()["percentiles"][3]["latency_ms"].asDouble(), 1.0);
+    fprintf(stderr, "%s", f2.toString().c_str());
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
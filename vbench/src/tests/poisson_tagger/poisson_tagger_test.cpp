@@ -0,0 +1,36 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vbench/test/all.h>
+
+using namespace vbench;
+
+TEST_FF("require that poisson tagger schedules requests at the given average rate",
+        RequestReceptor(), PoissonTagger(100.0, 42, f1))
+{
+    double prev = 0.0;
+    size_t n = 100000;
+    for (size_t i = 0; i < n; ++i) {
+        f2.handle(Request::UP(new Request()));
+        ASSERT_TRUE(f1.request.get() != 0);
+        if (i == 0) {
+            EXPECT_EQUAL(0.0, f1.request->scheduledTime());
+        }
+        EXPECT_GREATER_EQUAL(f1.request->scheduledTime(), prev);
+        prev = f1.request->scheduledTime();
+    }
+    EXPECT_APPROX(double(n - 1) / 100.0, prev, 20.0);
+}
+
+TEST("require that poisson tagger is deterministic for a given seed") {
+    RequestReceptor r1;
+    RequestReceptor r2;
+    PoissonTagger t1(10.0, 7, r1);
+    PoissonTagger t2(10.0, 7, r2);
+    for (size_t i = 0; i < 10; ++i) {
+        t1.handle(Request::UP(new Request()));
+        t2.handle(Request::UP(new Request()));
+        EXPECT_EQUAL(r1.request->scheduledTime(), r2.request->scheduledTime());
+    }
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,88 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "hdr_histogram.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace vbench {
+
+HdrHistogram::HdrHistogram()
+    : _counts(),
+      _total(0),
+      _min(0),
+      _max(0),
+      _sum(0.0)
+{
+}
+
+HdrHistogram::~HdrHistogram() = default;
+
+size_t
+HdrHistogram::index_of(uint64_t value)
+{
+    if (value < 2 * half_count) {
+        return value;
+    }
+    uint32_t shift = (63 - std::countl_zero(value)) - half_bits;
+    return ((shift + 1) * half_count) + ((value >> shift) - half_count);
+}
+
+uint64_t
+HdrHistogram::lowest_of(size_t index)
+{
+    if (index < 2 * half_count) {
+        return index;
+    }
+    uint32_t shift = (index / half_count) - 1;
+    return ((index % half_count) + half_count) << shift;
+}
+
+uint64_t
+HdrHistogram::highest_of(size_t index)
+{
+    return (lowest_of(index + 1) - 1);
+}
+
+void
+HdrHistogram::record(uint64_t value)
+{
+    size_t idx = index_of(value);
+    if (idx >= _counts.size()) {
+        _counts.resize(idx + 1, 0);
+    }
+    ++_counts[idx];
+    if (_total == 0 || value < _min) {
+        _min = value;
+    }
+    if (_total == 0 || value > _max) {
+        _max = value;
+    }
+    ++_total;
+    _sum += value;
+}
+
+double
+HdrHistogram::mean() const
+{
+    return (_total > 0) ? (_sum / _total) : 0.0;
+}
+
+uint64_t
+HdrHistogram::percentile(double per) const
+{
+    if (_total == 0) {
+        return 0;
+    }
+    size_t rank = std::max(size_t(std::ceil((std::clamp(per, 0.0, 100.0) / 100.0) * _total)), size_t(1));
+    size_t acc = 0;
+    for (size_t i = 0; i < _counts.size(); ++i) {
+        acc += _counts[i];
+        if (acc >= rank) {
+            return std::clamp(highest_of(i), _min, _max);
+        }
+    }
+    return _max;
+}
+
+} // namespace vbench
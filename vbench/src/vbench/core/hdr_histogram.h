@@ -0,0 +1,60 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace vbench {
+
+/**
+ * High dynamic range histogram of non-negative integer values
+ * (typically latencies in microseconds). Values are counted in
+ * log-linear buckets: values below 2048 are counted exactly, and
+ * larger values in buckets no wider than 1/1024 of their lowest
+ * value. This gives about 3 significant digits of precision for
+ * any value, using memory proportional to the logarithm of the
+ * largest value recorded.
+ **/
+class HdrHistogram
+{
+private:
+    static constexpr uint32_t half_bits = 10;
+    static constexpr uint64_t half_count = (uint64_t(1) << half_bits);
+
+    std::vector<size_t> _counts;
+    size_t              _total;
+    uint64_t            _min;
+    uint64_t            _max;
+    double              _sum;
+
+public:
+    HdrHistogram();
+    ~HdrHistogram();
+    void record(uint64_t value);
+    size_t count() const { return _total; }
+    uint64_t min() const { return _min; }
+    uint64_t max() const { return _max; }
+    double mean() const;
+
+    // lowest value v such that at least 'per' percent of the recorded values are <= v,
+    // within the precision of the histogram
+    uint64_t percentile(double per) const;
+
+    // visit all non-empty buckets in increasing order as (lowest value, highest value, count)
+    template <typename F>
+    void each_bucket(F &&f) const {
+        for (size_t i = 0; i < _counts.size(); ++i) {
+            if (_counts[i] > 0) {
+                f(lowest_of(i), highest_of(i), _counts[i]);
+            }
+        }
+    }
+
+    static size_t index_of(uint64_t value);
+    static uint64_t lowest_of(size_t index);
+    static uint64_t highest_of(size_t index);
+};
+
+} // namespace vbench
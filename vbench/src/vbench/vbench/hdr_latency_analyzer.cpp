@@ -0,0 +1,143 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "hdr_latency_analyzer.h"
+#include <vespa/vespalib/data/slime/slime.h>
+#include <vespa/vespalib/data/simple_buffer.h>
+#include <cmath>
+#include <cstdio>
+
+namespace vbench {
+
+namespace {
+
+const double percentiles[] = { 50.0, 90.0, 95.0, 99.0, 99.9, 99.99, 100.0 };
+
+double ms(uint64_t us) { return ((double)us) / 1000.0; }
+
+void writeFile(const string &name, const string &content) {
+    FILE *file = fopen(name.c_str(), "w");
+    if (file == nullptr) {
+        fprintf(stderr, "could not open '%s' for writing\n", name.c_str());
+        return;
+    }
+    if (fwrite(content.data(), 1, content.size(), file) != content.size()) {
+        fprintf(stderr, "could not write to '%s'\n", name.c_str());
+    }
+    fclose(file);
+}
+
+} // namespace vbench::<unnamed>
+
+void
+HdrLatencyAnalyzer::writeCsv() const
+{
+    if (!_csvFile.empty()) {
+        writeFile(_csvFile, toCsv());
+    }
+}
+
+void
+HdrLatencyAnalyzer::writeJson() const
+{
+    if (!_jsonFile.empty()) {
+        writeFile(_jsonFile, toJson());
+    }
+}
+
+HdrLatencyAnalyzer::HdrLatencyAnalyzer(bool fromScheduled, const string &csvFile, const string &jsonFile,
+                                       Handler<Request> &next)
+    : _next(next),
+      _fromScheduled(fromScheduled),
+      _csvFile(csvFile),
+      _jsonFile(jsonFile),
+      _hist(),
+      _dropped(0),
+      _failed(0)
+{
+}
+
+HdrLatencyAnalyzer::~HdrLatencyAnalyzer() = default;
+
+void
+HdrLatencyAnalyzer::handle(Request::UP request)
+{
+    if (request->status() == Request::STATUS_OK) {
+        addLatency(_fromScheduled ? request->scheduledLatency() : request->latency());
+    } else if (request->status() == Request::STATUS_DROPPED) {
+        ++_dropped;
+    } else {
+        ++_failed;
+    }
+    _next.handle(std::move(request));
+}
+
+void
+HdrLatencyAnalyzer::report()
+{
+    fprintf(stdout, "%s\n", toString().c_str());
+    writeCsv();
+    writeJson();
+}
+
+void
+HdrLatencyAnalyzer::addLatency(double latency)
+{
+    _hist.record((uint64_t)std::llround(std::max(latency, 0.0) * 1000000.0));
+}
+
+string
+HdrLatencyAnalyzer::toString() const
+{
+    string str = "HdrLatency {\n";
+    str += strfmt("  from: %s\n", _fromScheduled ? "scheduled" : "start");
+    str += strfmt("  count: %zu\n", _hist.count());
+    str += strfmt("  dropped: %zu\n", _dropped);
+    str += strfmt("  failed: %zu\n", _failed);
+    str += strfmt("  min: %g\n", ms(_hist.min()));
+    str += strfmt("  avg: %g\n", _hist.mean() / 1000.0);
+    for (double per: percentiles) {
+        str += strfmt("  %g%%: %g\n", per, ms(_hist.percentile(per)));
+    }
+    str += "}\n";
+    return str;
+}
+
+string
+HdrLatencyAnalyzer::toCsv() const
+{
+    string str = "latency_ms,percentile,total_count\n";
+    size_t acc = 0;
+    _hist.each_bucket([&](uint64_t, uint64_t highest, size_t cnt)
+                      {
+                          acc += cnt;
+                          double per = (100.0 * (double)acc) / (double)_hist.count();
+                          uint64_t value = std::min(std::max(highest, _hist.min()), _hist.max());
+                          str += strfmt("%g,%.6f,%zu\n", ms(value), per, acc);
+                      });
+    return str;
+}
+
+string
+HdrLatencyAnalyzer::toJson() const
+{
+    vespalib::Slime slime;
+    vespalib::slime::Cursor &top = slime.setObject();
+    top.setString("from", _fromScheduled ? "scheduled" : "start");
+    top.setLong("count", _hist.count());
+    top.setLong("dropped", _dropped);
+    top.setLong("failed", _failed);
+    top.setDouble("min_ms", ms(_hist.min()));
+    top.setDouble("avg_ms", _hist.mean() / 1000.0);
+    top.setDouble("max_ms", ms(_hist.max()));
+    vespalib::slime::Cursor &pers = top.setArray("percentiles");
+    for (double per: percentiles) {
+        vespalib::slime::Cursor &obj = pers.addObject();
+        obj.setDouble("percentile", per);
+        obj.setDouble("latency_ms", ms(_hist.percentile(per)));
+    }
+    vespalib::SimpleBuffer buf;
+    vespalib::slime::JsonFormat::encode(slime, buf, false);
+    return buf.get().make_string();
+}
+
+} // namespace vbench
@@ -0,0 +1,49 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "analyzer.h"
+#include <vbench/core/hdr_histogram.h>
+
+namespace vbench {
+
+/**
+ * Component collecting the latency of successful requests in a high
+ * dynamic range histogram with microsecond resolution. By default
+ * latency is measured from the time the request was scheduled to be
+ * sent rather than the time it was actually sent, so that time spent
+ * waiting for an available connection is not hidden from the
+ * results (coordinated omission). The full percentile distribution
+ * may be written to csv and json files in addition to the summary
+ * printed on report.
+ **/
+class HdrLatencyAnalyzer : public Analyzer
+{
+private:
+    Handler<Request> &_next;
+    bool              _fromScheduled;
+    string            _csvFile;
+    string            _jsonFile;
+    HdrHistogram      _hist;
+    size_t            _dropped;
+    size_t            _failed;
+
+    void writeCsv() const;
+    void writeJson() const;
+
+public:
+    HdrLatencyAnalyzer(bool fromScheduled, const string &csvFile, const string &jsonFile,
+                       Handler<Request> &next);
+    ~HdrLatencyAnalyzer() override;
+    void handle(Request::UP request) override;
+    void report() override;
+    void addLatency(double latency);
+    const HdrHistogram &histogram() const { return _hist; }
+    size_t dropped() const { return _dropped; }
+    size_t failed() const { return _failed; }
+    string toString() const;
+    string toCsv() const;
+    string toJson() const;
+};
+
+} // namespace vbench
@@ -5,10 +5,13 @@
 #include "request_generator.h"
 #include "server_tagger.h"
 #include "qps_tagger.h"
+#include "poisson_tagger.h"
 #include "latency_analyzer.h"
+#include "hdr_latency_analyzer.h"
 #include "qps_analyzer.h"
 #include "request_dumper.h"
 #include "ignore_before.h"
+#include <random>
 
 namespace vbench {
 
@@ -35,6 +38,10 @@ NativeFactory::createTagger(const vespalib::slime::Inspector &spec,
     if (type == "QpsTagger") {
         return Tagger::UP(new QpsTagger(spec["qps"].asLong(), next));
     }
+    if (type == "PoissonTagger") {
+        uint64_t seed = spec["seed"].valid() ? spec["seed"].asLong() : std::random_device()();
+        return Tagger::UP(new PoissonTagger(spec["qps"].asDouble(), seed, next));
+    }
     return Tagger::UP();
 }
 
@@ -46,6 +53,11 @@ NativeFactory::createAnalyzer(const vespalib::slime::Inspector &spec,
     if (type == "LatencyAnalyzer") {
         return Analyzer::UP(new LatencyAnalyzer(next));
     }
+    if (type == "HdrLatencyAnalyzer") {
+        bool fromScheduled = (spec["from"].asString().make_string() != "start");
+        return Analyzer::UP(new HdrLatencyAnalyzer(fromScheduled, spec["csv"].asString().make_string(),
+                                                   spec["json"].asString().make_string(), next));
+    }
     if (type == "QpsAnalyzer") {
         return Analyzer::UP(new QpsAnalyzer(next));
     }
@@ -0,0 +1,25 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "poisson_tagger.h"
+
+namespace vbench {
+
+PoissonTagger::PoissonTagger(double qps, uint64_t seed, Handler<Request> &next)
+    : _rnd(seed),
+      _dist(qps),
+      _time(0.0),
+      _next(next)
+{
+}
+
+PoissonTagger::~PoissonTagger() = default;
+
+void
+PoissonTagger::handle(Request::UP request)
+{
+    request->scheduledTime(_time);
+    _time += _dist(_rnd);
+    _next.handle(std::move(request));
+}
+
+} // namespace vbench
@@ -0,0 +1,31 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "tagger.h"
+#include "request.h"
+#include <random>
+
+namespace vbench {
+
+/**
+ * Sets the start time of requests so that they arrive as a Poisson
+ * process with the given average qps, i.e. with exponentially
+ * distributed time between requests. Unlike the fixed intervals of
+ * the QpsTagger, this also exposes how the server handles bursts.
+ **/
+class PoissonTagger : public Tagger
+{
+private:
+    std::mt19937_64                        _rnd;
+    std::exponential_distribution<double>  _dist;
+    double                                 _time;
+    Handler<Request>                      &_next;
+
+public:
+    PoissonTagger(double qps, uint64_t seed, Handler<Request> &next);
+    ~PoissonTagger() override;
+    void handle(Request::UP request) override;
+};
+
+} // namespace vbench
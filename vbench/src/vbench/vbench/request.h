@@ -67,6 +67,10 @@ public:
 
     double latency() const { return (_endTime - _startTime); }
 
+    // latency as seen from the time the request was supposed to be
+    // sent, including any time spent waiting to be sent
+    double scheduledLatency() const { return (_endTime - _scheduledTime); }
+
     void handleHeader(const string &name, const string &value) override;
     void handleContent(const Memory &data) override;
     void handleFailure(const string &reason) override;
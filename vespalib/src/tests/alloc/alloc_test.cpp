@@ -5,6 +5,7 @@
 #include <vespa/vespalib/util/alloc.h>
 #include <vespa/vespalib/util/memory_allocator.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/huge_page_allocator.h>
 #include <vespa/vespalib/util/round_up_to_page_size.h>
 #include <vespa/vespalib/util/size_literals.h>
 #include <cstddef>
@@ -297,4 +298,30 @@ TEST("auto alloced mmap alloc can not be shrinked below HUGEPAGE_SIZE/2 + 1 ") {
     EXPECT_EQUAL(SZ, buf.size());
 }
 
+TEST("huge page allocator uses default allocator for small buffers") {
+    HugePageAllocator allocator;
+    Alloc buf = Alloc::alloc_with_allocator(&allocator).create(1000);
+    EXPECT_EQUAL(1000u, buf.size());
+    memset(buf.get(), 0x55, buf.size());
+    auto stats = allocator.get_stats();
+    EXPECT_EQUAL(0u, stats.huge_page_bytes + stats.fallback_bytes);
+}
+
+TEST("huge page allocator rounds large buffers to huge pages and accounts for them") {
+    static constexpr size_t SZ = MemoryAllocator::HUGEPAGE_SIZE;
+    HugePageAllocator allocator;
+    {
+        Alloc buf = Alloc::alloc_with_allocator(&allocator).create(SZ + 1);
+        EXPECT_EQUAL(2 * SZ, buf.size());
+        memset(buf.get(), 0x55, buf.size());
+        EXPECT_FALSE(buf.resize_inplace(3 * SZ));
+        auto stats = allocator.get_stats();
+        // Huge pages might not be available, in which case an ordinary mapping is used
+        EXPECT_EQUAL(2 * SZ, stats.huge_page_bytes + stats.fallback_bytes);
+        EXPECT_EQUAL((stats.fallback_bytes != 0) ? 1u : 0u, stats.fallbacks);
+    }
+    auto stats = allocator.get_stats();
+    EXPECT_EQUAL(0u, stats.huge_page_bytes + stats.fallback_bytes);
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -882,6 +882,35 @@ TEST_F(BTreeAggregationTest, require_that_basic_tree_iterator_works)
     }
 }
 
+TEST_F(BTreeAggregationTest, require_that_tree_iterator_provides_leaf_aggregated_values)
+{
+    MyTree tree;
+    std::vector<LeafPair> exp;
+    size_t numEntries = 1000;
+    generateData(exp, numEntries);
+    for (size_t i = 0; i < numEntries; ++i) {
+        tree.insert(exp[i].first, exp[i].second);
+    }
+    std::sort(exp.begin(), exp.end(), LeafPairLess());
+    size_t ei = 0;
+    size_t num_leaves = 0;
+    for (MyTree::Iterator itr = tree.begin(); itr.valid(); ) {
+        int last_key = UNWRAP(itr.getLeafLastKey());
+        MinMaxAggregated leaf_aggr = itr.getLeafAggregated();
+        MinMaxAggregated exp_aggr;
+        for (; itr.valid() && UNWRAP(itr.getKey()) <= last_key; ++itr, ++ei) {
+            EXPECT_EQ(last_key, UNWRAP(itr.getLeafLastKey()));
+            exp_aggr.add(itr.getData());
+        }
+        EXPECT_EQ(last_key, UNWRAP(exp[ei - 1].first));
+        EXPECT_EQ(exp_aggr.getMin(), leaf_aggr.getMin());
+        EXPECT_EQ(exp_aggr.getMax(), leaf_aggr.getMax());
+        ++num_leaves;
+    }
+    EXPECT_EQ(numEntries, ei);
+    EXPECT_LT(1u, num_leaves);
+}
+
 TEST_F(BTreeAggregationTest, require_that_tree_iterator_assign_works)
 {
     GenerationHandler g;
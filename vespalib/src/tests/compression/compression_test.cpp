@@ -3,6 +3,9 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/vespalib/stllike/string.h>
 #include <vespa/vespalib/util/compressor.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
+#include <vespa/vespalib/util/size_literals.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/data/databuffer.h>
 
 #include <vespa/log/log.h>
@@ -67,6 +70,48 @@ TEST("requiret that zstd compression/decompression works") {
     EXPECT_EQUAL(_G_compressableText, vespalib::string(decompress.data(), decompress.size()));
 }
 
+std::vector<vespalib::string> makeSimilarDocuments(size_t count) {
+    std::vector<vespalib::string> docs;
+    for (size_t i(0); i < count; i++) {
+        docs.push_back(make_string("{\"title\":\"Document number %zu\",\"category\":\"sports\","
+                                   "\"body\":\"Some body text that is shared between many documents %zu\","
+                                   "\"popularity\":%zu}", i, i * 7, i % 13));
+    }
+    return docs;
+}
+
+std::vector<ConstBufferRef> asSamples(const std::vector<vespalib::string> & docs) {
+    std::vector<ConstBufferRef> samples;
+    for (const auto & doc : docs) {
+        samples.emplace_back(doc.data(), doc.size());
+    }
+    return samples;
+}
+
+TEST("require that zstd dictionary compression/decompression works") {
+    auto docs = makeSimilarDocuments(1000);
+    std::vector<char> dict = ZStdDictionaryCompressor::train(asSamples(docs), 4_Ki);
+    ASSERT_FALSE(dict.empty());
+    EXPECT_LESS_EQUAL(dict.size(), 4_Ki);
+    ZStdDictionaryCompressor compressor(ConstBufferRef(dict.data(), dict.size()));
+    EXPECT_NOT_EQUAL(0u, compressor.getDictionaryId());
+    CompressionConfig cfg(CompressionConfig::Type::ZSTD);
+    const vespalib::string & doc = docs[17];
+    DataBuffer plain;
+    EXPECT_EQUAL(CompressionConfig::Type::ZSTD, compress(cfg, ConstBufferRef(doc.data(), doc.size()), plain, false));
+    DataBuffer compressed;
+    EXPECT_EQUAL(CompressionConfig::Type::ZSTD, compress(compressor, cfg, ConstBufferRef(doc.data(), doc.size()), compressed));
+    EXPECT_LESS(compressed.getDataLen(), plain.getDataLen());
+    DataBuffer decompressed;
+    decompress(compressor, doc.size(), ConstBufferRef(compressed.getData(), compressed.getDataLen()), decompressed, false);
+    EXPECT_EQUAL(doc, vespalib::string(decompressed.getData(), decompressed.getDataLen()));
+}
+
+TEST("require that zstd dictionary training fails gracefully with too few samples") {
+    auto docs = makeSimilarDocuments(2);
+    EXPECT_TRUE(ZStdDictionaryCompressor::train(asSamples(docs), 4_Ki).empty());
+}
+
 TEST("require that CompressionConfig is Atomic") {
     EXPECT_EQUAL(8u, sizeof(CompressionConfig));
     EXPECT_TRUE(std::atomic<CompressionConfig>::is_always_lock_free);
@@ -232,4 +232,21 @@ TEST(ExecutionProfilerTest, flat_profiling_does_not_report_tasks_with_count_0) {
     EXPECT_EQ(slime["roots"][0]["count"].asLong(), 1);
 }
 
+TEST(ExecutionProfilerTest, total_count_and_time_are_summarized) {
+    Profiler tree_profiler(64);
+    Profiler flat_profiler(-2);
+    EXPECT_EQ(tree_profiler.total_count(), 0);
+    EXPECT_EQ(flat_profiler.total_count(), 0);
+    for (int i = 0; i < 3; ++i) {
+        foo(tree_profiler);
+        fox(tree_profiler);
+        foo(flat_profiler);
+        fox(flat_profiler);
+    }
+    EXPECT_EQ(tree_profiler.total_count(), 3 * 18);
+    EXPECT_EQ(flat_profiler.total_count(), 3 * 18);
+    EXPECT_GE(tree_profiler.total_time(), 3 * 13ms);
+    EXPECT_GE(flat_profiler.total_time(), 3 * 13ms);
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -3,6 +3,7 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/vespalib/hwaccelrated/iaccelrated.h>
 #include <vespa/vespalib/hwaccelrated/generic.h>
+#include <vespa/vespalib/util/bfloat16.h>
 #include <vespa/log/log.h>
 LOG_SETUP("hwaccelrated_test");
 
@@ -47,4 +48,83 @@ TEST("test euclidean distance") {
     TEST_DO(verifyEuclideanDistance(hwaccelrated::IAccelrated::getAccelerator(), TEST_LENGTH));
 }
 
+void
+verifyBFloat16(const hwaccelrated::IAccelrated & accel, size_t testLength) {
+    srand(1);
+    std::vector<float> a = createAndFill<float>(testLength);
+    std::vector<float> bf = createAndFill<float>(testLength);
+    std::vector<BFloat16> b;
+    for (float v : bf) {
+        b.emplace_back(v * 0.01f);
+    }
+    for (size_t j(0); j < 0x20; j++) {
+        double dot(0);
+        double selfDot(0);
+        double distance(0);
+        for (size_t i(j); i < testLength; i++) {
+            double bv = b[i].to_float();
+            dot += a[i] * bv;
+            selfDot += bv * bv;
+            distance += (a[i] - bv) * (a[i] - bv);
+        }
+        EXPECT_APPROX(dot, accel.dotProduct(&a[j], &b[j], testLength - j), dot*0.0001);
+        EXPECT_APPROX(selfDot, accel.dotProduct(&b[j], &b[j], testLength - j), selfDot*0.0001);
+        EXPECT_APPROX(distance, accel.squaredEuclideanDistance(&a[j], &b[j], testLength - j), distance*0.0001);
+    }
+}
+
+void
+verifyInt8DotProduct(const hwaccelrated::IAccelrated & accel, size_t testLength) {
+    srand(1);
+    std::vector<int8_t> a(testLength);
+    std::vector<int8_t> b(testLength);
+    for (size_t i(0); i < testLength; i++) {
+        a[i] = -128; // worst case for the accumulator
+        b[i] = (i % 3 == 0) ? -128 : rand()%256 - 128;
+    }
+    for (size_t j(0); j < 0x20; j++) {
+        int64_t sum(0);
+        for (size_t i(j); i < testLength; i++) {
+            sum += int64_t(a[i]) * b[i];
+        }
+        EXPECT_EQUAL(sum, accel.dotProduct(&a[j], &b[j], testLength - j));
+    }
+}
+
+void
+verifyBinaryHammingDistance(const hwaccelrated::IAccelrated & accel, size_t testLength) {
+    srand(1);
+    std::vector<uint8_t> a(testLength);
+    std::vector<uint8_t> b(testLength);
+    for (size_t i(0); i < testLength; i++) {
+        a[i] = rand();
+        b[i] = rand();
+    }
+    for (size_t j(0); j < 0x20; j++) {
+        size_t expected(0);
+        for (size_t i(j); i < testLength; i++) {
+            expected += __builtin_popcount(a[i] ^ b[i]);
+        }
+        EXPECT_EQUAL(expected, accel.binaryHammingDistance(&a[j], &b[j], testLength - j));
+    }
+}
+
+TEST("test bfloat16 dot product and euclidean distance") {
+    constexpr size_t TEST_LENGTH = 1000;
+    TEST_DO(verifyBFloat16(hwaccelrated::GenericAccelrator(), TEST_LENGTH));
+    TEST_DO(verifyBFloat16(hwaccelrated::IAccelrated::getAccelerator(), TEST_LENGTH));
+}
+
+TEST("test int8 dot product") {
+    constexpr size_t TEST_LENGTH = 140000; // must be longer than 64k
+    TEST_DO(verifyInt8DotProduct(hwaccelrated::GenericAccelrator(), TEST_LENGTH));
+    TEST_DO(verifyInt8DotProduct(hwaccelrated::IAccelrated::getAccelerator(), TEST_LENGTH));
+}
+
+TEST("test binary hamming distance") {
+    constexpr size_t TEST_LENGTH = 1000;
+    TEST_DO(verifyBinaryHammingDistance(hwaccelrated::GenericAccelrator(), TEST_LENGTH));
+    TEST_DO(verifyBinaryHammingDistance(hwaccelrated::IAccelrated::getAccelerator(), TEST_LENGTH));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,84 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/io/file_read_batch.h>
+#include <vespa/vespalib/io/fileutil.h>
+#include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <filesystem>
+#include <vector>
+
+using vespalib::File;
+using vespalib::FileReadBatch;
+using vespalib::IoException;
+
+namespace {
+
+const vespalib::string file_name("file_read_batch_test.dat");
+constexpr size_t file_size = 100000;
+
+char expected_byte(size_t offset) {
+    return static_cast<char>((offset * 7) % 251);
+}
+
+}
+
+class FileReadBatchTest : public ::testing::Test {
+protected:
+    File _file;
+
+    FileReadBatchTest()
+        : _file(file_name)
+    {
+        std::vector<char> data(file_size);
+        for (size_t i = 0; i < file_size; ++i) {
+            data[i] = expected_byte(i);
+        }
+        _file.open(File::CREATE | File::TRUNC);
+        _file.write(data.data(), data.size(), 0);
+        _file.close();
+        _file.open(File::READONLY);
+    }
+    ~FileReadBatchTest() override {
+        _file.close();
+        std::filesystem::remove(std::filesystem::path(file_name));
+    }
+};
+
+TEST_F(FileReadBatchTest, all_requests_are_read)
+{
+    // More requests than fits in the ring at once
+    size_t num_requests = 200;
+    std::vector<std::vector<char>> buffers;
+    std::vector<FileReadBatch::Request> requests;
+    for (size_t i = 0; i < num_requests; ++i) {
+        size_t len = 1 + (i * 37) % 2000;
+        off_t offset = (i * 4099) % (file_size - len);
+        buffers.emplace_back(len);
+        requests.push_back({buffers.back().data(), len, offset});
+    }
+    FileReadBatch::read(_file, requests);
+    for (size_t i = 0; i < num_requests; ++i) {
+        const auto &req = requests[i];
+        for (size_t j = 0; j < req.len; ++j) {
+            ASSERT_EQ(expected_byte(req.offset + j), buffers[i][j]) << "request " << i << ", byte " << j;
+        }
+    }
+}
+
+TEST_F(FileReadBatchTest, read_beyond_end_of_file_throws)
+{
+    std::vector<char> buf_1(100);
+    std::vector<char> buf_2(100);
+    std::vector<FileReadBatch::Request> requests;
+    requests.push_back({buf_1.data(), buf_1.size(), 0});
+    requests.push_back({buf_2.data(), buf_2.size(), file_size - 50});
+    EXPECT_THROW(FileReadBatch::read(_file, requests), IoException);
+    EXPECT_EQ(expected_byte(99), buf_1[99]);
+}
+
+TEST_F(FileReadBatchTest, empty_batch_is_ok)
+{
+    FileReadBatch::read(_file, {});
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,106 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/util/numa.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+using vespalib::NumaNodes;
+using vespalib::Runnable;
+using vespalib::bind_to_numa_node;
+using vespalib::bind_to_numa_nodes;
+using vespalib::current_numa_node;
+using CpuList = NumaNodes::CpuList;
+
+namespace {
+
+struct RunFun : Runnable {
+    std::function<void()> my_fun;
+    RunFun(std::function<void()> fun_in) : my_fun(std::move(fun_in)) {}
+    void run() override { my_fun(); }
+};
+
+int my_init_fun(Runnable &target) {
+    target.run();
+    return 1;
+}
+
+int node_of_thread_started_with(Runnable::init_fun_t init_fun) {
+    int node = -2;
+    std::thread thread([&]
+                       {
+                           RunFun run_fun([&node] { node = current_numa_node(); });
+                           init_fun(run_fun);
+                       });
+    thread.join();
+    return node;
+}
+
+void write_file(const std::string &name, const std::string &content) {
+    std::ofstream file(name);
+    file << content << "\n";
+}
+
+std::shared_ptr<const NumaNodes> make_nodes(size_t n) {
+    std::vector<NumaNodes::Node> nodes;
+    for (size_t i = 0; i < n; ++i) {
+        nodes.push_back(NumaNodes::Node{uint32_t(i), CpuList{0}});
+    }
+    return std::make_shared<const NumaNodes>(std::move(nodes));
+}
+
+}
+
+TEST(NumaTest, cpu_lists_can_be_parsed)
+{
+    EXPECT_EQ(CpuList({0}), NumaNodes::parse_list("0"));
+    EXPECT_EQ(CpuList({0, 1, 2, 3, 8, 10, 11}), NumaNodes::parse_list("0-3,8,10-11\n"));
+    EXPECT_EQ(CpuList(), NumaNodes::parse_list(""));
+    EXPECT_EQ(CpuList(), NumaNodes::parse_list("0-"));
+    EXPECT_EQ(CpuList(), NumaNodes::parse_list("3-1"));
+    EXPECT_EQ(CpuList(), NumaNodes::parse_list("0,x"));
+}
+
+TEST(NumaTest, nodes_are_detected_from_sysfs)
+{
+    std::filesystem::path dir("numa_test_sysfs");
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir / "node0");
+    std::filesystem::create_directories(dir / "node2");
+    write_file(dir / "online", "0,2");
+    write_file(dir / "node0" / "cpulist", "0-1,4-5");
+    write_file(dir / "node2" / "cpulist", "2-3,6-7");
+    auto nodes = NumaNodes::detect(dir.string());
+    ASSERT_EQ(2u, nodes.size());
+    EXPECT_EQ(0u, nodes.node(0).id);
+    EXPECT_EQ(CpuList({0, 1, 4, 5}), nodes.node(0).cpus);
+    EXPECT_EQ(2u, nodes.node(1).id);
+    EXPECT_EQ(CpuList({2, 3, 6, 7}), nodes.node(1).cpus);
+    EXPECT_EQ(0u, NumaNodes::detect((dir / "missing").string()).size());
+    std::filesystem::remove_all(dir);
+}
+
+TEST(NumaTest, threads_are_not_bound_without_multiple_nodes)
+{
+    EXPECT_EQ(-1, current_numa_node());
+    EXPECT_EQ(-1, node_of_thread_started_with(bind_to_numa_nodes(my_init_fun, {})));
+    EXPECT_EQ(-1, node_of_thread_started_with(bind_to_numa_nodes(my_init_fun, make_nodes(1))));
+    EXPECT_EQ(-1, node_of_thread_started_with(bind_to_numa_node(my_init_fun, make_nodes(2), 2)));
+}
+
+TEST(NumaTest, threads_are_bound_to_nodes_round_robin)
+{
+    auto init_fun = bind_to_numa_nodes(my_init_fun, make_nodes(3));
+    EXPECT_EQ(0, node_of_thread_started_with(init_fun));
+    EXPECT_EQ(1, node_of_thread_started_with(init_fun));
+    EXPECT_EQ(2, node_of_thread_started_with(init_fun));
+    EXPECT_EQ(0, node_of_thread_started_with(init_fun));
+}
+
+TEST(NumaTest, thread_can_be_bound_to_specific_node)
+{
+    EXPECT_EQ(1, node_of_thread_started_with(bind_to_numa_node(my_init_fun, make_nodes(2), 1)));
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -48,6 +48,51 @@ TEST("testCache") {
     EXPECT_TRUE(cache.size() == 1);
 }
 
+TEST("require that populate inserts objects read outside the cache") {
+    B m;
+    cache< CacheParam<P, B> > cache(m, -1);
+    m[1] = "first";
+    m[2] = "second";
+    size_t generation = cache.generation(1);
+    EXPECT_TRUE(cache.populate(1, m[1], generation));
+    EXPECT_TRUE(cache.hasKey(1));
+    EXPECT_EQUAL(1u, cache.getInsert());
+    EXPECT_FALSE(cache.populate(1, "other", generation));
+    EXPECT_EQUAL("first", cache.read(1));
+    EXPECT_EQUAL(1u, cache.getHit());
+}
+
+TEST("require that populate is rejected after write or invalidate of the same key") {
+    B m;
+    cache< CacheParam<P, B> > cache(m, -1);
+    size_t generation = cache.generation(1);
+    cache.invalidate(1);
+    EXPECT_FALSE(cache.populate(1, "stale", generation));
+    EXPECT_FALSE(cache.hasKey(1));
+    generation = cache.generation(1);
+    cache.write(1, "first");
+    cache.invalidate(1);
+    EXPECT_FALSE(cache.populate(1, "stale", generation));
+    EXPECT_FALSE(cache.hasKey(1));
+    EXPECT_TRUE(cache.populate(1, "fresh", cache.generation(1)));
+    EXPECT_EQUAL("fresh", cache.read(1));
+}
+
+TEST("require that populate is not rejected by writes to keys in other lock stripes") {
+    B m;
+    cache< CacheParam<P, B> > cache(m, -1);
+    size_t generation = cache.generation(1);
+    cache.write(2, "second");
+    cache.invalidate(3);
+    EXPECT_EQUAL(generation, cache.generation(1));
+    EXPECT_TRUE(cache.populate(1, "first", generation));
+    EXPECT_EQUAL("first", cache.read(1));
+    // Keys sharing lock stripe with 1 do reject it
+    generation = cache.generation(4);
+    cache.invalidate(4 + 113);
+    EXPECT_FALSE(cache.populate(4, "fourth", generation));
+}
+
 TEST("testCacheSize")
 {
     B m;
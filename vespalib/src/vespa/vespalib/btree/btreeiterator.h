@@ -333,6 +333,18 @@ public:
      */
     const DataType & getData() const noexcept { return _leaf.getData(); }
 
+    /**
+     * Get last key in the leaf node at current iterator location.
+     * Only valid when iterator is at a valid element.
+     */
+    const KeyType & getLeafLastKey() const noexcept { return _leaf.getNode()->getLastKey(); }
+
+    /**
+     * Get aggregated values for the leaf node at current iterator
+     * location. Only valid when iterator is at a valid element.
+     */
+    const AggrT & getLeafAggregated() const noexcept { return _leaf.getNode()->getAggregated(); }
+
     /**
      * Check if iterator is at a valid element, i.e. not at end.
      */
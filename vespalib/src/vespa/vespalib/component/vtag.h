@@ -15,6 +15,8 @@ extern char VersionTagBuilder[];
 extern char VersionTagPkg[];
 extern char VersionTagComponent[];
 extern char VersionTagArch[];
+extern char VersionTagCommitSha[];
+extern char VersionTagCommitDate[];
 
 
 class Vtag {
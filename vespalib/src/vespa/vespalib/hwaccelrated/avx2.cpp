@@ -2,9 +2,15 @@
 
 #include "avx2.h"
 #include "avxprivate.hpp"
+#include <vespa/vespalib/util/binary_hamming_distance.h>
 
 namespace vespalib::hwaccelrated {
 
+int64_t
+Avx2Accelrator::dotProduct(const int8_t * a, const int8_t * b, size_t sz) const noexcept {
+    return helper::dotProduct(a, b, sz);
+}
+
 size_t
 Avx2Accelrator::populationCount(const uint64_t *a, size_t sz) const noexcept {
     return helper::populationCount(a, sz);
@@ -25,6 +31,26 @@ Avx2Accelrator::squaredEuclideanDistance(const double * a, const double * b, siz
     return avx::euclideanDistanceSelectAlignment<double, 32>(a, b, sz);
 }
 
+float
+Avx2Accelrator::dotProduct(const float * a, const BFloat16 * b, size_t sz) const noexcept {
+    return avx::dotProductBFloat16<float, BFloat16, 32>(a, b, sz);
+}
+
+float
+Avx2Accelrator::dotProduct(const BFloat16 * a, const BFloat16 * b, size_t sz) const noexcept {
+    return avx::dotProductBFloat16<BFloat16, BFloat16, 32>(a, b, sz);
+}
+
+double
+Avx2Accelrator::squaredEuclideanDistance(const float * a, const BFloat16 * b, size_t sz) const noexcept {
+    return avx::euclideanDistanceBFloat16<32>(a, b, sz);
+}
+
+size_t
+Avx2Accelrator::binaryHammingDistance(const void * a, const void * b, size_t sz) const noexcept {
+    return vespalib::binary_hamming_distance(a, b, sz);
+}
+
 void
 Avx2Accelrator::and128(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const noexcept {
     helper::andChunks<32u, 4u>(offset, src, dest);
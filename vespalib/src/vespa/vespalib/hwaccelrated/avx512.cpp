@@ -2,9 +2,36 @@
 
 #include "avx512.h"
 #include "avxprivate.hpp"
+#include <vespa/vespalib/util/binary_hamming_distance.h>
+#include <immintrin.h>
 
 namespace vespalib:: hwaccelrated {
 
+namespace {
+
+// Only Ice Lake and later have VPOPCNTDQ, so it is selected at runtime instead of through -march.
+__attribute__((target("avx512vpopcntdq")))
+size_t
+binaryHammingDistanceVpopcnt(const void * lhs, const void * rhs, size_t sz) noexcept {
+    auto a = static_cast<const uint8_t *>(lhs);
+    auto b = static_cast<const uint8_t *>(rhs);
+    __m512i sum = _mm512_setzero_si512();
+    size_t i(0);
+    for (; (i + 64) <= sz; i += 64) {
+        __m512i x = _mm512_xor_si512(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i));
+        sum = _mm512_add_epi64(sum, _mm512_popcnt_epi64(x));
+    }
+    return _mm512_reduce_add_epi64(sum) + vespalib::binary_hamming_distance(a + i, b + i, sz - i);
+}
+
+}
+
+Avx512Accelrator::Avx512Accelrator()
+    : Avx2Accelrator(),
+      _has_vpopcntdq(__builtin_cpu_supports("avx512vpopcntdq"))
+{
+}
+
 float
 Avx512Accelrator::dotProduct(const float * af, const float * bf, size_t sz) const noexcept {
     return avx::dotProductSelectAlignment<float, 64>(af, bf, sz);
@@ -15,6 +42,11 @@ Avx512Accelrator::dotProduct(const double * af, const double * bf, size_t sz) co
     return avx::dotProductSelectAlignment<double, 64>(af, bf, sz);
 }
 
+int64_t
+Avx512Accelrator::dotProduct(const int8_t * a, const int8_t * b, size_t sz) const noexcept {
+    return helper::dotProduct(a, b, sz);
+}
+
 size_t
 Avx512Accelrator::populationCount(const uint64_t *a, size_t sz) const noexcept {
     return helper::populationCount(a, sz);
@@ -35,6 +67,29 @@ Avx512Accelrator::squaredEuclideanDistance(const double * a, const double * b, s
     return avx::euclideanDistanceSelectAlignment<double, 64>(a, b, sz);
 }
 
+float
+Avx512Accelrator::dotProduct(const float * a, const BFloat16 * b, size_t sz) const noexcept {
+    return avx::dotProductBFloat16<float, BFloat16, 64>(a, b, sz);
+}
+
+float
+Avx512Accelrator::dotProduct(const BFloat16 * a, const BFloat16 * b, size_t sz) const noexcept {
+    return avx::dotProductBFloat16<BFloat16, BFloat16, 64>(a, b, sz);
+}
+
+double
+Avx512Accelrator::squaredEuclideanDistance(const float * a, const BFloat16 * b, size_t sz) const noexcept {
+    return avx::euclideanDistanceBFloat16<64>(a, b, sz);
+}
+
+size_t
+Avx512Accelrator::binaryHammingDistance(const void * a, const void * b, size_t sz) const noexcept {
+    if (_has_vpopcntdq) {
+        return binaryHammingDistanceVpopcnt(a, b, sz);
+    }
+    return vespalib::binary_hamming_distance(a, b, sz);
+}
+
 void
 Avx512Accelrator::and128(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const noexcept {
     helper::andChunks<64, 2>(offset, src, dest);
@@ -11,13 +11,21 @@ namespace vespalib::hwaccelrated {
  */
 class Avx512Accelrator : public Avx2Accelrator
 {
+private:
+    bool _has_vpopcntdq;
 public:
+    Avx512Accelrator();
     float dotProduct(const float * a, const float * b, size_t sz) const noexcept override;
     double dotProduct(const double * a, const double * b, size_t sz) const noexcept override;
+    int64_t dotProduct(const int8_t * a, const int8_t * b, size_t sz) const noexcept override;
     size_t populationCount(const uint64_t *a, size_t sz) const noexcept override;
     double squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const noexcept override;
     double squaredEuclideanDistance(const float * a, const float * b, size_t sz) const noexcept override;
     double squaredEuclideanDistance(const double * a, const double * b, size_t sz) const noexcept override;
+    float dotProduct(const float * a, const BFloat16 * b, size_t sz) const noexcept override;
+    float dotProduct(const BFloat16 * a, const BFloat16 * b, size_t sz) const noexcept override;
+    double squaredEuclideanDistance(const float * a, const BFloat16 * b, size_t sz) const noexcept override;
+    size_t binaryHammingDistance(const void * a, const void * b, size_t sz) const noexcept override;
     void and128(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const noexcept override;
     void or128(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const noexcept override;
 };
@@ -133,4 +133,95 @@ double euclideanDistanceSelectAlignment(const T * af, const T * bf, size_t sz) n
     }
 }
 
+/**
+ * Loads VLEN bytes worth of floats, widening bfloat16 by shifting the
+ * raw bits into the upper half of each float. Specialized per vector
+ * length since gcc does not handle vector builtins on dependent types.
+ */
+template <unsigned VLEN>
+struct FloatLoader;
+
+template <>
+struct FloatLoader<32> {
+    typedef float V __attribute__ ((vector_size (32)));
+    typedef uint32_t U __attribute__ ((vector_size (32)));
+    typedef uint16_t H __attribute__ ((vector_size (16)));
+    static constexpr size_t N = sizeof(V)/sizeof(float);
+    static V load(const float * p) noexcept {
+        V v;
+        memcpy(&v, p, sizeof(V));
+        return v;
+    }
+    static V load(const BFloat16 * p) noexcept {
+        H h;
+        memcpy(&h, p, sizeof(H));
+        return (V)(__builtin_convertvector(h, U) << 16);
+    }
+};
+
+#ifdef __AVX512F__
+template <>
+struct FloatLoader<64> {
+    typedef float V __attribute__ ((vector_size (64)));
+    typedef uint32_t U __attribute__ ((vector_size (64)));
+    typedef uint16_t H __attribute__ ((vector_size (32)));
+    static constexpr size_t N = sizeof(V)/sizeof(float);
+    static V load(const float * p) noexcept {
+        V v;
+        memcpy(&v, p, sizeof(V));
+        return v;
+    }
+    static V load(const BFloat16 * p) noexcept {
+        H h;
+        memcpy(&h, p, sizeof(H));
+        return (V)(__builtin_convertvector(h, U) << 16);
+    }
+};
+#endif
+
+template <typename TA, typename TB, unsigned VLEN>
+float
+dotProductBFloat16(const TA * a, const TB * b, size_t sz) noexcept
+{
+    using L = FloatLoader<VLEN>;
+    using V = typename L::V;
+    constexpr unsigned VectorsPerChunk = 4;
+    constexpr size_t ChunkSize = L::N*VectorsPerChunk;
+    V partial[VectorsPerChunk];
+    memset(partial, 0, sizeof(partial));
+    const size_t numChunks(sz/ChunkSize);
+    for (size_t i(0); i < numChunks; i++) {
+        for (size_t j(0); j < VectorsPerChunk; j++) {
+            size_t offset = i*ChunkSize + j*L::N;
+            partial[j] += L::load(a + offset) * L::load(b + offset);
+        }
+    }
+    float sum = helper::dotProduct(a + numChunks*ChunkSize, b + numChunks*ChunkSize, sz - numChunks*ChunkSize);
+    partial[0] = sumR<V, VectorsPerChunk>(partial);
+    return sum + sumT<float, V>(partial[0]);
+}
+
+template <unsigned VLEN>
+double
+euclideanDistanceBFloat16(const float * a, const BFloat16 * b, size_t sz) noexcept
+{
+    using L = FloatLoader<VLEN>;
+    using V = typename L::V;
+    constexpr unsigned VectorsPerChunk = 4;
+    constexpr size_t ChunkSize = L::N*VectorsPerChunk;
+    V partial[VectorsPerChunk];
+    memset(partial, 0, sizeof(partial));
+    const size_t numChunks(sz/ChunkSize);
+    for (size_t i(0); i < numChunks; i++) {
+        for (size_t j(0); j < VectorsPerChunk; j++) {
+            size_t offset = i*ChunkSize + j*L::N;
+            V d = L::load(a + offset) - L::load(b + offset);
+            partial[j] += d * d;
+        }
+    }
+    double sum = helper::squaredEuclideanDistance(a + numChunks*ChunkSize, b + numChunks*ChunkSize, sz - numChunks*ChunkSize);
+    partial[0] = sumR<V, VectorsPerChunk>(partial);
+    return sum + sumT<float, V>(partial[0]);
+}
+
 }
@@ -2,6 +2,7 @@
 
 #include "generic.h"
 #include "private_helpers.hpp"
+#include <vespa/vespalib/util/binary_hamming_distance.h>
 #include <cblas.h>
 
 namespace vespalib::hwaccelrated {
@@ -172,6 +173,26 @@ GenericAccelrator::squaredEuclideanDistance(const double * a, const double * b,
     return squaredEuclideanDistanceT<double, 2>(a, b, sz);
 }
 
+float
+GenericAccelrator::dotProduct(const float * a, const BFloat16 * b, size_t sz) const noexcept {
+    return helper::dotProduct(a, b, sz);
+}
+
+float
+GenericAccelrator::dotProduct(const BFloat16 * a, const BFloat16 * b, size_t sz) const noexcept {
+    return helper::dotProduct(a, b, sz);
+}
+
+double
+GenericAccelrator::squaredEuclideanDistance(const float * a, const BFloat16 * b, size_t sz) const noexcept {
+    return helper::squaredEuclideanDistance(a, b, sz);
+}
+
+size_t
+GenericAccelrator::binaryHammingDistance(const void * a, const void * b, size_t sz) const noexcept {
+    return vespalib::binary_hamming_distance(a, b, sz);
+}
+
 void
 GenericAccelrator::and128(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const noexcept {
     helper::andChunks<16, 8>(offset, src, dest);
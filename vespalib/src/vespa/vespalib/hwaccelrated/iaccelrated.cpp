@@ -6,6 +6,7 @@
 #include "avx2.h"
 #include "avx512.h"
 #endif
+#include <vespa/vespalib/util/bfloat16.h>
 #include <vespa/vespalib/util/memory.h>
 #include <cstdio>
 #include <vector>
@@ -80,6 +81,81 @@ verifyEuclideanDistance(const IAccelrated & accel) {
     }
 }
 
+void
+verifyInt8Dotproduct(const IAccelrated & accel)
+{
+    const size_t testLength(255);
+    srand(1);
+    std::vector<int8_t> a(testLength);
+    std::vector<int8_t> b(testLength);
+    for (size_t i(0); i < testLength; i++) {
+        a[i] = rand()%256 - 128;
+        b[i] = rand()%256 - 128;
+    }
+    for (size_t j(0); j < 0x20; j++) {
+        int64_t sum(0);
+        for (size_t i(j); i < testLength; i++) {
+            sum += a[i]*b[i];
+        }
+        int64_t hwComputedSum(accel.dotProduct(&a[j], &b[j], testLength - j));
+        if (sum != hwComputedSum) {
+            fprintf(stderr, "Accelrator is not computing int8 dotproduct correctly.\n");
+            LOG_ABORT("should not be reached");
+        }
+    }
+}
+
+void
+verifyBFloat16(const IAccelrated & accel)
+{
+    // Small integers are exact in bfloat16, and all sums are exact in float
+    const size_t testLength(255);
+    srand(1);
+    std::vector<float> a = createAndFill<float>(testLength);
+    std::vector<float> bf = createAndFill<float>(testLength);
+    std::vector<BFloat16> b(bf.begin(), bf.end());
+    for (size_t j(0); j < 0x20; j++) {
+        float dot(0);
+        float selfDot(0);
+        float distance(0);
+        for (size_t i(j); i < testLength; i++) {
+            dot += a[i] * bf[i];
+            selfDot += bf[i] * bf[i];
+            distance += (a[i] - bf[i]) * (a[i] - bf[i]);
+        }
+        if ((dot != accel.dotProduct(&a[j], &b[j], testLength - j)) ||
+            (selfDot != accel.dotProduct(&b[j], &b[j], testLength - j)))
+        {
+            fprintf(stderr, "Accelrator is not computing bfloat16 dotproduct correctly.\n");
+            LOG_ABORT("should not be reached");
+        }
+        if (distance != accel.squaredEuclideanDistance(&a[j], &b[j], testLength - j)) {
+            fprintf(stderr, "Accelrator is not computing bfloat16 euclidean distance correctly.\n");
+            LOG_ABORT("should not be reached");
+        }
+    }
+}
+
+void
+verifyBinaryHammingDistance(const IAccelrated & accel)
+{
+    const size_t testLength(255);
+    srand(1);
+    std::vector<uint8_t> a = createAndFill<uint8_t>(testLength);
+    std::vector<uint8_t> b = createAndFill<uint8_t>(testLength);
+    for (size_t j(0); j < 0x20; j++) {
+        size_t expected(0);
+        for (size_t i(j); i < testLength; i++) {
+            expected += __builtin_popcount(a[i] ^ b[i]);
+        }
+        size_t hwComputed = accel.binaryHammingDistance(&a[j], &b[j], testLength - j);
+        if (expected != hwComputed) {
+            fprintf(stderr, "Accelrator is not computing binaryHammingDistance correctly. Expected %zu, computed %zu\n", expected, hwComputed);
+            LOG_ABORT("should not be reached");
+        }
+    }
+}
+
 void
 verifyPopulationCount(const IAccelrated & accel)
 {
@@ -222,6 +298,9 @@ private:
         verifyDotproduct<int64_t>(accelrated);
         verifyEuclideanDistance<float>(accelrated);
         verifyEuclideanDistance<double>(accelrated);
+        verifyInt8Dotproduct(accelrated);
+        verifyBFloat16(accelrated);
+        verifyBinaryHammingDistance(accelrated);
         verifyPopulationCount(accelrated);
         verifyAnd64(accelrated);
         verifyOr64(accelrated);
@@ -6,6 +6,8 @@
 #include <cstdint>
 #include <vector>
 
+namespace vespalib { class BFloat16; }
+
 namespace vespalib::hwaccelrated {
 
 /**
@@ -31,6 +33,12 @@ public:
     virtual double squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const noexcept = 0;
     virtual double squaredEuclideanDistance(const float * a, const float * b, size_t sz) const noexcept = 0;
     virtual double squaredEuclideanDistance(const double * a, const double * b, size_t sz) const noexcept = 0;
+    // bfloat16 values are widened to float, and products are accumulated as float
+    virtual float dotProduct(const float * a, const BFloat16 * b, size_t sz) const noexcept = 0;
+    virtual float dotProduct(const BFloat16 * a, const BFloat16 * b, size_t sz) const noexcept = 0;
+    virtual double squaredEuclideanDistance(const float * a, const BFloat16 * b, size_t sz) const noexcept = 0;
+    // Number of differing bits in two blobs of sz bytes
+    virtual size_t binaryHammingDistance(const void * a, const void * b, size_t sz) const noexcept = 0;
     // AND 128 bytes from multiple, optionally inverted sources
     virtual void and128(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const noexcept = 0;
     // OR 128 bytes from multiple, optionally inverted sources
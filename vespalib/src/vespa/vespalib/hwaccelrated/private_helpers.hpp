@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <vespa/vespalib/util/bfloat16.h>
 #include <vespa/vespalib/util/optimized.h>
 #include <cstring>
 
@@ -102,5 +103,71 @@ squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) {
     return sum;
 }
 
+template<typename TemporaryT=int32_t>
+int64_t dotProductT(const int8_t * a, const int8_t * b, size_t sz) __attribute__((noinline));
+template<typename TemporaryT>
+int64_t dotProductT(const int8_t * a, const int8_t * b, size_t sz)
+{
+    // Same trick as for euclidean distance, a narrow accumulator lets the compiler use wider vectors
+    TemporaryT sum = 0;
+    for (size_t i(0); i < sz; i++) {
+        sum += int16_t(a[i]) * int16_t(b[i]);
+    }
+    return sum;
+}
+
+inline int64_t
+dotProduct(const int8_t * a, const int8_t * b, size_t sz) {
+    constexpr size_t LOOP_COUNT = 0x10000;
+    int64_t sum(0);
+    size_t i=0;
+    for (; i + LOOP_COUNT <= sz; i += LOOP_COUNT) {
+        sum += dotProductT<int32_t>(a + i, b + i, LOOP_COUNT);
+    }
+    sum += dotProductT<int32_t>(a + i, b + i, sz - i);
+    return sum;
+}
+
+inline float
+toFloat(float v) { return v; }
+
+inline float
+toFloat(BFloat16 v) { return v.to_float(); }
+
+template <typename TA, typename TB>
+float
+dotProduct(const TA * a, const TB * b, size_t sz) {
+    constexpr size_t UNROLL = 4;
+    float partial[UNROLL] = { 0, 0, 0, 0 };
+    size_t i(0);
+    for (; i + UNROLL <= sz; i += UNROLL) {
+        for (size_t j(0); j < UNROLL; j++) {
+            partial[j] += toFloat(a[i+j]) * toFloat(b[i+j]);
+        }
+    }
+    for (; i < sz; i++) {
+        partial[i%UNROLL] += toFloat(a[i]) * toFloat(b[i]);
+    }
+    return (partial[0] + partial[1]) + (partial[2] + partial[3]);
+}
+
+inline double
+squaredEuclideanDistance(const float * a, const BFloat16 * b, size_t sz) {
+    constexpr size_t UNROLL = 4;
+    float partial[UNROLL] = { 0, 0, 0, 0 };
+    size_t i(0);
+    for (; i + UNROLL <= sz; i += UNROLL) {
+        for (size_t j(0); j < UNROLL; j++) {
+            float d = a[i+j] - b[i+j].to_float();
+            partial[j] += d * d;
+        }
+    }
+    for (; i < sz; i++) {
+        float d = a[i] - b[i].to_float();
+        partial[i%UNROLL] += d * d;
+    }
+    return double(partial[0] + partial[1]) + double(partial[2] + partial[3]);
+}
+
 }
 }
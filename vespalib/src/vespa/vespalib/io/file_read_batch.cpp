@@ -0,0 +1,195 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "file_read_batch.h"
+#include "fileutil.h"
+#include <vespa/vespalib/util/error.h>
+#include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/hdr_abort.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/config.h>
+#include <cerrno>
+#include <cinttypes>
+
+#ifdef VESPA_HAS_IO_URING
+#include <liburing.h>
+#include <liburing/io_uring.h>
+#include <cstdlib>
+#include <exception>
+#endif
+
+namespace vespalib {
+
+namespace {
+
+using Request = FileReadBatch::Request;
+
+// Read (the rest of) a request using pread, starting 'done' bytes into it.
+void
+read_rest(const File &file, const Request &req, size_t done)
+{
+    size_t remaining = req.len - done;
+    size_t got = file.read(static_cast<char *>(req.buf) + done, remaining, req.offset + done);
+    if (got != remaining) {
+        throw IoException(make_string("read(%s): short read, got %zu of %zu bytes at offset %" PRIu64,
+                                      file.getFilename().c_str(), done + got, req.len, uint64_t(req.offset)),
+                          IoException::CORRUPT_DATA, VESPA_STRLOC);
+    }
+}
+
+void
+read_sync(const File &file, std::span<const Request> requests)
+{
+    for (const auto &req : requests) {
+        read_rest(file, req, 0);
+    }
+}
+
+#ifdef VESPA_HAS_IO_URING
+
+constexpr unsigned ring_entries = 64;
+
+struct ThreadRing {
+    io_uring ring;
+    bool     valid;
+
+    static bool read_supported() {
+        io_uring_probe *probe = io_uring_get_probe();
+        bool result = (probe != nullptr) && io_uring_opcode_supported(probe, IORING_OP_READ);
+        free(probe);
+        return result;
+    }
+    ThreadRing() : ring(), valid(read_supported() && (io_uring_queue_init(ring_entries, &ring, 0) == 0)) {}
+    ~ThreadRing() {
+        if (valid) {
+            io_uring_queue_exit(&ring);
+        }
+    }
+    // Drop any queued submissions the kernel never accepted by setting up a new ring.
+    void reset() {
+        if (valid) {
+            io_uring_queue_exit(&ring);
+            ring = io_uring();
+            valid = (io_uring_queue_init(ring_entries, &ring, 0) == 0);
+        }
+    }
+};
+
+ThreadRing &
+thread_ring()
+{
+    thread_local ThreadRing thread_ring;
+    return thread_ring;
+}
+
+// Wait for a completion without submitting anything more.
+int
+wait_completion(io_uring &ring)
+{
+    io_uring_cqe *cqe = nullptr;
+    return io_uring_wait_cqe(&ring, &cqe);
+}
+
+void
+read_uring(ThreadRing &thread_ring, const File &file, std::span<const Request> requests)
+{
+    io_uring &ring = thread_ring.ring;
+    int fd = file.getFileDescriptor();
+    size_t next = 0;
+    size_t inflight = 0;
+    std::exception_ptr error;
+    bool submit_failed = false;
+    while ((next < requests.size()) || (inflight > 0)) {
+        while ((next < requests.size()) && (inflight < ring_entries)) {
+            io_uring_sqe *sqe = io_uring_get_sqe(&ring);
+            if (sqe == nullptr) {
+                break;
+            }
+            const auto &req = requests[next];
+            io_uring_prep_read(sqe, fd, req.buf, req.len, req.offset);
+            io_uring_sqe_set_data(sqe, reinterpret_cast<void *>(next));
+            ++next;
+            ++inflight;
+        }
+        int res = submit_failed ? wait_completion(ring) : io_uring_submit_and_wait(&ring, 1);
+        if (res < 0 && res != -EINTR) {
+            if (submit_failed) {
+                // Reads accepted by the kernel may still write into the caller's buffers.
+                HDR_ABORT("could not wait for io_uring completions");
+            }
+            // Only happens on ring setup errors or resource exhaustion in the kernel.
+            // Requests the kernel did not accept will never complete; they are
+            // dropped with the ring once the accepted ones are done.
+            submit_failed = true;
+            inflight -= io_uring_sq_ready(&ring);
+            next = requests.size();
+            if (!error) {
+                error = std::make_exception_ptr(
+                        IoException(make_string("read(%s): io_uring submit failed: %s",
+                                                file.getFilename().c_str(), getErrorString(-res).c_str()),
+                                    IoException::getErrorType(-res), VESPA_STRLOC));
+            }
+        }
+        io_uring_cqe *cqe = nullptr;
+        while (io_uring_peek_cqe(&ring, &cqe) == 0) {
+            size_t idx = reinterpret_cast<size_t>(io_uring_cqe_get_data(cqe));
+            int32_t cqe_res = cqe->res;
+            io_uring_cqe_seen(&ring, cqe);
+            --inflight;
+            const auto &req = requests[idx];
+            if (error || ((cqe_res >= 0) && (size_t(cqe_res) == req.len))) {
+                continue;
+            }
+            try {
+                if (cqe_res >= 0) {
+                    read_rest(file, req, cqe_res);
+                } else if (cqe_res == -EINTR || cqe_res == -EAGAIN) {
+                    read_rest(file, req, 0);
+                } else {
+                    throw IoException(make_string("read(%s): failed reading %zu bytes at offset %" PRIu64 ": %s",
+                                                  file.getFilename().c_str(), req.len, uint64_t(req.offset),
+                                                  getErrorString(-cqe_res).c_str()),
+                                      IoException::getErrorType(-cqe_res), VESPA_STRLOC);
+                }
+            } catch (...) {
+                // Keep draining completions, buffers are owned by the caller.
+                error = std::current_exception();
+                next = requests.size();
+            }
+        }
+    }
+    if (submit_failed) {
+        thread_ring.reset();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+#endif
+
+}
+
+bool
+FileReadBatch::uses_io_uring()
+{
+#ifdef VESPA_HAS_IO_URING
+    return thread_ring().valid;
+#else
+    return false;
+#endif
+}
+
+void
+FileReadBatch::read(const File &file, std::span<const Request> requests)
+{
+#ifdef VESPA_HAS_IO_URING
+    ThreadRing &ring = thread_ring();
+    if (ring.valid && (requests.size() > 1)) {
+        read_uring(ring, file, requests);
+        return;
+    }
+#endif
+    read_sync(file, requests);
+}
+
+}
@@ -0,0 +1,45 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <sys/types.h>
+
+namespace vespalib {
+
+class File;
+
+/**
+ * Performs a batch of positioned reads from a single open file.
+ *
+ * When io_uring is available all reads are submitted to the kernel at
+ * once, letting the storage device serve them in parallel instead of
+ * serializing one pread call per request. Otherwise (or if io_uring
+ * cannot be set up for the calling thread) each request is served by
+ * a regular pread. Each calling thread uses its own ring.
+ **/
+class FileReadBatch {
+public:
+    struct Request {
+        void   *buf;
+        size_t  len;
+        off_t   offset;
+    };
+
+    /**
+     * Returns true if reads issued by the calling thread will be
+     * submitted using io_uring.
+     **/
+    static bool uses_io_uring();
+
+    /**
+     * Read all requests fully. All reads have completed when this
+     * function returns, also when an exception is thrown.
+     *
+     * @throw IoException if a read fails or hits end of file.
+     **/
+    static void read(const File &file, std::span<const Request> requests);
+};
+
+}
@@ -110,6 +110,27 @@ public:
      */
     bool hasKey(const K & key) const;
 
+    /**
+     * Generation of the cached content for the given key, bumped every time
+     * an object with a key in the same lock stripe is written or invalidated.
+     * Sample it before reading from the backing store outside the cache,
+     * and give it to populate.
+     */
+    size_t generation(const K & key) const {
+        return _generations[getStripe(key)].load(std::memory_order_acquire);
+    }
+
+    /**
+     * Insert an object read from the backing store outside the cache.
+     * It is only inserted if the key is not already present and nothing
+     * in the lock stripe of the key has been written or invalidated since
+     * the given generation was sampled, so a stale object is never inserted.
+     * Object is then put at head of LRU list.
+     *
+     * @return true if the object was inserted.
+     */
+    bool populate(const K & key, V value, size_t generation);
+
     virtual CacheStats get_stats() const;
 
     size_t          getHit() const { return _hit.load(std::memory_order_relaxed); }
@@ -136,9 +157,16 @@ private:
      */
     bool removeOldest(const value_type & v) override;
     size_t calcSize(const K & k, const V & v) const { return sizeof(value_type) + _sizeK(k) + _sizeV(v); }
-    std::mutex & getLock(const K & k) {
+    static constexpr size_t NUM_STRIPES = 113;
+    size_t getStripe(const K & k) const {
         size_t h(_hasher(k));
-        return _addLocks[h%(sizeof(_addLocks)/sizeof(_addLocks[0]))];
+        return h % NUM_STRIPES;
+    }
+    std::mutex & getLock(const K & k) {
+        return _addLocks[getStripe(k)];
+    }
+    void bumpGeneration(const K & k) {
+        _generations[getStripe(k)].fetch_add(1, std::memory_order_release);
     }
 
     template <typename V>
@@ -167,7 +195,9 @@ private:
     BackingStore              & _store;
     mutable std::mutex          _hashLock;
     /// Striped locks that can be used for having a locked access to the backing store.
-    std::mutex                  _addLocks[113];
+    std::mutex                  _addLocks[NUM_STRIPES];
+    /// Generation per lock stripe, used to reject populate of objects that might be stale.
+    std::atomic<size_t>         _generations[NUM_STRIPES];
 };
 
 }
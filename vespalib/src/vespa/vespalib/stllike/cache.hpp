@@ -53,7 +53,11 @@ cache<P>::cache(BackingStore & b, size_t maxBytes) :
     _invalidate(0),
     _lookup(0),
     _store(b)
-{ }
+{
+    for (auto & generation : _generations) {
+        generation.store(0, std::memory_order_relaxed);
+    }
+}
 
 template< typename P >
 MemoryUsage
@@ -133,12 +137,29 @@ cache<P>::write(const K & key, V value)
     _store.write(key, value);
     {
         std::lock_guard guard(_hashLock);
+        bumpGeneration(key);
         (*this)[key] = std::move(value);
         _sizeBytes.store(sizeBytes() + newSize, std::memory_order_relaxed);
         increment_stat(_write, guard);
     }
 }
 
+template< typename P >
+bool
+cache<P>::populate(const K & key, V value, size_t generation)
+{
+    std::lock_guard storeGuard(getLock(key));
+    std::lock_guard guard(_hashLock);
+    if ((_generations[getStripe(key)].load(std::memory_order_relaxed) != generation) || Lru::hasKey(key)) {
+        return false;
+    }
+    size_t size = calcSize(key, value);
+    Lru::insert(key, std::move(value));
+    _sizeBytes.store(sizeBytes() + size, std::memory_order_relaxed);
+    increment_stat(_insert, guard);
+    return true;
+}
+
 template< typename P >
 void
 cache<P>::erase(const K & key)
@@ -153,6 +174,8 @@ void
 cache<P>::invalidate(const UniqueLock & guard, const K & key)
 {
     verifyHashLock(guard);
+    // Also when not present, to stop populate of objects read before the invalidation.
+    bumpGeneration(key);
     if (Lru::hasKey(key)) {
         _sizeBytes.store(sizeBytes() - calcSize(key, (*this)[key]), std::memory_order_relaxed);
         increment_stat(_invalidate, guard);
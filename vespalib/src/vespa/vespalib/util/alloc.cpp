@@ -2,8 +2,14 @@
 #include "alloc.h"
 #include "atomic.h"
 #include "memory_allocator.h"
+#include "numa.h"
 #include "round_up_to_page_size.h"
 #include <sys/mman.h>
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/exceptions.h>
 #include <vespa/vespalib/util/backtrace.h>
@@ -29,6 +35,7 @@ bool _G_SilenceCoreOnOOM(false);
 int  _G_HugeFlags = 0;
 size_t _G_MMapLogLimit = std::numeric_limits<size_t>::max();
 size_t _G_MMapNoCoreLimit = std::numeric_limits<size_t>::max();
+size_t _G_MMapInterleaveLimit = std::numeric_limits<size_t>::max();
 std::mutex _G_lock;
 std::atomic<size_t> _G_mmapCount(0);
 
@@ -74,8 +81,42 @@ void initializeEnvironment()
     _G_SilenceCoreOnOOM = (getenv("VESPA_SILENCE_CORE_ON_OOM") != nullptr) ? true : false;
     _G_MMapLogLimit = readOptionalEnvironmentVar("VESPA_MMAP_LOG_LIMIT", std::numeric_limits<size_t>::max());
     _G_MMapNoCoreLimit = readOptionalEnvironmentVar("VESPA_MMAP_NOCORE_LIMIT", std::numeric_limits<size_t>::max());
+    _G_MMapInterleaveLimit = readOptionalEnvironmentVar("VESPA_MMAP_INTERLEAVE_LIMIT", std::numeric_limits<size_t>::max());
 }
 
+#ifdef __linux__
+/*
+ * Spread the pages of a large mapping over all NUMA nodes, so that large
+ * shared structures (attribute vectors, data store buffers) do not end up
+ * on the node of the thread that happened to touch them first.
+ */
+void interleaveOverNumaNodes(void * buf, size_t sz)
+{
+    static const std::vector<unsigned long> nodeMask = [] {
+        NumaNodes nodes = NumaNodes::detect();
+        std::vector<unsigned long> mask;
+        if (nodes.size() > 1) {
+            constexpr size_t bits = 8 * sizeof(unsigned long);
+            for (size_t i = 0; i < nodes.size(); ++i) {
+                uint32_t id = nodes.node(i).id;
+                mask.resize(std::max(mask.size(), id / bits + 1), 0);
+                mask[id / bits] |= 1ul << (id % bits);
+            }
+        }
+        return mask;
+    }();
+    if (nodeMask.empty()) {
+        return;
+    }
+    if (syscall(SYS_mbind, buf, sz, MPOL_INTERLEAVE, nodeMask.data(), 8 * sizeof(unsigned long) * nodeMask.size() + 1, 0) != 0) {
+        static std::atomic<bool> warned(false);
+        if ( ! warned.exchange(true, std::memory_order_relaxed)) {
+            LOG(warning, "Failed mbind(%p, %ld, MPOL_INTERLEAVE) = '%s'", buf, sz, FastOS_FileInterface::getLastErrorString().c_str());
+        }
+    }
+}
+#endif
+
 class Initialize {
 public:
     Initialize() { initializeEnvironment(); }
@@ -376,6 +417,9 @@ MMapAllocator::salloc(size_t sz, void * wantedAddress)
                 LOG(warning, "Failed madvise(%p, %ld, MADV_DONTDUMP) = '%s'", buf, sz, FastOS_FileInterface::getLastErrorString().c_str());
             }
         }
+        if (sz >= _G_MMapInterleaveLimit) {
+            interleaveOverNumaNodes(buf, sz);
+        }
 #endif
         if (sz >= _G_MMapLogLimit) {
             std::lock_guard guard(_G_lock);
@@ -30,6 +30,13 @@ public:
 CompressionConfig::Type compress(CompressionConfig::Type compression, const ConstBufferRef & org, DataBuffer & dest, bool allowSwap);
 CompressionConfig::Type compress(CompressionConfig compression, const vespalib::ConstBufferRef & org, vespalib::DataBuffer & dest, bool allowSwap);
 
+/**
+ * As above, but using the given compressor instead of one selected by the compression type.
+ * The return value tells if the data was compressed (compression.type) or not (NONE).
+ * When not compressed nothing is written to dest.
+ */
+CompressionConfig::Type compress(ICompressor & compressor, CompressionConfig compression, const ConstBufferRef & org, DataBuffer & dest);
+
 /**
  * Will try to decompress a buffer according to the config.
  * be met it will return NONE and dest will get the input buffer.
@@ -43,6 +50,11 @@ CompressionConfig::Type compress(CompressionConfig compression, const vespalib::
  */
 void decompress(CompressionConfig::Type compression, size_t uncompressedLen, const vespalib::ConstBufferRef & org, vespalib::DataBuffer & dest, bool allowSwap);
 
+/**
+ * As above, but using the given decompressor for data that is known to be compressed.
+ */
+void decompress(ICompressor & decompressor, size_t uncompressedLen, const ConstBufferRef & org, DataBuffer & dest, bool allowSwap);
+
 size_t computeMaxCompressedsize(CompressionConfig::Type type, size_t uncompressedSize);
 
 //-----------------------------------------------------------------------------
@@ -115,6 +115,16 @@ public:
         node.total_time += elapsed;
         _state.pop_back();
     }
+    size_t total_count() const override {
+        size_t result = 0;
+        for (const auto &node: _nodes) {
+            result += node.count;
+        }
+        return result;
+    }
+    duration total_time() const override {
+        return get_children_time(_roots);
+    }
     void report(slime::Cursor &obj, ReportContext &ctx) const override {
         obj.setString("profiler", "tree");
         obj.setLong("depth", ctx.get_max_depth());
@@ -198,6 +208,16 @@ public:
             _state.back().overlap += elapsed;
         }
     }
+    size_t total_count() const override {
+        size_t result = 0;
+        for (const auto &node: _nodes) {
+            result += node.count;
+        }
+        return result;
+    }
+    duration total_time() const override {
+        return get_total_time();
+    }
     void report(slime::Cursor &obj, ReportContext &ctx) const override {
         obj.setString("profiler", "flat");
         obj.setLong("topn", _topn);
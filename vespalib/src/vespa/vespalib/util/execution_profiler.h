@@ -31,6 +31,8 @@ public:
         virtual void track_start(TaskId task) = 0;
         virtual void track_complete() = 0;
         virtual void report(slime::Cursor &obj, ReportContext &ctx) const = 0;
+        virtual size_t total_count() const = 0;
+        virtual duration total_time() const = 0;
     };
     using NameMapper = std::function<vespalib::string(const vespalib::string &)>;
 
@@ -58,6 +60,10 @@ public:
     }
     void report(slime::Cursor &obj, const NameMapper &name_mapper =
                 [](const vespalib::string &name) noexcept { return name; }) const;
+    // total number of completed tasks (within max depth)
+    size_t total_count() const { return _impl->total_count(); }
+    // total time spent in top-level tasks (within max depth)
+    duration total_time() const { return _impl->total_time(); }
 };
 
 }
@@ -0,0 +1,116 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "huge_page_allocator.h"
+#include "exceptions.h"
+#include "stringfmt.h"
+#include <sys/mman.h>
+#include <cassert>
+#include <cerrno>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".vespalib.alloc.huge_page_allocator");
+
+namespace vespalib::alloc {
+
+HugePageAllocator::HugePageAllocator()
+    : MemoryAllocator(),
+      _small_allocator(*MemoryAllocator::select_allocator()),
+      _lock(),
+      _huge_page_allocations(),
+      _stats()
+{
+}
+
+HugePageAllocator::~HugePageAllocator()
+{
+    assert(_huge_page_allocations.empty());
+}
+
+PtrAndSize
+HugePageAllocator::alloc(size_t sz) const
+{
+    if (sz == 0) {
+        return PtrAndSize();
+    }
+    return is_large(sz) ? alloc_large(sz) : _small_allocator.alloc(sz);
+}
+
+PtrAndSize
+HugePageAllocator::alloc_large(size_t sz) const
+{
+    sz = roundUpToHugePages(sz);
+    const int prot(PROT_READ | PROT_WRITE);
+    bool huge_pages = false;
+    void *buf = MAP_FAILED;
+#ifdef __linux__
+    buf = mmap(nullptr, sz, prot, MAP_ANON | MAP_PRIVATE | MAP_HUGETLB, -1, 0);
+    huge_pages = (buf != MAP_FAILED);
+#endif
+    if (!huge_pages) {
+        buf = mmap(nullptr, sz, prot, MAP_ANON | MAP_PRIVATE, -1, 0);
+        if (buf == MAP_FAILED) {
+            throw OOMException(make_string("Failed mmaping anonymous of size %zu errno(%d)", sz, errno));
+        }
+#ifdef __linux__
+        if (madvise(buf, sz, MADV_HUGEPAGE) != 0) {
+            // Just an advise, not everyone will listen...
+        }
+#endif
+    }
+    std::lock_guard guard(_lock);
+    if (huge_pages) {
+        _huge_page_allocations.insert(buf);
+        _stats.huge_page_bytes += sz;
+    } else {
+        if (_stats.fallbacks == 0) {
+            LOG(info, "Huge pages not available for allocation of %zu bytes, using ordinary pages", sz);
+        }
+        ++_stats.fallbacks;
+        _stats.fallback_bytes += sz;
+    }
+    return PtrAndSize(buf, sz);
+}
+
+void
+HugePageAllocator::free(PtrAndSize alloc) const noexcept
+{
+    if (alloc.get() == nullptr) {
+        return;
+    }
+    if (alloc.size() >= HUGEPAGE_SIZE) {
+        free_large(alloc);
+    } else {
+        _small_allocator.free(alloc);
+    }
+}
+
+void
+HugePageAllocator::free_large(PtrAndSize alloc) const noexcept
+{
+    {
+        std::lock_guard guard(_lock);
+        if (_huge_page_allocations.erase(alloc.get()) != 0) {
+            _stats.huge_page_bytes -= alloc.size();
+        } else {
+            _stats.fallback_bytes -= alloc.size();
+        }
+    }
+    int retval = munmap(alloc.get(), alloc.size());
+    assert(retval == 0);
+    (void) retval;
+}
+
+size_t
+HugePageAllocator::resize_inplace(PtrAndSize, size_t) const
+{
+    return 0;
+}
+
+HugePageAllocator::Stats
+HugePageAllocator::get_stats() const
+{
+    std::lock_guard guard(_lock);
+    return _stats;
+}
+
+}
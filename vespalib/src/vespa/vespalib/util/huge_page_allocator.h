@@ -0,0 +1,49 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "memory_allocator.h"
+#include <mutex>
+#include <unordered_set>
+
+namespace vespalib::alloc {
+
+/*
+ * Class handling memory allocations backed by explicit huge pages.
+ *
+ * Allocations of at least half a huge page are rounded up to whole huge
+ * pages and mapped with MAP_HUGETLB. If the huge page pool is exhausted
+ * (or not configured) the allocation falls back to an ordinary mapping
+ * advised to use transparent huge pages. Smaller allocations use the
+ * default allocator.
+ *
+ * Thread safe. Should not be destructed before all allocations have
+ * been freed.
+ */
+class HugePageAllocator : public MemoryAllocator {
+public:
+    struct Stats {
+        size_t huge_page_bytes; // allocated bytes backed by explicit huge pages
+        size_t fallback_bytes;  // allocated bytes in ordinary mappings due to fallback
+        size_t fallbacks;       // number of allocations that fell back to ordinary mappings
+        Stats() noexcept : huge_page_bytes(0), fallback_bytes(0), fallbacks(0) { }
+    };
+private:
+    const MemoryAllocator&                   _small_allocator;
+    mutable std::mutex                       _lock;
+    mutable std::unordered_set<const void *> _huge_page_allocations;
+    mutable Stats                            _stats;
+
+    static bool is_large(size_t sz) noexcept { return sz >= (HUGEPAGE_SIZE >> 1); }
+    PtrAndSize alloc_large(size_t sz) const;
+    void free_large(PtrAndSize alloc) const noexcept;
+public:
+    HugePageAllocator();
+    ~HugePageAllocator() override;
+    PtrAndSize alloc(size_t sz) const override;
+    void free(PtrAndSize alloc) const noexcept override;
+    size_t resize_inplace(PtrAndSize, size_t) const override;
+    Stats get_stats() const;
+};
+
+}
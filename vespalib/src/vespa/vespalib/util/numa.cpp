@@ -0,0 +1,122 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "numa.h"
+#include <vespa/vespalib/util/stringfmt.h>
+#include <atomic>
+#include <fstream>
+#include <cstdlib>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace vespalib {
+
+namespace {
+
+thread_local int _current_numa_node = -1;
+
+vespalib::string read_first_line(const vespalib::string &file_name) {
+    std::ifstream file(file_name.c_str());
+    std::string line;
+    if (file && std::getline(file, line)) {
+        return line;
+    }
+    return {};
+}
+
+void bind_current_thread(const NumaNodes &nodes, size_t node_idx) {
+#ifdef __linux__
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    for (uint32_t cpu: nodes.node(node_idx).cpus) {
+        if (cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &cpus);
+        }
+    }
+    // Just a placement hint, run unbound if it is not allowed
+    [[maybe_unused]] int result = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+#endif
+    _current_numa_node = node_idx;
+}
+
+}
+
+NumaNodes::CpuList
+NumaNodes::parse_list(const vespalib::string &list)
+{
+    CpuList result;
+    const char *pos = list.c_str();
+    while (*pos != '\0' && *pos != '\n') {
+        char *end = nullptr;
+        unsigned long first = strtoul(pos, &end, 10);
+        if (end == pos) {
+            return {};
+        }
+        unsigned long last = first;
+        pos = end;
+        if (*pos == '-') {
+            ++pos;
+            last = strtoul(pos, &end, 10);
+            if (end == pos || last < first) {
+                return {};
+            }
+            pos = end;
+        }
+        for (unsigned long cpu = first; cpu <= last; ++cpu) {
+            result.push_back(cpu);
+        }
+        if (*pos == ',') {
+            ++pos;
+        } else if (*pos != '\0' && *pos != '\n') {
+            return {};
+        }
+    }
+    return result;
+}
+
+NumaNodes
+NumaNodes::detect(const vespalib::string &node_dir)
+{
+    std::vector<Node> nodes;
+    for (uint32_t id: parse_list(read_first_line(node_dir + "/online"))) {
+        auto cpus = parse_list(read_first_line(make_string("%s/node%u/cpulist", node_dir.c_str(), id)));
+        if (!cpus.empty()) {
+            nodes.push_back(Node{id, std::move(cpus)});
+        }
+    }
+    return NumaNodes(std::move(nodes));
+}
+
+NumaNodes
+NumaNodes::detect()
+{
+    return detect("/sys/devices/system/node");
+}
+
+Runnable::init_fun_t bind_to_numa_nodes(Runnable::init_fun_t init, std::shared_ptr<const NumaNodes> nodes) {
+    if (!nodes || nodes->size() < 2) {
+        return init;
+    }
+    auto next = std::make_shared<std::atomic<size_t>>(0);
+    return [init,nodes,next](Runnable &target) {
+        bind_current_thread(*nodes, next->fetch_add(1, std::memory_order_relaxed) % nodes->size());
+        return init(target);
+    };
+}
+
+Runnable::init_fun_t bind_to_numa_node(Runnable::init_fun_t init, std::shared_ptr<const NumaNodes> nodes, size_t node_idx) {
+    if (!nodes || node_idx >= nodes->size()) {
+        return init;
+    }
+    return [init,nodes,node_idx](Runnable &target) {
+        bind_current_thread(*nodes, node_idx);
+        return init(target);
+    };
+}
+
+int current_numa_node() noexcept {
+    return _current_numa_node;
+}
+
+} // namespace
@@ -0,0 +1,59 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "runnable.h"
+#include <vespa/vespalib/stllike/string.h>
+#include <memory>
+#include <vector>
+
+namespace vespalib {
+
+/**
+ * The NUMA nodes of this host together with the cpus belonging to
+ * each node, as reported by sysfs. A host without NUMA support (or
+ * without sysfs) is reported as having no nodes.
+ **/
+class NumaNodes {
+public:
+    using CpuList = std::vector<uint32_t>;
+    struct Node {
+        uint32_t id;
+        CpuList  cpus;
+    };
+private:
+    std::vector<Node> _nodes;
+public:
+    NumaNodes() noexcept : _nodes() {}
+    explicit NumaNodes(std::vector<Node> nodes) noexcept : _nodes(std::move(nodes)) {}
+    size_t size() const noexcept { return _nodes.size(); }
+    const Node &node(size_t idx) const noexcept { return _nodes[idx]; }
+
+    // parse a kernel cpu/node list like "0-3,8,10-11"; returns an
+    // empty list if the input could not be parsed.
+    static CpuList parse_list(const vespalib::string &list);
+
+    // detect the NUMA nodes of this host using the given sysfs node
+    // directory (normally "/sys/devices/system/node")
+    static NumaNodes detect(const vespalib::string &node_dir);
+    static NumaNodes detect();
+};
+
+// Wraps an init function inside another init function that binds the
+// thread being started to the cpus of a single NUMA node. Threads
+// are spread over the nodes in a round robin fashion. The wrapped
+// init function is returned unchanged if there is less than 2 nodes.
+
+Runnable::init_fun_t bind_to_numa_nodes(Runnable::init_fun_t init, std::shared_ptr<const NumaNodes> nodes);
+
+// Wraps an init function inside another init function that binds the
+// thread being started to the cpus of the given NUMA node (index
+// into 'nodes').
+
+Runnable::init_fun_t bind_to_numa_node(Runnable::init_fun_t init, std::shared_ptr<const NumaNodes> nodes, size_t node_idx);
+
+// The index of the NUMA node the current thread was bound to by one
+// of the functions above, -1 if the thread is not bound.
+
+int current_numa_node() noexcept;
+
+}
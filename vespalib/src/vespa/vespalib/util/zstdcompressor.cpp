@@ -3,7 +3,9 @@
 #include "zstdcompressor.h"
 #include <vespa/vespalib/util/alloc.h>
 #include <zstd.h>
+#include <zdict.h>
 #include <cassert>
+#include <stdexcept>
 
 using vespalib::alloc::Alloc;
 
@@ -31,6 +33,22 @@ private:
 thread_local std::unique_ptr<CompressContext>  _tlCompressState;
 thread_local std::unique_ptr<DecompressContext> _tlDecompressState;
 
+CompressContext &
+compress_context() {
+    if ( ! _tlCompressState) {
+        _tlCompressState = std::make_unique<CompressContext>();
+    }
+    return *_tlCompressState;
+}
+
+DecompressContext &
+decompress_context() {
+    if ( ! _tlDecompressState) {
+        _tlDecompressState = std::make_unique<DecompressContext>();
+    }
+    return *_tlDecompressState;
+}
+
 }
 
 size_t ZStdCompressor::adjustProcessLen(uint16_t, size_t len)   const { return ZSTD_compressBound(len); }
@@ -39,10 +57,7 @@ bool
 ZStdCompressor::process(CompressionConfig config, const void * inputV, size_t inputLen, void * outputV, size_t & outputLenV)
 {
     size_t maxOutputLen = ZSTD_compressBound(inputLen);
-    if ( ! _tlCompressState) {
-        _tlCompressState = std::make_unique<CompressContext>();
-    }
-    size_t sz = ZSTD_compressCCtx(_tlCompressState->get(), outputV, maxOutputLen, inputV, inputLen, config.compressionLevel);
+    size_t sz = ZSTD_compressCCtx(compress_context().get(), outputV, maxOutputLen, inputV, inputLen, config.compressionLevel);
     assert( ! ZSTD_isError(sz) );
     outputLenV = sz;
     return ! ZSTD_isError(sz);
@@ -51,13 +66,91 @@ ZStdCompressor::process(CompressionConfig config, const void * inputV, size_t in
 bool
 ZStdCompressor::unprocess(const void * inputV, size_t inputLen, void * outputV, size_t & outputLenV)
 {
-    if ( ! _tlDecompressState) {
-        _tlDecompressState = std::make_unique<DecompressContext>();
-    }
-    size_t sz = ZSTD_decompressDCtx(_tlDecompressState->get(), outputV, outputLenV, inputV, inputLen);
+    size_t sz = ZSTD_decompressDCtx(decompress_context().get(), outputV, outputLenV, inputV, inputLen);
     assert( ! ZSTD_isError(sz) );
     outputLenV = sz;
     return ! ZSTD_isError(sz);
 }
 
+ZStdDictionaryCompressor::ZStdDictionaryCompressor(ConstBufferRef dictionary)
+    : _dictionary(dictionary.c_str(), dictionary.c_str() + dictionary.size()),
+      _cdictOnce(),
+      _cdict(nullptr),
+      _ddict(ZSTD_createDDict(_dictionary.data(), _dictionary.size()))
+{
+    if (_ddict == nullptr) {
+        throw std::runtime_error("Failed creating zstd decompression dictionary");
+    }
+}
+
+ZStdDictionaryCompressor::~ZStdDictionaryCompressor()
+{
+    ZSTD_freeCDict(_cdict);
+    ZSTD_freeDDict(_ddict);
+}
+
+std::vector<char>
+ZStdDictionaryCompressor::train(const std::vector<ConstBufferRef> & samples, size_t maxSize)
+{
+    std::vector<char> concatenated;
+    std::vector<size_t> sampleSizes;
+    sampleSizes.reserve(samples.size());
+    for (const ConstBufferRef & sample : samples) {
+        concatenated.insert(concatenated.end(), sample.c_str(), sample.c_str() + sample.size());
+        sampleSizes.push_back(sample.size());
+    }
+    std::vector<char> dictionary(maxSize);
+    size_t sz = ZDICT_trainFromBuffer(dictionary.data(), dictionary.size(), concatenated.data(),
+                                      sampleSizes.data(), sampleSizes.size());
+    if (ZDICT_isError(sz)) {
+        return {};
+    }
+    dictionary.resize(sz);
+    return dictionary;
+}
+
+uint32_t
+ZStdDictionaryCompressor::getDictionaryId() const
+{
+    return ZDICT_getDictID(_dictionary.data(), _dictionary.size());
+}
+
+const ZSTD_CDict_s *
+ZStdDictionaryCompressor::getCompressDictionary(int compressionLevel)
+{
+    std::call_once(_cdictOnce, [this, compressionLevel]() {
+        _cdict = ZSTD_createCDict(_dictionary.data(), _dictionary.size(), compressionLevel);
+    });
+    return _cdict;
+}
+
+size_t ZStdDictionaryCompressor::adjustProcessLen(uint16_t, size_t len) const { return ZSTD_compressBound(len); }
+
+bool
+ZStdDictionaryCompressor::process(CompressionConfig config, const void * inputV, size_t inputLen, void * outputV, size_t & outputLenV)
+{
+    const ZSTD_CDict * cdict = getCompressDictionary(config.compressionLevel);
+    if (cdict == nullptr) {
+        return false;
+    }
+    size_t maxOutputLen = ZSTD_compressBound(inputLen);
+    size_t sz = ZSTD_compress_usingCDict(compress_context().get(), outputV, maxOutputLen, inputV, inputLen, cdict);
+    if (ZSTD_isError(sz)) {
+        return false;
+    }
+    outputLenV = sz;
+    return true;
+}
+
+bool
+ZStdDictionaryCompressor::unprocess(const void * inputV, size_t inputLen, void * outputV, size_t & outputLenV)
+{
+    size_t sz = ZSTD_decompress_usingDDict(decompress_context().get(), outputV, outputLenV, inputV, inputLen, _ddict);
+    if (ZSTD_isError(sz)) {
+        return false;
+    }
+    outputLenV = sz;
+    return true;
+}
+
 }
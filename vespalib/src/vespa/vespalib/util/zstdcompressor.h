@@ -2,6 +2,11 @@
 #pragma once
 
 #include "compressor.h"
+#include <mutex>
+#include <vector>
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
 
 namespace vespalib::compression {
 
@@ -13,5 +18,41 @@ public:
     size_t adjustProcessLen(uint16_t options, size_t len)   const override;
 };
 
+/**
+ * Zstd compression using a pre-trained dictionary. This compresses small inputs
+ * similar to the training samples far better than plain zstd.
+ * Data must be decompressed with the same dictionary it was compressed with.
+ * Safe for concurrent use. The compression level of the first process() call
+ * is used for the lifetime of the instance.
+ **/
+class ZStdDictionaryCompressor : public ICompressor
+{
+public:
+    explicit ZStdDictionaryCompressor(ConstBufferRef dictionary);
+    ZStdDictionaryCompressor(const ZStdDictionaryCompressor &) = delete;
+    ZStdDictionaryCompressor & operator = (const ZStdDictionaryCompressor &) = delete;
+    ~ZStdDictionaryCompressor() override;
+
+    /**
+     * Train a dictionary of at most maxSize bytes from the given samples.
+     * Returns an empty dictionary if training fails, e.g. when there are too few samples.
+     **/
+    static std::vector<char> train(const std::vector<ConstBufferRef> & samples, size_t maxSize);
+
+    ConstBufferRef getDictionary() const { return {_dictionary.data(), _dictionary.size()}; }
+    uint32_t getDictionaryId() const;
+
+    bool process(CompressionConfig config, const void * input, size_t inputLen, void * output, size_t & outputLen) override;
+    bool unprocess(const void * input, size_t inputLen, void * output, size_t & outputLen) override;
+    size_t adjustProcessLen(uint16_t options, size_t len)   const override;
+private:
+    const ZSTD_CDict_s * getCompressDictionary(int compressionLevel);
+
+    std::vector<char>   _dictionary;
+    std::once_flag      _cdictOnce;
+    ZSTD_CDict_s      * _cdict;
+    ZSTD_DDict_s      * _ddict;
+};
+
 }
 